@@ -0,0 +1 @@
+#include "/root/repo/src/antenna/model/antenna-model.h"
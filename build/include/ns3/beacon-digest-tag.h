@@ -0,0 +1 @@
+#include "/root/repo/src/wifi/model/beacon-digest-tag.h"
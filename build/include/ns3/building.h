@@ -0,0 +1 @@
+#include "/root/repo/src/buildings/model/building.h"
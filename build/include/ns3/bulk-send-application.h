@@ -0,0 +1 @@
+#include "/root/repo/src/applications/model/bulk-send-application.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/propagation/model/cached-propagation-loss-model.h"
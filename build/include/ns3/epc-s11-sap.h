@@ -0,0 +1 @@
+#include "/root/repo/src/lte/model/epc-s11-sap.h"
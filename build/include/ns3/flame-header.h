@@ -0,0 +1 @@
+#include "/root/repo/src/mesh/model/flame/flame-header.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/internet/helper/ipv6-list-routing-helper.h"
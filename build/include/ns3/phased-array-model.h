@@ -0,0 +1 @@
+#include "/root/repo/src/antenna/model/phased-array-model.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/lte/helper/radio-environment-map-helper.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/sixlowpan/helper/sixlowpan-helper.h"
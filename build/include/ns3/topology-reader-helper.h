@@ -0,0 +1 @@
+#include "/root/repo/src/topology-read/helper/topology-reader-helper.h"
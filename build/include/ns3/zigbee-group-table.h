@@ -0,0 +1 @@
+#include "/root/repo/src/zigbee/model/zigbee-group-table.h"
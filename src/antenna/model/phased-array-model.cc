@@ -10,10 +10,13 @@
 
 #include "ns3/boolean.h"
 #include "ns3/double.h"
+#include "ns3/hash.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
 #include "ns3/uinteger.h"
 
+#include <sstream>
+
 namespace ns3
 {
 
@@ -151,6 +154,73 @@ PhasedArrayModel::IsChannelOutOfDate(Ptr<const PhasedArrayModel> antennaB) const
     return needsUpdate;
 }
 
+/**
+ * Write the type and the values of all the attributes of an object to a stream. The objects
+ * pointed to by attributes holding a pointer are serialized recursively.
+ *
+ * @param object the object
+ * @param os the output stream
+ */
+static void
+SerializeConfig(const ObjectBase& object, std::ostream& os)
+{
+    TypeId tid = object.GetInstanceTypeId();
+    os << tid.GetName() << '{';
+    while (true)
+    {
+        for (std::size_t i = 0; i < tid.GetAttributeN(); ++i)
+        {
+            auto info = tid.GetAttribute(i);
+            if (!(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter())
+            {
+                continue;
+            }
+            auto value = info.checker->Create();
+            object.GetAttribute(info.name, *value);
+            os << info.name << '=';
+            if (auto pointer = dynamic_cast<const PointerValue*>(PeekPointer(value)))
+            {
+                if (auto pointee = pointer->Get<Object>())
+                {
+                    SerializeConfig(*pointee, os);
+                }
+            }
+            else
+            {
+                os << value->SerializeToString(info.checker);
+            }
+            os << ';';
+        }
+        if (!tid.HasParent())
+        {
+            break;
+        }
+        tid = tid.GetParent();
+    }
+    os << '}';
+}
+
+uint64_t
+PhasedArrayModel::GetConfigHash() const
+{
+    NS_LOG_FUNCTION(this);
+
+    std::ostringstream oss;
+    oss << std::hexfloat;
+    SerializeConfig(*this, oss);
+    if (m_antennaElement)
+    {
+        // the antenna element may have been set without using the attribute
+        SerializeConfig(*m_antennaElement, oss);
+    }
+    for (std::size_t i = 0; i < GetNumElems(); ++i)
+    {
+        oss << GetElementLocation(i) << ':' << +GetElemPol(i) << ';';
+    }
+    oss << GetPolSlant();
+    return Hash64(oss.str());
+}
+
 void
 PhasedArrayModel::InvalidateChannels() const
 {
@@ -251,6 +251,21 @@ class PhasedArrayModel : public Object
      */
     bool IsChannelOutOfDate(Ptr<const PhasedArrayModel> antennaB) const;
 
+    /**
+     * Returns a hash of the configuration of this antenna array, i.e., of its type, of the
+     * values of its attributes (including those of the antenna element) and of the location
+     * and polarization of its elements. Antenna arrays with the same configuration hash
+     * produce the same channel realizations when used to generate the channel matrix from the
+     * same channel parameters, hence this hash can be used to share channel matrices among
+     * different antenna arrays. The beamforming vector is not part of the configuration.
+     *
+     * The hash is recomputed at every call, hence this method should not be called for every
+     * transmission.
+     *
+     * @return the hash of the configuration of this antenna array
+     */
+    uint64_t GetConfigHash() const;
+
   protected:
     /**
      * After changing the antenna settings, InvalidateChannels() should be called to mark
@@ -9,6 +9,7 @@
 #include "sstream"
 #include "string"
 
+#include "ns3/cosine-antenna-model.h"
 #include "ns3/double.h"
 #include "ns3/isotropic-antenna-model.h"
 #include "ns3/log.h"
@@ -276,6 +277,76 @@ UpdateOnChangeTestCase::DoRun()
                           "Expecting update, antenna parameter changed");
 }
 
+/**
+ * @ingroup antenna-tests
+ *
+ * @brief Test that the configuration hash of a UniformPlanarArray only depends on its
+ * configuration
+ */
+class ConfigHashTestCase : public TestCase
+{
+  public:
+    ConfigHashTestCase()
+        : TestCase("Test GetConfigHash() for UniformPlanarArray")
+    {
+    }
+
+  private:
+    /**
+     * Run the test
+     */
+    void DoRun() override;
+};
+
+void
+ConfigHashTestCase::DoRun()
+{
+    auto createArray = []() {
+        return CreateObjectWithAttributes<UniformPlanarArray>(
+            "AntennaElement",
+            PointerValue(CreateObject<CosineAntennaModel>()),
+            "NumRows",
+            UintegerValue(4),
+            "NumColumns",
+            UintegerValue(8),
+            "DowntiltAngle",
+            DoubleValue(DegreesToRadians(10)));
+    };
+    auto ant = createArray();
+    auto ant2 = createArray();
+
+    NS_TEST_ASSERT_MSG_EQ(ant->GetConfigHash(),
+                          ant2->GetConfigHash(),
+                          "Arrays with the same configuration should have the same hash");
+
+    ant->SetBeamformingVector(ant->GetBeamformingVector(Angles(DegreesToRadians(30), 0)));
+    NS_TEST_ASSERT_MSG_EQ(ant->GetConfigHash(),
+                          ant2->GetConfigHash(),
+                          "The beamforming vector should not affect the hash");
+
+    ant->SetBeta(DegreesToRadians(20));
+    NS_TEST_ASSERT_MSG_NE(ant->GetConfigHash(),
+                          ant2->GetConfigHash(),
+                          "The downtilt angle should affect the hash");
+    ant->SetBeta(DegreesToRadians(10));
+    NS_TEST_ASSERT_MSG_EQ(ant->GetConfigHash(),
+                          ant2->GetConfigHash(),
+                          "Arrays with the same configuration should have the same hash");
+
+    ant->SetNumRows(5);
+    NS_TEST_ASSERT_MSG_NE(ant->GetConfigHash(),
+                          ant2->GetConfigHash(),
+                          "The number of rows should affect the hash");
+    ant->SetNumRows(4);
+
+    ant->GetAntennaElement()->GetObject<CosineAntennaModel>()->SetAttribute(
+        "HorizontalBeamwidth",
+        DoubleValue(65));
+    NS_TEST_ASSERT_MSG_NE(ant->GetConfigHash(),
+                          ant2->GetConfigHash(),
+                          "The configuration of the antenna element should affect the hash");
+}
+
 /**
  * @ingroup antenna-tests
  *
@@ -465,6 +536,7 @@ UniformPlanarArrayTestSuite::UniformPlanarArrayTestSuite()
                                            "Test IsChannelOutOfDate() and InvalidateChannels() for "
                                            "UniformPlanarArray with 3GPP antenna element"),
                 TestCase::Duration::QUICK);
+    AddTestCase(new ConfigHashTestCase(), TestCase::Duration::QUICK);
 }
 
 static UniformPlanarArrayTestSuite staticUniformPlanarArrayTestSuiteInstance;
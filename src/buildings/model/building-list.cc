@@ -12,11 +12,14 @@
 #include "building.h"
 
 #include "ns3/assert.h"
+#include "ns3/box.h"
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -66,6 +69,29 @@ class BuildingListPriv : public Object
      * @returns the container size
      */
     uint32_t GetNBuildings();
+    /**
+     * Invalidate the bounding volume hierarchy because the boundaries of a building changed.
+     *
+     * @param building the building whose boundaries have changed
+     */
+    void NotifyBoundariesChanged(Ptr<Building> building);
+    /**
+     * @param l1 position
+     * @param l2 position
+     * @returns true if the line-segment between l1 and l2 intersects any building
+     */
+    bool IsIntersect(const Vector& l1, const Vector& l2);
+    /**
+     * @param l1 position
+     * @param l2 position
+     * @returns the buildings intersected by the line-segment between l1 and l2, sorted by ID
+     */
+    std::vector<Ptr<Building>> GetIntersectingBuildings(const Vector& l1, const Vector& l2);
+    /**
+     * @param position the given position
+     * @returns the buildings containing the given position, sorted by ID
+     */
+    std::vector<Ptr<Building>> GetBuildingsContaining(const Vector& position);
 
     /**
      * Get the Singleton instance of BuildingListPriv (or create one)
@@ -87,7 +113,54 @@ class BuildingListPriv : public Object
      *
      */
     static void Delete();
+
+    /**
+     * Build the bounding volume hierarchy, if it has been invalidated.
+     */
+    void UpdateBvh();
+
+    /**
+     * Build the subtree of the bounding volume hierarchy covering the given range of building
+     * indices.
+     *
+     * @param first the first element of m_bvhIndices covered by the subtree
+     * @param count the number of elements of m_bvhIndices covered by the subtree
+     * @param centroids the centroids of the boundaries of the buildings
+     * @return the index of the root node of the subtree
+     */
+    uint32_t BuildBvhNode(uint32_t first, uint32_t count, const std::vector<Vector>& centroids);
+
+    /**
+     * Visit the buildings whose boundaries may overlap a given region, i.e., the buildings in
+     * the leaves of the bounding volume hierarchy that are reached by descending only into the
+     * nodes whose bounds overlap the given region.
+     *
+     * @tparam OVERLAPS \deduced type of the overlap test
+     * @tparam VISIT \deduced type of the visitor
+     * @param overlaps a callable returning whether a given Box overlaps the region
+     * @param visit a callable taking the index of a building and returning whether the
+     *              traversal has to be stopped
+     */
+    template <typename OVERLAPS, typename VISIT>
+    void VisitBvh(OVERLAPS overlaps, VISIT visit);
+
+    /// A node of the bounding volume hierarchy
+    struct BvhNode
+    {
+        Box bounds;     //!< the boundaries of all the buildings covered by this node
+        uint32_t first; //!< index of the first element of m_bvhIndices covered by this node
+        uint32_t count; //!< number of elements of m_bvhIndices covered by this (leaf) node
+        uint32_t right; //!< index of the right child of this (internal) node
+    };
+
+    /// maximum number of buildings stored in a leaf of the bounding volume hierarchy
+    static constexpr uint32_t BVH_LEAF_SIZE = 4;
+
     std::vector<Ptr<Building>> m_buildings; //!< Container of Building
+    std::vector<BvhNode> m_bvh;             //!< bounding volume hierarchy (root is the first node)
+    std::vector<uint32_t> m_bvhIndices;     //!< building indices sorted by BVH leaf
+    std::vector<uint32_t> m_bvhStack;       //!< stack of the nodes to visit during a traversal
+    bool m_bvhValid{false};                 //!< whether the bounding volume hierarchy is valid
 };
 
 NS_OBJECT_ENSURE_REGISTERED(BuildingListPriv);
@@ -154,6 +227,9 @@ BuildingListPriv::DoDispose()
         *i = nullptr;
     }
     m_buildings.erase(m_buildings.begin(), m_buildings.end());
+    m_bvh.clear();
+    m_bvhIndices.clear();
+    m_bvhValid = false;
     Object::DoDispose();
 }
 
@@ -162,6 +238,7 @@ BuildingListPriv::Add(Ptr<Building> building)
 {
     uint32_t index = m_buildings.size();
     m_buildings.push_back(building);
+    m_bvhValid = false;
     Simulator::ScheduleWithContext(index, TimeStep(0), &Building::Initialize, building);
     return index;
 }
@@ -193,6 +270,215 @@ BuildingListPriv::GetBuilding(uint32_t n)
     return m_buildings.at(n);
 }
 
+void
+BuildingListPriv::NotifyBoundariesChanged(Ptr<Building> building)
+{
+    NS_LOG_FUNCTION(this << building);
+    m_bvhValid = false;
+}
+
+void
+BuildingListPriv::UpdateBvh()
+{
+    if (m_bvhValid)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this);
+
+    m_bvh.clear();
+    m_bvhIndices.resize(m_buildings.size());
+    std::vector<Vector> centroids;
+    centroids.reserve(m_buildings.size());
+    for (uint32_t i = 0; i < m_buildings.size(); ++i)
+    {
+        m_bvhIndices[i] = i;
+        auto box = m_buildings[i]->GetBoundaries();
+        centroids.emplace_back(0.5 * (box.xMin + box.xMax),
+                               0.5 * (box.yMin + box.yMax),
+                               0.5 * (box.zMin + box.zMax));
+    }
+    if (!m_buildings.empty())
+    {
+        m_bvh.reserve(2 * (m_buildings.size() / BVH_LEAF_SIZE + 1));
+        BuildBvhNode(0, m_buildings.size(), centroids);
+    }
+    m_bvhValid = true;
+}
+
+uint32_t
+BuildingListPriv::BuildBvhNode(uint32_t first, uint32_t count, const std::vector<Vector>& centroids)
+{
+    auto nodeIndex = static_cast<uint32_t>(m_bvh.size());
+    m_bvh.push_back({});
+
+    auto begin = m_bvhIndices.begin() + first;
+    auto end = begin + count;
+
+    Box bounds = m_buildings[*begin]->GetBoundaries();
+    Box centroidBounds(centroids[*begin].x,
+                       centroids[*begin].x,
+                       centroids[*begin].y,
+                       centroids[*begin].y,
+                       centroids[*begin].z,
+                       centroids[*begin].z);
+    for (auto it = begin; it != end; ++it)
+    {
+        auto box = m_buildings[*it]->GetBoundaries();
+        bounds = Box(std::min(bounds.xMin, box.xMin),
+                     std::max(bounds.xMax, box.xMax),
+                     std::min(bounds.yMin, box.yMin),
+                     std::max(bounds.yMax, box.yMax),
+                     std::min(bounds.zMin, box.zMin),
+                     std::max(bounds.zMax, box.zMax));
+        const auto& c = centroids[*it];
+        centroidBounds = Box(std::min(centroidBounds.xMin, c.x),
+                             std::max(centroidBounds.xMax, c.x),
+                             std::min(centroidBounds.yMin, c.y),
+                             std::max(centroidBounds.yMax, c.y),
+                             std::min(centroidBounds.zMin, c.z),
+                             std::max(centroidBounds.zMax, c.z));
+    }
+    // Enlarge the bounds of the node by a small margin, so that rounding errors in the
+    // intersection tests cannot cull a node containing a building intersected by a segment
+    const double margin = 1e-6 * (1 + std::max({std::abs(bounds.xMin),
+                                                std::abs(bounds.xMax),
+                                                std::abs(bounds.yMin),
+                                                std::abs(bounds.yMax),
+                                                std::abs(bounds.zMin),
+                                                std::abs(bounds.zMax)}));
+    m_bvh[nodeIndex].bounds = Box(bounds.xMin - margin,
+                                  bounds.xMax + margin,
+                                  bounds.yMin - margin,
+                                  bounds.yMax + margin,
+                                  bounds.zMin - margin,
+                                  bounds.zMax + margin);
+    m_bvh[nodeIndex].first = first;
+
+    const double extentX = centroidBounds.xMax - centroidBounds.xMin;
+    const double extentY = centroidBounds.yMax - centroidBounds.yMin;
+    const double extentZ = centroidBounds.zMax - centroidBounds.zMin;
+
+    if (count <= BVH_LEAF_SIZE || std::max({extentX, extentY, extentZ}) == 0)
+    {
+        m_bvh[nodeIndex].count = count;
+        return nodeIndex;
+    }
+
+    // split the buildings at the median of the centroids along the axis of largest extent
+    auto axis = (extentX >= extentY && extentX >= extentZ) ? &Vector::x
+                : (extentY >= extentZ)                     ? &Vector::y
+                                                           : &Vector::z;
+    auto half = count / 2;
+    std::nth_element(begin, begin + half, end, [&](uint32_t lhs, uint32_t rhs) {
+        return centroids[lhs].*axis < centroids[rhs].*axis ||
+               (centroids[lhs].*axis == centroids[rhs].*axis && lhs < rhs);
+    });
+
+    m_bvh[nodeIndex].count = 0;
+    BuildBvhNode(first, half, centroids);
+    auto right = BuildBvhNode(first + half, count - half, centroids);
+    m_bvh[nodeIndex].right = right;
+    return nodeIndex;
+}
+
+template <typename OVERLAPS, typename VISIT>
+void
+BuildingListPriv::VisitBvh(OVERLAPS overlaps, VISIT visit)
+{
+    UpdateBvh();
+    if (m_bvh.empty())
+    {
+        return;
+    }
+
+    auto& stack = m_bvhStack;
+    stack.assign(1, 0);
+    while (!stack.empty())
+    {
+        auto nodeIndex = stack.back();
+        const auto& node = m_bvh[nodeIndex];
+        stack.pop_back();
+
+        if (!overlaps(node.bounds))
+        {
+            continue;
+        }
+        if (node.count == 0)
+        {
+            // the left child immediately follows its parent
+            stack.push_back(node.right);
+            stack.push_back(nodeIndex + 1);
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i)
+        {
+            if (visit(m_bvhIndices[i]))
+            {
+                return;
+            }
+        }
+    }
+}
+
+bool
+BuildingListPriv::IsIntersect(const Vector& l1, const Vector& l2)
+{
+    bool found = false;
+    VisitBvh([&](const Box& box) { return box.IsIntersect(l1, l2); },
+             [&](uint32_t index) {
+                 found = m_buildings[index]->IsIntersect(l1, l2);
+                 return found;
+             });
+    return found;
+}
+
+std::vector<Ptr<Building>>
+BuildingListPriv::GetIntersectingBuildings(const Vector& l1, const Vector& l2)
+{
+    std::vector<uint32_t> indices;
+    VisitBvh([&](const Box& box) { return box.IsIntersect(l1, l2); },
+             [&](uint32_t index) {
+                 if (m_buildings[index]->IsIntersect(l1, l2))
+                 {
+                     indices.push_back(index);
+                 }
+                 return false;
+             });
+    std::sort(indices.begin(), indices.end());
+
+    std::vector<Ptr<Building>> buildings;
+    buildings.reserve(indices.size());
+    for (auto index : indices)
+    {
+        buildings.push_back(m_buildings[index]);
+    }
+    return buildings;
+}
+
+std::vector<Ptr<Building>>
+BuildingListPriv::GetBuildingsContaining(const Vector& position)
+{
+    std::vector<uint32_t> indices;
+    VisitBvh([&](const Box& box) { return box.IsInside(position); },
+             [&](uint32_t index) {
+                 if (m_buildings[index]->IsInside(position))
+                 {
+                     indices.push_back(index);
+                 }
+                 return false;
+             });
+    std::sort(indices.begin(), indices.end());
+
+    std::vector<Ptr<Building>> buildings;
+    buildings.reserve(indices.size());
+    for (auto index : indices)
+    {
+        buildings.push_back(m_buildings[index]);
+    }
+    return buildings;
+}
+
 } // namespace ns3
 
 /**
@@ -233,4 +519,28 @@ BuildingList::GetNBuildings()
     return BuildingListPriv::Get()->GetNBuildings();
 }
 
+void
+BuildingList::NotifyBoundariesChanged(Ptr<Building> building)
+{
+    BuildingListPriv::Get()->NotifyBoundariesChanged(building);
+}
+
+bool
+BuildingList::IsIntersect(const Vector& l1, const Vector& l2)
+{
+    return BuildingListPriv::Get()->IsIntersect(l1, l2);
+}
+
+std::vector<Ptr<Building>>
+BuildingList::GetIntersectingBuildings(const Vector& l1, const Vector& l2)
+{
+    return BuildingListPriv::Get()->GetIntersectingBuildings(l1, l2);
+}
+
+std::vector<Ptr<Building>>
+BuildingList::GetBuildingsContaining(const Vector& position)
+{
+    return BuildingListPriv::Get()->GetBuildingsContaining(position);
+}
+
 } // namespace ns3
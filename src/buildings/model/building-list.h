@@ -12,6 +12,7 @@
 #define BUILDING_LIST_H_
 
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 #include <vector>
 
@@ -24,6 +25,11 @@ class Building;
  * @ingroup buildings
  *
  * Container for Building class
+ *
+ * The boundaries of the buildings are indexed by a bounding volume hierarchy, so that the
+ * buildings intersected by a line-segment or containing a position can be found without
+ * checking every building. The hierarchy is (re)built the first time it is queried after a
+ * building is added or the boundaries of a building change.
  */
 class BuildingList
 {
@@ -58,6 +64,33 @@ class BuildingList
      * @returns the number of buildings currently in the list.
      */
     static uint32_t GetNBuildings();
+    /**
+     * @param building the building whose boundaries have changed
+     *
+     * This method is called automatically from Building::SetBoundaries so
+     * the user has little reason to call it himself.
+     */
+    static void NotifyBoundariesChanged(Ptr<Building> building);
+    /**
+     * Check whether the line-segment between the given positions intersects any building.
+     *
+     * @param l1 position
+     * @param l2 position
+     * @return true if there is an intersection with at least one building, false otherwise
+     */
+    static bool IsIntersect(const Vector& l1, const Vector& l2);
+    /**
+     * @param l1 position
+     * @param l2 position
+     * @returns the buildings intersected by the line-segment between the given positions,
+     *          sorted by building ID
+     */
+    static std::vector<Ptr<Building>> GetIntersectingBuildings(const Vector& l1, const Vector& l2);
+    /**
+     * @param position the given position
+     * @returns the buildings inside which the given position falls, sorted by building ID
+     */
+    static std::vector<Ptr<Building>> GetBuildingsContaining(const Vector& position);
 };
 
 } // namespace ns3
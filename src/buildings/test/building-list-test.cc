@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/building-list.h"
+#include "ns3/building.h"
+#include "ns3/log.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("BuildingListTest");
+
+/**
+ * @ingroup building-test
+ *
+ * Test case for the spatial queries of BuildingList. It checks that the buildings returned by
+ * the queries, which use a bounding volume hierarchy, are the same as those found by checking
+ * all the buildings, also after the boundaries of some buildings are changed and new buildings
+ * are added.
+ */
+class BuildingListQueriesTestCase : public TestCase
+{
+  public:
+    BuildingListQueriesTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @return a random box of the given maximum size within the area of the scenario
+     * @param maxSize the maximum size of the box along the x and y axes
+     */
+    Box GetRandomBox(double maxSize);
+
+    /**
+     * @return a random position within the area of the scenario
+     */
+    Vector GetRandomPosition();
+
+    /**
+     * Compare the results of the queries against those obtained by checking all the buildings.
+     *
+     * @param nQueries the number of random queries to check
+     */
+    void CheckQueries(uint32_t nQueries);
+
+    Ptr<UniformRandomVariable> m_rv; //!< random variable
+};
+
+BuildingListQueriesTestCase::BuildingListQueriesTestCase()
+    : TestCase("Test case for the BuildingList spatial queries")
+{
+}
+
+Box
+BuildingListQueriesTestCase::GetRandomBox(double maxSize)
+{
+    auto x = m_rv->GetValue(0, 1000);
+    auto y = m_rv->GetValue(0, 1000);
+    return Box(x,
+               x + m_rv->GetValue(1, maxSize),
+               y,
+               y + m_rv->GetValue(1, maxSize),
+               0,
+               m_rv->GetValue(3, 30));
+}
+
+Vector
+BuildingListQueriesTestCase::GetRandomPosition()
+{
+    return Vector(m_rv->GetValue(-10, 1010), m_rv->GetValue(-10, 1010), m_rv->GetValue(0, 40));
+}
+
+void
+BuildingListQueriesTestCase::CheckQueries(uint32_t nQueries)
+{
+    for (uint32_t i = 0; i < nQueries; ++i)
+    {
+        auto l1 = GetRandomPosition();
+        auto l2 = (i % 2 == 0) ? GetRandomPosition() : l1 + Vector(m_rv->GetValue(-50, 50),
+                                                                       m_rv->GetValue(-50, 50),
+                                                                       0);
+
+        std::vector<Ptr<Building>> intersecting;
+        std::vector<Ptr<Building>> containing;
+        for (auto it = BuildingList::Begin(); it != BuildingList::End(); ++it)
+        {
+            if ((*it)->IsIntersect(l1, l2))
+            {
+                intersecting.push_back(*it);
+            }
+            if ((*it)->IsInside(l1))
+            {
+                containing.push_back(*it);
+            }
+        }
+
+        NS_TEST_EXPECT_MSG_EQ(BuildingList::IsIntersect(l1, l2),
+                              !intersecting.empty(),
+                              "Unexpected intersection for segment " << l1 << " - " << l2);
+        NS_TEST_EXPECT_MSG_EQ((BuildingList::GetIntersectingBuildings(l1, l2) == intersecting),
+                              true,
+                              "Unexpected intersecting buildings for segment " << l1 << " - "
+                                                                               << l2);
+        NS_TEST_EXPECT_MSG_EQ((BuildingList::GetBuildingsContaining(l1) == containing),
+                              true,
+                              "Unexpected buildings containing position " << l1);
+    }
+}
+
+void
+BuildingListQueriesTestCase::DoRun()
+{
+    m_rv = CreateObject<UniformRandomVariable>();
+    m_rv->SetStream(1);
+
+    // no building
+    NS_TEST_EXPECT_MSG_EQ(BuildingList::IsIntersect(Vector(0, 0, 0), Vector(10, 10, 10)),
+                          false,
+                          "No building expected to be intersected");
+    NS_TEST_EXPECT_MSG_EQ(BuildingList::GetBuildingsContaining(Vector(0, 0, 0)).empty(),
+                          true,
+                          "No building expected to contain the position");
+
+    std::vector<Ptr<Building>> buildings;
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+        auto building = CreateObject<Building>();
+        building->SetBoundaries(GetRandomBox(40));
+        buildings.push_back(building);
+    }
+    // a few buildings sharing the same centroid
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        auto building = CreateObject<Building>();
+        building->SetBoundaries(Box(500 - i, 510 + i, 500 - i, 510 + i, 0, 10 + i));
+        buildings.push_back(building);
+    }
+    CheckQueries(2000);
+
+    // move some buildings
+    for (uint32_t i = 0; i < buildings.size(); i += 7)
+    {
+        buildings[i]->SetBoundaries(GetRandomBox(100));
+    }
+    CheckQueries(2000);
+
+    // add more buildings
+    for (uint32_t i = 0; i < 50; ++i)
+    {
+        CreateObject<Building>()->SetBoundaries(GetRandomBox(20));
+    }
+    CheckQueries(2000);
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup building-test
+ * Test suite for the BuildingList
+ */
+class BuildingListTestSuite : public TestSuite
+{
+  public:
+    BuildingListTestSuite();
+};
+
+BuildingListTestSuite::BuildingListTestSuite()
+    : TestSuite("building-list", Type::UNIT)
+{
+    AddTestCase(new BuildingListQueriesTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static BuildingListTestSuite g_buildingListTestSuite;
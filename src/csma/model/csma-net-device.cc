@@ -15,9 +15,11 @@
 #include "ns3/error-model.h"
 #include "ns3/ethernet-header.h"
 #include "ns3/ethernet-trailer.h"
+#include "ns3/gso-tag.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/queue-item.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
@@ -369,7 +371,13 @@ CsmaNetDevice::AddHeader(Ptr<Packet> p,
             p->AddAtEnd(padd);
         }
 
-        NS_ASSERT_MSG(p->GetSize() <= GetMtu(),
+        uint32_t frameSize = p->GetSize();
+        if (GsoTag gso; p->PeekPacketTag(gso))
+        {
+            // the segments of a super-segment must fit in a frame
+            frameSize = gso.GetLargestSegmentSize(frameSize);
+        }
+        NS_ASSERT_MSG(frameSize <= GetMtu(),
                       "CsmaNetDevice::AddHeader(): 802.3 Length/Type field with LLC/SNAP: "
                       "length interpretation must not exceed device frame size minus overhead");
     }
@@ -517,7 +525,17 @@ CsmaNetDevice::TransmitStart()
             m_backoff.ResetBackoffTime();
             m_txMachineState = BUSY;
 
-            Time tEvent = m_bps.CalculateBytesTxTime(m_currentPkt->GetSize());
+            // a super-segment takes as long as the segments it is made of
+            uint32_t size = m_currentPkt->GetSize();
+            uint32_t nSegments = 1;
+            if (GsoTag gso; m_currentPkt->PeekPacketTag(gso))
+            {
+                size = gso.GetSegmentedSize(size);
+                nSegments = gso.GetNSegments();
+            }
+
+            Time tEvent =
+                m_bps.CalculateBytesTxTime(size) + m_tInterframeGap * (nSegments - 1);
             NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << tEvent.As(Time::S));
             Simulator::Schedule(tEvent, &CsmaNetDevice::TransmitCompleteEvent, this);
         }
@@ -1007,6 +1025,54 @@ CsmaNetDevice::SendFrom(Ptr<Packet> packet,
     return true;
 }
 
+std::size_t
+CsmaNetDevice::SendBatch(std::span<const Ptr<QueueDiscItem>> items)
+{
+    NS_LOG_FUNCTION(items.size());
+
+    NS_ASSERT(IsLinkUp());
+
+    std::size_t sent = 0;
+    for (const auto& item : items)
+    {
+        Ptr<Packet> packet = item->GetPacket();
+
+        //
+        // Only transmit if send side of net device is enabled
+        //
+        if (!IsSendEnabled())
+        {
+            m_macTxDropTrace(packet);
+            continue;
+        }
+
+        Mac48Address destination = Mac48Address::ConvertFrom(item->GetAddress());
+        AddHeader(packet, m_address, destination, item->GetProtocol());
+
+        m_macTxTrace(packet);
+
+        if (!m_queue->Enqueue(packet))
+        {
+            m_macTxDropTrace(packet);
+            continue;
+        }
+        ++sent;
+    }
+
+    //
+    // If the device is idle, start a transmission once the whole batch has
+    // been placed on the send queue
+    //
+    if (m_txMachineState == READY && !m_queue->IsEmpty())
+    {
+        m_currentPkt = m_queue->Dequeue();
+        m_promiscSnifferTrace(m_currentPkt);
+        m_snifferTrace(m_currentPkt);
+        TransmitStart();
+    }
+    return sent;
+}
+
 Ptr<Node>
 CsmaNetDevice::GetNode() const
 {
@@ -280,6 +280,15 @@ class CsmaNetDevice : public NetDevice
                   const Address& dest,
                   uint16_t protocolNumber) override;
 
+    /**
+     * Enqueue all the packets of the batch in the transmit queue and then start
+     * sending, if the device is idle.
+     *
+     * @param items the packets to send
+     * @return the number of packets enqueued in the transmit queue
+     */
+    std::size_t SendBatch(std::span<const Ptr<QueueDiscItem>> items) override;
+
     /**
      * Get the node to which this device is attached.
      *
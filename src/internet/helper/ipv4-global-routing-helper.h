@@ -76,6 +76,8 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      * Users must first call PopulateRoutingTables() and then may subsequently
      * call RecomputeRoutingTables() at any later time in the simulation.
      *
+     * Only the routes of the nodes that may be affected by the changes in the
+     * topology are actually computed again (see GlobalRouteManager::UpdateRoutes()).
      */
     static void RecomputeRoutingTables();
 };
@@ -19,6 +19,8 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -186,12 +188,17 @@ void
 ArpCache::HandleWaitReplyTimeout()
 {
     NS_LOG_FUNCTION(this);
-    ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // the state of the entries changes while they are processed
+    std::vector<ArpCache::Entry*> waitReplyEntries;
+    waitReplyEntries.reserve(m_waitReplyEntries.size());
+    for (const auto& [address, entry] : m_waitReplyEntries)
+    {
+        waitReplyEntries.push_back(entry);
+    }
+    for (auto entry : waitReplyEntries)
     {
-        entry = (*i).second;
-        if (entry != nullptr && entry->IsWaitReply())
+        if (entry->IsWaitReply())
         {
             if (entry->GetRetries() < m_maxRetries)
             {
@@ -234,11 +241,14 @@ void
 ArpCache::Flush()
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    for (auto entry : m_entries)
     {
-        delete (*i).second;
+        delete entry;
     }
-    m_arpCache.erase(m_arpCache.begin(), m_arpCache.end());
+    m_entries.clear();
+    m_slots.clear();
+    m_macIndex.clear();
+    m_waitReplyEntries.clear();
     if (m_waitReplyTimer.IsPending())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -253,9 +263,14 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // print the entries in the order of their IPv4 address
+    std::vector<ArpCache::Entry*> entries(m_entries);
+    std::sort(entries.begin(), entries.end(), [](ArpCache::Entry* a, ArpCache::Entry* b) {
+        return a->GetIpv4Address() < b->GetIpv4Address();
+    });
+    for (auto entry : entries)
     {
-        *os << i->first << " dev ";
+        *os << entry->GetIpv4Address() << " dev ";
         std::string found = Names::FindName(m_device);
         if (!Names::FindName(m_device).empty())
         {
@@ -266,21 +281,21 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
             *os << static_cast<int>(m_device->GetIfIndex());
         }
 
-        *os << " lladdr " << i->second->GetMacAddress();
+        *os << " lladdr " << entry->GetMacAddress();
 
-        if (i->second->IsAlive())
+        if (entry->IsAlive())
         {
             *os << " REACHABLE\n";
         }
-        else if (i->second->IsWaitReply())
+        else if (entry->IsWaitReply())
         {
             *os << " DELAY\n";
         }
-        else if (i->second->IsPermanent())
+        else if (entry->IsPermanent())
         {
             *os << " PERMANENT\n";
         }
-        else if (i->second->IsAutoGenerated())
+        else if (entry->IsAutoGenerated())
         {
             *os << " STATIC_AUTOGENERATED\n";
         }
@@ -295,13 +310,13 @@ void
 ArpCache::RemoveAutoGeneratedEntries()
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end();)
+    std::size_t i = 0;
+    while (i < m_entries.size())
     {
-        if (i->second->IsAutoGenerated())
+        if (m_entries[i]->IsAutoGenerated())
         {
-            i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete i->second;
-            m_arpCache.erase(i++);
+            // the last entry is moved to position i
+            DeleteEntry(FindSlot(m_entries[i]->GetIpv4Address()));
             continue;
         }
         i++;
@@ -314,13 +329,22 @@ ArpCache::LookupInverse(Address to)
     NS_LOG_FUNCTION(this << to);
 
     std::list<ArpCache::Entry*> entryList;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    if (to.IsInvalid())
     {
-        ArpCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == to)
+        // entries whose MAC address is invalid are not indexed
+        for (auto entry : m_entries)
         {
-            entryList.push_back(entry);
+            if (entry->GetMacAddress() == to)
+            {
+                entryList.push_back(entry);
+            }
         }
+        return entryList;
+    }
+    auto it = m_macIndex.find(to);
+    if (it != m_macIndex.end())
+    {
+        entryList.assign(it->second.begin(), it->second.end());
     }
     return entryList;
 }
@@ -329,10 +353,14 @@ ArpCache::Entry*
 ArpCache::Lookup(Ipv4Address to)
 {
     NS_LOG_FUNCTION(this << to);
-    auto it = m_arpCache.find(to);
-    if (it != m_arpCache.end())
+    if (m_slots.empty())
+    {
+        return nullptr;
+    }
+    auto slot = FindSlot(to);
+    if (m_slots[slot] != NONE)
     {
-        return it->second;
+        return m_entries[m_slots[slot]];
     }
     return nullptr;
 }
@@ -341,11 +369,18 @@ ArpCache::Entry*
 ArpCache::Add(Ipv4Address to)
 {
     NS_LOG_FUNCTION(this << to);
-    NS_ASSERT(m_arpCache.find(to) == m_arpCache.end());
+    NS_ASSERT(Lookup(to) == nullptr);
+
+    // keep the load factor of the hash table below 1/2
+    if (2 * (m_entries.size() + 1) > m_slots.size())
+    {
+        Rehash(std::max<std::size_t>(2 * m_slots.size(), 16));
+    }
 
     auto entry = new ArpCache::Entry(this);
-    m_arpCache[to] = entry;
     entry->SetIpv4Address(to);
+    m_slots[FindSlot(to)] = m_entries.size();
+    m_entries.push_back(entry);
     return entry;
 }
 
@@ -354,19 +389,113 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    if (!m_slots.empty())
     {
-        if ((*i).second == entry)
+        auto slot = FindSlot(entry->GetIpv4Address());
+        if (m_slots[slot] != NONE && m_entries[m_slots[slot]] == entry)
         {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
+            DeleteEntry(slot);
             return;
         }
     }
     NS_LOG_WARN("Entry not found in this ARP Cache");
 }
 
+std::size_t
+ArpCache::FindSlot(Ipv4Address to) const
+{
+    auto mask = m_slots.size() - 1;
+    auto slot = Ipv4AddressHash()(to) & mask;
+    while (m_slots[slot] != NONE && m_entries[m_slots[slot]]->GetIpv4Address() != to)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void
+ArpCache::Rehash(std::size_t nSlots)
+{
+    NS_LOG_FUNCTION(this << nSlots);
+    m_slots.assign(nSlots, NONE);
+    for (uint32_t i = 0; i < m_entries.size(); i++)
+    {
+        m_slots[FindSlot(m_entries[i]->GetIpv4Address())] = i;
+    }
+}
+
+void
+ArpCache::EraseSlot(std::size_t slot)
+{
+    auto index = m_slots[slot];
+    auto mask = m_slots.size() - 1;
+
+    // backward shift deletion: move back the following indices that cannot be found anymore
+    // once the slot is emptied
+    m_slots[slot] = NONE;
+    for (auto next = (slot + 1) & mask; m_slots[next] != NONE; next = (next + 1) & mask)
+    {
+        auto home = Ipv4AddressHash()(m_entries[m_slots[next]]->GetIpv4Address()) & mask;
+        bool reachable = (slot < next) ? (slot < home && home <= next)
+                                       : (slot < home || home <= next);
+        if (!reachable)
+        {
+            m_slots[slot] = m_slots[next];
+            m_slots[next] = NONE;
+            slot = next;
+        }
+    }
+
+    // move the last entry to the position of the removed one
+    if (index != m_entries.size() - 1)
+    {
+        m_slots[FindSlot(m_entries.back()->GetIpv4Address())] = index;
+        m_entries[index] = m_entries.back();
+    }
+    m_entries.pop_back();
+}
+
+void
+ArpCache::AddToMacIndex(ArpCache::Entry* entry)
+{
+    if (!entry->GetMacAddress().IsInvalid())
+    {
+        m_macIndex[entry->GetMacAddress()].push_back(entry);
+    }
+}
+
+void
+ArpCache::RemoveFromMacIndex(ArpCache::Entry* entry)
+{
+    if (entry->GetMacAddress().IsInvalid())
+    {
+        return;
+    }
+    auto it = m_macIndex.find(entry->GetMacAddress());
+    NS_ASSERT_MSG(it != m_macIndex.end(), "Entry " << *entry << " is not indexed");
+    auto& entries = it->second;
+    entries.erase(std::find(entries.begin(), entries.end(), entry));
+    if (entries.empty())
+    {
+        m_macIndex.erase(it);
+    }
+}
+
+void
+ArpCache::DeleteEntry(std::size_t slot)
+{
+    auto entry = m_entries[m_slots[slot]];
+    NS_LOG_FUNCTION(this << entry);
+    EraseSlot(slot);
+    RemoveFromMacIndex(entry);
+    if (entry->IsWaitReply())
+    {
+        m_waitReplyEntries.erase(entry->GetIpv4Address());
+    }
+    entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+    delete entry;
+}
+
 ArpCache::Entry::Entry(ArpCache* arp)
     : m_arp(arp),
       m_state(ALIVE),
@@ -415,7 +544,7 @@ ArpCache::Entry::MarkDead()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(m_state == ALIVE || m_state == WAIT_REPLY || m_state == DEAD);
-    m_state = DEAD;
+    SetState(DEAD);
     ClearRetries();
     UpdateSeen();
 }
@@ -425,8 +554,8 @@ ArpCache::Entry::MarkAlive(Address macAddress)
 {
     NS_LOG_FUNCTION(this << macAddress);
     NS_ASSERT(m_state == WAIT_REPLY);
-    m_macAddress = macAddress;
-    m_state = ALIVE;
+    SetMacAddress(macAddress);
+    SetState(ALIVE);
     ClearRetries();
     UpdateSeen();
 }
@@ -437,7 +566,7 @@ ArpCache::Entry::MarkPermanent()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
-    m_state = PERMANENT;
+    SetState(PERMANENT);
     ClearRetries();
     UpdateSeen();
 }
@@ -448,7 +577,7 @@ ArpCache::Entry::MarkAutoGenerated()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
-    m_state = STATIC_AUTOGENERATED;
+    SetState(STATIC_AUTOGENERATED);
     ClearRetries();
     UpdateSeen();
 }
@@ -478,7 +607,7 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     NS_ASSERT(m_pending.empty());
     NS_ASSERT_MSG(waiting.first, "Can not add a null packet to the ARP queue");
 
-    m_state = WAIT_REPLY;
+    SetState(WAIT_REPLY);
     m_pending.push_back(waiting);
     UpdateSeen();
     m_arp->StartWaitReplyTimer();
@@ -495,7 +624,23 @@ void
 ArpCache::Entry::SetMacAddress(Address macAddress)
 {
     NS_LOG_FUNCTION(this);
+    m_arp->RemoveFromMacIndex(this);
     m_macAddress = macAddress;
+    m_arp->AddToMacIndex(this);
+}
+
+void
+ArpCache::Entry::SetState(ArpCacheEntryState_e state)
+{
+    if (m_state == WAIT_REPLY && state != WAIT_REPLY)
+    {
+        m_arp->m_waitReplyEntries.erase(m_ipv4Address);
+    }
+    else if (m_state != WAIT_REPLY && state == WAIT_REPLY)
+    {
+        m_arp->m_waitReplyEntries.emplace(m_ipv4Address, this);
+    }
+    m_state = state;
 }
 
 Ipv4Address
@@ -20,9 +20,11 @@
 #include "ns3/simulator.h"
 #include "ns3/traced-callback.h"
 
+#include <limits>
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -37,6 +39,11 @@ class Ipv4Header;
  *
  * A cached lookup table for translating layer 3 addresses to layer 2.
  * This implementation does lookups from IPv4 to a MAC address
+ *
+ * The entries are stored in an open addressing hash table with linear probing,
+ * keyed by IPv4 address, and are also indexed by MAC address. A single timer
+ * per cache handles the retransmissions of the ARP requests of the entries
+ * in WAIT_REPLY state, which are kept in a separate container.
  */
 class ArpCache : public Object
 {
@@ -130,7 +137,7 @@ class ArpCache : public Object
      * @brief Do lookup in the ARP cache against a MAC address
      * @param destination The destination MAC address to lookup
      * of
-     * @return A std::list of ArpCache::Entry with info about layer 2
+     * @return A std::list of ArpCache::Entry with info about layer 2 (in no particular order)
      */
     std::list<ArpCache::Entry*> LookupInverse(Address destination);
     /**
@@ -240,6 +247,8 @@ class ArpCache : public Object
          */
         void SetMacAddress(Address macAddress);
         /**
+         * The IPv4 address is the key of the entry in the cache, hence it is set when the
+         * entry is added to the cache and must not be changed afterwards.
          * @param destination The Ipv4Address for this entry
          */
         void SetIpv4Address(Ipv4Address destination);
@@ -304,6 +313,13 @@ class ArpCache : public Object
             STATIC_AUTOGENERATED
         };
 
+        /**
+         * @brief Change the state of this entry, updating the entries in WAIT_REPLY state
+         * stored by the ARP cache.
+         * @param state the new state
+         */
+        void SetState(ArpCacheEntryState_e state);
+
         ArpCache* m_arp;              //!< pointer to the ARP cache owning the entry
         ArpCacheEntryState_e m_state; //!< state of the entry
         Time m_lastSeen;              //!< last moment a packet from that address has been seen
@@ -314,16 +330,47 @@ class ArpCache : public Object
     };
 
   private:
+    void DoDispose() override;
+
     /**
-     * @brief ARP Cache container
+     * @param to an IPv4 address
+     * @return the index of the slot of the hash table storing the index of the entry of the
+     *         given address, if present, or of the empty slot where it would be stored otherwise
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*> Cache;
+    std::size_t FindSlot(Ipv4Address to) const;
+
     /**
-     * @brief ARP Cache container iterator
+     * @brief Remove an entry from the hash table and from the entries (but do not delete it).
+     * @param slot the slot of the hash table storing the index of the entry
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*>::iterator CacheI;
+    void EraseSlot(std::size_t slot);
 
-    void DoDispose() override;
+    /**
+     * @brief Resize the hash table and store again the indices of all the entries.
+     * @param nSlots the number of slots (a power of two)
+     */
+    void Rehash(std::size_t nSlots);
+
+    /**
+     * @brief Add an entry to the MAC address index.
+     * @param entry the entry
+     */
+    void AddToMacIndex(ArpCache::Entry* entry);
+
+    /**
+     * @brief Remove an entry from the MAC address index.
+     * @param entry the entry
+     */
+    void RemoveFromMacIndex(ArpCache::Entry* entry);
+
+    /**
+     * @brief Remove an entry from all the containers and delete it.
+     * @param slot the slot of the hash table storing the index of the entry
+     */
+    void DeleteEntry(std::size_t slot);
+
+    /// Value used to indicate an empty slot of the hash table
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
 
     Ptr<NetDevice> m_device;        //!< NetDevice associated with the cache
     Ptr<Ipv4Interface> m_interface; //!< Ipv4Interface associated with the cache
@@ -341,8 +388,13 @@ class ArpCache : public Object
      * If there are no Arp requests pending, this event is not scheduled.
      */
     void HandleWaitReplyTimeout();
-    uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
-    Cache m_arpCache;            //!< the ARP cache
+    uint32_t m_pendingQueueSize;             //!< number of packets waiting for a resolution
+    std::vector<ArpCache::Entry*> m_entries; //!< the entries of the ARP cache
+    std::vector<uint32_t> m_slots;           //!< hash table (linear probing) of entry indices
+    std::map<Address, std::vector<ArpCache::Entry*>>
+        m_macIndex; //!< the entries with each (valid) MAC address
+    std::map<Ipv4Address, ArpCache::Entry*>
+        m_waitReplyEntries; //!< the entries in WAIT_REPLY state, by IPv4 address
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
@@ -11,8 +11,8 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
-#include <algorithm>
 #include <iostream>
+#include <vector>
 
 namespace ns3
 {
@@ -60,7 +60,7 @@ operator<<(std::ostream& os, const CandidateQueue& q)
 }
 
 CandidateQueue::CandidateQueue()
-    : m_candidates()
+    : m_candidates(&CandidateQueue::CompareSPFVertex)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -88,11 +88,8 @@ CandidateQueue::Push(SPFVertex* vNew)
 {
     NS_LOG_FUNCTION(this << vNew);
 
-    auto i = std::upper_bound(m_candidates.begin(),
-                              m_candidates.end(),
-                              vNew,
-                              &CandidateQueue::CompareSPFVertex);
-    m_candidates.insert(i, vNew);
+    // the vertex is inserted after the vertices having the same priority
+    m_positions[vNew->GetVertexId()] = m_candidates.insert(vNew);
 }
 
 SPFVertex*
@@ -104,8 +101,9 @@ CandidateQueue::Pop()
         return nullptr;
     }
 
-    SPFVertex* v = m_candidates.front();
-    m_candidates.pop_front();
+    SPFVertex* v = *m_candidates.begin();
+    m_candidates.erase(m_candidates.begin());
+    m_positions.erase(v->GetVertexId());
     return v;
 }
 
@@ -118,7 +116,7 @@ CandidateQueue::Top() const
         return nullptr;
     }
 
-    return m_candidates.front();
+    return *m_candidates.begin();
 }
 
 bool
@@ -139,26 +137,37 @@ SPFVertex*
 CandidateQueue::Find(const Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this);
-    auto i = m_candidates.begin();
+    auto it = m_positions.find(addr);
+    return it != m_positions.end() ? *it->second : nullptr;
+}
 
-    for (; i != m_candidates.end(); i++)
+void
+CandidateQueue::Reorder()
+{
+    NS_LOG_FUNCTION(this);
+
+    // re-insert all the vertices in their current order, so that the vertices
+    // having the same priority keep their relative order
+    std::vector<SPFVertex*> candidates(m_candidates.begin(), m_candidates.end());
+    m_candidates.clear();
+    for (auto v : candidates)
     {
-        SPFVertex* v = *i;
-        if (v->GetVertexId() == addr)
-        {
-            return v;
-        }
+        m_positions[v->GetVertexId()] = m_candidates.insert(v);
     }
-
-    return nullptr;
+    NS_LOG_LOGIC("After reordering the CandidateQueue");
+    NS_LOG_LOGIC(*this);
 }
 
 void
-CandidateQueue::Reorder()
+CandidateQueue::Reorder(SPFVertex* v)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << v);
 
-    m_candidates.sort(&CandidateQueue::CompareSPFVertex);
+    auto it = m_positions.find(v->GetVertexId());
+    NS_ASSERT_MSG(it != m_positions.end() && *it->second == v, "Vertex not in the queue");
+    // erasing through the iterator does not compare the (modified) vertex
+    m_candidates.erase(it->second);
+    it->second = m_candidates.insert(v);
     NS_LOG_LOGIC("After reordering the CandidateQueue");
     NS_LOG_LOGIC(*this);
 }
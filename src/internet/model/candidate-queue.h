@@ -11,8 +11,9 @@
 
 #include "ns3/ipv4-address.h"
 
-#include <list>
+#include <set>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -36,7 +37,10 @@ class SPFVertex;
  * Although a STL priority_queue almost does what we want, the requirement
  * for a Find () operation, the dynamic nature of the data and the derived
  * requirement for a Reorder () operation led us to implement this simple
- * enhanced priority queue.
+ * enhanced priority queue.  The vertices are kept in an ordered set and
+ * indexed by vertex ID, so that all the operations take a time logarithmic
+ * in the number of candidates.  Vertices with the same priority are popped
+ * in the order in which they have been pushed (or reordered).
  */
 class CandidateQueue
 {
@@ -148,6 +152,19 @@ class CandidateQueue
      */
     void Reorder();
 
+    /**
+     * @brief Move the given Shortest Path First Vertex pointer, which is stored
+     * in the queue, to its position according to the priority scheme.
+     *
+     * This method must be called instead of Reorder () when the value of the
+     * field m_distanceFromRoot of a single vertex in the queue has decreased.
+     * The vertex is then placed after the vertices having the same priority.
+     *
+     * @see SPFVertex
+     * @param v The Shortest Path First Vertex whose distance has decreased.
+     */
+    void Reorder(SPFVertex* v);
+
   private:
     /**
      * @brief return true if v1 < v2
@@ -162,8 +179,12 @@ class CandidateQueue
      */
     static bool CompareSPFVertex(const SPFVertex* v1, const SPFVertex* v2);
 
-    typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
-    CandidateList_t m_candidates;                  //!< SPFVertex candidates
+    /// container of SPFVertex pointers, sorted according to the priority scheme
+    typedef std::multiset<SPFVertex*, bool (*)(const SPFVertex*, const SPFVertex*)>
+        CandidateList_t;
+    CandidateList_t m_candidates; //!< SPFVertex candidates
+    /// SPFVertex candidates indexed by vertex ID
+    std::unordered_map<Ipv4Address, CandidateList_t::iterator, Ipv4AddressHash> m_positions;
 
     /**
      * @brief Stream insertion operator.
@@ -19,13 +19,18 @@
 
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <queue>
+#include <set>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -34,6 +39,13 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+/// The number of threads computing the global routes
+static GlobalValue g_globalRoutingThreads(
+    "GlobalRoutingThreads",
+    "The number of threads computing the global routes of the routers in parallel",
+    UintegerValue(1),
+    MakeUintegerChecker<uint32_t>(1));
+
 /**
  * @brief Stream insertion operator.
  *
@@ -104,7 +116,6 @@ SPFVertex::SPFVertex(GlobalRoutingLSA* lsa)
     {
         NS_LOG_LOGIC("Setting m_vertexType to VertexRouter");
         m_vertexType = SPFVertex::VertexRouter;
-        m_node = lsa->GetNode();
     }
     else if (lsa->GetLSType() == GlobalRoutingLSA::NetworkLSA)
     {
@@ -409,7 +420,9 @@ SPFVertex::ClearVertexProcessed()
 Ptr<Node>
 SPFVertex::GetNode() const
 {
-    return m_node;
+    // the node is looked up when needed, since the node list can only be accessed by the
+    // main thread whereas the vertices may be created by the SPF worker threads
+    return m_vertexType == VertexRouter ? m_lsa->GetNode() : nullptr;
 }
 
 // ---------------------------------------------------------------------------
@@ -442,6 +455,7 @@ GlobalRouteManagerLSDB::~GlobalRouteManagerLSDB()
     }
     NS_LOG_LOGIC("clear map");
     m_database.clear();
+    m_linkDataIndex.clear();
 }
 
 void
@@ -463,9 +477,23 @@ GlobalRouteManagerLSDB::Insert(Ipv4Address addr, GlobalRoutingLSA* lsa)
     {
         m_extdatabase.push_back(lsa);
     }
-    else
+    else if (m_database.insert(LSDBPair_t(addr, lsa)).second)
     {
-        m_database.insert(LSDBPair_t(addr, lsa));
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() != GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                continue;
+            }
+            // keep the LSA with the lowest address, which is the first one found
+            // when walking the database
+            auto [it, inserted] = m_linkDataIndex.emplace(lr->GetLinkData(), addr);
+            if (!inserted && addr < it->second)
+            {
+                it->second = addr;
+            }
+        }
     }
 }
 
@@ -490,14 +518,8 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
-    {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
-    }
-    return nullptr;
+    auto i = m_database.find(addr);
+    return i != m_database.end() ? i->second : nullptr;
 }
 
 GlobalRoutingLSA*
@@ -505,23 +527,23 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this << addr);
     //
-    // Look up an LSA by its address.
+    // Look up the address of the LSA in the index built when inserting the LSAs.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_linkDataIndex.find(addr);
+    return i != m_linkDataIndex.end() ? GetLSA(i->second) : nullptr;
+}
+
+std::vector<Ipv4Address>
+GlobalRouteManagerLSDB::GetLinkStateIds() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<Ipv4Address> ids;
+    ids.reserve(m_database.size());
+    for (const auto& [addr, lsa] : m_database)
     {
-        GlobalRoutingLSA* temp = i->second;
-        // Iterate among temp's Link Records
-        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
-        {
-            GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
-            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork &&
-                lr->GetLinkData() == addr)
-            {
-                return temp;
-            }
-        }
+        ids.push_back(addr);
     }
-    return nullptr;
+    return ids;
 }
 
 // ---------------------------------------------------------------------------
@@ -531,16 +553,25 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 // ---------------------------------------------------------------------------
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
+    : m_spfroot(nullptr),
+      m_ownsLsdb(true)
 {
     NS_LOG_FUNCTION(this);
     m_lsdb = new GlobalRouteManagerLSDB();
 }
 
+GlobalRouteManagerImpl::GlobalRouteManagerImpl(GlobalRouteManagerLSDB* lsdb)
+    : m_spfroot(nullptr),
+      m_lsdb(lsdb),
+      m_ownsLsdb(false)
+{
+    NS_LOG_FUNCTION(this << lsdb);
+}
+
 GlobalRouteManagerImpl::~GlobalRouteManagerImpl()
 {
     NS_LOG_FUNCTION(this);
-    if (m_lsdb)
+    if (m_lsdb && m_ownsLsdb)
     {
         delete m_lsdb;
     }
@@ -569,20 +600,11 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
         {
             continue;
         }
-        Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-        uint32_t j = 0;
-        uint32_t nRoutes = gr->GetNRoutes();
-        NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
-        // Each time we delete route 0, the route index shifts downward
-        // We can delete all routes if we delete the route numbered 0
-        // nRoutes times
-        for (j = 0; j < nRoutes; j++)
-        {
-            NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
-            gr->RemoveRoute(0);
-        }
-        NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+        NS_LOG_LOGIC("Deleting routes from node " << node->GetId());
+        DeleteRoutes(router->GetRoutingProtocol());
     }
+    m_routers.clear();
+    m_lsaIndices.clear();
     if (m_lsdb)
     {
         NS_LOG_LOGIC("Deleting LSDB, creating new one");
@@ -591,6 +613,24 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
     }
 }
 
+void
+GlobalRouteManagerImpl::DeleteRoutes(Ptr<Ipv4GlobalRouting> routing)
+{
+    NS_LOG_FUNCTION(routing);
+    uint32_t j = 0;
+    uint32_t nRoutes = routing->GetNRoutes();
+    NS_LOG_LOGIC("Deleting " << nRoutes << " routes");
+    // Each time we delete route 0, the route index shifts downward
+    // We can delete all routes if we delete the route numbered 0
+    // nRoutes times
+    for (j = 0; j < nRoutes; j++)
+    {
+        NS_LOG_LOGIC("Deleting global route " << j);
+        routing->RemoveRoute(0);
+    }
+    NS_LOG_LOGIC("Deleted " << j << " global routes");
+}
+
 //
 // In order to build the routing database, we need to walk the list of nodes
 // in the system and look for those that support the GlobalRouter interface.
@@ -690,6 +730,7 @@ GlobalRouteManagerImpl::InitializeRoutes()
     // Walk the list of nodes in the system.
     //
     NS_LOG_INFO("About to start SPF calculation");
+    std::vector<Ptr<Node>> roots;
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
         Ptr<Node> node = *i;
@@ -712,12 +753,241 @@ GlobalRouteManagerImpl::InitializeRoutes()
         //
         if (rtr && rtr->GetNumLSAs())
         {
-            SPFCalculate(rtr->GetRouterId());
+            roots.push_back(node);
         }
     }
+    m_routers.clear();
+    ComputeRoutes(roots);
     NS_LOG_INFO("Finished SPF calculation");
 }
 
+void
+GlobalRouteManagerImpl::ComputeRoutes(const std::vector<Ptr<Node>>& nodes)
+{
+    NS_LOG_FUNCTION(this << nodes.size());
+
+    for (const auto& id : m_lsdb->GetLinkStateIds())
+    {
+        m_lsaIndices.emplace(id, m_lsaIndices.size());
+    }
+    std::vector<Ipv4Address> routerIds;
+    std::vector<Ptr<Ipv4GlobalRouting>> routings;
+    for (const auto& node : nodes)
+    {
+        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        routerIds.push_back(rtr->GetRouterId());
+        routings.push_back(rtr->GetRoutingProtocol());
+    }
+
+    // The workers only access the objects aggregated to the node whose routes they
+    // compute (but not the node list, for instance), since reference counting is not
+    // thread safe
+    std::vector<RouterState> states(nodes.size());
+    auto compute = [&](GlobalRouteManagerImpl& worker, std::size_t i) {
+        worker.SPFCalculate(routerIds[i], nodes[i]);
+        auto& state = states[i];
+        state.nRoutes = routings[i]->GetNRoutes();
+        state.readLsas.resize(m_lsaIndices.size());
+        for (const auto& [lsa, status] : worker.m_lsaStatus)
+        {
+            auto it = m_lsaIndices.find(lsa->GetLinkStateId());
+            NS_ASSERT_MSG(it != m_lsaIndices.end(), "Unknown LSA " << lsa->GetLinkStateId());
+            state.readLsas[it->second] = true;
+        }
+    };
+
+    UintegerValue nThreads;
+    g_globalRoutingThreads.GetValue(nThreads);
+    const auto nWorkers = std::min<std::size_t>(nThreads.Get(), nodes.size());
+    // logging is not thread safe, hence the routes are computed by this thread if any log
+    // component is enabled
+    const auto& components = *LogComponent::GetComponentList();
+    if (nWorkers <= 1 ||
+        !std::all_of(components.cbegin(), components.cend(), [](const auto& component) {
+            return component.second->IsNoneEnabled();
+        }))
+    {
+        for (std::size_t i = 0; i < nodes.size(); ++i)
+        {
+            compute(*this, i);
+        }
+    }
+    else
+    {
+        // each thread repeatedly picks the next router until the routes of all the routers
+        // have been computed
+        std::atomic<std::size_t> next{0};
+        auto work = [&]() {
+            GlobalRouteManagerImpl worker(m_lsdb);
+            for (auto i = next++; i < nodes.size(); i = next++)
+            {
+                compute(worker, i);
+            }
+        };
+        std::vector<std::thread> threads;
+        threads.reserve(nWorkers);
+        for (std::size_t t = 0; t < nWorkers; ++t)
+        {
+            threads.emplace_back(work);
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    for (std::size_t i = 0; i < nodes.size(); ++i)
+    {
+        m_routers[routerIds[i]] = std::move(states[i]);
+    }
+}
+
+//
+// Build the routing database again and find the LSAs that changed.  The routes
+// computed by a router only depend on the LSAs it read during the SPF
+// calculation and on the External LSAs.  The LSAs linked to a changed LSA are
+// considered as changed as well, since they may have been read while looking
+// for a router LSA by link data, which may now return the changed LSA.
+//
+void
+GlobalRouteManagerImpl::UpdateRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_routers.empty())
+    {
+        DeleteGlobalRoutes();
+        BuildGlobalRoutingDatabase();
+        InitializeRoutes();
+        return;
+    }
+
+    GlobalRouteManagerLSDB* oldLsdb = m_lsdb;
+    m_lsdb = new GlobalRouteManagerLSDB();
+    BuildGlobalRoutingDatabase();
+
+    std::set<Ipv4Address> changed;
+    auto addChanged = [&changed](Ipv4Address id, const GlobalRoutingLSA* lsa) {
+        changed.insert(id);
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint ||
+                lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                changed.insert(lr->GetLinkId());
+            }
+        }
+    };
+    for (const auto& id : oldLsdb->GetLinkStateIds())
+    {
+        GlobalRoutingLSA* oldLsa = oldLsdb->GetLSA(id);
+        GlobalRoutingLSA* newLsa = m_lsdb->GetLSA(id);
+        if (!newLsa || !IsSameLSA(oldLsa, newLsa))
+        {
+            addChanged(id, oldLsa);
+            if (newLsa)
+            {
+                addChanged(id, newLsa);
+            }
+        }
+    }
+    for (const auto& id : m_lsdb->GetLinkStateIds())
+    {
+        if (!oldLsdb->GetLSA(id))
+        {
+            addChanged(id, m_lsdb->GetLSA(id));
+        }
+    }
+    bool extChanged = (oldLsdb->GetNumExtLSAs() != m_lsdb->GetNumExtLSAs());
+    for (uint32_t i = 0; !extChanged && i < m_lsdb->GetNumExtLSAs(); i++)
+    {
+        extChanged = !IsSameLSA(oldLsdb->GetExtLSA(i), m_lsdb->GetExtLSA(i));
+    }
+    delete oldLsdb;
+    NS_LOG_LOGIC(changed.size() << " LSAs changed, External LSAs changed: " << extChanged);
+
+    std::vector<uint32_t> changedIndices;
+    for (const auto& id : changed)
+    {
+        if (auto it = m_lsaIndices.find(id); it != m_lsaIndices.end())
+        {
+            changedIndices.push_back(it->second);
+        }
+    }
+
+    std::vector<Ptr<Node>> roots;
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        if (!rtr)
+        {
+            continue;
+        }
+        Ptr<Ipv4GlobalRouting> gr = rtr->GetRoutingProtocol();
+        // the routes of the other routers are deleted, as in InitializeRoutes ()
+        if (node->GetSystemId() != Simulator::GetSystemId() || !rtr->GetNumLSAs())
+        {
+            m_routers.erase(rtr->GetRouterId());
+            DeleteRoutes(gr);
+            continue;
+        }
+        auto it = m_routers.find(rtr->GetRouterId());
+        if (!extChanged && it != m_routers.end() && it->second.nRoutes == gr->GetNRoutes() &&
+            std::none_of(changedIndices.cbegin(),
+                         changedIndices.cend(),
+                         [&readLsas = it->second.readLsas](uint32_t index) {
+                             return index < readLsas.size() && readLsas[index];
+                         }))
+        {
+            NS_LOG_LOGIC("Keeping the routes of node " << node->GetId());
+            continue;
+        }
+        NS_LOG_LOGIC("Computing again the routes of node " << node->GetId());
+        DeleteRoutes(gr);
+        roots.push_back(node);
+    }
+    ComputeRoutes(roots);
+}
+
+bool
+GlobalRouteManagerImpl::IsSameLSA(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b)
+{
+    if (a->GetLSType() != b->GetLSType() || a->GetLinkStateId() != b->GetLinkStateId() ||
+        a->GetAdvertisingRouter() != b->GetAdvertisingRouter() ||
+        a->GetNetworkLSANetworkMask() != b->GetNetworkLSANetworkMask() ||
+        a->GetNLinkRecords() != b->GetNLinkRecords() ||
+        a->GetNAttachedRouters() != b->GetNAttachedRouters())
+    {
+        return false;
+    }
+    for (uint32_t j = 0; j < a->GetNLinkRecords(); j++)
+    {
+        const GlobalRoutingLinkRecord* la = a->GetLinkRecord(j);
+        const GlobalRoutingLinkRecord* lb = b->GetLinkRecord(j);
+        if (la->GetLinkType() != lb->GetLinkType() || la->GetLinkId() != lb->GetLinkId() ||
+            la->GetLinkData() != lb->GetLinkData() || la->GetMetric() != lb->GetMetric())
+        {
+            return false;
+        }
+    }
+    for (uint32_t j = 0; j < a->GetNAttachedRouters(); j++)
+    {
+        if (a->GetAttachedRouter(j) != b->GetAttachedRouter(j))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+GlobalRoutingLSA::SPFStatus
+GlobalRouteManagerImpl::GetLSAStatus(const GlobalRoutingLSA* lsa) const
+{
+    auto it = m_lsaStatus.find(lsa);
+    return it != m_lsaStatus.end() ? it->second : GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED;
+}
+
 //
 // This method is derived from quagga ospf_spf_next ().  See RFC2328 Section
 // 16.1 (2) for further details.
@@ -822,7 +1092,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         // If the link is to a router that is already in the shortest path first tree
         // then we have it covered -- ignore it.
         //
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
+        if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_IN_SPFTREE)
         {
             NS_LOG_LOGIC("Skipping ->  LSA " << w_lsa->GetLinkStateId() << " already in SPF tree");
             continue;
@@ -846,7 +1116,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
         NS_LOG_LOGIC("Considering w_lsa " << w_lsa->GetLinkStateId());
 
         // Is there already vertex w in candidate list?
-        if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
+        if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED)
         {
             // Calculate nexthop to w
             // We need to figure out how to actually get to the new router represented
@@ -858,7 +1128,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
             w = new SPFVertex(w_lsa);
             if (SPFNexthopCalculation(v, w, l, distance))
             {
-                w_lsa->SetStatus(GlobalRoutingLSA::LSA_SPF_CANDIDATE);
+                m_lsaStatus[w_lsa] = GlobalRoutingLSA::LSA_SPF_CANDIDATE;
                 //
                 // Push this new vertex onto the priority queue (ordered by distance from the
                 // root node).
@@ -873,7 +1143,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                 NS_ASSERT_MSG(0, "SPFNexthopCalculation never return false, but it does now!");
             }
         }
-        else if (w_lsa->GetStatus() == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
+        else if (GetLSAStatus(w_lsa) == GlobalRoutingLSA::LSA_SPF_CANDIDATE)
         {
             //
             // We have already considered the link represented by <w>.  What wse have to
@@ -945,7 +1215,7 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                     // If we've changed the cost to get to the vertex represented by <w>, we
                     // must reorder the priority queue keyed to that cost.
                     //
-                    candidate.Reorder();
+                    candidate.Reorder(cw);
                 }
             }
         }
@@ -1281,6 +1551,8 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
             // The link record LinkID is the router ID of the peer.
             // The Link Data is the local IP interface address
             GlobalRoutingLSA* w_lsa = m_lsdb->GetLSA(transitLink->GetLinkId());
+            // the routes now depend on the LSA of the neighbor as well
+            m_lsaStatus.try_emplace(w_lsa, GlobalRoutingLSA::LSA_SPF_NOT_EXPLORED);
             uint32_t nLinkRecords = w_lsa->GetNLinkRecords();
             for (uint32_t j = 0; j < nLinkRecords; ++j)
             {
@@ -1296,7 +1568,7 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
                 if (lr->GetLinkId() == myRouterId)
                 {
                     // Next hop is stored in the LinkID field of lr
-                    Ptr<GlobalRouter> router = rlsa->GetNode()->GetObject<GlobalRouter>();
+                    Ptr<GlobalRouter> router = m_spfrootNode->GetObject<GlobalRouter>();
                     NS_ASSERT(router);
                     Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
                     NS_ASSERT(gr);
@@ -1316,17 +1588,26 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
     return false;
 }
 
-// quagga ospf_spf_calculate
 void
 GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
 {
     NS_LOG_FUNCTION(this << root);
+    SPFCalculate(root, NodeList::GetNNodes() > 0 ? m_lsdb->GetLSA(root)->GetNode() : nullptr);
+}
+
+// quagga ospf_spf_calculate
+void
+GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root, Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << root << node);
 
     SPFVertex* v;
     //
-    // Initialize the Link State Database.
+    // Initialize the status of the Link State Advertisements: none of them has
+    // been explored.
     //
-    m_lsdb->Initialize();
+    m_lsaStatus.clear();
+    m_spfrootNode = node;
     //
     // The candidate queue is a priority queue of SPFVertex objects, with the top
     // of the queue being the closest vertex in terms of distance from the root
@@ -1346,7 +1627,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     //
     m_spfroot = v;
     v->SetDistanceFromRoot(0);
-    v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+    m_lsaStatus[v->GetLSA()] = GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
     NS_LOG_LOGIC("Starting SPFCalculate for node " << root);
 
     //
@@ -1356,10 +1637,12 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     // reached.  Instead, short-circuit this computation and just install
     // a default route in the CheckForStubNode() method.
     //
-    if (NodeList::GetNNodes() > 0 && CheckForStubNode(root))
+    if (m_spfrootNode && CheckForStubNode(root))
     {
         NS_LOG_LOGIC("SPFCalculate truncated for stub node " << root);
         delete m_spfroot;
+        m_spfroot = nullptr;
+        m_spfrootNode = nullptr;
         return;
     }
 
@@ -1407,7 +1690,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
         // Update the status field of the vertex to indicate that it is in the SPF
         // tree.
         //
-        v->GetLSA()->SetStatus(GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
+        m_lsaStatus[v->GetLSA()] = GlobalRoutingLSA::LSA_SPF_IN_SPFTREE;
         //
         // The current vertex has a parent pointer.  By calling this rather oddly
         // named method (blame quagga) we add the current vertex to the list of
@@ -1480,6 +1763,7 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     //
     delete m_spfroot;
     m_spfroot = nullptr;
+    m_spfrootNode = nullptr;
 }
 
 void
@@ -1539,7 +1823,7 @@ GlobalRouteManagerImpl::SPFAddASExternal(GlobalRoutingLSA* extlsa, SPFVertex* v)
     // The node we need to add routes to is the node corresponding to the root vertex.
     // This is the node for which we are building the routing table.
     //
-    Ptr<Node> node = m_spfroot->GetNode();
+    Ptr<Node> node = m_spfrootNode;
 
     if (!node)
     {
@@ -1699,7 +1983,7 @@ GlobalRouteManagerImpl::SPFIntraAddStub(GlobalRoutingLinkRecord* l, SPFVertex* v
     // The node we need to add routes to is the node corresponding to the root vertex.
     // This is the node for which we are building the routing table.
     //
-    Ptr<Node> node = m_spfroot->GetNode();
+    Ptr<Node> node = m_spfrootNode;
     if (!node)
     {
         NS_LOG_ERROR("SPFIntraAddStub():Can't find root node " << routerId);
@@ -1811,7 +2095,7 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId(Ipv4Address a, Ipv4Mask amask)
     // The node we need to add routes to is the node corresponding to the root vertex.
     // This is the node for which we are building the routing table.
     //
-    Ptr<Node> node = m_spfroot->GetNode();
+    Ptr<Node> node = m_spfrootNode;
     if (!node)
     {
         //
@@ -1897,7 +2181,7 @@ GlobalRouteManagerImpl::SPFIntraAddRouter(SPFVertex* v)
     // The node we need to add routes to is the node corresponding to the root vertex.
     // This is the node for which we are building the routing table.
     //
-    Ptr<Node> node = m_spfroot->GetNode();
+    Ptr<Node> node = m_spfrootNode;
     if (!node)
     {
         NS_LOG_ERROR("SPFIntraAddRouter():Can't find root node " << routerId);
@@ -2036,7 +2320,7 @@ GlobalRouteManagerImpl::SPFIntraAddTransit(SPFVertex* v)
     // The node we need to add routes to is the node corresponding to the root vertex.
     // This is the node for which we are building the routing table.
     //
-    Ptr<Node> node = m_spfroot->GetNode();
+    Ptr<Node> node = m_spfrootNode;
     if (!node)
     {
         NS_LOG_ERROR("SPFIntraAddTransit():Can't find root node " << routerId);
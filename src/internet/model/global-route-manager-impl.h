@@ -20,6 +20,7 @@
 #include <map>
 #include <queue>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -542,7 +543,6 @@ class SPFVertex
     ListOfSPFVertex_t m_children;                    //!< Children list
     bool m_vertexProcessed; //!< Flag to note whether vertex has been processed in stage two of SPF
                             //!< computation
-    Ptr<Node> m_node;       //!< node pointer corresponding to the this Vertex
 
     /**
      * @brief Stream insertion operator.
@@ -625,7 +625,8 @@ class GlobalRouteManagerLSDB
      * @brief Look up the Link State Advertisement associated with the given
      * link state ID (address).  This is a variation of the GetLSA call
      * to allow the LSA to be found by matching addr with the LinkData field
-     * of the TransitNetwork link record.
+     * of the TransitNetwork link record.  If several LSAs match, the one with
+     * the lowest link state ID is returned.
      *
      * @see GetLSA
      * @param addr The IP address associated with the LSA.  Typically the Router
@@ -635,6 +636,14 @@ class GlobalRouteManagerLSDB
      */
     GlobalRoutingLSA* GetLSAByLinkData(Ipv4Address addr) const;
 
+    /**
+     * @brief Get the link state IDs (addresses) of the Link State Advertisements
+     * stored in the database, other than the External ones.
+     *
+     * @returns the link state IDs, in increasing order
+     */
+    std::vector<Ipv4Address> GetLinkStateIds() const;
+
     /**
      * @brief Set all LSA flags to an initialized state, for SPF computation
      *
@@ -675,6 +684,9 @@ class GlobalRouteManagerLSDB
         LSDBPair_t; //!< pair of IPv4 addresses / Link State Advertisements
 
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
+    /// Addresses of the Link State Advertisements indexed by the LinkData field of their
+    /// TransitNetwork link records
+    std::map<Ipv4Address, Ipv4Address> m_linkDataIndex;
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
 };
@@ -721,6 +733,19 @@ class GlobalRouteManagerImpl
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Build the routing database again and compute again the routes of
+     * the routers that may be affected by the changes in the database.
+     *
+     * The resulting forwarding tables are the same as the ones obtained by
+     * calling DeleteGlobalRoutes (), BuildGlobalRoutingDatabase () and
+     * InitializeRoutes ().  The routes of a router are kept if none of the Link
+     * State Advertisements read when computing them (and none of the LSAs linked
+     * to them) changed, if no External LSA changed and if the number of routes
+     * of the router did not change in the meantime.
+     */
+    virtual void UpdateRoutes();
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -734,8 +759,63 @@ class GlobalRouteManagerImpl
     void DebugSPFCalculate(Ipv4Address root);
 
   private:
+    /**
+     * @brief Create a worker computing the routes of some routers, to be used
+     * by the threads computing the routes in parallel.
+     *
+     * @param lsdb the LSDB the routes are computed from, which is not owned by the worker
+     */
+    explicit GlobalRouteManagerImpl(GlobalRouteManagerLSDB* lsdb);
+
+    /// State of a router whose routes have been computed
+    struct RouterState
+    {
+        uint32_t nRoutes;            //!< number of routes after they have been computed
+        std::vector<bool> readLsas; //!< the LSAs read, indexed as in m_lsaIndices
+    };
+
     SPFVertex* m_spfroot;           //!< the root node
+    Ptr<Node> m_spfrootNode;        //!< the node of the root, during an SPF calculation
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    bool m_ownsLsdb;                //!< whether the LSDB is deleted along with this object
+    /// Status of the LSAs read during the current SPF calculation (the other LSAs are not
+    /// explored)
+    std::unordered_map<const GlobalRoutingLSA*, GlobalRoutingLSA::SPFStatus> m_lsaStatus;
+    std::map<Ipv4Address, uint32_t> m_lsaIndices; //!< indices of the link state IDs ever seen
+    std::map<Ipv4Address, RouterState> m_routers; //!< routers with routes, indexed by router ID
+
+    /**
+     * @brief Compute the routes of the given nodes, possibly with several threads,
+     * and record the state of their routers.
+     *
+     * The number of threads is given by the "GlobalRoutingThreads" global value.
+     * All the routes are computed by the calling thread if logging is enabled.
+     *
+     * @param nodes the nodes, which are global routers with LSAs
+     */
+    void ComputeRoutes(const std::vector<Ptr<Node>>& nodes);
+
+    /**
+     * @brief Delete all the routes of the given routing protocol.
+     *
+     * @param routing the routing protocol
+     */
+    static void DeleteRoutes(Ptr<Ipv4GlobalRouting> routing);
+
+    /**
+     * @brief Compare the contents of two LSAs, regardless of their SPF status.
+     *
+     * @param a the first LSA
+     * @param b the second LSA
+     * @returns true if the LSAs have the same contents
+     */
+    static bool IsSameLSA(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b);
+
+    /**
+     * @param lsa an LSA
+     * @returns the status of the given LSA in the current SPF calculation
+     */
+    GlobalRoutingLSA::SPFStatus GetLSAStatus(const GlobalRoutingLSA* lsa) const;
 
     /**
      * @brief Test if a node is a stub, from an OSPF sense.
@@ -757,6 +837,18 @@ class GlobalRouteManagerImpl
      */
     void SPFCalculate(Ipv4Address root);
 
+    /**
+     * @brief Calculate the shortest path first (SPF) tree
+     *
+     * The routes are added to the forwarding table of the given node.  This
+     * method can be called concurrently by several workers for different roots,
+     * since it only accesses the objects aggregated to the given node.
+     *
+     * @param root the root node
+     * @param node the node of the root node, or null if the node list is empty
+     */
+    void SPFCalculate(Ipv4Address root, Ptr<Node> node);
+
     /**
      * @brief Process Stub nodes
      *
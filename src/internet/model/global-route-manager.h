@@ -60,6 +60,15 @@ class GlobalRouteManager
      */
     static void InitializeRoutes();
 
+    /**
+     * @brief Build the routing database again and only compute again the routes
+     * of the nodes that may be affected by the changes in the database.
+     *
+     * This yields the same per-node forwarding tables as calling
+     * DeleteGlobalRoutes (), BuildGlobalRoutingDatabase () and InitializeRoutes ().
+     */
+    static void UpdateRoutes();
+
     /**
      * @brief Reset the router ID counter to zero. This should only be called by tests to reset the
      * router ID counter between simulations within the same program. This function should not be
@@ -13,6 +13,9 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace ns3
 {
 
@@ -32,33 +35,82 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv4EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
+    m_ports.clear();
+    m_fourTuples.clear();
+    m_positions.clear();
+}
+
+std::size_t
+Ipv4EndPointDemux::FourTupleHash::operator()(const FourTuple& tuple) const
+{
+    uint64_t local = (static_cast<uint64_t>(tuple.localAddress.Get()) << 16) | tuple.localPort;
+    uint64_t peer = (static_cast<uint64_t>(tuple.peerAddress.Get()) << 16) | tuple.peerPort;
+    return std::hash<uint64_t>()(local) ^ (std::hash<uint64_t>()(peer) * 0x9e3779b97f4a7c15ULL);
+}
+
+Ipv4EndPoint*
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto all = m_endPoints.insert(m_endPoints.end(), endPoint);
+    auto& sameport = m_ports[endPoint->GetLocalPort()];
+    auto port = sameport.insert(sameport.end(), endPoint);
+    m_positions.emplace(endPoint, Position{all, port});
+    endPoint->m_demux = this;
+    AddToIndex(endPoint);
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv4EndPointDemux::AddToIndex(Ipv4EndPoint* endPoint)
+{
+    m_fourTuples[FourTuple{endPoint->GetLocalAddress(),
+                           endPoint->GetLocalPort(),
+                           endPoint->GetPeerAddress(),
+                           endPoint->GetPeerPort()}]
+        .push_back(endPoint);
+}
+
+void
+Ipv4EndPointDemux::RemoveFromIndex(Ipv4EndPoint* endPoint)
+{
+    auto it = m_fourTuples.find(FourTuple{endPoint->GetLocalAddress(),
+                                          endPoint->GetLocalPort(),
+                                          endPoint->GetPeerAddress(),
+                                          endPoint->GetPeerPort()});
+    NS_ASSERT_MSG(it != m_fourTuples.end(), "End point " << endPoint << " is not indexed");
+    auto& endPoints = it->second;
+    endPoints.erase(std::find(endPoints.begin(), endPoints.end(), endPoint));
+    if (endPoints.empty())
+    {
+        m_fourTuples.erase(it);
+    }
 }
 
 bool
 Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_ports.contains(port);
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_ports.find(port);
+    if (it == m_ports.end())
+    {
+        return false;
+    }
+    for (auto i = it->second.begin(); i != it->second.end(); i++)
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        if ((*i)->GetLocalAddress() == addr && (*i)->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -77,9 +129,7 @@ Ipv4EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv4EndPoint*
@@ -93,9 +143,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv4EndPoint*
@@ -116,9 +164,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv4EndPoint*
@@ -129,38 +175,43 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_fourTuples.find(FourTuple{localAddress, localPort, peerAddress, peerPort});
+    if (it != m_fourTuples.end())
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto i = it->second.begin(); i != it->second.end(); i++)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice())
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv4EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_positions.find(endPoint);
+    if (it == m_positions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
     }
+    RemoveFromIndex(endPoint);
+    auto portIt = m_ports.find(endPoint->GetLocalPort());
+    portIt->second.erase(it->second.port);
+    if (portIt->second.empty())
+    {
+        m_ports.erase(portIt);
+    }
+    m_endPoints.erase(it->second.all);
+    m_positions.erase(it);
+    endPoint->m_demux = nullptr;
+    delete endPoint;
 }
 
 /*
@@ -200,9 +251,49 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
     EndPoints retval4; // Exact match on all 4
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+
+    // Only the endpoints whose local address is either the destination address, the wildcard
+    // or a subnet address of the incoming interface (matching the destination address) and
+    // whose peer is either the source or the wildcard may match: look them up in the index
+    std::vector<Ipv4Address> localAddresses{daddr};
+    if (daddr != Ipv4Address::GetAny())
+    {
+        localAddresses.push_back(Ipv4Address::GetAny());
+    }
+    if (incomingInterface)
+    {
+        for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
+        {
+            Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+            Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+            if (daddr.CombineMask(addr.GetMask()) == addrNetpart &&
+                std::find(localAddresses.begin(), localAddresses.end(), addrNetpart) ==
+                    localAddresses.end())
+            {
+                localAddresses.push_back(addrNetpart);
+            }
+        }
+    }
+    std::vector<std::pair<Ipv4Address, uint16_t>> peers{{saddr, sport}};
+    if (saddr != Ipv4Address::GetAny() || sport != 0)
+    {
+        peers.emplace_back(Ipv4Address::GetAny(), 0);
+    }
+    std::vector<Ipv4EndPoint*> candidates;
+    for (const auto& localAddress : localAddresses)
+    {
+        for (const auto& [peerAddress, peerPort] : peers)
+        {
+            auto it = m_fourTuples.find(FourTuple{localAddress, dport, peerAddress, peerPort});
+            if (it != m_fourTuples.end())
+            {
+                candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+
+    for (Ipv4EndPoint* endP : candidates)
     {
-        Ipv4EndPoint* endP = *i;
 
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
@@ -361,16 +452,25 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport);
 
+    // an exact match is unique unless several endpoints only differ by their bound device
+    auto exact = m_fourTuples.find(FourTuple{daddr, dport, saddr, sport});
+    if (exact != m_fourTuples.end() && exact->second.size() == 1)
+    {
+        return exact->second.front();
+    }
+
+    auto sameport = m_ports.find(dport);
+    if (sameport == m_ports.end())
+    {
+        return nullptr;
+    }
+
     // this code is a copy/paste version of an old BSD ip stack lookup
     // function.
     uint32_t genericity = 3;
     Ipv4EndPoint* generic = nullptr;
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (auto i = sameport->second.begin(); i != sameport->second.end(); i++)
     {
-        if ((*i)->GetLocalPort() != dport)
-        {
-            continue;
-        }
         if ((*i)->GetLocalAddress() == daddr && (*i)->GetPeerPort() == sport &&
             (*i)->GetPeerAddress() == saddr)
         {
@@ -15,6 +15,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -31,6 +33,11 @@ class Ipv4EndPoint;
  * of endpoints, and has APIs to add and find endpoints in this demux.  This
  * code is shared in common to TCP and UDP protocols in ns3.  This demux
  * sits between ns3's layer four and the socket layer
+ *
+ * The endpoints are indexed by local port and by four-tuple, so that a lookup
+ * only examines the endpoints that may match the looked up four-tuple rather
+ * than all the endpoints.  The endpoints notify the demux when their local
+ * address or peer change, so that the index is kept up to date.
  */
 
 class Ipv4EndPointDemux
@@ -160,6 +167,66 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    friend class Ipv4EndPoint;
+
+    /**
+     * @brief The local address, local port, peer address and peer port of an endpoint.
+     */
+    struct FourTuple
+    {
+        Ipv4Address localAddress; //!< local address
+        uint16_t localPort;       //!< local port
+        Ipv4Address peerAddress;  //!< peer address
+        uint16_t peerPort;        //!< peer port
+
+        /**
+         * @param other the four-tuple to compare to
+         * @return true if the four-tuples are equal
+         */
+        bool operator==(const FourTuple& other) const = default;
+    };
+
+    /**
+     * @brief Hash function for the four-tuples.
+     */
+    struct FourTupleHash
+    {
+        /**
+         * @param tuple the four-tuple
+         * @return the hash of the four-tuple
+         */
+        std::size_t operator()(const FourTuple& tuple) const;
+    };
+
+    /**
+     * @brief The position of an endpoint in the containers.
+     */
+    struct Position
+    {
+        EndPointsI all;  //!< position in the list of all the endpoints
+        EndPointsI port; //!< position in the list of the endpoints with the same local port
+    };
+
+    /**
+     * @brief Insert a newly allocated endpoint into the demux.
+     * @param endPoint the endpoint
+     * @return the endpoint
+     */
+    Ipv4EndPoint* Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Add an endpoint to the four-tuple index.
+     * @param endPoint the endpoint
+     */
+    void AddToIndex(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Remove an endpoint from the four-tuple index. This is called by the endpoint
+     * before changing its local address or its peer.
+     * @param endPoint the endpoint
+     */
+    void RemoveFromIndex(Ipv4EndPoint* endPoint);
+
     /**
      * @brief Allocate an ephemeral port.
      * @returns the ephemeral port
@@ -185,6 +252,21 @@ class Ipv4EndPointDemux
      * @brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief The end points with each local port, in allocation order.
+     */
+    std::unordered_map<uint16_t, EndPoints> m_ports;
+
+    /**
+     * @brief The end points with each four-tuple.
+     */
+    std::unordered_map<FourTuple, std::vector<Ipv4EndPoint*>, FourTupleHash> m_fourTuples;
+
+    /**
+     * @brief The position of each end point in the containers.
+     */
+    std::unordered_map<Ipv4EndPoint*, Position> m_positions;
 };
 
 } // namespace ns3
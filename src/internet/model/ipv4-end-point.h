@@ -22,6 +22,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv4EndPointDemux;
 class Packet;
 
 /**
@@ -180,6 +181,8 @@ class Ipv4EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv4EndPointDemux;
+
     /**
      * @brief The local address.
      */
@@ -224,6 +227,12 @@ class Ipv4EndPoint
      * @brief true if the endpoint can receive packets.
      */
     bool m_rxEnabled;
+
+    /**
+     * @brief The demux the endpoint has been allocated by (if any), which is notified when
+     * the local address or the peer change.
+     */
+    Ipv4EndPointDemux* m_demux;
 };
 
 } // namespace ns3
@@ -19,7 +19,9 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <iterator>
 #include <vector>
 
 namespace ns3
@@ -71,16 +73,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     NS_LOG_FUNCTION(this << dest << nextHop << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
-    for (auto routePointer : m_hostRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_hostRoutes.push_back(route);
+    AddHostRoute(route);
 }
 
 void
@@ -89,16 +82,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     NS_LOG_FUNCTION(this << dest << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
-    for (auto routePointer : m_hostRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_hostRoutes.push_back(route);
+    AddHostRoute(route);
 }
 
 void
@@ -110,16 +94,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
-    for (auto routePointer : m_networkRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_networkRoutes.push_back(route);
+    AddNetworkRoute(route);
 }
 
 void
@@ -128,16 +103,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
     NS_LOG_FUNCTION(this << network << networkMask << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
-    for (auto routePointer : m_networkRoutes)
-    {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
-    }
-    m_networkRoutes.push_back(route);
+    AddNetworkRoute(route);
 }
 
 void
@@ -149,16 +115,108 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
-    for (auto routePointer : m_ASexternalRoutes)
+    AddASExternalRoute(route);
+}
+
+void
+Ipv4GlobalRouting::AddHostRoute(Ipv4RoutingTableEntry* route)
+{
+    const auto routes = m_hostRouteTrie.Find(route->GetDest(), Ipv4Mask::GetOnes());
+    if (routes && std::any_of(routes->cbegin(), routes->cend(), [route](auto routePointer) {
+            return *routePointer == *route;
+        }))
     {
-        if (*routePointer == *route)
-        {
-            NS_LOG_LOGIC("Route already exists");
-            delete route;
-            return;
-        }
+        NS_LOG_LOGIC("Route already exists");
+        delete route;
+        return;
+    }
+    m_hostRoutes.push_back(route);
+    m_hostRouteTrie.Insert(route->GetDest(), Ipv4Mask::GetOnes(), route);
+}
+
+void
+Ipv4GlobalRouting::AddNetworkRoute(Ipv4RoutingTableEntry* route)
+{
+    const auto network = route->GetDestNetwork();
+    const auto mask = route->GetDestNetworkMask();
+    const auto isEqual = [route](auto routePointer) { return *routePointer == *route; };
+    const auto isPrefix = Ipv4PrefixTrie<Ipv4RoutingTableEntry*>::IsPrefixMask(mask);
+    const auto routes = m_networkRouteTrie.Find(network, mask);
+    if ((isPrefix && routes && std::any_of(routes->cbegin(), routes->cend(), isEqual)) ||
+        (!isPrefix && std::any_of(m_networkRoutes.cbegin(), m_networkRoutes.cend(), isEqual)))
+    {
+        NS_LOG_LOGIC("Route already exists");
+        delete route;
+        return;
+    }
+    m_networkRoutes.push_back(route);
+    if (isPrefix)
+    {
+        m_networkRouteTrie.Insert(network, mask, route);
+    }
+    else
+    {
+        NS_LOG_LOGIC("Mask " << mask << " is not a prefix, the routing table will be scanned");
+        ++m_nNonPrefixRoutes;
+    }
+}
+
+void
+Ipv4GlobalRouting::AddASExternalRoute(Ipv4RoutingTableEntry* route)
+{
+    const auto network = route->GetDestNetwork();
+    const auto mask = route->GetDestNetworkMask();
+    const auto isPrefix = Ipv4PrefixTrie<ASExternalRouteSeq>::IsPrefixMask(mask);
+    const auto routes = m_ASexternalRouteTrie.Find(network, mask);
+    if ((isPrefix && routes &&
+         std::any_of(routes->cbegin(),
+                     routes->cend(),
+                     [route](const auto& seqRoute) { return *seqRoute.second == *route; })) ||
+        (!isPrefix &&
+         std::any_of(m_ASexternalRoutes.cbegin(),
+                     m_ASexternalRoutes.cend(),
+                     [route](auto routePointer) { return *routePointer == *route; })))
+    {
+        NS_LOG_LOGIC("Route already exists");
+        delete route;
+        return;
     }
     m_ASexternalRoutes.push_back(route);
+    if (isPrefix)
+    {
+        m_ASexternalRouteTrie.Insert(network, mask, {m_ASexternalRouteSeq++, route});
+    }
+    else
+    {
+        NS_LOG_LOGIC("Mask " << mask << " is not a prefix, the routing table will be scanned");
+        ++m_nNonPrefixRoutes;
+    }
+}
+
+void
+Ipv4GlobalRouting::RemoveFromTrie(Ipv4RoutingTableEntry* route, bool external)
+{
+    const auto network = route->GetDestNetwork();
+    const auto mask = route->GetDestNetworkMask();
+    if (!Ipv4PrefixTrie<Ipv4RoutingTableEntry*>::IsPrefixMask(mask))
+    {
+        NS_ASSERT(m_nNonPrefixRoutes > 0);
+        --m_nNonPrefixRoutes;
+        return;
+    }
+    if (!external)
+    {
+        m_networkRouteTrie.Remove(network, mask, route);
+        return;
+    }
+    const auto routes = m_ASexternalRouteTrie.Find(network, mask);
+    NS_ASSERT(routes);
+    auto it = std::find_if(routes->cbegin(), routes->cend(), [route](const auto& seqRoute) {
+        return seqRoute.second == route;
+    });
+    NS_ASSERT(it != routes->cend());
+    const auto seqRoute = *it;
+    m_ASexternalRouteTrie.Remove(network, mask, seqRoute);
 }
 
 Ptr<Ipv4Route>
@@ -171,6 +229,109 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
     RouteVec_t allRoutes;
 
+    if (m_nNonPrefixRoutes > 0)
+    {
+        LookupGlobalLinear(dest, oif, allRoutes);
+    }
+    else
+    {
+        LookupGlobalTrie(dest, oif, allRoutes);
+    }
+
+    if (!allRoutes.empty()) // if route(s) is found
+    {
+        // pick up one of the routes uniformly at random if random
+        // ECMP routing is enabled, or always select the first route
+        // consistently if random ECMP routing is disabled
+        uint32_t selectIndex;
+        if (m_randomEcmpRouting)
+        {
+            selectIndex = m_rand->GetInteger(0, allRoutes.size() - 1);
+        }
+        else
+        {
+            selectIndex = 0;
+        }
+        Ipv4RoutingTableEntry* route = allRoutes.at(selectIndex);
+        // create a Ipv4Route object from the selected routing table entry
+        rtentry = Create<Ipv4Route>();
+        rtentry->SetDestination(route->GetDest());
+        /// @todo handle multi-address case
+        rtentry->SetSource(m_ipv4->GetAddress(route->GetInterface(), 0).GetLocal());
+        rtentry->SetGateway(route->GetGateway());
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
+        return rtentry;
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+void
+Ipv4GlobalRouting::LookupGlobalTrie(Ipv4Address dest,
+                                    Ptr<NetDevice> oif,
+                                    std::vector<Ipv4RoutingTableEntry*>& allRoutes) const
+{
+    auto isOnInterface = [this, oif](const Ipv4RoutingTableEntry* route) {
+        if (oif && oif != m_ipv4->GetNetDevice(route->GetInterface()))
+        {
+            NS_LOG_LOGIC("Not on requested interface, skipping");
+            return false;
+        }
+        return true;
+    };
+
+    NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
+    if (auto routes = m_hostRouteTrie.Find(dest, Ipv4Mask::GetOnes()))
+    {
+        std::copy_if(routes->cbegin(),
+                     routes->cend(),
+                     std::back_inserter(allRoutes),
+                     isOnInterface);
+    }
+    if (allRoutes.empty()) // if no host route is found
+    {
+        // routes with the longest mask on the requested interface, in the order they were added
+        NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
+        m_networkRouteTrie.ForEachMatch(dest, [&](uint8_t masklen, const auto& routes) {
+            std::copy_if(routes.cbegin(),
+                         routes.cend(),
+                         std::back_inserter(allRoutes),
+                         isOnInterface);
+            NS_LOG_LOGIC(allRoutes.size() << " global network routes with mask length "
+                                          << +masklen);
+            return !allRoutes.empty();
+        });
+    }
+    if (allRoutes.empty()) // consider external if no host/network found
+    {
+        // the first matching route on the requested interface that was added
+        const ASExternalRouteSeq* first = nullptr;
+        m_ASexternalRouteTrie.ForEachMatch(dest, [&](uint8_t, const auto& routes) {
+            auto it = std::find_if(routes.cbegin(), routes.cend(), [&](const auto& seqRoute) {
+                return isOnInterface(seqRoute.second);
+            });
+            if (it != routes.cend() && (!first || it->first < first->first))
+            {
+                first = &(*it);
+            }
+            return false;
+        });
+        if (first)
+        {
+            NS_LOG_LOGIC("Found external route" << first->second);
+            allRoutes.push_back(first->second);
+        }
+    }
+}
+
+void
+Ipv4GlobalRouting::LookupGlobalLinear(Ipv4Address dest,
+                                      Ptr<NetDevice> oif,
+                                      std::vector<Ipv4RoutingTableEntry*>& allRoutes) const
+{
     NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
     for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
     {
@@ -224,6 +385,7 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
                 else
                 {
                     NS_LOG_LOGIC("Longer mask length found, clearing the list and adding");
+                    longest_mask = masklen;
                     allRoutes.clear();
                     allRoutes.push_back(*j);
                 }
@@ -252,35 +414,6 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
             }
         }
     }
-    if (!allRoutes.empty()) // if route(s) is found
-    {
-        // pick up one of the routes uniformly at random if random
-        // ECMP routing is enabled, or always select the first route
-        // consistently if random ECMP routing is disabled
-        uint32_t selectIndex;
-        if (m_randomEcmpRouting)
-        {
-            selectIndex = m_rand->GetInteger(0, allRoutes.size() - 1);
-        }
-        else
-        {
-            selectIndex = 0;
-        }
-        Ipv4RoutingTableEntry* route = allRoutes.at(selectIndex);
-        // create a Ipv4Route object from the selected routing table entry
-        rtentry = Create<Ipv4Route>();
-        rtentry->SetDestination(route->GetDest());
-        /// @todo handle multi-address case
-        rtentry->SetSource(m_ipv4->GetAddress(route->GetInterface(), 0).GetLocal());
-        rtentry->SetGateway(route->GetGateway());
-        uint32_t interfaceIdx = route->GetInterface();
-        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
-        return rtentry;
-    }
-    else
-    {
-        return nullptr;
-    }
 }
 
 uint32_t
@@ -350,6 +483,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             if (tmp == index)
             {
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
+                m_hostRouteTrie.Remove((*i)->GetDest(), Ipv4Mask::GetOnes(), *i);
                 delete *i;
                 m_hostRoutes.erase(i);
                 NS_LOG_LOGIC("Done removing host route "
@@ -366,6 +500,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
+            RemoveFromTrie(*j, false);
             delete *j;
             m_networkRoutes.erase(j);
             NS_LOG_LOGIC("Done removing network route "
@@ -381,6 +516,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_ASexternalRoutes.size());
+            RemoveFromTrie(*k, true);
             delete *k;
             m_ASexternalRoutes.erase(k);
             NS_LOG_LOGIC("Done removing network route "
@@ -417,6 +553,10 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_hostRouteTrie.Clear();
+    m_networkRouteTrie.Clear();
+    m_ASexternalRouteTrie.Clear();
+    m_nNonPrefixRoutes = 0;
 
     Ipv4RoutingProtocol::DoDispose();
 }
@@ -585,9 +725,7 @@ Ipv4GlobalRouting::NotifyInterfaceUp(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateRoutes();
     }
 }
 
@@ -597,9 +735,7 @@ Ipv4GlobalRouting::NotifyInterfaceDown(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateRoutes();
     }
 }
 
@@ -609,9 +745,7 @@ Ipv4GlobalRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress add
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateRoutes();
     }
 }
 
@@ -621,9 +755,7 @@ Ipv4GlobalRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::UpdateRoutes();
     }
 }
 
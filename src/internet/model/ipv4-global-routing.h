@@ -8,6 +8,7 @@
 #define IPV4_GLOBAL_ROUTING_H
 
 #include "ipv4-header.h"
+#include "ipv4-prefix-trie.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
 
@@ -17,6 +18,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -54,6 +57,12 @@ class Node;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * Besides the lists of routes, which define the order of the routes in the routing table, the
+ * routes are indexed by destination prefix in radix tries (Ipv4PrefixTrie), so that the routes
+ * to a destination are found in a time that does not depend on the number of routes. The lists
+ * are only scanned if a network route whose mask is not made of contiguous leading ones has been
+ * added.
+ *
  * @see Ipv4RoutingProtocol
  * @see GlobalRouteManager
  */
@@ -254,6 +263,34 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     /// iterator of container of Ipv4RoutingTableEntry (routes to external AS)
     typedef std::list<Ipv4RoutingTableEntry*>::iterator ASExternalRoutesI;
 
+    /// External route along with the sequence number of its insertion
+    typedef std::pair<uint64_t, Ipv4RoutingTableEntry*> ASExternalRouteSeq;
+
+    /**
+     * @brief Add a route to hosts, unless an identical route exists.
+     * @param route the route, which is deleted if an identical route exists
+     */
+    void AddHostRoute(Ipv4RoutingTableEntry* route);
+
+    /**
+     * @brief Add a route to networks, unless an identical route exists.
+     * @param route the route, which is deleted if an identical route exists
+     */
+    void AddNetworkRoute(Ipv4RoutingTableEntry* route);
+
+    /**
+     * @brief Add an external route, unless an identical route exists.
+     * @param route the route, which is deleted if an identical route exists
+     */
+    void AddASExternalRoute(Ipv4RoutingTableEntry* route);
+
+    /**
+     * @brief Remove a route to networks or an external route from the corresponding trie.
+     * @param route the route
+     * @param external whether the route is an external route
+     */
+    void RemoveFromTrie(Ipv4RoutingTableEntry* route, bool external);
+
     /**
      * @brief Lookup in the forwarding table for destination.
      * @param dest destination address
@@ -262,10 +299,36 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
 
+    /**
+     * @brief Find the routes to a destination by scanning the lists of routes.
+     * @param dest destination address
+     * @param oif output interface if any (put 0 otherwise)
+     * @param allRoutes the vector to which the routes found are appended
+     */
+    void LookupGlobalLinear(Ipv4Address dest,
+                            Ptr<NetDevice> oif,
+                            std::vector<Ipv4RoutingTableEntry*>& allRoutes) const;
+
+    /**
+     * @brief Find the routes to a destination by searching the tries.
+     * @param dest destination address
+     * @param oif output interface if any (put 0 otherwise)
+     * @param allRoutes the vector to which the routes found are appended
+     */
+    void LookupGlobalTrie(Ipv4Address dest,
+                          Ptr<NetDevice> oif,
+                          std::vector<Ipv4RoutingTableEntry*>& allRoutes) const;
+
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    Ipv4PrefixTrie<Ipv4RoutingTableEntry*> m_hostRouteTrie;    //!< Routes to hosts by destination
+    Ipv4PrefixTrie<Ipv4RoutingTableEntry*> m_networkRouteTrie; //!< Routes to networks by prefix
+    Ipv4PrefixTrie<ASExternalRouteSeq> m_ASexternalRouteTrie;  //!< External routes by prefix
+    uint64_t m_ASexternalRouteSeq{0}; //!< Sequence number of the next external route
+    uint32_t m_nNonPrefixRoutes{0};   //!< Number of routes that are not stored in the tries
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
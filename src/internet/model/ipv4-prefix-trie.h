@@ -0,0 +1,430 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef IPV4_PREFIX_TRIE_H
+#define IPV4_PREFIX_TRIE_H
+
+#include "ns3/assert.h"
+#include "ns3/ipv4-address.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup ipv4Routing
+ *
+ * A path-compressed binary trie (radix trie) storing values (typically routes) associated with
+ * IPv4 prefixes, which allows to find the prefixes matching an address in a time that does not
+ * depend on the number of stored prefixes. Multiple values can be associated with the same
+ * prefix; they are kept in the order in which they were inserted.
+ *
+ * Only prefixes whose mask is made of contiguous leading ones can be stored (see IsPrefixMask()).
+ *
+ * @tparam T the type of the values
+ */
+template <typename T>
+class Ipv4PrefixTrie
+{
+  public:
+    Ipv4PrefixTrie();
+
+    /**
+     * @param mask an IPv4 mask
+     * @return whether the given mask is made of contiguous leading ones, i.e., whether the
+     *         prefixes with such a mask can be stored in the trie
+     */
+    static bool IsPrefixMask(Ipv4Mask mask);
+
+    /**
+     * Associate a value with the given prefix. The value is stored after the values already
+     * associated with the same prefix.
+     *
+     * @param network the network address (the bits not covered by the mask are ignored)
+     * @param mask the network mask
+     * @param value the value
+     */
+    void Insert(Ipv4Address network, Ipv4Mask mask, const T& value);
+
+    /**
+     * Remove the first value equal to the given one among those associated with the given
+     * prefix.
+     *
+     * @param network the network address (the bits not covered by the mask are ignored)
+     * @param mask the network mask
+     * @param value the value
+     * @return whether a value has been removed
+     */
+    bool Remove(Ipv4Address network, Ipv4Mask mask, const T& value);
+
+    /**
+     * @param network the network address (the bits not covered by the mask are ignored)
+     * @param mask the network mask
+     * @return the values associated with the given prefix, in insertion order, or a null
+     *         pointer if no value is associated with the given prefix
+     */
+    const std::vector<T>* Find(Ipv4Address network, Ipv4Mask mask) const;
+
+    /**
+     * Call the given function for every prefix matching the given address and having values
+     * associated with it, from the longest prefix to the shortest one, until the function
+     * returns true.
+     *
+     * @tparam F the type of the function, which is passed the length of the prefix and the
+     *           values associated with the prefix and returns whether to stop
+     * @param address the address
+     * @param f the function
+     * @return whether the function returned true
+     */
+    template <typename F>
+    bool ForEachMatch(Ipv4Address address, F&& f) const;
+
+    /// Remove all the values
+    void Clear();
+
+    /// @return the number of values stored in the trie
+    std::size_t GetSize() const;
+
+  private:
+    /// Index of a node in the node vector
+    using NodeIndex = uint32_t;
+    /// Index used to indicate that there is no node
+    static constexpr NodeIndex NO_NODE = std::numeric_limits<NodeIndex>::max();
+
+    /// A node of the trie
+    struct Node
+    {
+        uint32_t prefix;                     //!< the prefix (bits beyond length are zero)
+        uint8_t length;                      //!< length of the prefix
+        std::array<NodeIndex, 2> children{}; //!< children whose next bit is 0 and 1
+        std::vector<T> values;               //!< values associated with the prefix
+    };
+
+    /**
+     * @param prefix the prefix
+     * @param length the length of the prefix
+     * @return the given prefix, where the bits beyond the given length are zeroed
+     */
+    static uint32_t Truncate(uint32_t prefix, uint8_t length);
+
+    /**
+     * @param address an address
+     * @param position the position of the bit, starting from the most significant one
+     * @return the value of the given bit of the given address
+     */
+    static uint8_t GetBit(uint32_t address, uint8_t position);
+
+    /**
+     * @param prefix the prefix
+     * @param length the length of the prefix
+     * @return the index of a new node with no children and no values
+     */
+    NodeIndex NewNode(uint32_t prefix, uint8_t length);
+
+    /**
+     * Release a node, which can be reused for another prefix.
+     *
+     * @param index the index of the node
+     */
+    void FreeNode(NodeIndex index);
+
+    /**
+     * @param prefix the prefix
+     * @param length the length of the prefix
+     * @return the index of the node storing the given prefix, or NO_NODE
+     */
+    NodeIndex FindNode(uint32_t prefix, uint8_t length) const;
+
+    std::vector<Node> m_nodes;          //!< nodes (the root, with an empty prefix, is the first)
+    std::vector<NodeIndex> m_freeNodes; //!< indices of the released nodes
+    std::size_t m_size{0};              //!< number of values stored in the trie
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <typename T>
+Ipv4PrefixTrie<T>::Ipv4PrefixTrie()
+{
+    NewNode(0, 0);
+}
+
+template <typename T>
+bool
+Ipv4PrefixTrie<T>::IsPrefixMask(Ipv4Mask mask)
+{
+    const auto length = mask.GetPrefixLength();
+    return mask.Get() == Truncate(0xffffffff, length);
+}
+
+template <typename T>
+uint32_t
+Ipv4PrefixTrie<T>::Truncate(uint32_t prefix, uint8_t length)
+{
+    return length == 0 ? 0 : prefix & (0xffffffff << (32 - length));
+}
+
+template <typename T>
+uint8_t
+Ipv4PrefixTrie<T>::GetBit(uint32_t address, uint8_t position)
+{
+    return (address >> (31 - position)) & 1;
+}
+
+template <typename T>
+typename Ipv4PrefixTrie<T>::NodeIndex
+Ipv4PrefixTrie<T>::NewNode(uint32_t prefix, uint8_t length)
+{
+    NodeIndex index;
+    if (!m_freeNodes.empty())
+    {
+        index = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    }
+    else
+    {
+        index = m_nodes.size();
+        m_nodes.emplace_back();
+    }
+    auto& node = m_nodes[index];
+    node.prefix = prefix;
+    node.length = length;
+    node.children = {NO_NODE, NO_NODE};
+    node.values.clear();
+    return index;
+}
+
+template <typename T>
+void
+Ipv4PrefixTrie<T>::FreeNode(NodeIndex index)
+{
+    m_nodes[index].values.clear();
+    m_freeNodes.push_back(index);
+}
+
+template <typename T>
+void
+Ipv4PrefixTrie<T>::Insert(Ipv4Address network, Ipv4Mask mask, const T& value)
+{
+    NS_ASSERT_MSG(IsPrefixMask(mask), "Mask " << mask << " is not a prefix mask");
+    const uint8_t length = mask.GetPrefixLength();
+    const auto prefix = Truncate(network.Get(), length);
+    ++m_size;
+
+    // the prefix of the current node is a prefix of the inserted one
+    NodeIndex current = 0;
+    while (m_nodes[current].length < length)
+    {
+        const auto bit = GetBit(prefix, m_nodes[current].length);
+        const auto child = m_nodes[current].children[bit];
+        if (child == NO_NODE)
+        {
+            const auto leaf = NewNode(prefix, length);
+            m_nodes[leaf].values.push_back(value);
+            m_nodes[current].children[bit] = leaf;
+            return;
+        }
+
+        const auto childLength = m_nodes[child].length;
+        const uint8_t common = std::min<int>({std::countl_zero(m_nodes[child].prefix ^ prefix),
+                                              childLength,
+                                              length});
+        if (common == childLength)
+        {
+            current = child;
+            continue;
+        }
+
+        // the child has to be split: insert a node whose prefix is the common part of the
+        // prefix of the child and the inserted one
+        const auto split = NewNode(Truncate(prefix, common), common);
+        m_nodes[split].children[GetBit(m_nodes[child].prefix, common)] = child;
+        if (common == length)
+        {
+            m_nodes[split].values.push_back(value);
+        }
+        else
+        {
+            const auto leaf = NewNode(prefix, length);
+            m_nodes[leaf].values.push_back(value);
+            m_nodes[split].children[GetBit(prefix, common)] = leaf;
+        }
+        m_nodes[current].children[bit] = split;
+        return;
+    }
+    m_nodes[current].values.push_back(value);
+}
+
+template <typename T>
+bool
+Ipv4PrefixTrie<T>::Remove(Ipv4Address network, Ipv4Mask mask, const T& value)
+{
+    if (!IsPrefixMask(mask))
+    {
+        return false;
+    }
+    const uint8_t length = mask.GetPrefixLength();
+    const auto prefix = Truncate(network.Get(), length);
+
+    NodeIndex grandParent = NO_NODE;
+    NodeIndex parent = NO_NODE;
+    NodeIndex current = 0;
+    while (current != NO_NODE && m_nodes[current].length < length)
+    {
+        if (Truncate(prefix, m_nodes[current].length) != m_nodes[current].prefix)
+        {
+            return false;
+        }
+        grandParent = parent;
+        parent = current;
+        current = m_nodes[current].children[GetBit(prefix, m_nodes[current].length)];
+    }
+    if (current == NO_NODE || m_nodes[current].prefix != prefix ||
+        m_nodes[current].length != length)
+    {
+        return false;
+    }
+
+    auto& values = m_nodes[current].values;
+    auto it = std::find(values.begin(), values.end(), value);
+    if (it == values.end())
+    {
+        return false;
+    }
+    values.erase(it);
+    --m_size;
+
+    // remove the nodes that are no longer needed, so that every node other than the root has
+    // values or two children
+    if (current == 0 || !values.empty())
+    {
+        return true;
+    }
+    const auto& children = m_nodes[current].children;
+    if (children[0] != NO_NODE && children[1] != NO_NODE)
+    {
+        return true;
+    }
+    const auto replacement = (children[0] != NO_NODE ? children[0] : children[1]);
+    auto& parentChildren = m_nodes[parent].children;
+    parentChildren[parentChildren[0] == current ? 0 : 1] = replacement;
+    FreeNode(current);
+
+    if (replacement == NO_NODE && parent != 0 && m_nodes[parent].values.empty())
+    {
+        // the parent has a single child left
+        const auto sibling = (parentChildren[0] != NO_NODE ? parentChildren[0] : parentChildren[1]);
+        auto& grandParentChildren = m_nodes[grandParent].children;
+        grandParentChildren[grandParentChildren[0] == parent ? 0 : 1] = sibling;
+        FreeNode(parent);
+    }
+    return true;
+}
+
+template <typename T>
+typename Ipv4PrefixTrie<T>::NodeIndex
+Ipv4PrefixTrie<T>::FindNode(uint32_t prefix, uint8_t length) const
+{
+    NodeIndex current = 0;
+    while (current != NO_NODE)
+    {
+        const auto& node = m_nodes[current];
+        if (node.length >= length || Truncate(prefix, node.length) != node.prefix)
+        {
+            break;
+        }
+        current = node.children[GetBit(prefix, node.length)];
+    }
+    if (current == NO_NODE || m_nodes[current].prefix != prefix ||
+        m_nodes[current].length != length)
+    {
+        return NO_NODE;
+    }
+    return current;
+}
+
+template <typename T>
+const std::vector<T>*
+Ipv4PrefixTrie<T>::Find(Ipv4Address network, Ipv4Mask mask) const
+{
+    if (!IsPrefixMask(mask))
+    {
+        return nullptr;
+    }
+    const uint8_t length = mask.GetPrefixLength();
+    const auto index = FindNode(Truncate(network.Get(), length), length);
+    if (index == NO_NODE || m_nodes[index].values.empty())
+    {
+        return nullptr;
+    }
+    return &m_nodes[index].values;
+}
+
+template <typename T>
+template <typename F>
+bool
+Ipv4PrefixTrie<T>::ForEachMatch(Ipv4Address address, F&& f) const
+{
+    const auto addr = address.Get();
+
+    // collect the matching nodes from the shortest prefix to the longest one
+    std::array<NodeIndex, 33> matches;
+    std::size_t nMatches = 0;
+    NodeIndex current = 0;
+    while (current != NO_NODE)
+    {
+        const auto& node = m_nodes[current];
+        if (Truncate(addr, node.length) != node.prefix)
+        {
+            break;
+        }
+        if (!node.values.empty())
+        {
+            matches[nMatches++] = current;
+        }
+        if (node.length == 32)
+        {
+            break;
+        }
+        current = node.children[GetBit(addr, node.length)];
+    }
+
+    while (nMatches > 0)
+    {
+        const auto& node = m_nodes[matches[--nMatches]];
+        if (f(node.length, node.values))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+void
+Ipv4PrefixTrie<T>::Clear()
+{
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_size = 0;
+    NewNode(0, 0);
+}
+
+template <typename T>
+std::size_t
+Ipv4PrefixTrie<T>::GetSize() const
+{
+    return m_size;
+}
+
+} // namespace ns3
+
+#endif /* IPV4_PREFIX_TRIE_H */
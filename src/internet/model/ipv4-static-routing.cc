@@ -25,6 +25,7 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
 
 using std::make_pair;
@@ -67,8 +68,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -84,9 +84,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -141,7 +139,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AddRoute(route, 0);
 }
 
 uint32_t
@@ -213,19 +211,52 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    auto isEqual = [&route, metric](const auto& j) {
+        const Ipv4RoutingTableEntry* rtentry = j.first;
+        return rtentry->GetDest() == route.GetDest() &&
+               rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
+               rtentry->GetGateway() == route.GetGateway() &&
+               rtentry->GetInterface() == route.GetInterface() && j.second == metric;
+    };
+
+    if (!Ipv4PrefixTrie<NetworkRoutes::value_type>::IsPrefixMask(route.GetDestNetworkMask()))
     {
-        Ipv4RoutingTableEntry* rtentry = j->first;
+        return std::any_of(m_networkRoutes.cbegin(), m_networkRoutes.cend(), isEqual);
+    }
+    // identical routes have the same prefix
+    auto routes = m_networkRouteTrie.Find(route.GetDestNetwork(), route.GetDestNetworkMask());
+    return routes && std::any_of(routes->cbegin(), routes->cend(), isEqual);
+}
 
-        if (rtentry->GetDest() == route.GetDest() &&
-            rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
-            rtentry->GetGateway() == route.GetGateway() &&
-            rtentry->GetInterface() == route.GetInterface() && j->second == metric)
-        {
-            return true;
-        }
+void
+Ipv4StaticRouting::AddRoute(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    m_networkRoutes.emplace_back(route, metric);
+    if (Ipv4PrefixTrie<NetworkRoutes::value_type>::IsPrefixMask(route->GetDestNetworkMask()))
+    {
+        m_networkRouteTrie.Insert(route->GetDestNetwork(),
+                                  route->GetDestNetworkMask(),
+                                  m_networkRoutes.back());
+    }
+    else
+    {
+        NS_LOG_LOGIC("Mask " << route->GetDestNetworkMask()
+                             << " is not a prefix, the routing table will be scanned");
+        ++m_nNonPrefixRoutes;
     }
-    return false;
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::EraseRoute(NetworkRoutesI it)
+{
+    auto route = it->first;
+    if (!m_networkRouteTrie.Remove(route->GetDestNetwork(), route->GetDestNetworkMask(), *it))
+    {
+        NS_ASSERT(m_nNonPrefixRoutes > 0);
+        --m_nNonPrefixRoutes;
+    }
+    delete route;
+    return m_networkRoutes.erase(it);
 }
 
 Ptr<Ipv4Route>
@@ -250,55 +281,92 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
+    Ipv4RoutingTableEntry* route = nullptr;
+    if (m_nNonPrefixRoutes > 0)
     {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
-        Ipv4Mask mask = (j)->GetDestNetworkMask();
-        uint16_t masklen = mask.GetPrefixLength();
-        Ipv4Address entry = (j)->GetDestNetwork();
-        NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to " << entry
-                                               << "/" << masklen);
-        if (mask.IsMatch(dest, entry))
+        for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
         {
-            NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
-                                                       << ", metric " << metric);
-            if (oif)
+            Ipv4RoutingTableEntry* j = i->first;
+            uint32_t metric = i->second;
+            Ipv4Mask mask = (j)->GetDestNetworkMask();
+            uint16_t masklen = mask.GetPrefixLength();
+            Ipv4Address entry = (j)->GetDestNetwork();
+            NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to "
+                                                   << entry << "/" << masklen);
+            if (mask.IsMatch(dest, entry))
             {
-                if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
+                NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
+                                                           << ", metric " << metric);
+                if (oif)
                 {
-                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    if (oif != m_ipv4->GetNetDevice(j->GetInterface()))
+                    {
+                        NS_LOG_LOGIC("Not on requested interface, skipping");
+                        continue;
+                    }
+                }
+                if (masklen < longest_mask) // Not interested if got shorter mask
+                {
+                    NS_LOG_LOGIC("Previous match longer, skipping");
                     continue;
                 }
+                if (masklen > longest_mask) // Reset metric if longer masklen
+                {
+                    shortest_metric = 0xffffffff;
+                }
+                longest_mask = masklen;
+                if (metric > shortest_metric)
+                {
+                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
+                    continue;
+                }
+                shortest_metric = metric;
+                route = j;
+                if (masklen == 32)
+                {
+                    break;
+                }
             }
-            if (masklen < longest_mask) // Not interested if got shorter mask
-            {
-                NS_LOG_LOGIC("Previous match longer, skipping");
-                continue;
-            }
-            if (masklen > longest_mask) // Reset metric if longer masklen
-            {
-                shortest_metric = 0xffffffff;
-            }
-            longest_mask = masklen;
-            if (metric > shortest_metric)
-            {
-                NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
-                continue;
-            }
-            shortest_metric = metric;
-            Ipv4RoutingTableEntry* route = (j);
-            uint32_t interfaceIdx = route->GetInterface();
-            rtentry = Create<Ipv4Route>();
-            rtentry->SetDestination(route->GetDest());
-            rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
-            rtentry->SetGateway(route->GetGateway());
-            rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
-            if (masklen == 32)
+        }
+    }
+    else
+    {
+        // among the routes on the requested interface having the longest matching prefix,
+        // select the first route if the prefix is 32 bits long, and the last route with the
+        // lowest metric otherwise
+        m_networkRouteTrie.ForEachMatch(dest, [&](uint8_t masklen, const auto& routes) {
+            for (const auto& [j, metric] : routes)
             {
-                break;
+                NS_LOG_LOGIC("Found global network route " << j << ", mask length " << +masklen
+                                                           << ", metric " << metric);
+                if (oif && oif != m_ipv4->GetNetDevice(j->GetInterface()))
+                {
+                    NS_LOG_LOGIC("Not on requested interface, skipping");
+                    continue;
+                }
+                if (metric > shortest_metric)
+                {
+                    NS_LOG_LOGIC("Equal mask length, but previous metric shorter, skipping");
+                    continue;
+                }
+                shortest_metric = metric;
+                route = j;
+                if (masklen == 32)
+                {
+                    break;
+                }
             }
-        }
+            return route != nullptr;
+        });
+    }
+    if (route)
+    {
+        uint32_t interfaceIdx = route->GetInterface();
+        rtentry = Create<Ipv4Route>();
+        rtentry->SetDestination(route->GetDest());
+        rtentry->SetSource(m_ipv4->SourceAddressSelection(interfaceIdx, route->GetDest()));
+        rtentry->SetGateway(route->GetGateway());
+        rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
     }
     if (rtentry)
     {
@@ -446,8 +514,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete j->first;
-            m_networkRoutes.erase(j);
+            EraseRoute(j);
             return;
         }
         tmp++;
@@ -581,6 +648,8 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_networkRouteTrie.Clear();
+    m_nNonPrefixRoutes = 0;
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -620,8 +689,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseRoute(it);
         }
         else
         {
@@ -665,8 +733,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseRoute(it);
         }
         else
         {
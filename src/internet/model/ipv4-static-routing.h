@@ -11,6 +11,7 @@
 #define IPV4_STATIC_ROUTING_H
 
 #include "ipv4-header.h"
+#include "ipv4-prefix-trie.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
 
@@ -49,6 +50,11 @@ class Node;
  * Ipv4RoutingProtocol that defines the interface methods that a routing
  * protocol must support.
  *
+ * The unicast routes are also indexed by destination prefix in a radix trie
+ * (Ipv4PrefixTrie), so that the lookup time does not depend on the number of
+ * routes, unless a route whose mask is not made of contiguous leading ones
+ * has been added.
+ *
  * @see Ipv4RoutingProtocol
  * @see Ipv4ListRouting
  * @see Ipv4ListRouting::AddRoutingProtocol
@@ -378,6 +384,20 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     bool LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * @brief Add a route to the forwarding table.
+     * @param route route
+     * @param metric metric of route
+     */
+    void AddRoute(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove and delete a route from the forwarding table.
+     * @param it iterator to the route
+     * @return iterator to the route following the removed one
+     */
+    NetworkRoutesI EraseRoute(NetworkRoutesI it);
+
     /**
      * @brief Lookup in the forwarding table for destination.
      * @param dest destination address
@@ -400,6 +420,16 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the routes of the forwarding table for network, indexed by prefix.
+     */
+    Ipv4PrefixTrie<std::pair<Ipv4RoutingTableEntry*, uint32_t>> m_networkRouteTrie;
+
+    /**
+     * @brief the number of routes whose mask is not a prefix mask, hence not in the trie.
+     */
+    uint32_t m_nNonPrefixRoutes{0};
+
     /**
      * @brief the forwarding table for multicast.
      */
@@ -12,6 +12,9 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace ns3
 {
 
@@ -31,33 +34,101 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv6EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
+    m_ports.clear();
+    m_fourTuples.clear();
+    m_positions.clear();
+}
+
+std::size_t
+Ipv6EndPointDemux::FourTupleHash::operator()(const FourTuple& tuple) const
+{
+    Ipv6AddressHash addressHash;
+    std::size_t local = addressHash(tuple.localAddress) ^ tuple.localPort;
+    std::size_t peer = addressHash(tuple.peerAddress) ^ tuple.peerPort;
+    return local ^ (peer * 0x9e3779b97f4a7c15ULL);
+}
+
+Ipv6EndPoint*
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto all = m_endPoints.insert(m_endPoints.end(), endPoint);
+    auto& sameport = m_ports[endPoint->GetLocalPort()];
+    auto port = sameport.insert(sameport.end(), endPoint);
+    m_positions.emplace(endPoint, Position{all, port});
+    endPoint->m_demux = this;
+    AddToIndex(endPoint);
+    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
+    return endPoint;
+}
+
+void
+Ipv6EndPointDemux::AddToIndex(Ipv6EndPoint* endPoint)
+{
+    m_fourTuples[FourTuple{endPoint->GetLocalAddress(),
+                           endPoint->GetLocalPort(),
+                           endPoint->GetPeerAddress(),
+                           endPoint->GetPeerPort()}]
+        .push_back(endPoint);
+}
+
+void
+Ipv6EndPointDemux::RemoveFromIndex(Ipv6EndPoint* endPoint)
+{
+    auto it = m_fourTuples.find(FourTuple{endPoint->GetLocalAddress(),
+                                          endPoint->GetLocalPort(),
+                                          endPoint->GetPeerAddress(),
+                                          endPoint->GetPeerPort()});
+    NS_ASSERT_MSG(it != m_fourTuples.end(), "End point " << endPoint << " is not indexed");
+    auto& endPoints = it->second;
+    endPoints.erase(std::find(endPoints.begin(), endPoints.end(), endPoint));
+    if (endPoints.empty())
+    {
+        m_fourTuples.erase(it);
+    }
+}
+
+void
+Ipv6EndPointDemux::ChangeLocalPort(Ipv6EndPoint* endPoint, uint16_t port)
+{
+    NS_LOG_FUNCTION(this << endPoint << port);
+    RemoveFromIndex(endPoint);
+    auto& position = m_positions.at(endPoint);
+    auto oldport = m_ports.find(endPoint->GetLocalPort());
+    oldport->second.erase(position.port);
+    if (oldport->second.empty())
+    {
+        m_ports.erase(oldport);
+    }
+    endPoint->m_localPort = port;
+    auto& sameport = m_ports[port];
+    position.port = sameport.insert(sameport.end(), endPoint);
+    AddToIndex(endPoint);
 }
 
 bool
 Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_ports.contains(port);
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_ports.find(port);
+    if (it == m_ports.end())
+    {
+        return false;
+    }
+    for (auto i = it->second.begin(); i != it->second.end(); i++)
     {
-        if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
-            (*i)->GetBoundNetDevice() == boundNetDevice)
+        if ((*i)->GetLocalAddress() == addr && (*i)->GetBoundNetDevice() == boundNetDevice)
         {
             return true;
         }
@@ -76,9 +147,7 @@ Ipv6EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv6EndPoint*
@@ -92,9 +161,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv6EndPoint*
@@ -115,9 +182,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-    return endPoint;
+    return Insert(endPoint);
 }
 
 Ipv6EndPoint*
@@ -128,38 +193,43 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_fourTuples.find(FourTuple{localAddress, localPort, peerAddress, peerPort});
+    if (it != m_fourTuples.end())
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto i = it->second.begin(); i != it->second.end(); i++)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice())
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                return nullptr;
+            }
         }
     }
     auto endPoint = new Ipv6EndPoint(localAddress, localPort);
     endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
-
-    NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
-
-    return endPoint;
+    return Insert(endPoint);
 }
 
 void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto it = m_positions.find(endPoint);
+    if (it == m_positions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
     }
+    RemoveFromIndex(endPoint);
+    auto portIt = m_ports.find(endPoint->GetLocalPort());
+    portIt->second.erase(it->second.port);
+    if (portIt->second.empty())
+    {
+        m_ports.erase(portIt);
+    }
+    m_endPoints.erase(it->second.all);
+    m_positions.erase(it);
+    endPoint->m_demux = nullptr;
+    delete endPoint;
 }
 
 /*
@@ -182,9 +252,35 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
     EndPoints retval4; /* Exact match on all 4 */
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+
+    /* Only the end points whose local address is either the destination address or the
+       wildcard and whose peer is either the source or the wildcard may match: look them up
+       in the index */
+    std::vector<Ipv6Address> localAddresses{daddr};
+    if (daddr != Ipv6Address::GetAny())
+    {
+        localAddresses.push_back(Ipv6Address::GetAny());
+    }
+    std::vector<std::pair<Ipv6Address, uint16_t>> peers{{saddr, sport}};
+    if (saddr != Ipv6Address::GetAny() || sport != 0)
+    {
+        peers.emplace_back(Ipv6Address::GetAny(), 0);
+    }
+    std::vector<Ipv6EndPoint*> candidates;
+    for (const auto& localAddress : localAddresses)
+    {
+        for (const auto& [peerAddress, peerPort] : peers)
+        {
+            auto it = m_fourTuples.find(FourTuple{localAddress, dport, peerAddress, peerPort});
+            if (it != m_fourTuples.end())
+            {
+                candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+
+    for (Ipv6EndPoint* endP : candidates)
     {
-        Ipv6EndPoint* endP = *i;
 
         NS_LOG_DEBUG("Looking at endpoint dport="
                      << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
@@ -299,18 +395,26 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 Ipv6EndPoint*
 Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+    /* an exact match is unique unless several end points only differ by their bound device */
+    auto exact = m_fourTuples.find(FourTuple{dst, dport, src, sport});
+    if (exact != m_fourTuples.end() && exact->second.size() == 1)
+    {
+        return exact->second.front();
+    }
+
+    auto sameport = m_ports.find(dport);
+    if (sameport == m_ports.end())
+    {
+        return nullptr;
+    }
+
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
 
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    for (auto i = sameport->second.begin(); i != sameport->second.end(); i++)
     {
         uint32_t tmp = 0;
 
-        if ((*i)->GetLocalPort() != dport)
-        {
-            continue;
-        }
-
         if ((*i)->GetLocalAddress() == dst && (*i)->GetPeerPort() == sport &&
             (*i)->GetPeerAddress() == src)
         {
@@ -15,6 +15,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -25,6 +27,11 @@ class Ipv6EndPoint;
  * @ingroup ipv6
  *
  * @brief Demultiplexer for end points.
+ *
+ * The end points are indexed by local port and by four-tuple, so that a lookup
+ * only examines the end points that may match the looked up four-tuple rather
+ * than all the end points.  The end points notify the demux when their local
+ * address, local port or peer change, so that the index is kept up to date.
  */
 class Ipv6EndPointDemux
 {
@@ -150,6 +157,74 @@ class Ipv6EndPointDemux
     EndPoints GetEndPoints() const;
 
   private:
+    friend class Ipv6EndPoint;
+
+    /**
+     * @brief The local address, local port, peer address and peer port of an end point.
+     */
+    struct FourTuple
+    {
+        Ipv6Address localAddress; //!< local address
+        uint16_t localPort;       //!< local port
+        Ipv6Address peerAddress;  //!< peer address
+        uint16_t peerPort;        //!< peer port
+
+        /**
+         * @param other the four-tuple to compare to
+         * @return true if the four-tuples are equal
+         */
+        bool operator==(const FourTuple& other) const = default;
+    };
+
+    /**
+     * @brief Hash function for the four-tuples.
+     */
+    struct FourTupleHash
+    {
+        /**
+         * @param tuple the four-tuple
+         * @return the hash of the four-tuple
+         */
+        std::size_t operator()(const FourTuple& tuple) const;
+    };
+
+    /**
+     * @brief The position of an end point in the containers.
+     */
+    struct Position
+    {
+        EndPointsI all;  //!< position in the list of all the end points
+        EndPointsI port; //!< position in the list of the end points with the same local port
+    };
+
+    /**
+     * @brief Insert a newly allocated end point into the demux.
+     * @param endPoint the end point
+     * @return the end point
+     */
+    Ipv6EndPoint* Insert(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Add an end point to the four-tuple index.
+     * @param endPoint the end point
+     */
+    void AddToIndex(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Remove an end point from the four-tuple index. This is called by the end point
+     * before changing its local address or its peer.
+     * @param endPoint the end point
+     */
+    void RemoveFromIndex(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Change the local port of an end point, which is moved to the end of the list of
+     * the end points with the new local port.
+     * @param endPoint the end point
+     * @param port the new local port
+     */
+    void ChangeLocalPort(Ipv6EndPoint* endPoint, uint16_t port);
+
     /**
      * @brief Allocate a ephemeral port.
      * @return a port
@@ -175,6 +250,21 @@ class Ipv6EndPointDemux
      * @brief A list of IPv6 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief The end points with each local port, in allocation order.
+     */
+    std::unordered_map<uint16_t, EndPoints> m_ports;
+
+    /**
+     * @brief The end points with each four-tuple.
+     */
+    std::unordered_map<FourTuple, std::vector<Ipv6EndPoint*>, FourTupleHash> m_fourTuples;
+
+    /**
+     * @brief The position of each end point in the containers.
+     */
+    std::unordered_map<Ipv6EndPoint*, Position> m_positions;
 };
 
 } /* namespace ns3 */
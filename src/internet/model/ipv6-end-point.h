@@ -22,6 +22,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv6EndPointDemux;
 class Packet;
 
 /**
@@ -184,6 +185,8 @@ class Ipv6EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv6EndPointDemux;
+
     /**
      * @brief The local address.
      */
@@ -228,6 +231,12 @@ class Ipv6EndPoint
      * @brief true if the endpoint can receive packets.
      */
     bool m_rxEnabled;
+
+    /**
+     * @brief The demux the endpoint has been allocated by (if any), which is notified when
+     * the local address, the local port or the peer change.
+     */
+    Ipv6EndPointDemux* m_demux;
 };
 
 } /* namespace ns3 */
@@ -24,6 +24,7 @@
 
 #include "ns3/boolean.h"
 #include "ns3/callback.h"
+#include "ns3/gso-tag.h"
 #include "ns3/log.h"
 #include "ns3/mac16-address.h"
 #include "ns3/mac64-address.h"
@@ -1210,7 +1211,13 @@ Ipv6L3Protocol::SendRealOut(Ptr<Ipv6Route> route, Ptr<Packet> packet, const Ipv6
         targetMtu = dev->GetMtu();
     }
 
-    if (packet->GetSize() + ipHeader.GetSerializedSize() > targetMtu)
+    uint32_t size = packet->GetSize();
+    if (GsoTag gso; packet->PeekPacketTag(gso))
+    {
+        // super-segments are segmented by the device, only their segments must fit the MTU
+        size = gso.GetLargestSegmentSize(size);
+    }
+    if (size + ipHeader.GetSerializedSize() > targetMtu)
     {
         // Router => drop
         if (!fromMe)
@@ -17,6 +17,8 @@
 #include "ns3/node.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -90,9 +92,9 @@ NdiscCache::Lookup(Ipv6Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
 
-    if (m_ndCache.find(dst) != m_ndCache.end())
+    if (!m_slots.empty() && m_slots[FindSlot(dst)] != NONE)
     {
-        NdiscCache::Entry* entry = m_ndCache[dst];
+        NdiscCache::Entry* entry = m_entries[m_slots[FindSlot(dst)]];
         NS_LOG_LOGIC("Found an entry: " << *entry);
 
         return entry;
@@ -107,14 +109,23 @@ NdiscCache::LookupInverse(Address dst)
     NS_LOG_FUNCTION(this << dst);
 
     std::list<NdiscCache::Entry*> entryList;
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    if (dst.IsInvalid())
     {
-        NdiscCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == dst)
+        // entries whose MAC address is invalid are not indexed
+        for (auto entry : m_entries)
         {
-            NS_LOG_LOGIC("Found an entry:" << (*entry));
-            entryList.push_back(entry);
+            if (entry->GetMacAddress() == dst)
+            {
+                NS_LOG_LOGIC("Found an entry:" << (*entry));
+                entryList.push_back(entry);
+            }
         }
+        return entryList;
+    }
+    auto it = m_macIndex.find(dst);
+    if (it != m_macIndex.end())
+    {
+        entryList.assign(it->second.begin(), it->second.end());
     }
     return entryList;
 }
@@ -123,11 +134,18 @@ NdiscCache::Entry*
 NdiscCache::Add(Ipv6Address to)
 {
     NS_LOG_FUNCTION(this << to);
-    NS_ASSERT(m_ndCache.find(to) == m_ndCache.end());
+    NS_ASSERT(m_slots.empty() || m_slots[FindSlot(to)] == NONE);
+
+    // keep the load factor of the hash table below 1/2
+    if (2 * (m_entries.size() + 1) > m_slots.size())
+    {
+        Rehash(std::max<std::size_t>(2 * m_slots.size(), 16));
+    }
 
     auto entry = new NdiscCache::Entry(this);
     entry->SetIpv6Address(to);
-    m_ndCache[to] = entry;
+    m_slots[FindSlot(to)] = m_entries.size();
+    m_entries.push_back(entry);
     return entry;
 }
 
@@ -136,14 +154,12 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    if (!m_slots.empty())
     {
-        if ((*i).second == entry)
+        auto slot = FindSlot(entry->GetIpv6Address());
+        if (m_slots[slot] != NONE && m_entries[m_slots[slot]] == entry)
         {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
-            return;
+            DeleteEntry(slot);
         }
     }
 }
@@ -153,12 +169,171 @@ NdiscCache::Flush()
 {
     NS_LOG_FUNCTION(this);
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // the NUD event is pending only if some NUD timers are running
+    if (!m_nudTimers.empty())
     {
-        delete (*i).second; /* delete the pointer NdiscCache::Entry */
+        m_nudEvent.Cancel();
+        m_nudTimers.clear();
     }
 
-    m_ndCache.erase(m_ndCache.begin(), m_ndCache.end());
+    for (auto entry : m_entries)
+    {
+        delete entry; /* delete the pointer NdiscCache::Entry */
+    }
+
+    m_entries.clear();
+    m_slots.clear();
+    m_macIndex.clear();
+}
+
+std::size_t
+NdiscCache::FindSlot(Ipv6Address to) const
+{
+    auto mask = m_slots.size() - 1;
+    auto slot = Ipv6AddressHash()(to) & mask;
+    while (m_slots[slot] != NONE && m_entries[m_slots[slot]]->GetIpv6Address() != to)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void
+NdiscCache::Rehash(std::size_t nSlots)
+{
+    NS_LOG_FUNCTION(this << nSlots);
+    m_slots.assign(nSlots, NONE);
+    for (uint32_t i = 0; i < m_entries.size(); i++)
+    {
+        m_slots[FindSlot(m_entries[i]->GetIpv6Address())] = i;
+    }
+}
+
+void
+NdiscCache::EraseSlot(std::size_t slot)
+{
+    auto index = m_slots[slot];
+    auto mask = m_slots.size() - 1;
+
+    // backward shift deletion: move back the following indices that cannot be found anymore
+    // once the slot is emptied
+    m_slots[slot] = NONE;
+    for (auto next = (slot + 1) & mask; m_slots[next] != NONE; next = (next + 1) & mask)
+    {
+        auto home = Ipv6AddressHash()(m_entries[m_slots[next]]->GetIpv6Address()) & mask;
+        bool reachable = (slot < next) ? (slot < home && home <= next)
+                                       : (slot < home || home <= next);
+        if (!reachable)
+        {
+            m_slots[slot] = m_slots[next];
+            m_slots[next] = NONE;
+            slot = next;
+        }
+    }
+
+    // move the last entry to the position of the removed one
+    if (index != m_entries.size() - 1)
+    {
+        m_slots[FindSlot(m_entries.back()->GetIpv6Address())] = index;
+        m_entries[index] = m_entries.back();
+    }
+    m_entries.pop_back();
+}
+
+void
+NdiscCache::AddToMacIndex(NdiscCache::Entry* entry)
+{
+    if (!entry->GetMacAddress().IsInvalid())
+    {
+        m_macIndex[entry->GetMacAddress()].push_back(entry);
+    }
+}
+
+void
+NdiscCache::RemoveFromMacIndex(NdiscCache::Entry* entry)
+{
+    if (entry->GetMacAddress().IsInvalid())
+    {
+        return;
+    }
+    auto it = m_macIndex.find(entry->GetMacAddress());
+    NS_ASSERT_MSG(it != m_macIndex.end(), "Entry " << *entry << " is not indexed");
+    auto& entries = it->second;
+    entries.erase(std::find(entries.begin(), entries.end(), entry));
+    if (entries.empty())
+    {
+        m_macIndex.erase(it);
+    }
+}
+
+void
+NdiscCache::DeleteEntry(std::size_t slot)
+{
+    auto entry = m_entries[m_slots[slot]];
+    NS_LOG_FUNCTION(this << entry);
+    EraseSlot(slot);
+    RemoveFromMacIndex(entry);
+    RemoveNudTimer(entry);
+    ScheduleNudEvent();
+    entry->ClearWaitingPacket();
+    delete entry;
+}
+
+void
+NdiscCache::AddNudTimer(NdiscCache::Entry* entry)
+{
+    entry->m_nudTimer = m_nudTimers.emplace(entry->m_nudExpiration, entry);
+    entry->m_nudRunning = true;
+}
+
+void
+NdiscCache::RemoveNudTimer(NdiscCache::Entry* entry)
+{
+    if (entry->m_nudRunning)
+    {
+        m_nudTimers.erase(entry->m_nudTimer);
+        entry->m_nudRunning = false;
+    }
+}
+
+void
+NdiscCache::ScheduleNudEvent()
+{
+    if (m_nudTimers.empty())
+    {
+        m_nudEvent.Cancel();
+        return;
+    }
+    auto expiration = m_nudTimers.begin()->first;
+    if (!m_nudEvent.IsPending() || expiration < TimeStep(m_nudEvent.GetTs()))
+    {
+        m_nudEvent.Cancel();
+        m_nudEvent = Simulator::Schedule(expiration - Simulator::Now(),
+                                         &NdiscCache::HandleNudTimers,
+                                         this);
+    }
+}
+
+void
+NdiscCache::HandleNudTimers()
+{
+    NS_LOG_FUNCTION(this);
+    auto now = Simulator::Now();
+    while (!m_nudTimers.empty() && m_nudTimers.begin()->first <= now)
+    {
+        auto entry = m_nudTimers.begin()->second;
+        m_nudTimers.erase(m_nudTimers.begin());
+        entry->m_nudRunning = false;
+        if (entry->m_nudExpiration > now)
+        {
+            // the timer has been postponed after it was added
+            AddNudTimer(entry);
+            continue;
+        }
+        // the function can restart the timer or remove the entry
+        (entry->*entry->m_nudFunction)();
+    }
+    ScheduleNudEvent();
 }
 
 void
@@ -181,9 +356,14 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // print the entries in the order of their IPv6 address
+    std::vector<NdiscCache::Entry*> entries(m_entries);
+    std::sort(entries.begin(), entries.end(), [](NdiscCache::Entry* a, NdiscCache::Entry* b) {
+        return a->GetIpv6Address() < b->GetIpv6Address();
+    });
+    for (auto entry : entries)
     {
-        *os << i->first << " dev ";
+        *os << entry->GetIpv6Address() << " dev ";
         std::string found = Names::FindName(m_device);
         if (!Names::FindName(m_device).empty())
         {
@@ -194,33 +374,33 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
             *os << static_cast<int>(m_device->GetIfIndex());
         }
 
-        *os << " lladdr " << i->second->GetMacAddress();
+        *os << " lladdr " << entry->GetMacAddress();
 
-        if (i->second->IsReachable())
+        if (entry->IsReachable())
         {
             *os << " REACHABLE\n";
         }
-        else if (i->second->IsDelay())
+        else if (entry->IsDelay())
         {
             *os << " DELAY\n";
         }
-        else if (i->second->IsIncomplete())
+        else if (entry->IsIncomplete())
         {
             *os << " INCOMPLETE\n";
         }
-        else if (i->second->IsProbe())
+        else if (entry->IsProbe())
         {
             *os << " PROBE\n";
         }
-        else if (i->second->IsStale())
+        else if (entry->IsStale())
         {
             *os << " STALE\n";
         }
-        else if (i->second->IsPermanent())
+        else if (entry->IsPermanent())
         {
             *os << " PERMANENT\n";
         }
-        else if (i->second->IsAutoGenerated())
+        else if (entry->IsAutoGenerated())
         {
             *os << " STATIC_AUTOGENERATED\n";
         }
@@ -236,7 +416,8 @@ NdiscCache::Entry::Entry(NdiscCache* nd)
     : m_ndCache(nd),
       m_waiting(),
       m_router(false),
-      m_nudTimer(Timer::CANCEL_ON_DESTROY),
+      m_nudFunction(nullptr),
+      m_nudRunning(false),
       m_lastReachabilityConfirmation(),
       m_nsRetransmit(0)
 {
@@ -454,19 +635,26 @@ NdiscCache::Entry::GetLastReachabilityConfirmation() const
     return m_lastReachabilityConfirmation;
 }
 
+void
+NdiscCache::Entry::StartNudTimer(NudFunction function, Time delay)
+{
+    NS_LOG_FUNCTION(this << delay);
+    m_ndCache->RemoveNudTimer(this);
+
+    m_nudFunction = function;
+    m_nudDelay = delay;
+    m_nudExpiration = Simulator::Now() + delay;
+    m_ndCache->AddNudTimer(this);
+    m_ndCache->ScheduleNudEvent();
+}
+
 void
 NdiscCache::Entry::StartReachableTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
     m_lastReachabilityConfirmation = Simulator::Now();
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionReachableTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetReachableTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionReachableTimeout,
+                  m_ndCache->m_icmpv6->GetReachableTime());
 }
 
 void
@@ -477,11 +665,15 @@ NdiscCache::Entry::UpdateReachableTimer()
     if (m_state == REACHABLE)
     {
         m_lastReachabilityConfirmation = Simulator::Now();
-        if (m_nudTimer.IsRunning())
+        if (m_nudRunning && Simulator::Now() + m_nudDelay >= m_nudTimer->first)
         {
-            m_nudTimer.Cancel();
+            // postpone the timer without moving it, which is done only when it expires
+            m_nudExpiration = Simulator::Now() + m_nudDelay;
+        }
+        else if (m_nudFunction != nullptr)
+        {
+            StartNudTimer(m_nudFunction, m_nudDelay);
         }
-        m_nudTimer.Schedule();
     }
 }
 
@@ -489,49 +681,32 @@ void
 NdiscCache::Entry::StartProbeTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionProbeTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionProbeTimeout,
+                  m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StartDelayTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionDelayTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetDelayFirstProbe());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionDelayTimeout,
+                  m_ndCache->m_icmpv6->GetDelayFirstProbe());
 }
 
 void
 NdiscCache::Entry::StartRetransmitTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionRetransmitTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    StartNudTimer(&NdiscCache::Entry::FunctionRetransmitTimeout,
+                  m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StopNudTimer()
 {
     NS_LOG_FUNCTION(this);
-    m_nudTimer.Cancel();
+    m_ndCache->RemoveNudTimer(this);
+    m_ndCache->ScheduleNudEvent();
     m_nsRetransmit = 0;
 }
 
@@ -552,7 +727,7 @@ NdiscCache::Entry::MarkReachable(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = REACHABLE;
-    m_macAddress = mac;
+    SetMacAddress(mac);
     return m_waiting;
 }
 
@@ -582,7 +757,7 @@ NdiscCache::Entry::MarkStale(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = STALE;
-    m_macAddress = mac;
+    SetMacAddress(mac);
     return m_waiting;
 }
 
@@ -669,7 +844,9 @@ void
 NdiscCache::Entry::SetMacAddress(Address mac)
 {
     NS_LOG_FUNCTION(this << mac << int(m_state));
+    m_ndCache->RemoveFromMacIndex(this);
     m_macAddress = mac;
+    m_ndCache->AddToMacIndex(this);
 }
 
 void
@@ -706,13 +883,13 @@ void
 NdiscCache::RemoveAutoGeneratedEntries()
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end();)
+    std::size_t i = 0;
+    while (i < m_entries.size())
     {
-        if (i->second->IsAutoGenerated())
+        if (m_entries[i]->IsAutoGenerated())
         {
-            i->second->ClearWaitingPacket();
-            delete i->second;
-            m_ndCache.erase(i++);
+            // the last entry is moved to position i
+            DeleteEntry(FindSlot(m_entries[i]->GetIpv6Address()));
             continue;
         }
         i++;
@@ -15,11 +15,13 @@
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
-#include "ns3/timer.h"
+#include "ns3/simulator.h"
 
+#include <limits>
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -33,6 +35,11 @@ class Icmpv6L4Protocol;
  * @ingroup ipv6
  *
  * @brief IPv6 Neighbor Discovery cache.
+ *
+ * The entries are stored in an open addressing hash table with linear probing,
+ * keyed by IPv6 address, and are also indexed by MAC address. The Neighbor
+ * Unreachability Detection (NUD) timers of all the entries are handled by a
+ * single event per cache, which is scheduled at the earliest expiration time.
  */
 class NdiscCache : public Object
 {
@@ -86,7 +93,7 @@ class NdiscCache : public Object
     /**
      * @brief Lookup in the cache for a MAC address.
      * @param dst destination MAC address.
-     * @return a list of matching entries.
+     * @return a list of matching entries (in no particular order).
      */
     std::list<NdiscCache::Entry*> LookupInverse(Address dst);
 
@@ -371,6 +378,9 @@ class NdiscCache : public Object
 
         /**
          * @brief Set the IPv6 address.
+         *
+         * The IPv6 address is the key of the entry in the cache, hence it is set when the
+         * entry is added to the cache and must not be changed afterwards.
          * @param ipv6Address IPv6 address
          */
         void SetIpv6Address(Ipv6Address ipv6Address);
@@ -401,6 +411,18 @@ class NdiscCache : public Object
         NdiscCache* m_ndCache;
 
       private:
+        friend class NdiscCache;
+
+        /// Pointer to the function called when the NUD timer expires
+        using NudFunction = void (Entry::*)();
+
+        /**
+         * @brief Start the NUD timer.
+         * @param function the function called when the timer expires
+         * @param delay the delay after which the timer expires
+         */
+        void StartNudTimer(NudFunction function, Time delay);
+
         /**
          * @brief The IPv6 address.
          */
@@ -422,9 +444,32 @@ class NdiscCache : public Object
         bool m_router;
 
         /**
-         * @brief Timer (used for NUD).
+         * @brief Function called when the NUD timer expires.
+         */
+        NudFunction m_nudFunction;
+
+        /**
+         * @brief Delay of the NUD timer.
+         */
+        Time m_nudDelay;
+
+        /**
+         * @brief Expiration time of the NUD timer, if running.
+         *
+         * It can be later than the key of the NUD timer in the cache, in which case the timer
+         * is rescheduled when that key expires.
+         */
+        Time m_nudExpiration;
+
+        /**
+         * @brief Whether the NUD timer is running.
+         */
+        bool m_nudRunning;
+
+        /**
+         * @brief The NUD timer of this entry in the cache, if running.
          */
-        Timer m_nudTimer;
+        std::multimap<Time, Entry*>::iterator m_nudTimer;
 
         /**
          * @brief Last time we see a reachability confirmation.
@@ -443,21 +488,95 @@ class NdiscCache : public Object
      */
     void DoDispose() override;
 
+  private:
     /**
-     * @brief Neighbor Discovery Cache container
+     * @param to an IPv6 address
+     * @return the index of the slot of the hash table storing the index of the entry of the
+     *         given address, if present, or of the empty slot where it would be stored otherwise
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
+    std::size_t FindSlot(Ipv6Address to) const;
+
     /**
-     * @brief Neighbor Discovery Cache container iterator
+     * @brief Remove an entry from the hash table and from the entries (but do not delete it).
+     * @param slot the slot of the hash table storing the index of the entry
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    void EraseSlot(std::size_t slot);
 
     /**
-     * @brief A list of Entry.
+     * @brief Resize the hash table and store again the indices of all the entries.
+     * @param nSlots the number of slots (a power of two)
      */
-    Cache m_ndCache;
+    void Rehash(std::size_t nSlots);
+
+    /**
+     * @brief Add an entry to the MAC address index.
+     * @param entry the entry
+     */
+    void AddToMacIndex(NdiscCache::Entry* entry);
+
+    /**
+     * @brief Remove an entry from the MAC address index.
+     * @param entry the entry
+     */
+    void RemoveFromMacIndex(NdiscCache::Entry* entry);
+
+    /**
+     * @brief Remove an entry from all the containers and delete it.
+     * @param slot the slot of the hash table storing the index of the entry
+     */
+    void DeleteEntry(std::size_t slot);
+
+    /**
+     * @brief Add the NUD timer of an entry, expiring at its NUD expiration time.
+     * @param entry the entry
+     */
+    void AddNudTimer(NdiscCache::Entry* entry);
+
+    /**
+     * @brief Remove the NUD timer of an entry, if running.
+     * @param entry the entry
+     */
+    void RemoveNudTimer(NdiscCache::Entry* entry);
+
+    /**
+     * @brief Make sure that the NUD event is scheduled at the earliest expiration time of the
+     * NUD timers, if any.
+     */
+    void ScheduleNudEvent();
+
+    /**
+     * @brief Handle the NUD timers that expired.
+     */
+    void HandleNudTimers();
+
+    /// Value used to indicate an empty slot of the hash table
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief The entries.
+     */
+    std::vector<NdiscCache::Entry*> m_entries;
+
+    /**
+     * @brief Hash table (with linear probing) of the indices of the entries.
+     */
+    std::vector<uint32_t> m_slots;
+
+    /**
+     * @brief The entries with each (valid) MAC address.
+     */
+    std::map<Address, std::vector<NdiscCache::Entry*>> m_macIndex;
+
+    /**
+     * @brief The running NUD timers, by expiration time.
+     */
+    std::multimap<Time, NdiscCache::Entry*> m_nudTimers;
+
+    /**
+     * @brief The event handling the NUD timers that expire first.
+     */
+    EventId m_nudEvent;
 
-  private:
     /**
      * @brief The NetDevice.
      */
@@ -8,12 +8,18 @@
 
 #include "tcp-header.h"
 
+#include "tcp-option-rfc793.h"
+#include "tcp-option-sack-permitted.h"
+#include "tcp-option-sack.h"
+#include "tcp-option-ts.h"
+#include "tcp-option-winscale.h"
 #include "tcp-option.h"
 
 #include "ns3/address-utils.h"
 #include "ns3/buffer.h"
 #include "ns3/log.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 
@@ -256,10 +262,10 @@ TcpHeader::Print(std::ostream& os) const
 
     os << " Seq=" << m_sequenceNumber << " Ack=" << m_ackNumber << " Win=" << m_windowSize;
 
-    for (auto op = m_options.begin(); op != m_options.end(); ++op)
+    for (const auto& op : GetOptionList())
     {
-        os << " " << (*op)->GetInstanceTypeId().GetName() << "(";
-        (*op)->Print(os);
+        os << " " << op->GetInstanceTypeId().GetName() << "(";
+        op->Print(os);
         os << ")";
     }
 }
@@ -287,12 +293,47 @@ TcpHeader::Serialize(Buffer::Iterator start) const
     // This implementation does not presently try to align options on word
     // boundaries using NOP options
     uint32_t optionLen = 0;
+    uint16_t seen = 0;
+    auto op = m_options.begin();
 
-    for (auto op = m_options.begin(); op != m_options.end(); ++op)
+    for (uint8_t n = 0; n < m_numOptions; ++n)
     {
-        optionLen += (*op)->GetSerializedSize();
-        (*op)->Serialize(i);
-        i.Next((*op)->GetSerializedSize());
+        uint8_t kind = m_optionKinds[n];
+        if (!IsInlineSlot(kind, seen))
+        {
+            optionLen += (*op)->GetSerializedSize();
+            (*op)->Serialize(i);
+            i.Next((*op)->GetSerializedSize());
+            ++op;
+            continue;
+        }
+
+        uint8_t size = GetInlineOptionSize(kind);
+        optionLen += size;
+        i.WriteU8(kind);
+        i.WriteU8(size);
+        switch (kind)
+        {
+        case TcpOption::MSS:
+            i.WriteHtonU16(m_mss);
+            break;
+        case TcpOption::WINSCALE:
+            i.WriteU8(m_winScale);
+            break;
+        case TcpOption::SACK:
+            for (uint8_t b = 0; b < m_numSackBlocks; ++b)
+            {
+                i.WriteHtonU32(m_sackBlocks[b].first.GetValue());
+                i.WriteHtonU32(m_sackBlocks[b].second.GetValue());
+            }
+            break;
+        case TcpOption::TS:
+            i.WriteHtonU32(m_tsValue);
+            i.WriteHtonU32(m_tsEcho);
+            break;
+        default:
+            break;
+        }
     }
 
     // padding to word alignment; add ENDs and/or pad values (they are the same)
@@ -333,6 +374,10 @@ TcpHeader::Deserialize(Buffer::Iterator start)
 
     // Deserialize options if they exist
     m_options.clear();
+    m_numOptions = 0;
+    m_inlineKinds = 0;
+    m_optionsSize = 0;
+    m_numSackBlocks = 0;
     uint32_t optionLen = (m_length - 5) * 4;
     if (optionLen > m_maxOptionsLen)
     {
@@ -342,6 +387,15 @@ TcpHeader::Deserialize(Buffer::Iterator start)
     while (optionLen)
     {
         uint8_t kind = i.PeekU8();
+        if (IsInlineKind(kind))
+        {
+            if (uint32_t size = DeserializeInlineOption(i, optionLen); size > 0)
+            {
+                optionLen -= size;
+                i.Next(size);
+                continue;
+            }
+        }
         Ptr<TcpOption> op;
         uint32_t optionSize;
         if (TcpOption::IsKindKnown(kind))
@@ -364,6 +418,7 @@ TcpHeader::Deserialize(Buffer::Iterator start)
             optionLen -= optionSize;
             i.Next(optionSize);
             m_options.emplace_back(op);
+            AddOptionKind(op->GetKind(), optionSize);
             m_optionsLen += optionSize;
         }
         else
@@ -403,12 +458,8 @@ TcpHeader::Deserialize(Buffer::Iterator start)
 uint8_t
 TcpHeader::CalculateHeaderLength() const
 {
-    uint32_t len = 20;
+    uint32_t len = 20 + m_optionsSize;
 
-    for (auto i = m_options.begin(); i != m_options.end(); ++i)
-    {
-        len += (*i)->GetSerializedSize();
-    }
     // Option list may not include padding; need to pad up to word boundary
     if (len % 4)
     {
@@ -430,11 +481,15 @@ TcpHeader::AppendOption(Ptr<const TcpOption> option)
 
         if (option->GetKind() != TcpOption::END)
         {
-            m_options.push_back(option);
-            m_optionsLen += option->GetSerializedSize();
+            if (!IsInlineKind(option->GetKind()) || !CopyInlineOption(option))
+            {
+                m_options.push_back(option);
+                AddOptionKind(option->GetKind(), option->GetSerializedSize());
+                m_optionsLen += option->GetSerializedSize();
 
-            uint32_t totalLen = 20 + 3 + m_optionsLen;
-            m_length = totalLen >> 2;
+                uint32_t totalLen = 20 + 3 + m_optionsLen;
+                m_length = totalLen >> 2;
+            }
         }
 
         return true;
@@ -443,20 +498,367 @@ TcpHeader::AppendOption(Ptr<const TcpOption> option)
     return false;
 }
 
+bool
+TcpHeader::AppendOptionMss(uint16_t mss)
+{
+    if (!AppendInlineOption(TcpOption::MSS, 4))
+    {
+        return false;
+    }
+    m_mss = mss;
+    return true;
+}
+
+bool
+TcpHeader::AppendOptionWinScale(uint8_t scale)
+{
+    if (!AppendInlineOption(TcpOption::WINSCALE, 3))
+    {
+        return false;
+    }
+    m_winScale = scale;
+    return true;
+}
+
+bool
+TcpHeader::AppendOptionSackPermitted()
+{
+    return AppendInlineOption(TcpOption::SACKPERMITTED, 2);
+}
+
+bool
+TcpHeader::AppendOptionSack(const TcpOptionSack::SackList& list)
+{
+    uint8_t optionLenAvail = m_maxOptionsLen - m_optionsLen;
+    if (optionLenAvail < 10)
+    {
+        return false;
+    }
+    auto numBlocks = std::min<std::size_t>({list.size(),
+                                            (optionLenAvail - 2) / 8u,
+                                            static_cast<std::size_t>(m_maxSackBlocks)});
+    if (numBlocks == 0 ||
+        !AppendInlineOption(TcpOption::SACK, static_cast<uint8_t>(2 + numBlocks * 8)))
+    {
+        return false;
+    }
+    m_numSackBlocks = static_cast<uint8_t>(numBlocks);
+    std::copy_n(list.begin(), numBlocks, m_sackBlocks.begin());
+    return true;
+}
+
+bool
+TcpHeader::AppendOptionTs(uint32_t timestamp, uint32_t echo)
+{
+    if (!AppendInlineOption(TcpOption::TS, 10))
+    {
+        return false;
+    }
+    m_tsValue = timestamp;
+    m_tsEcho = echo;
+    return true;
+}
+
+uint16_t
+TcpHeader::GetOptionMss() const
+{
+    NS_ASSERT_MSG(HasInlineOption(TcpOption::MSS), "No MSS option in the header");
+    return m_mss;
+}
+
+uint8_t
+TcpHeader::GetOptionWinScale() const
+{
+    NS_ASSERT_MSG(HasInlineOption(TcpOption::WINSCALE), "No Window Scale option in the header");
+    return m_winScale;
+}
+
+std::span<const TcpOptionSack::SackBlock>
+TcpHeader::GetOptionSackBlocks() const
+{
+    return {m_sackBlocks.data(), m_numSackBlocks};
+}
+
+uint32_t
+TcpHeader::GetOptionTsValue() const
+{
+    NS_ASSERT_MSG(HasInlineOption(TcpOption::TS), "No Timestamp option in the header");
+    return m_tsValue;
+}
+
+uint32_t
+TcpHeader::GetOptionTsEcho() const
+{
+    NS_ASSERT_MSG(HasInlineOption(TcpOption::TS), "No Timestamp option in the header");
+    return m_tsEcho;
+}
+
+bool
+TcpHeader::IsInlineKind(uint8_t kind)
+{
+    switch (kind)
+    {
+    case TcpOption::MSS:
+    case TcpOption::WINSCALE:
+    case TcpOption::SACKPERMITTED:
+    case TcpOption::SACK:
+    case TcpOption::TS:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool
+TcpHeader::HasInlineOption(uint8_t kind) const
+{
+    return IsInlineKind(kind) && (m_inlineKinds & (1 << kind));
+}
+
+bool
+TcpHeader::IsInlineSlot(uint8_t kind, uint16_t& seen) const
+{
+    if (!IsInlineKind(kind))
+    {
+        return false;
+    }
+    bool first = !(seen & (1 << kind));
+    seen |= (1 << kind);
+    return first && (m_inlineKinds & (1 << kind));
+}
+
+void
+TcpHeader::AddOptionKind(uint8_t kind, uint8_t size)
+{
+    NS_ASSERT(m_numOptions < m_maxOptionsLen);
+    m_optionKinds[m_numOptions++] = kind;
+    m_optionsSize += size;
+}
+
+bool
+TcpHeader::AppendInlineOption(uint8_t kind, uint8_t size)
+{
+    // only the first option of each kind is stored inline
+    if (m_optionsLen + size > m_maxOptionsLen || HasOption(kind))
+    {
+        return false;
+    }
+    m_inlineKinds |= (1 << kind);
+    AddOptionKind(kind, size);
+    m_optionsLen += size;
+
+    uint32_t totalLen = 20 + 3 + m_optionsLen;
+    m_length = totalLen >> 2;
+    return true;
+}
+
+uint8_t
+TcpHeader::GetInlineOptionSize(uint8_t kind) const
+{
+    switch (kind)
+    {
+    case TcpOption::MSS:
+        return 4;
+    case TcpOption::WINSCALE:
+        return 3;
+    case TcpOption::SACKPERMITTED:
+        return 2;
+    case TcpOption::SACK:
+        return 2 + m_numSackBlocks * 8;
+    case TcpOption::TS:
+        return 10;
+    default:
+        NS_FATAL_ERROR("Option kind " << static_cast<int>(kind) << " is not stored inline");
+    }
+}
+
+Ptr<TcpOption>
+TcpHeader::CreateInlineOption(uint8_t kind) const
+{
+    switch (kind)
+    {
+    case TcpOption::MSS: {
+        auto option = CreateObject<TcpOptionMSS>();
+        option->SetMSS(m_mss);
+        return option;
+    }
+    case TcpOption::WINSCALE: {
+        auto option = CreateObject<TcpOptionWinScale>();
+        option->SetScale(m_winScale);
+        return option;
+    }
+    case TcpOption::SACKPERMITTED:
+        return CreateObject<TcpOptionSackPermitted>();
+    case TcpOption::SACK: {
+        auto option = CreateObject<TcpOptionSack>();
+        for (const auto& block : GetOptionSackBlocks())
+        {
+            option->AddSackBlock(block);
+        }
+        return option;
+    }
+    case TcpOption::TS: {
+        auto option = CreateObject<TcpOptionTS>();
+        option->SetTimestamp(m_tsValue);
+        option->SetEcho(m_tsEcho);
+        return option;
+    }
+    default:
+        NS_FATAL_ERROR("Option kind " << static_cast<int>(kind) << " is not stored inline");
+    }
+}
+
+bool
+TcpHeader::CopyInlineOption(Ptr<const TcpOption> option)
+{
+    switch (option->GetKind())
+    {
+    case TcpOption::MSS:
+        if (auto mss = DynamicCast<const TcpOptionMSS>(option))
+        {
+            return AppendOptionMss(mss->GetMSS());
+        }
+        break;
+    case TcpOption::WINSCALE:
+        if (auto ws = DynamicCast<const TcpOptionWinScale>(option))
+        {
+            return AppendOptionWinScale(ws->GetScale());
+        }
+        break;
+    case TcpOption::SACKPERMITTED:
+        if (DynamicCast<const TcpOptionSackPermitted>(option))
+        {
+            return AppendOptionSackPermitted();
+        }
+        break;
+    case TcpOption::SACK:
+        if (auto sack = DynamicCast<const TcpOptionSack>(option);
+            sack && sack->GetNumSackBlocks() <= m_maxSackBlocks)
+        {
+            return AppendOptionSack(sack->GetSackList());
+        }
+        break;
+    case TcpOption::TS:
+        if (auto ts = DynamicCast<const TcpOptionTS>(option))
+        {
+            return AppendOptionTs(ts->GetTimestamp(), ts->GetEcho());
+        }
+        break;
+    default:
+        break;
+    }
+    return false;
+}
+
+uint32_t
+TcpHeader::DeserializeInlineOption(Buffer::Iterator start, uint32_t optionLen)
+{
+    Buffer::Iterator i = start;
+    if (optionLen < 2)
+    {
+        return 0;
+    }
+    uint8_t kind = i.ReadU8();
+    uint8_t size = i.ReadU8();
+    if (size > optionLen || HasOption(kind))
+    {
+        // let the TcpOption classes deal with this case
+        return 0;
+    }
+
+    switch (kind)
+    {
+    case TcpOption::MSS:
+        if (size != 4)
+        {
+            return 0;
+        }
+        m_mss = i.ReadNtohU16();
+        break;
+    case TcpOption::WINSCALE:
+        if (size != 3)
+        {
+            return 0;
+        }
+        m_winScale = i.ReadU8();
+        break;
+    case TcpOption::SACKPERMITTED:
+        if (size != 2)
+        {
+            return 0;
+        }
+        break;
+    case TcpOption::SACK:
+        if (size < 10 || (size - 2) % 8 != 0 || (size - 2) / 8 > m_maxSackBlocks)
+        {
+            return 0;
+        }
+        m_numSackBlocks = (size - 2) / 8;
+        for (uint8_t b = 0; b < m_numSackBlocks; ++b)
+        {
+            m_sackBlocks[b].first = SequenceNumber32(i.ReadNtohU32());
+            m_sackBlocks[b].second = SequenceNumber32(i.ReadNtohU32());
+        }
+        break;
+    case TcpOption::TS:
+        if (size != 10)
+        {
+            return 0;
+        }
+        m_tsValue = i.ReadNtohU32();
+        m_tsEcho = i.ReadNtohU32();
+        break;
+    default:
+        return 0;
+    }
+
+    m_inlineKinds |= (1 << kind);
+    AddOptionKind(kind, size);
+    m_optionsLen += size;
+    return size;
+}
+
 const TcpHeader::TcpOptionList&
 TcpHeader::GetOptionList() const
 {
-    return m_options;
+    m_optionList.clear();
+    uint16_t seen = 0;
+    auto op = m_options.begin();
+
+    for (uint8_t n = 0; n < m_numOptions; ++n)
+    {
+        if (IsInlineSlot(m_optionKinds[n], seen))
+        {
+            m_optionList.emplace_back(CreateInlineOption(m_optionKinds[n]));
+        }
+        else
+        {
+            m_optionList.emplace_back(*op++);
+        }
+    }
+    return m_optionList;
 }
 
 Ptr<const TcpOption>
 TcpHeader::GetOption(uint8_t kind) const
 {
-    for (auto i = m_options.begin(); i != m_options.end(); ++i)
+    uint16_t seen = 0;
+    auto op = m_options.begin();
+
+    for (uint8_t n = 0; n < m_numOptions; ++n)
     {
-        if ((*i)->GetKind() == kind)
+        bool isInline = IsInlineSlot(m_optionKinds[n], seen);
+        if (m_optionKinds[n] == kind)
         {
-            return (*i);
+            if (isInline)
+            {
+                return CreateInlineOption(kind);
+            }
+            return *op;
+        }
+        if (!isInline)
+        {
+            ++op;
         }
     }
 
@@ -466,6 +868,11 @@ TcpHeader::GetOption(uint8_t kind) const
 bool
 TcpHeader::HasOption(uint8_t kind) const
 {
+    if (HasInlineOption(kind))
+    {
+        return true;
+    }
+
     for (auto i = m_options.begin(); i != m_options.end(); ++i)
     {
         if ((*i)->GetKind() == kind)
@@ -9,6 +9,7 @@
 #ifndef TCP_HEADER_H
 #define TCP_HEADER_H
 
+#include "tcp-option-sack.h"
 #include "tcp-option.h"
 #include "tcp-socket-factory.h"
 
@@ -18,6 +19,8 @@
 #include "ns3/ipv6-address.h"
 #include "ns3/sequence-number.h"
 
+#include <array>
+#include <span>
 #include <stdint.h>
 
 namespace ns3
@@ -30,6 +33,15 @@ namespace ns3
  * This class has fields corresponding to those in a network TCP header
  * (port numbers, sequence and acknowledgement numbers, flags, etc) as well
  * as methods for serialization to and deserialization from a byte buffer.
+ *
+ * The standard options (MSS, Window Scale, SACK-Permitted, SACK and
+ * Timestamp) are stored inline in the header, and can be added and read
+ * through typed accessors (e.g., AppendOptionTs and GetOptionTsValue) without
+ * allocating any TcpOption object. The TcpOption based methods (AppendOption,
+ * GetOption and GetOptionList) are kept for compatibility and for the other
+ * kinds of options: the standard options passed to AppendOption are copied
+ * into the inline storage, while GetOption and GetOptionList create the
+ * TcpOption objects corresponding to the standard options.
  */
 
 class TcpHeader : public Header
@@ -177,6 +189,10 @@ class TcpHeader : public Header
 
     /**
      * @brief Get the list of option in this header
+     *
+     * The list is built again at every call; the returned reference is valid
+     * until the next call or until the header is modified.
+     *
      * @return a const reference to the option list
      */
     const TcpOptionList& GetOptionList() const;
@@ -207,6 +223,88 @@ class TcpHeader : public Header
      */
     bool AppendOption(Ptr<const TcpOption> option);
 
+    /**
+     * @brief Append a Maximum Segment Size option to the TCP header
+     * @param mss the maximum segment size
+     * @return true if option has been appended, false otherwise
+     */
+    bool AppendOptionMss(uint16_t mss);
+
+    /**
+     * @brief Append a Window Scale option to the TCP header
+     * @param scale the window scale factor
+     * @return true if option has been appended, false otherwise
+     */
+    bool AppendOptionWinScale(uint8_t scale);
+
+    /**
+     * @brief Append a SACK-Permitted option to the TCP header
+     * @return true if option has been appended, false otherwise
+     */
+    bool AppendOptionSackPermitted();
+
+    /**
+     * @brief Append a SACK option to the TCP header
+     *
+     * The option is made of the first blocks of the list that fit the option
+     * space left in the header.
+     *
+     * @param list the list of SACK blocks
+     * @return true if option has been appended, false if the list is empty or
+     *         not even one block fits the header
+     */
+    bool AppendOptionSack(const TcpOptionSack::SackList& list);
+
+    /**
+     * @brief Append a Timestamp option to the TCP header
+     * @param timestamp the timestamp value
+     * @param echo the timestamp echo reply
+     * @return true if option has been appended, false otherwise
+     */
+    bool AppendOptionTs(uint32_t timestamp, uint32_t echo);
+
+    /**
+     * @brief Get the value of the Maximum Segment Size option
+     *
+     * The header must have such an option.
+     *
+     * @return the maximum segment size
+     */
+    uint16_t GetOptionMss() const;
+
+    /**
+     * @brief Get the value of the Window Scale option
+     *
+     * The header must have such an option.
+     *
+     * @return the window scale factor
+     */
+    uint8_t GetOptionWinScale() const;
+
+    /**
+     * @brief Get the blocks of the SACK option
+     * @return the SACK blocks, or an empty span if the header has no SACK option
+     */
+    std::span<const TcpOptionSack::SackBlock> GetOptionSackBlocks() const;
+
+    /**
+     * @brief Get the timestamp value of the Timestamp option
+     *
+     * The header must have such an option.
+     *
+     * @return the timestamp value
+     */
+    uint32_t GetOptionTsValue() const;
+
+    /**
+     * @brief Get the timestamp echo reply of the Timestamp option
+     *
+     * The header must have such an option.
+     *
+     * @return the timestamp echo reply
+     */
+    uint32_t GetOptionTsEcho() const;
+
     /**
      * @brief Initialize the TCP checksum.
      *
@@ -318,6 +416,81 @@ class TcpHeader : public Header
      */
     uint8_t CalculateHeaderLength() const;
 
+    /**
+     * @brief Check if options of the given kind are stored inline
+     * @param kind the option kind
+     * @return true if the first option of the given kind is stored inline
+     */
+    static bool IsInlineKind(uint8_t kind);
+
+    /**
+     * @brief Check if the header has an option of the given kind stored inline
+     * @param kind the option kind
+     * @return true if the header has an option of the given kind stored inline
+     */
+    bool HasInlineOption(uint8_t kind) const;
+
+    /**
+     * @brief Check if an option of the header is stored inline
+     *
+     * Only the first option of each standard kind is stored inline. This method
+     * must be called for the options of the header in order.
+     *
+     * @param kind the kind of the option
+     * @param [in,out] seen bitmask of the standard kinds of the previous options
+     * @return true if the option is stored inline
+     */
+    bool IsInlineSlot(uint8_t kind, uint16_t& seen) const;
+
+    /**
+     * @brief Record an option added to the header
+     * @param kind the option kind
+     * @param size the serialized size of the option
+     */
+    void AddOptionKind(uint8_t kind, uint8_t size);
+
+    /**
+     * @brief Record an option appended to the inline storage
+     *
+     * The value of the option must be stored by the caller if the option has
+     * been appended.
+     *
+     * @param kind the option kind
+     * @param size the serialized size of the option
+     * @return true if option can be appended, false otherwise
+     */
+    bool AppendInlineOption(uint8_t kind, uint8_t size);
+
+    /**
+     * @brief Get the serialized size of an option stored inline
+     * @param kind the option kind
+     * @return the serialized size of the option
+     */
+    uint8_t GetInlineOptionSize(uint8_t kind) const;
+
+    /**
+     * @brief Create the TcpOption corresponding to an option stored inline
+     * @param kind the option kind
+     * @return the option
+     */
+    Ptr<TcpOption> CreateInlineOption(uint8_t kind) const;
+
+    /**
+     * @brief Copy an option into the inline storage
+     * @param option the option, whose kind is stored inline
+     * @return true if the option has been copied
+     */
+    bool CopyInlineOption(Ptr<const TcpOption> option);
+
+    /**
+     * @brief Deserialize an option into the inline storage
+     *
+     * @param start the buffer iterator pointing to the option
+     * @param optionLen the option space left in the header
+     * @return the size of the option, or 0 if it cannot be stored inline
+     */
+    uint32_t DeserializeInlineOption(Buffer::Iterator start, uint32_t optionLen);
+
     uint16_t m_sourcePort{0};             //!< Source port
     uint16_t m_destinationPort{0};        //!< Destination port
     SequenceNumber32 m_sequenceNumber{0}; //!< Sequence number
@@ -335,8 +508,24 @@ class TcpHeader : public Header
     bool m_goodChecksum{true};  //!< Flag to indicate that checksum is correct
 
     static const uint8_t m_maxOptionsLen = 40; //!< Maximum options length
-    TcpOptionList m_options;                   //!< TcpOption present in the header
+    static const uint8_t m_maxSackBlocks = 4;  //!< Maximum number of SACK blocks
     uint8_t m_optionsLen{0};                   //!< Tcp options length.
+    uint8_t m_optionsSize{0};                  //!< Tcp options length, without padding
+    uint8_t m_numOptions{0};                   //!< Number of options in the header
+    uint16_t m_inlineKinds{0};                 //!< Kinds of the options stored inline (bitmask)
+
+    std::array<uint8_t, m_maxOptionsLen> m_optionKinds{}; //!< Kinds of the options, in order
+
+    TcpOptionList m_options;            //!< Options which are not stored inline, in order
+    mutable TcpOptionList m_optionList; //!< All the options, built by GetOptionList
+
+    std::array<TcpOptionSack::SackBlock, m_maxSackBlocks> m_sackBlocks; //!< SACK option blocks
+
+    uint8_t m_numSackBlocks{0}; //!< Number of blocks of the SACK option
+    uint16_t m_mss{0};          //!< Value of the MSS option
+    uint8_t m_winScale{0};      //!< Value of the Window Scale option
+    uint32_t m_tsValue{0};      //!< Value of the Timestamp option
+    uint32_t m_tsEcho{0};       //!< Echo reply of the Timestamp option
 };
 
 } // namespace ns3
@@ -27,10 +27,8 @@
 #include "tcp-congestion-ops.h"
 #include "tcp-header.h"
 #include "tcp-l4-protocol.h"
-#include "tcp-option-sack-permitted.h"
 #include "tcp-option-sack.h"
 #include "tcp-option-ts.h"
-#include "tcp-option-winscale.h"
 #include "tcp-rate-ops.h"
 #include "tcp-recovery-ops.h"
 #include "tcp-rx-buffer.h"
@@ -39,6 +37,7 @@
 #include "ns3/abort.h"
 #include "ns3/data-rate.h"
 #include "ns3/double.h"
+#include "ns3/gso-tag.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/inet6-socket-address.h"
 #include "ns3/log.h"
@@ -184,6 +183,15 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_limitedTx),
                           MakeBooleanChecker())
+            .AddAttribute("TsoMaxSize",
+                          "Maximum size of the payload of the super-segments sent when emulating "
+                          "TCP segmentation offload (TSO). New data is sent in super-segments made "
+                          "of full-sized segments, which are segmented by the NetDevice. The "
+                          "emulation is disabled if this value is not larger than the segment "
+                          "size.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&TcpSocketBase::m_tsoMaxSize),
+                          MakeUintegerChecker<uint32_t>(0, 65000))
             .AddAttribute("UseEcn",
                           "Parameter to set ECN functionality",
                           EnumValue(TcpSocketState::Off),
@@ -397,6 +405,7 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_recoverActive(sock.m_recoverActive),
       m_retxThresh(sock.m_retxThresh),
       m_limitedTx(sock.m_limitedTx),
+      m_tsoMaxSize(sock.m_tsoMaxSize),
       m_isFirstPartialAck(sock.m_isFirstPartialAck),
       m_txTrace(sock.m_txTrace),
       m_rxTrace(sock.m_rxTrace),
@@ -1379,7 +1388,7 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
 
         if (tcpHeader.HasOption(TcpOption::WINSCALE) && m_winScalingEnabled)
         {
-            ProcessOptionWScale(tcpHeader.GetOption(TcpOption::WINSCALE));
+            ProcessOptionWScale(tcpHeader.GetOptionWinScale());
         }
         else
         {
@@ -1388,7 +1397,7 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
 
         if (tcpHeader.HasOption(TcpOption::SACKPERMITTED) && m_sackEnabled)
         {
-            ProcessOptionSackPermitted(tcpHeader.GetOption(TcpOption::SACKPERMITTED));
+            ProcessOptionSackPermitted();
         }
         else
         {
@@ -1399,7 +1408,8 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
         // When receiving a <SYN> or <SYN-ACK> we should adapt TS to the other end
         if (tcpHeader.HasOption(TcpOption::TS) && m_timestampEnabled)
         {
-            ProcessOptionTimestamp(tcpHeader.GetOption(TcpOption::TS),
+            ProcessOptionTimestamp(tcpHeader.GetOptionTsValue(),
+                                   tcpHeader.GetOptionTsEcho(),
                                    tcpHeader.GetSequenceNumber());
         }
         else
@@ -1433,7 +1443,8 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
             }
             else
             {
-                ProcessOptionTimestamp(tcpHeader.GetOption(TcpOption::TS),
+                ProcessOptionTimestamp(tcpHeader.GetOptionTsValue(),
+                                       tcpHeader.GetOptionTsEcho(),
                                        tcpHeader.GetSequenceNumber());
             }
         }
@@ -1628,17 +1639,10 @@ TcpSocketBase::ReadOptions(const TcpHeader& tcpHeader, uint32_t* bytesSacked)
 {
     NS_LOG_FUNCTION(this << tcpHeader);
 
-    for (const auto& option : tcpHeader.GetOptionList())
+    // Check only for ACK options here
+    if (tcpHeader.HasOption(TcpOption::SACK))
     {
-        // Check only for ACK options here
-        switch (option->GetKind())
-        {
-        case TcpOption::SACK:
-            *bytesSacked = ProcessOptionSack(option);
-            break;
-        default:
-            continue;
-        }
+        *bytesSacked = ProcessOptionSack(tcpHeader.GetOptionSackBlocks());
     }
 }
 
@@ -3239,6 +3243,12 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     bool isEct = IsEct(isRetransmission ? TcpPacketType_t::RE_XMT : TcpPacketType_t::DATA);
     AddSocketTags(p, isEct);
 
+    if (sz > m_tcb->m_segmentSize)
+    {
+        // a super-segment, to be segmented by the NetDevice
+        p->AddPacketTag(GsoTag(m_tcb->m_segmentSize, sz));
+    }
+
     if (m_closeOnEmpty && (remainingData == 0))
     {
         flags |= TcpHeader::FIN;
@@ -3465,6 +3475,19 @@ TcpSocketBase::SendPendingData(bool withAck)
             auto maxSizeToSend = static_cast<uint32_t>(nextHigh - next);
             s = std::min(s, maxSizeToSend);
 
+            if (m_tsoMaxSize > m_tcb->m_segmentSize && s == m_tcb->m_segmentSize &&
+                next >= m_tcb->m_highTxMark)
+            {
+                // TSO emulation: send as many full-sized segments of new data as allowed by the
+                // windows in a single super-segment
+                int32_t rWndLeft = (m_highRxAckMark + SequenceNumber32(m_rWnd)) - next;
+                uint32_t size = std::min({m_tsoMaxSize,
+                                          availableWindow,
+                                          availableData,
+                                          static_cast<uint32_t>(std::max(rWndLeft, 0))});
+                s = std::max(size / m_tcb->m_segmentSize, 1U) * m_tcb->m_segmentSize;
+            }
+
             // (C.2) If any of the data octets sent in (C.1) are below HighData,
             //       HighRxt MUST be set to the highest sequence number of the
             //       retransmitted segment unless NextSeg () rule (4) was
@@ -3674,7 +3697,10 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
     else
     { // In-sequence packet: ACK if delayed ack count allows
-        if (++m_delAckCount >= m_delAckMaxCount)
+        // A super-segment counts as the segments it is made of
+        GsoTag gso;
+        m_delAckCount += p->PeekPacketTag(gso) ? gso.GetNSegments() : 1;
+        if (m_delAckCount >= m_delAckMaxCount)
         {
             m_delAckEvent.Cancel();
             m_delAckCount = 0;
@@ -3728,9 +3754,7 @@ TcpSocketBase::CalculateRttSample(const TcpHeader& tcpHeader, const RttHistory&
         // of the data segment triggered the acknowledgment.
         if (m_timestampEnabled && tcpHeader.HasOption(TcpOption::TS))
         {
-            Ptr<const TcpOptionTS> ts;
-            ts = DynamicCast<const TcpOptionTS>(tcpHeader.GetOption(TcpOption::TS));
-            rtt = TcpOptionTS::ElapsedTimeFromTsValue(ts->GetEcho());
+            rtt = TcpOptionTS::ElapsedTimeFromTsValue(tcpHeader.GetOptionTsEcho());
             if (rtt.IsZero())
             {
                 NS_LOG_LOGIC("TcpSocketBase::EstimateRtt - RTT calculated from TcpOption::TS "
@@ -4326,15 +4350,13 @@ TcpSocketBase::AddOptions(TcpHeader& header)
 }
 
 void
-TcpSocketBase::ProcessOptionWScale(const Ptr<const TcpOption> option)
+TcpSocketBase::ProcessOptionWScale(uint8_t scale)
 {
-    NS_LOG_FUNCTION(this << option);
-
-    Ptr<const TcpOptionWinScale> ws = DynamicCast<const TcpOptionWinScale>(option);
+    NS_LOG_FUNCTION(this << static_cast<int>(scale));
 
     // In naming, we do the contrary of RFC 1323. The received scaling factor
     // is Rcv.Wind.Scale (and not Snd.Wind.Scale)
-    m_sndWindShift = ws->GetScale();
+    m_sndWindShift = scale;
 
     if (m_sndWindShift > 14)
     {
@@ -4377,38 +4399,31 @@ TcpSocketBase::AddOptionWScale(TcpHeader& header)
     NS_LOG_FUNCTION(this << header);
     NS_ASSERT(header.GetFlags() & TcpHeader::SYN);
 
-    Ptr<TcpOptionWinScale> option = CreateObject<TcpOptionWinScale>();
-
     // In naming, we do the contrary of RFC 1323. The sended scaling factor
     // is Snd.Wind.Scale (and not Rcv.Wind.Scale)
 
     m_rcvWindShift = CalculateWScale();
-    option->SetScale(m_rcvWindShift);
-
-    header.AppendOption(option);
+    header.AppendOptionWinScale(m_rcvWindShift);
 
     NS_LOG_INFO(m_node->GetId() << " Send a scaling factor of "
                                 << static_cast<int>(m_rcvWindShift));
 }
 
 uint32_t
-TcpSocketBase::ProcessOptionSack(const Ptr<const TcpOption> option)
+TcpSocketBase::ProcessOptionSack(std::span<const TcpOptionSack::SackBlock> blocks)
 {
-    NS_LOG_FUNCTION(this << option);
+    NS_LOG_FUNCTION(this << blocks.size());
 
-    Ptr<const TcpOptionSack> s = DynamicCast<const TcpOptionSack>(option);
-    return m_txBuffer->Update(s->GetSackList(), MakeCallback(&TcpRateOps::SkbDelivered, m_rateOps));
+    return m_txBuffer->Update(blocks, MakeCallback(&TcpRateOps::SkbDelivered, m_rateOps));
 }
 
 void
-TcpSocketBase::ProcessOptionSackPermitted(const Ptr<const TcpOption> option)
+TcpSocketBase::ProcessOptionSackPermitted()
 {
-    NS_LOG_FUNCTION(this << option);
-
-    Ptr<const TcpOptionSackPermitted> s = DynamicCast<const TcpOptionSackPermitted>(option);
+    NS_LOG_FUNCTION(this);
 
     NS_ASSERT(m_sackEnabled == true);
-    NS_LOG_INFO(m_node->GetId() << " Received a SACK_PERMITTED option " << s);
+    NS_LOG_INFO(m_node->GetId() << " Received a SACK_PERMITTED option");
 }
 
 void
@@ -4417,8 +4432,7 @@ TcpSocketBase::AddOptionSackPermitted(TcpHeader& header)
     NS_LOG_FUNCTION(this << header);
     NS_ASSERT(header.GetFlags() & TcpHeader::SYN);
 
-    Ptr<TcpOptionSackPermitted> option = CreateObject<TcpOptionSackPermitted>();
-    header.AppendOption(option);
+    header.AppendOptionSackPermitted();
     NS_LOG_INFO(m_node->GetId() << " Add option SACK-PERMITTED");
 }
 
@@ -4427,56 +4441,41 @@ TcpSocketBase::AddOptionSack(TcpHeader& header)
 {
     NS_LOG_FUNCTION(this << header);
 
-    // Calculate the number of SACK blocks allowed in this packet
-    uint8_t optionLenAvail = header.GetMaxOptionLength() - header.GetOptionLength();
-    uint8_t allowedSackBlocks = (optionLenAvail - 2) / 8;
-
-    TcpOptionSack::SackList sackList = m_tcb->m_rxBuffer->GetSackList();
-    if (allowedSackBlocks == 0 || sackList.empty())
+    // Append the number of SACK blocks allowed in this packet
+    if (!header.AppendOptionSack(m_tcb->m_rxBuffer->GetSackList()))
     {
         NS_LOG_LOGIC("No space available or sack list empty, not adding sack blocks");
         return;
     }
 
-    // Append the allowed number of SACK blocks
-    Ptr<TcpOptionSack> option = CreateObject<TcpOptionSack>();
-
-    for (auto i = sackList.begin(); allowedSackBlocks > 0 && i != sackList.end(); ++i)
-    {
-        option->AddSackBlock(*i);
-        allowedSackBlocks--;
-    }
-
-    header.AppendOption(option);
-    NS_LOG_INFO(m_node->GetId() << " Add option SACK " << *option);
+    NS_LOG_INFO(m_node->GetId() << " Add option SACK with "
+                                << header.GetOptionSackBlocks().size() << " blocks");
 }
 
 void
-TcpSocketBase::ProcessOptionTimestamp(const Ptr<const TcpOption> option,
+TcpSocketBase::ProcessOptionTimestamp(uint32_t timestamp,
+                                      uint32_t echo,
                                       const SequenceNumber32& seq)
 {
-    NS_LOG_FUNCTION(this << option);
-
-    Ptr<const TcpOptionTS> ts = DynamicCast<const TcpOptionTS>(option);
+    NS_LOG_FUNCTION(this << timestamp << echo << seq);
 
     // This is valid only when no overflow occurs. It happens
     // when a connection last longer than 50 days.
-    if (m_tcb->m_rcvTimestampValue > ts->GetTimestamp())
+    if (m_tcb->m_rcvTimestampValue > timestamp)
     {
         // Do not save a smaller timestamp (probably there is reordering)
         return;
     }
 
-    m_tcb->m_rcvTimestampValue = ts->GetTimestamp();
-    m_tcb->m_rcvTimestampEchoReply = ts->GetEcho();
+    m_tcb->m_rcvTimestampValue = timestamp;
+    m_tcb->m_rcvTimestampEchoReply = echo;
 
     if (seq == m_tcb->m_rxBuffer->NextRxSequence() && seq <= m_highTxAck)
     {
-        m_timestampToEcho = ts->GetTimestamp();
+        m_timestampToEcho = timestamp;
     }
 
-    NS_LOG_INFO(m_node->GetId() << " Got timestamp=" << m_timestampToEcho
-                                << " and Echo=" << ts->GetEcho());
+    NS_LOG_INFO(m_node->GetId() << " Got timestamp=" << m_timestampToEcho << " and Echo=" << echo);
 }
 
 void
@@ -4484,13 +4483,8 @@ TcpSocketBase::AddOptionTimestamp(TcpHeader& header)
 {
     NS_LOG_FUNCTION(this << header);
 
-    Ptr<TcpOptionTS> option = CreateObject<TcpOptionTS>();
-
-    option->SetTimestamp(TcpOptionTS::NowToTsValue());
-    option->SetEcho(m_timestampToEcho);
-
-    header.AppendOption(option);
-    NS_LOG_INFO(m_node->GetId() << " Add option TS, ts=" << option->GetTimestamp()
+    header.AppendOptionTs(TcpOptionTS::NowToTsValue(), m_timestampToEcho);
+    NS_LOG_INFO(m_node->GetId() << " Add option TS, ts=" << header.GetOptionTsValue()
                                 << " echo=" << m_timestampToEcho);
 }
 
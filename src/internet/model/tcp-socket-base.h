@@ -11,6 +11,7 @@
 
 #include "ipv4-header.h"
 #include "ipv6-header.h"
+#include "tcp-option-sack.h"
 #include "tcp-socket-state.h"
 #include "tcp-socket.h"
 
@@ -21,6 +22,7 @@
 #include "ns3/traced-value.h"
 
 #include <queue>
+#include <span>
 #include <stdint.h>
 
 namespace ns3
@@ -186,7 +188,8 @@ class RttHistory
  *
  * SYN and SYN-ACK options, which are allowed only at the beginning of the
  * connection, are managed in the DoForwardUp and SendEmptyPacket methods.
- * To read all others, we have set up a cycle inside ReadOptions. For adding
+ * All others are read in ReadOptions, through the typed accessors of
+ * TcpHeader. For adding
  * them, there is no a unique place, since the options (and the information
  * available to build them) are scattered around the code. For instance,
  * the SACK option is built in SendEmptyPacket only under certain conditions.
@@ -1212,9 +1215,9 @@ class TcpSocketBase : public TcpSocket
      * Read the window scale option (encoded logarithmically) and save it.
      * Per RFC 1323, the value can't exceed 14.
      *
-     * @param option Window scale option read from the header
+     * @param scale Window scale factor read from the header
      */
-    void ProcessOptionWScale(const Ptr<const TcpOption> option);
+    void ProcessOptionWScale(uint8_t scale);
     /**
      * @brief Add the window scale option to the header
      *
@@ -1239,18 +1242,16 @@ class TcpSocketBase : public TcpSocket
      *
      * Currently this is a placeholder, since no operations should be done
      * on such option.
-     *
-     * @param option SACK PERMITTED option from the header
      */
-    void ProcessOptionSackPermitted(const Ptr<const TcpOption> option);
+    void ProcessOptionSackPermitted();
 
     /**
      * @brief Read the SACK option
      *
-     * @param option SACK option from the header
+     * @param blocks SACK blocks from the header
      * @returns the number of bytes sacked by this option
      */
-    uint32_t ProcessOptionSack(const Ptr<const TcpOption> option);
+    uint32_t ProcessOptionSack(std::span<const TcpOptionSack::SackBlock> blocks);
 
     /**
      * @brief Add the SACK PERMITTED option to the header
@@ -1274,10 +1275,11 @@ class TcpSocketBase : public TcpSocket
      * to utilize later to calculate RTT.
      *
      * @see EstimateRtt
-     * @param option Option from the segment
+     * @param timestamp Timestamp value from the segment
+     * @param echo Timestamp echo reply from the segment
      * @param seq Sequence number of the segment
      */
-    void ProcessOptionTimestamp(const Ptr<const TcpOption> option, const SequenceNumber32& seq);
+    void ProcessOptionTimestamp(uint32_t timestamp, uint32_t echo, const SequenceNumber32& seq);
     /**
      * @brief Add the timestamp option to the header
      *
@@ -1424,6 +1426,8 @@ class TcpSocketBase : public TcpSocket
     uint32_t m_retxThresh{3};    //!< Fast Retransmit threshold
     bool m_limitedTx{true};      //!< perform limited transmit
 
+    uint32_t m_tsoMaxSize{0}; //!< Maximum payload size of the super-segments (TSO emulation)
+
     // Transmission Control Block
     Ptr<TcpSocketState> m_tcb;                 //!< Congestion control information
     Ptr<TcpCongestionOps> m_congestionControl; //!< Congestion control
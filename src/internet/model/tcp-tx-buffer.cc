@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <vector>
 
 namespace ns3
 {
@@ -156,7 +157,9 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
 
     if (!m_sentList.empty())
     {
+        m_sentIndex.erase(m_sentList.front()->m_startSeq);
         m_sentList.front()->m_startSeq = seq;
+        AddToSentIndex(m_sentList.begin());
     }
 
     // if you change the head with data already sent, something bad will happen
@@ -283,7 +286,7 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     NS_ASSERT(it != m_appList.end());
 
     m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    AddToSentIndex(m_sentList.insert(m_sentList.end(), item));
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -297,37 +300,33 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(!m_sentList.empty());
 
-    auto it = m_sentList.begin();
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    if (auto index = m_sentIndex.find(seq); index != m_sentIndex.end())
     {
-        if ((*it)->m_startSeq == seq)
+        auto it = index->second;
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -389,7 +388,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                const SequenceNumber32& listStartFrom,
                                uint32_t numBytes,
                                const SequenceNumber32& seq,
-                               bool* listEdited) const
+                               bool* listEdited)
 {
     NS_LOG_FUNCTION(this << numBytes << seq);
 
@@ -425,6 +424,17 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     TcpTxItem* outItem = nullptr;
     auto it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+    const bool isSentList = (&list == &m_sentList);
+
+    if (isSentList)
+    {
+        // start from the packet containing seq, instead of walking the list
+        if (auto item = FindSentItem(seq); item != m_sentList.end())
+        {
+            it = item;
+            beginOfCurrentPacket = (*item)->m_startSeq;
+        }
+    }
 
     while (it != list.end())
     {
@@ -459,7 +469,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    AddToSentIndex(firstPartIt);
+                    AddToSentIndex(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -506,6 +521,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                     TcpTxItem* previous = *(--it);
 
                     list.erase(it);
+                    if (isSentList)
+                    {
+                        m_sentIndex.erase(previous->m_startSeq);
+                    }
 
                     MergeItems(previous, currentItem);
                     delete currentItem;
@@ -525,7 +544,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    AddToSentIndex(firstPartIt);
+                    AddToSentIndex(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -555,6 +579,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
 
             MergeItems(currentItem, next);
             list.erase(it);
+            if (isSentList)
+            {
+                m_sentIndex.erase(next->m_startSeq);
+            }
 
             delete next;
 
@@ -638,16 +666,15 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // the only item that can end at ack is the one containing the previous byte
+    auto it = FindSentItem(ack - 1);
+    if (it == m_sentList.end())
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    TcpTxItem* item = *it;
+    return item->m_startSeq + item->m_packet->GetSize() == ack && !item->m_sacked &&
+           item->m_retrans;
 }
 
 void
@@ -695,6 +722,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
             RemoveFromCounts(item, pktSize);
 
+            m_sentIndex.erase(item->m_startSeq);
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
                                    << " sacked: " << m_sackedOut << ". Remaining data " << m_size);
@@ -713,7 +741,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             NS_LOG_INFO(*item);
             // PacketTags are preserved when fragmenting
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
+            m_sentIndex.erase(item->m_startSeq);
             item->m_startSeq += offset;
+            AddToSentIndex(i);
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -769,23 +799,37 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
 uint32_t
 TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, TcpTxItem*>& sackedCb)
+{
+    std::vector<TcpOptionSack::SackBlock> blocks(list.begin(), list.end());
+    return Update(std::span<const TcpOptionSack::SackBlock>(blocks), sackedCb);
+}
+
+uint32_t
+TcpTxBuffer::Update(std::span<const TcpOptionSack::SackBlock> blocks,
+                    const Callback<void, TcpTxItem*>& sackedCb)
 {
     NS_LOG_FUNCTION(this);
-    NS_LOG_INFO("Updating scoreboard, got " << list.size() << " blocks to analyze");
+    NS_LOG_INFO("Updating scoreboard, got " << blocks.size() << " blocks to analyze");
 
     uint32_t bytesSacked = 0;
 
-    for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
+    for (auto option_it = blocks.begin(); option_it != blocks.end(); ++option_it)
     {
-        auto item_it = m_sentList.begin();
-        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
             NS_LOG_INFO("Not updating scoreboard, the option block is outside the sent list");
             return bytesSacked;
         }
 
+        // Only the items starting at or after the beginning of the block can be sacked
+        auto item_it = m_sentList.end();
+        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq + m_sentSize;
+        if (auto index = m_sentIndex.lower_bound((*option_it).first); index != m_sentIndex.end())
+        {
+            item_it = index->second;
+            beginOfCurrentPacket = index->first;
+        }
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
@@ -921,24 +965,19 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    auto it = FindSentItem(seq);
+    if (it != m_sentList.end())
     {
-        // Search for the right iterator before calling IsLost()
-        if ((*it)->m_startSeq <= seq && seq < (*it)->m_startSeq + (*it)->m_packet->GetSize())
+        if ((*it)->m_lost)
         {
-            if ((*it)->m_lost)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
+            NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+            return true;
+        }
 
-            if ((*it)->m_sacked)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
+        if ((*it)->m_sacked)
+        {
+            NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
+            return false;
         }
     }
 
@@ -972,6 +1011,19 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
     {
         item = *it;
 
+        if (m_sackSeen && item->m_startSeq >= m_highestSack.second)
+        {
+            // Condition 1.b does not hold for this item and the following ones
+            break;
+        }
+
+        if (m_lostOut == 0 && (!isRecovery || seqPerRule3.GetValue() != 0))
+        {
+            // No item is lost, hence the condition 1.c does not hold for any item, and the
+            // sequence number per rule 3 is either not needed or already found
+            break;
+        }
+
         // Condition 1.a , 1.b , and 1.c
         if (!item->m_retrans && !item->m_sacked &&
             ((m_sackSeen && item->m_startSeq < m_highestSack.second) || !m_sackSeen))
@@ -1229,6 +1281,7 @@ TcpTxBuffer::ResetSentList()
         m_sentList.pop_back();
     }
 
+    m_sentIndex.clear();
     m_sentSize = 0;
     m_lostOut = 0;
     m_retrans = 0;
@@ -1245,6 +1298,7 @@ TcpTxBuffer::ResetLastSegmentSent()
     {
         TcpTxItem* item = m_sentList.back();
 
+        m_sentIndex.erase(item->m_startSeq);
         m_sentList.pop_back();
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
@@ -1407,6 +1461,28 @@ TcpTxBuffer::AddRenoSack()
     ConsistencyCheck();
 }
 
+void
+TcpTxBuffer::AddToSentIndex(PacketList::iterator it)
+{
+    m_sentIndex[(*it)->m_startSeq] = it;
+}
+
+TcpTxBuffer::PacketList::iterator
+TcpTxBuffer::FindSentItem(const SequenceNumber32& seq) const
+{
+    auto index = m_sentIndex.upper_bound(seq);
+    if (index == m_sentIndex.begin())
+    {
+        return const_cast<PacketList&>(m_sentList).end();
+    }
+    --index;
+    if (seq < index->first + (*index->second)->m_packet->GetSize())
+    {
+        return index->second;
+    }
+    return const_cast<PacketList&>(m_sentList).end();
+}
+
 void
 TcpTxBuffer::ConsistencyCheck() const
 {
@@ -1423,6 +1499,9 @@ TcpTxBuffer::ConsistencyCheck() const
 
     for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
     {
+        auto index = m_sentIndex.find((*it)->m_startSeq);
+        NS_ASSERT_MSG(index != m_sentIndex.end() && index->second == it,
+                      "Item " << *(*it) << " is not indexed");
         if ((*it)->m_sacked)
         {
             sacked += (*it)->m_packet->GetSize();
@@ -1442,6 +1521,8 @@ TcpTxBuffer::ConsistencyCheck() const
     NS_ASSERT_MSG(lost == m_lostOut, " Counted lost: " << lost << " stored lost: " << m_lostOut);
     NS_ASSERT_MSG(retrans == m_retrans,
                   " Counted retrans: " << retrans << " stored retrans: " << m_retrans);
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  "Indexed items: " << m_sentIndex.size() << " sent items: " << m_sentList.size());
 }
 
 std::ostream&
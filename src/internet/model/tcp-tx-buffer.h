@@ -18,6 +18,10 @@
 #include "ns3/sequence-number.h"
 #include "ns3/traced-value.h"
 
+#include <list>
+#include <map>
+#include <span>
+
 namespace ns3
 {
 class Packet;
@@ -289,6 +293,16 @@ class TcpTxBuffer : public Object
     uint32_t Update(const TcpOptionSack::SackList& list,
                     const Callback<void, TcpTxItem*>& sackedCb = m_nullCb);
 
+    /**
+     * @brief Update the scoreboard
+     * @param blocks SACKed blocks
+     * @param sackedCb Callback invoked, if it is not null, when a segment has been
+     * SACKed by the receiver.
+     * @returns the number of bytes newly sacked by the blocks
+     */
+    uint32_t Update(std::span<const TcpOptionSack::SackBlock> blocks,
+                    const Callback<void, TcpTxItem*>& sackedCb = m_nullCb);
+
     /**
      * @brief Check if a segment is lost
      *
@@ -403,6 +417,19 @@ class TcpTxBuffer : public Object
 
     typedef std::list<TcpTxItem*> PacketList; //!< container for data stored in the buffer
 
+    /**
+     * @brief Add an item of the sent list to the index of the sent list
+     * @param it iterator to the item in the sent list
+     */
+    void AddToSentIndex(PacketList::iterator it);
+
+    /**
+     * @brief Find the item of the sent list containing the given sequence number
+     * @param seq the sequence number
+     * @return an iterator to the item, or the end of the sent list if no item contains seq
+     */
+    PacketList::iterator FindSentItem(const SequenceNumber32& seq) const;
+
     /**
      * @brief Update the lost count
      *
@@ -554,7 +581,7 @@ class TcpTxBuffer : public Object
                                  const SequenceNumber32& startingSeq,
                                  uint32_t numBytes,
                                  const SequenceNumber32& requestedSeq,
-                                 bool* listEdited = nullptr) const;
+                                 bool* listEdited = nullptr);
 
     /**
      * @brief Merge two TcpTxItem
@@ -594,6 +621,8 @@ class TcpTxBuffer : public Object
 
     PacketList m_appList;              //!< Buffer for application data
     PacketList m_sentList;             //!< Buffer for sent (but not acked) data
+    std::map<SequenceNumber32, PacketList::iterator>
+        m_sentIndex; //!< Items of the sent list, by starting sequence number
     uint32_t m_maxBuffer;              //!< Max number of data bytes in buffer (SND.WND)
     uint32_t m_size;                   //!< Size of all data in this buffer
     uint32_t m_sentSize;               //!< Size of sent (and not discarded) segments
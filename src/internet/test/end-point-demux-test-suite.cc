@@ -0,0 +1,215 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface-address.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Ipv4EndPointDemux lookup test: checks that the endpoints are found according to the
+ * matching precedence, also after their local address or peer changed or other endpoints were
+ * removed.
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxTestCase();
+    void DoRun() override;
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase()
+    : TestCase("Ipv4EndPointDemux lookup")
+{
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun()
+{
+    Ipv4EndPointDemux demux;
+    auto iface = CreateObject<Ipv4Interface>();
+    iface->AddAddress(Ipv4InterfaceAddress("10.0.0.1", "255.255.255.0"));
+
+    Ipv4Address local("10.0.0.1");
+    Ipv4Address peer("10.0.0.2");
+
+    auto lookup = [&](Ipv4Address daddr, uint16_t dport, Ipv4Address saddr, uint16_t sport) {
+        auto endPoints = demux.Lookup(daddr, dport, saddr, sport, iface);
+        return endPoints.empty() ? nullptr : endPoints.front();
+    };
+
+    auto listener = demux.Allocate(nullptr, 80);
+    auto subnet = demux.Allocate(nullptr, Ipv4Address("10.0.0.0"), 81);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Allocation of the listener failed");
+    NS_TEST_ASSERT_MSG_NE(subnet, nullptr, "Allocation of the subnet endpoint failed");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, 80),
+                          nullptr,
+                          "Duplicated endpoint should not be allocated");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1234), listener, "Wildcard match expected");
+
+    auto connection = demux.Allocate(nullptr, local, 80, peer, 1234);
+    NS_TEST_ASSERT_MSG_NE(connection, nullptr, "Allocation of the connection failed");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, local, 80, peer, 1234),
+                          nullptr,
+                          "Duplicated four-tuple should not be allocated");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1234), connection, "Exact match expected");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1235), listener, "Wildcard match expected");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, Ipv4Address("10.0.0.3"), 1234),
+                          listener,
+                          "Wildcard match expected");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 82, peer, 1234), nullptr, "No match expected");
+
+    // subnet-directed broadcast
+    NS_TEST_EXPECT_MSG_EQ(lookup(Ipv4Address("10.0.0.255"), 81, peer, 1234),
+                          subnet,
+                          "Subnet match expected");
+    NS_TEST_EXPECT_MSG_EQ(lookup(Ipv4Address("10.1.0.255"), 81, peer, 1234),
+                          nullptr,
+                          "No match expected outside of the subnet");
+
+    // endpoints that cannot receive packets are skipped
+    connection->SetRxEnabled(false);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1234), listener, "Wildcard match expected");
+    connection->SetRxEnabled(true);
+
+    // an endpoint whose local address and peer are set after its allocation
+    auto client = demux.Allocate();
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Allocation of the client failed");
+    uint16_t clientPort = client->GetLocalPort();
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(clientPort), true, "Port should be in use");
+    client->SetLocalAddress(local);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, clientPort, peer, 80), client, "Local match expected");
+    client->SetPeer(peer, 80);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, clientPort, peer, 80), client, "Exact match expected");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, clientPort, peer, 81), nullptr, "No match expected");
+    NS_TEST_EXPECT_MSG_EQ(demux.SimpleLookup(local, clientPort, peer, 80),
+                          client,
+                          "Exact match expected");
+
+    // many connections to the same port
+    std::vector<Ipv4EndPoint*> connections;
+    for (uint16_t port = 2000; port < 3000; port++)
+    {
+        connections.push_back(demux.Allocate(nullptr, local, 80, peer, port));
+    }
+    for (uint16_t port = 2000; port < 3000; port++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, port),
+                              connections[port - 2000],
+                              "Exact match expected");
+    }
+    for (auto endPoint : connections)
+    {
+        demux.DeAllocate(endPoint);
+    }
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 2000), listener, "Wildcard match expected");
+
+    demux.DeAllocate(connection);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1234), listener, "Wildcard match expected");
+    NS_TEST_EXPECT_MSG_EQ(demux.SimpleLookup(local, 80, peer, 1234),
+                          listener,
+                          "Generic match expected");
+    demux.DeAllocate(listener);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1234), nullptr, "No match expected");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), false, "Port should no longer be in use");
+    NS_TEST_EXPECT_MSG_EQ(demux.SimpleLookup(local, 80, peer, 1234), nullptr, "No match expected");
+    NS_TEST_EXPECT_MSG_EQ(demux.GetAllEndPoints().size(), 2, "Two endpoints should be left");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Ipv6EndPointDemux lookup test: checks that the end points are found according to the
+ * matching precedence, also after their local address, local port or peer changed or other end
+ * points were removed.
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxTestCase();
+    void DoRun() override;
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase()
+    : TestCase("Ipv6EndPointDemux lookup")
+{
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun()
+{
+    Ipv6EndPointDemux demux;
+
+    Ipv6Address local("2001:db8::1");
+    Ipv6Address peer("2001:db8::2");
+
+    auto lookup = [&](Ipv6Address daddr, uint16_t dport, Ipv6Address saddr, uint16_t sport) {
+        auto endPoints = demux.Lookup(daddr, dport, saddr, sport, nullptr);
+        return endPoints.empty() ? nullptr : endPoints.front();
+    };
+
+    auto listener = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Allocation of the listener failed");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1234), listener, "Wildcard match expected");
+
+    auto connection = demux.Allocate(nullptr, local, 80, peer, 1234);
+    NS_TEST_ASSERT_MSG_NE(connection, nullptr, "Allocation of the connection failed");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, local, 80, peer, 1234),
+                          nullptr,
+                          "Duplicated four-tuple should not be allocated");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1234), connection, "Exact match expected");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1235), listener, "Wildcard match expected");
+    NS_TEST_EXPECT_MSG_EQ(demux.SimpleLookup(local, 80, peer, 1234),
+                          connection,
+                          "Exact match expected");
+
+    // an end point whose local address, local port and peer change after its allocation
+    auto client = demux.Allocate();
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Allocation of the client failed");
+    uint16_t clientPort = client->GetLocalPort();
+    client->SetLocalAddress(local);
+    client->SetPeer(peer, 80);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, clientPort, peer, 80), client, "Exact match expected");
+    client->SetLocalPort(5000);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(clientPort), false, "Port should not be in use");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(5000), true, "Port should be in use");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, clientPort, peer, 80), nullptr, "No match expected");
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 5000, peer, 80), client, "Exact match expected");
+
+    demux.DeAllocate(connection);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 80, peer, 1234), listener, "Wildcard match expected");
+    demux.DeAllocate(client);
+    NS_TEST_EXPECT_MSG_EQ(lookup(local, 5000, peer, 80), nullptr, "No match expected");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(5000), false, "Port should not be in use");
+    NS_TEST_EXPECT_MSG_EQ(demux.GetEndPoints().size(), 1, "One end point should be left");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 and IPv6 end point demux TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite();
+};
+
+EndPointDemuxTestSuite::EndPointDemuxTestSuite()
+    : TestSuite("end-point-demux", Type::UNIT)
+{
+    AddTestCase(new Ipv4EndPointDemuxTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new Ipv6EndPointDemuxTestCase(), TestCase::Duration::QUICK);
+}
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
@@ -15,8 +15,10 @@
 #include "ns3/candidate-queue.h"
 #include "ns3/config.h"
 #include "ns3/global-route-manager-impl.h"
+#include "ns3/global-route-manager.h"
 #include "ns3/internet-module.h"
 #include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
 #include "ns3/ipv4-global-routing-helper.h"
 #include "ns3/ipv4-global-routing.h"
 #include "ns3/network-module.h"
@@ -25,8 +27,12 @@
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <cstdlib> // for rand()
+#include <sstream>
+#include <string>
+#include <vector>
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImplTestSuite");
@@ -52,6 +58,12 @@ NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImplTestSuite");
 //  - GlobalRouteManagerImpl computes ECMP routes correctly.
 //  - Those random routes are in fact used by the GlobalRouting protocol
 //
+//  TestCase 4: GlobalRouteUpdateTestCase
+//  This test case tests that:
+//  - Updating the routes after a link went down yields the same routes as computing them again,
+//    and only the routes of the nodes affected by the change are computed again
+//  - Computing the routes with several threads yields the same routes
+//
 
 /**
  * @ingroup internet
@@ -940,6 +952,146 @@ RandomEcmpTestCase::DoRun()
     delete srm;
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief This test case checks that updating the routes after a topology change yields the same
+ * forwarding tables as computing all of them again, while keeping the routes of the nodes that
+ * are not affected by the change, and that computing the routes with several threads yields the
+ * same forwarding tables as well.
+ */
+class GlobalRouteUpdateTestCase : public TestCase
+{
+  public:
+    GlobalRouteUpdateTestCase();
+    void DoRun() override;
+
+  private:
+    /// The routes of each node, as text
+    using Routes = std::vector<std::vector<std::string>>;
+
+    /**
+     * @return the routes of each node
+     */
+    Routes GetRoutes() const;
+
+    /**
+     * Compute again all the routes.
+     */
+    static void RecomputeAll();
+
+    NodeContainer m_nodes; //!< the nodes
+};
+
+GlobalRouteUpdateTestCase::GlobalRouteUpdateTestCase()
+    : TestCase("GlobalRouteManagerImpl incremental and parallel route computation")
+{
+}
+
+GlobalRouteUpdateTestCase::Routes
+GlobalRouteUpdateTestCase::GetRoutes() const
+{
+    Routes routes;
+    for (auto it = m_nodes.Begin(); it != m_nodes.End(); ++it)
+    {
+        auto routing = (*it)->GetObject<GlobalRouter>()->GetRoutingProtocol();
+        routes.emplace_back();
+        for (uint32_t i = 0; i < routing->GetNRoutes(); i++)
+        {
+            std::ostringstream oss;
+            oss << *routing->GetRoute(i);
+            routes.back().push_back(oss.str());
+        }
+    }
+    return routes;
+}
+
+void
+GlobalRouteUpdateTestCase::RecomputeAll()
+{
+    GlobalRouteManager::DeleteGlobalRoutes();
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    GlobalRouteManager::InitializeRoutes();
+}
+
+void
+GlobalRouteUpdateTestCase::DoRun()
+{
+    // Routers 0 to 5 form a ring of point-to-point links, routers 0, 2 and 4 share a LAN,
+    // host 6 + i is attached to router i and routers 12 and 13 are isolated from the others
+    m_nodes.Create(14);
+    InternetStackHelper internet;
+    Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+    internet.SetRoutingHelper(ipv4RoutingHelper);
+    internet.Install(m_nodes);
+
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.255.252");
+    SimpleNetDeviceHelper p2pHelper;
+    p2pHelper.SetNetDevicePointToPointMode(true);
+    auto addLink = [&](uint32_t a, uint32_t b) {
+        auto devices = p2pHelper.Install(NodeContainer(m_nodes.Get(a), m_nodes.Get(b)));
+        ipv4.Assign(devices);
+        ipv4.NewNetwork();
+    };
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        addLink(i, (i + 1) % 6);
+    }
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        addLink(i, 6 + i);
+    }
+    addLink(12, 13);
+    SimpleNetDeviceHelper lanHelper;
+    ipv4.SetBase("10.1.0.0", "255.255.255.0");
+    ipv4.Assign(lanHelper.Install(NodeContainer(m_nodes.Get(0), m_nodes.Get(2), m_nodes.Get(4))));
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    auto initialRoutes = GetRoutes();
+    NS_TEST_ASSERT_MSG_EQ(initialRoutes[6].size(), 1, "Host 6 should have a default route");
+
+    auto getRoute = [this](uint32_t node) {
+        return m_nodes.Get(node)->GetObject<GlobalRouter>()->GetRoutingProtocol()->GetRoute(0);
+    };
+    auto host9Route = getRoute(9);
+    auto router12Route = getRoute(12);
+    auto host6Route = getRoute(6);
+
+    // bring down the link between routers 0 and 1 (the first interface is the loopback)
+    m_nodes.Get(0)->GetObject<Ipv4>()->SetDown(1);
+    m_nodes.Get(1)->GetObject<Ipv4>()->SetDown(1);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    auto updatedRoutes = GetRoutes();
+    NS_TEST_ASSERT_MSG_EQ(getRoute(9), host9Route, "The routes of host 9 should have been kept");
+    NS_TEST_ASSERT_MSG_EQ(getRoute(12), router12Route, "The routes of node 12 should be kept");
+    NS_TEST_ASSERT_MSG_NE(getRoute(6), host6Route, "The routes of host 6 should be computed");
+    NS_TEST_ASSERT_MSG_EQ((updatedRoutes != initialRoutes), true, "The routes should change");
+
+    RecomputeAll();
+    NS_TEST_ASSERT_MSG_EQ((GetRoutes() == updatedRoutes),
+                          true,
+                          "Updating the routes and computing all of them differ");
+
+    Config::SetGlobal("GlobalRoutingThreads", UintegerValue(4));
+    RecomputeAll();
+    Config::SetGlobal("GlobalRoutingThreads", UintegerValue(1));
+    NS_TEST_ASSERT_MSG_EQ((GetRoutes() == updatedRoutes),
+                          true,
+                          "Computing the routes with several threads yields different routes");
+
+    // bring the link up again
+    m_nodes.Get(0)->GetObject<Ipv4>()->SetUp(1);
+    m_nodes.Get(1)->GetObject<Ipv4>()->SetUp(1);
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    NS_TEST_ASSERT_MSG_EQ((GetRoutes() == initialRoutes),
+                          true,
+                          "The initial routes should be restored");
+
+    Simulator::Destroy();
+    GlobalRouteManager::ResetRouterId();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -959,6 +1111,7 @@ GlobalRouteManagerImplTestSuite::GlobalRouteManagerImplTestSuite()
     AddTestCase(new LinkRoutesTestCase(), TestCase::Duration::QUICK);
     AddTestCase(new LanRoutesTestCase(), TestCase::Duration::QUICK);
     AddTestCase(new RandomEcmpTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new GlobalRouteUpdateTestCase(), TestCase::Duration::QUICK);
 }
 
 static GlobalRouteManagerImplTestSuite
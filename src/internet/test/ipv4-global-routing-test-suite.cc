@@ -22,6 +22,7 @@
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/simple-channel.h"
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/simple-net-device.h"
@@ -32,6 +33,8 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <string>
+#include <utility>
 #include <vector>
 using namespace ns3;
 
@@ -1760,6 +1763,151 @@ GlobalRoutingProtocolTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 GlobalRouting lookup test.
+ *
+ * A large number of overlapping host, network and external routes is added to (and some of them
+ * removed from) the routing table. The routes returned for random destinations when the routes
+ * are searched in the prefix tries are checked against the routes returned when the routing
+ * table is scanned, which happens once a route whose mask is not a prefix mask is added. Routes
+ * are looked up both with and without random ECMP routing, so that the order of the equal cost
+ * routes is checked as well.
+ */
+class Ipv4GlobalRoutingLookupTestCase : public TestCase
+{
+  public:
+    Ipv4GlobalRoutingLookupTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Gateway and output device of the route to a destination
+    using RouteInfo = std::pair<Ipv4Address, Ptr<NetDevice>>;
+
+    /**
+     * Look up the route to the given destinations, without and with random ECMP routing.
+     *
+     * @param routing the routing protocol
+     * @param destinations the destinations and the requested output devices
+     * @return the gateway and output device of the route to each destination
+     */
+    std::vector<RouteInfo> Lookup(
+        Ptr<Ipv4GlobalRouting> routing,
+        const std::vector<std::pair<Ipv4Address, Ptr<NetDevice>>>& destinations);
+};
+
+Ipv4GlobalRoutingLookupTestCase::Ipv4GlobalRoutingLookupTestCase()
+    : TestCase("Global routing lookup in the prefix tries")
+{
+}
+
+std::vector<Ipv4GlobalRoutingLookupTestCase::RouteInfo>
+Ipv4GlobalRoutingLookupTestCase::Lookup(
+    Ptr<Ipv4GlobalRouting> routing,
+    const std::vector<std::pair<Ipv4Address, Ptr<NetDevice>>>& destinations)
+{
+    std::vector<RouteInfo> routes;
+    for (auto randomEcmp : {false, true})
+    {
+        routing->SetAttribute("RandomEcmpRouting", BooleanValue(randomEcmp));
+        routing->AssignStreams(1);
+        for (const auto& [dest, oif] : destinations)
+        {
+            Ipv4Header header;
+            header.SetDestination(dest);
+            Socket::SocketErrno sockerr;
+            auto route = routing->RouteOutput(Create<Packet>(), header, oif, sockerr);
+            routes.emplace_back(route ? route->GetGateway() : Ipv4Address(),
+                                route ? route->GetOutputDevice() : nullptr);
+        }
+    }
+    return routes;
+}
+
+void
+Ipv4GlobalRoutingLookupTestCase::DoRun()
+{
+    auto node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    SimpleNetDeviceHelper devHelper;
+    auto devices = devHelper.Install(NodeContainer(node, node, node));
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("192.168.0.0", "255.255.255.0");
+    ipv4.Assign(devices);
+
+    auto routing = CreateObject<Ipv4GlobalRouting>();
+    routing->SetIpv4(node->GetObject<Ipv4>());
+
+    auto rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    // addresses in 10.0.0.0/16, so that routes overlap
+    auto randomAddress = [&]() { return Ipv4Address(0x0a000000 | rng->GetInteger(0, 0xffff)); };
+
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        const auto interface = rng->GetInteger(1, 3);
+        const auto gateway = Ipv4Address(0xc0a80000 | (interface - 1) << 8 | rng->GetInteger(2, 5));
+        const auto mask = Ipv4Mask(("/" + std::to_string(rng->GetInteger(8, 31))).c_str());
+        switch (i % 3)
+        {
+        case 0:
+            routing->AddHostRouteTo(Ipv4Address(0x0a000000 | rng->GetInteger(0, 0x3ff)),
+                                    gateway,
+                                    interface);
+            break;
+        case 1:
+            routing->AddNetworkRouteTo(randomAddress().CombineMask(mask),
+                                       mask,
+                                       gateway,
+                                       interface);
+            break;
+        default:
+            routing->AddASExternalRouteTo(randomAddress().CombineMask(mask),
+                                          mask,
+                                          gateway,
+                                          interface);
+        }
+    }
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+        routing->RemoveRoute(rng->GetInteger(0, routing->GetNRoutes() - 1));
+    }
+
+    std::vector<std::pair<Ipv4Address, Ptr<NetDevice>>> destinations;
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        const auto oif = rng->GetInteger(0, 3);
+        destinations.emplace_back(randomAddress(), oif == 0 ? nullptr : devices.Get(oif - 1));
+    }
+    destinations.emplace_back(Ipv4Address("172.16.0.1"), nullptr);
+
+    const auto trieRoutes = Lookup(routing, destinations);
+
+    // a route that matches none of the destinations
+    routing->AddNetworkRouteTo(Ipv4Address("192.0.1.0"), Ipv4Mask("255.0.255.0"), 1);
+    const auto scanRoutes = Lookup(routing, destinations);
+
+    std::size_t nFound = 0;
+    for (std::size_t i = 0; i < trieRoutes.size(); ++i)
+    {
+        const auto& dest = destinations[i % destinations.size()].first;
+        NS_TEST_EXPECT_MSG_EQ(trieRoutes[i].first,
+                              scanRoutes[i].first,
+                              "Unexpected gateway for destination " << dest);
+        NS_TEST_EXPECT_MSG_EQ(trieRoutes[i].second,
+                              scanRoutes[i].second,
+                              "Unexpected device for destination " << dest);
+        nFound += (trieRoutes[i].second ? 1 : 0);
+    }
+    NS_TEST_EXPECT_MSG_GT(nFound, 0, "No route found");
+    NS_TEST_EXPECT_MSG_EQ(trieRoutes.back().second, nullptr, "No route expected to 172.16.0.1");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1784,6 +1932,7 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::Duration::QUICK);
     AddTestCase(new EcmpRouteCalculationTestCase, TestCase::Duration::QUICK);
     AddTestCase(new GlobalRoutingProtocolTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4GlobalRoutingLookupTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
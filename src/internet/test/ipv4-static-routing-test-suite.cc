@@ -10,10 +10,12 @@
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
 #include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
 #include "ns3/node-container.h"
 #include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/simple-channel.h"
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/simple-net-device.h"
@@ -24,6 +26,10 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -196,6 +202,140 @@ Ipv4StaticRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 StaticRouting lookup test.
+ *
+ * A large number of overlapping routes with different metrics is added to (and some of them
+ * removed from) the routing table. The routes returned for random destinations when the routes
+ * are searched in the prefix trie are checked against the routes returned when the routing
+ * table is scanned, which happens once a route whose mask is not a prefix mask is added.
+ */
+class Ipv4StaticRoutingLookupTestCase : public TestCase
+{
+  public:
+    Ipv4StaticRoutingLookupTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Gateway and output device of the route to a destination
+    using RouteInfo = std::pair<Ipv4Address, Ptr<NetDevice>>;
+
+    /**
+     * Look up the route to the given destinations.
+     *
+     * @param routing the routing protocol
+     * @param destinations the destinations and the requested output devices
+     * @return the gateway and output device of the route to each destination
+     */
+    std::vector<RouteInfo> Lookup(
+        Ptr<Ipv4StaticRouting> routing,
+        const std::vector<std::pair<Ipv4Address, Ptr<NetDevice>>>& destinations);
+};
+
+Ipv4StaticRoutingLookupTestCase::Ipv4StaticRoutingLookupTestCase()
+    : TestCase("Static routing lookup in the prefix trie")
+{
+}
+
+std::vector<Ipv4StaticRoutingLookupTestCase::RouteInfo>
+Ipv4StaticRoutingLookupTestCase::Lookup(
+    Ptr<Ipv4StaticRouting> routing,
+    const std::vector<std::pair<Ipv4Address, Ptr<NetDevice>>>& destinations)
+{
+    std::vector<RouteInfo> routes;
+    for (const auto& [dest, oif] : destinations)
+    {
+        Ipv4Header header;
+        header.SetDestination(dest);
+        Socket::SocketErrno sockerr;
+        auto route = routing->RouteOutput(Create<Packet>(), header, oif, sockerr);
+        routes.emplace_back(route ? route->GetGateway() : Ipv4Address(),
+                            route ? route->GetOutputDevice() : nullptr);
+    }
+    return routes;
+}
+
+void
+Ipv4StaticRoutingLookupTestCase::DoRun()
+{
+    auto node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    SimpleNetDeviceHelper devHelper;
+    auto devices = devHelper.Install(NodeContainer(node, node, node));
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("192.168.0.0", "255.255.255.0");
+    ipv4.Assign(devices);
+
+    auto routing = CreateObject<Ipv4StaticRouting>();
+    routing->SetIpv4(node->GetObject<Ipv4>());
+
+    auto rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    // addresses in 10.0.0.0/16, so that routes overlap
+    auto randomAddress = [&]() { return Ipv4Address(0x0a000000 | rng->GetInteger(0, 0xffff)); };
+
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        const auto interface = rng->GetInteger(1, 3);
+        const auto gateway = Ipv4Address(0xc0a80000 | (interface - 1) << 8 | rng->GetInteger(2, 5));
+        const auto metric = rng->GetInteger(0, 2);
+        if (i % 4 == 0)
+        {
+            routing->AddHostRouteTo(randomAddress(), gateway, interface, metric);
+        }
+        else
+        {
+            const auto mask = Ipv4Mask(("/" + std::to_string(rng->GetInteger(8, 31))).c_str());
+            routing->AddNetworkRouteTo(randomAddress().CombineMask(mask),
+                                       mask,
+                                       gateway,
+                                       interface,
+                                       metric);
+        }
+    }
+    routing->SetDefaultRoute(Ipv4Address("192.168.0.2"), 1, 3);
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+        routing->RemoveRoute(rng->GetInteger(0, routing->GetNRoutes() - 1));
+    }
+
+    std::vector<std::pair<Ipv4Address, Ptr<NetDevice>>> destinations;
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        const auto oif = rng->GetInteger(0, 3);
+        destinations.emplace_back(randomAddress(), oif == 0 ? nullptr : devices.Get(oif - 1));
+    }
+    destinations.emplace_back(Ipv4Address("172.16.0.1"), nullptr);
+
+    const auto trieRoutes = Lookup(routing, destinations);
+
+    // a route that matches none of the destinations
+    routing->AddNetworkRouteTo(Ipv4Address("192.0.1.0"), Ipv4Mask("255.0.255.0"), 1);
+    const auto scanRoutes = Lookup(routing, destinations);
+
+    std::size_t nNonDefaultRoutes = 0;
+    for (std::size_t i = 0; i < destinations.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(trieRoutes[i].first,
+                              scanRoutes[i].first,
+                              "Unexpected gateway for destination " << destinations[i].first);
+        NS_TEST_EXPECT_MSG_EQ(trieRoutes[i].second,
+                              scanRoutes[i].second,
+                              "Unexpected device for destination " << destinations[i].first);
+        if (trieRoutes[i].first != Ipv4Address("192.168.0.2"))
+        {
+            ++nNonDefaultRoutes;
+        }
+    }
+    NS_TEST_EXPECT_MSG_GT(nNonDefaultRoutes, 0, "No route other than the default route was used");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -211,6 +351,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite()
     : TestSuite("ipv4-static-routing", Type::UNIT)
 {
     AddTestCase(new Ipv4StaticRoutingSlash32TestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4StaticRoutingLookupTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite
@@ -6,6 +6,7 @@
  * Author: Zhiheng Dong <dzh2077@gmail.com>
  */
 
+#include "ns3/arp-cache.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/internet-stack-helper.h"
@@ -15,6 +16,7 @@
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-routing-helper.h"
+#include "ns3/ndisc-cache.h"
 #include "ns3/neighbor-cache-helper.h"
 #include "ns3/simple-channel.h"
 #include "ns3/simple-net-device-helper.h"
@@ -26,6 +28,9 @@
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/udp-socket-factory.h"
 
+#include <sstream>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -1210,6 +1215,202 @@ DynamicPartialTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief Neighbor Cache Lookup Test: checks that the entries of large ARP and NDISC caches are
+ * found by IP and MAC address, also after some entries have been removed.
+ */
+class CacheLookupTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    CacheLookupTest();
+};
+
+CacheLookupTest::CacheLookupTest()
+    : TestCase("The CacheLookupTest checks the lookups in large ARP and NDISC caches.")
+{
+}
+
+void
+CacheLookupTest::DoRun()
+{
+    const uint32_t nEntries = 1000;
+    const uint32_t nMacs = 10;
+    std::vector<Mac48Address> macs;
+    for (uint32_t i = 0; i < nMacs; i++)
+    {
+        macs.push_back(Mac48Address::Allocate());
+    }
+    auto ipv6Address = [](uint32_t i) {
+        std::ostringstream oss;
+        oss << "2001::" << std::hex << i + 1;
+        return Ipv6Address(oss.str().c_str());
+    };
+
+    auto arpCache = CreateObject<ArpCache>();
+    auto ndiscCache = CreateObject<NdiscCache>();
+    for (uint32_t i = 0; i < nEntries; i++)
+    {
+        arpCache->Add(Ipv4Address(0x0a000001 + i))->SetMacAddress(macs[i % nMacs]);
+        ndiscCache->Add(ipv6Address(i))->SetMacAddress(macs[i % nMacs]);
+    }
+    // every other entry is auto-generated
+    for (uint32_t i = 0; i < nEntries; i += 2)
+    {
+        arpCache->Lookup(Ipv4Address(0x0a000001 + i))->MarkAutoGenerated();
+        ndiscCache->Lookup(ipv6Address(i))->MarkAutoGenerated();
+    }
+    for (uint32_t i = 0; i < nEntries; i++)
+    {
+        auto arpEntry = arpCache->Lookup(Ipv4Address(0x0a000001 + i));
+        NS_TEST_ASSERT_MSG_NE(arpEntry, nullptr, "ARP entry " << i << " not found");
+        NS_TEST_EXPECT_MSG_EQ(arpEntry->GetIpv4Address(),
+                              Ipv4Address(0x0a000001 + i),
+                              "Wrong ARP entry found");
+        auto ndiscEntry = ndiscCache->Lookup(ipv6Address(i));
+        NS_TEST_ASSERT_MSG_NE(ndiscEntry, nullptr, "NDISC entry " << i << " not found");
+        NS_TEST_EXPECT_MSG_EQ(ndiscEntry->GetIpv6Address(),
+                              ipv6Address(i),
+                              "Wrong NDISC entry found");
+    }
+    NS_TEST_EXPECT_MSG_EQ(arpCache->Lookup(Ipv4Address(0x0a000001 + nEntries)),
+                          nullptr,
+                          "Unexpected ARP entry found");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->Lookup(ipv6Address(nEntries)),
+                          nullptr,
+                          "Unexpected NDISC entry found");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(macs[1]).size(),
+                          nEntries / nMacs,
+                          "Wrong number of ARP entries with the same MAC address");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(macs[1]).size(),
+                          nEntries / nMacs,
+                          "Wrong number of NDISC entries with the same MAC address");
+
+    // change the MAC address of an entry
+    arpCache->Lookup(Ipv4Address(0x0a000002))->SetMacAddress(macs[2]);
+    ndiscCache->Lookup(ipv6Address(1))->SetMacAddress(macs[2]);
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(macs[1]).size(),
+                          nEntries / nMacs - 1,
+                          "Wrong number of ARP entries with the old MAC address");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(macs[2]).size(),
+                          nEntries / nMacs + 1,
+                          "Wrong number of NDISC entries with the new MAC address");
+
+    arpCache->RemoveAutoGeneratedEntries();
+    ndiscCache->RemoveAutoGeneratedEntries();
+    for (uint32_t i = 0; i < nEntries; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((arpCache->Lookup(Ipv4Address(0x0a000001 + i)) != nullptr),
+                              (i % 2 == 1),
+                              "Only the entries that are not auto-generated should be left");
+        NS_TEST_EXPECT_MSG_EQ((ndiscCache->Lookup(ipv6Address(i)) != nullptr),
+                              (i % 2 == 1),
+                              "Only the entries that are not auto-generated should be left");
+    }
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(macs[0]).size(),
+                          0,
+                          "ARP entries with removed MAC address should not be found");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(macs[3]).size(),
+                          nEntries / nMacs,
+                          "Wrong number of NDISC entries with the same MAC address");
+
+    arpCache->Remove(arpCache->Lookup(Ipv4Address(0x0a000004)));
+    ndiscCache->Remove(ndiscCache->Lookup(ipv6Address(3)));
+    NS_TEST_EXPECT_MSG_EQ(arpCache->Lookup(Ipv4Address(0x0a000004)),
+                          nullptr,
+                          "Removed ARP entry found");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->Lookup(ipv6Address(3)),
+                          nullptr,
+                          "Removed NDISC entry found");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(macs[3]).size(),
+                          nEntries / nMacs - 1,
+                          "Removed NDISC entry found by MAC address");
+
+    arpCache->Dispose();
+    ndiscCache->Dispose();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief NDISC Cache NUD Timer Test: checks that the reachable timer of an entry expires after
+ * the reachable time, which is restarted when the reachable timer is updated.
+ */
+class NudTimerTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    NudTimerTest();
+
+  private:
+    /**
+     * @brief Store the state of the entries.
+     * @param index the index of the stored states
+     */
+    void CheckStates(uint32_t index);
+
+    std::vector<NdiscCache::Entry*> m_entries;  //!< Entries of the NDISC cache.
+    std::vector<std::vector<bool>> m_reachable; //!< Whether the entries were REACHABLE.
+};
+
+NudTimerTest::NudTimerTest()
+    : TestCase("The NudTimerTest checks the expiration of the reachable timer of NDISC entries.")
+{
+}
+
+void
+NudTimerTest::CheckStates(uint32_t index)
+{
+    for (auto entry : m_entries)
+    {
+        m_reachable[index].push_back(entry->IsReachable());
+    }
+}
+
+void
+NudTimerTest::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    SimpleNetDeviceHelper simpleHelper;
+    NetDeviceContainer net = simpleHelper.Install(node);
+    InternetStackHelper internet;
+    internet.SetIpv4StackInstall(false);
+    internet.Install(node);
+    Ipv6AddressHelper ipv6;
+    ipv6.SetBase(Ipv6Address("2001:0::"), Ipv6Prefix(64));
+    Ipv6InterfaceContainer icv6 = ipv6.Assign(net);
+
+    auto ipv6L3 = DynamicCast<Ipv6L3Protocol>(icv6.Get(0).first);
+    Ptr<NdiscCache> ndiscCache = ipv6L3->GetInterface(icv6.Get(0).second)->GetNdiscCache();
+    auto reachableTime = node->GetObject<Icmpv6L4Protocol>()->GetReachableTime();
+
+    // the first entry is confirmed again after 10 seconds, the second one is not
+    for (auto address : {"2001::2", "2001::3"})
+    {
+        auto entry = ndiscCache->Add(Ipv6Address(address));
+        entry->MarkReachable(Mac48Address::Allocate());
+        entry->StartReachableTimer();
+        m_entries.push_back(entry);
+    }
+    m_reachable.resize(3);
+    Simulator::Schedule(Seconds(10), &NdiscCache::Entry::UpdateReachableTimer, m_entries[0]);
+    Simulator::Schedule(reachableTime - Seconds(1), &NudTimerTest::CheckStates, this, 0);
+    Simulator::Schedule(reachableTime + Seconds(1), &NudTimerTest::CheckStates, this, 1);
+    Simulator::Schedule(reachableTime + Seconds(11), &NudTimerTest::CheckStates, this, 2);
+
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_reachable[0][0], true, "The first entry should be REACHABLE");
+    NS_TEST_EXPECT_MSG_EQ(m_reachable[0][1], true, "The second entry should be REACHABLE");
+    NS_TEST_EXPECT_MSG_EQ(m_reachable[1][0], true, "The first entry should be REACHABLE");
+    NS_TEST_EXPECT_MSG_EQ(m_reachable[1][1], false, "The second entry should be STALE");
+    NS_TEST_EXPECT_MSG_EQ(m_reachable[2][0], false, "The first entry should be STALE");
+    NS_TEST_EXPECT_MSG_EQ(m_reachable[2][1], false, "The second entry should be STALE");
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1228,6 +1429,8 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new FlushTest, TestCase::Duration::QUICK);
         AddTestCase(new DuplicateTest, TestCase::Duration::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::Duration::QUICK);
+        AddTestCase(new CacheLookupTest, TestCase::Duration::QUICK);
+        AddTestCase(new NudTimerTest, TestCase::Duration::QUICK);
     }
 };
 
@@ -10,6 +10,8 @@
 #include "ns3/core-module.h"
 #include "ns3/tcp-header.h"
 #include "ns3/tcp-option-rfc793.h"
+#include "ns3/tcp-option-sack.h"
+#include "ns3/tcp-option-ts.h"
 #include "ns3/test.h"
 
 #include <stdint.h>
@@ -371,6 +373,143 @@ TcpHeaderWithRFC793OptionTestCase::DoTeardown()
 {
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief TCP header with the standard options stored inline test.
+ *
+ * Checks that the options appended through the typed accessors are serialized
+ * and deserialized in order, that they are serialized as the corresponding
+ * TcpOption objects, and that the SACK option is limited by the option space.
+ */
+class TcpHeaderInlineOptionsTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param name Test description.
+     */
+    TcpHeaderInlineOptionsTestCase(std::string name);
+
+  private:
+    void DoRun() override;
+};
+
+TcpHeaderInlineOptionsTestCase::TcpHeaderInlineOptionsTestCase(std::string name)
+    : TestCase(name)
+{
+}
+
+void
+TcpHeaderInlineOptionsTestCase::DoRun()
+{
+    TcpOptionSack::SackList sackList;
+    for (uint32_t i = 1; i <= 5; ++i)
+    {
+        sackList.emplace_back(SequenceNumber32(i * 1000), SequenceNumber32(i * 1000 + 500));
+    }
+
+    // typed accessors, serialization and deserialization
+    {
+        TcpHeader header;
+        NS_TEST_ASSERT_MSG_EQ(header.AppendOptionWinScale(7), true, "Window Scale not appended");
+        NS_TEST_ASSERT_MSG_EQ(header.AppendOptionSackPermitted(),
+                              true,
+                              "SACK-Permitted not appended");
+        NS_TEST_ASSERT_MSG_EQ(header.AppendOptionTs(1234, 5678), true, "Timestamp not appended");
+        NS_TEST_ASSERT_MSG_EQ(header.AppendOptionTs(1, 2), false, "Second Timestamp appended");
+        NS_TEST_ASSERT_MSG_EQ(header.AppendOptionSack(sackList), true, "SACK not appended");
+        NS_TEST_ASSERT_MSG_EQ(header.GetOptionSackBlocks().size(),
+                              2,
+                              "The SACK option should be limited by the option space");
+        NS_TEST_ASSERT_MSG_EQ(header.GetOptionLength(), 3 + 2 + 10 + 18, "Wrong option length");
+        NS_TEST_ASSERT_MSG_EQ(header.GetSerializedSize(), 56, "Wrong serialized size");
+
+        Buffer buffer;
+        buffer.AddAtStart(header.GetSerializedSize());
+        header.Serialize(buffer.Begin());
+
+        Buffer::Iterator i = buffer.Begin();
+        i.Next(20);
+        NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), TcpOption::WINSCALE, "Wrong first option");
+        i.Next(2);
+        NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), TcpOption::SACKPERMITTED, "Wrong second option");
+        i.Next(1);
+        NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), TcpOption::TS, "Wrong third option");
+        i.Next(9);
+        NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), TcpOption::SACK, "Wrong fourth option");
+        NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), 18, "Wrong SACK option length");
+
+        TcpHeader dest;
+        NS_TEST_ASSERT_MSG_EQ(dest.Deserialize(buffer.Begin()),
+                              header.GetSerializedSize(),
+                              "Wrong deserialized size");
+        NS_TEST_ASSERT_MSG_EQ(dest.HasOption(TcpOption::MSS), false, "Unexpected MSS option");
+        NS_TEST_ASSERT_MSG_EQ(dest.HasOption(TcpOption::SACKPERMITTED),
+                              true,
+                              "SACK-Permitted not deserialized");
+        NS_TEST_ASSERT_MSG_EQ(dest.GetOptionWinScale(), 7, "Wrong Window Scale");
+        NS_TEST_ASSERT_MSG_EQ(dest.GetOptionTsValue(), 1234, "Wrong timestamp value");
+        NS_TEST_ASSERT_MSG_EQ(dest.GetOptionTsEcho(), 5678, "Wrong timestamp echo reply");
+        auto blocks = dest.GetOptionSackBlocks();
+        NS_TEST_ASSERT_MSG_EQ(blocks.size(), 2, "Wrong number of SACK blocks");
+        NS_TEST_ASSERT_MSG_EQ(blocks[1].first, SequenceNumber32(2000), "Wrong SACK block");
+        NS_TEST_ASSERT_MSG_EQ(blocks[1].second, SequenceNumber32(2500), "Wrong SACK block");
+
+        // compatibility path
+        const auto& options = dest.GetOptionList();
+        // the header is padded with an END option
+        NS_TEST_ASSERT_MSG_EQ(options.size(), 5, "Wrong number of options");
+        NS_TEST_ASSERT_MSG_EQ(options.front()->GetKind(),
+                              TcpOption::WINSCALE,
+                              "Wrong first option");
+        NS_TEST_ASSERT_MSG_EQ(options.back()->GetKind(), TcpOption::END, "Wrong last option");
+        auto ts = DynamicCast<const TcpOptionTS>(dest.GetOption(TcpOption::TS));
+        NS_TEST_ASSERT_MSG_NE(ts, nullptr, "Timestamp option not found");
+        NS_TEST_ASSERT_MSG_EQ(ts->GetTimestamp(), 1234, "Wrong timestamp value");
+        NS_TEST_ASSERT_MSG_EQ(ts->GetEcho(), 5678, "Wrong timestamp echo reply");
+    }
+
+    // options appended as TcpOption objects are serialized in the same way
+    {
+        auto ts = CreateObject<TcpOptionTS>();
+        ts->SetTimestamp(1234);
+        ts->SetEcho(5678);
+        auto sack = CreateObject<TcpOptionSack>();
+        sack->AddSackBlock(sackList.front());
+        auto nop = CreateObject<TcpOptionNOP>();
+
+        TcpHeader compat;
+        compat.AppendOption(nop);
+        compat.AppendOption(ts);
+        compat.AppendOption(nop);
+        compat.AppendOption(sack);
+        TcpHeader typed;
+        typed.AppendOption(nop);
+        typed.AppendOptionTs(1234, 5678);
+        typed.AppendOption(nop);
+        typed.AppendOptionSack({sackList.front()});
+
+        NS_TEST_ASSERT_MSG_EQ(compat.GetSerializedSize(),
+                              typed.GetSerializedSize(),
+                              "Different serialized sizes");
+        Buffer compatBuffer;
+        compatBuffer.AddAtStart(compat.GetSerializedSize());
+        compat.Serialize(compatBuffer.Begin());
+        Buffer typedBuffer;
+        typedBuffer.AddAtStart(typed.GetSerializedSize());
+        typed.Serialize(typedBuffer.Begin());
+        Buffer::Iterator i = compatBuffer.Begin();
+        Buffer::Iterator j = typedBuffer.Begin();
+        for (uint32_t k = 0; k < compatBuffer.GetSize(); ++k)
+        {
+            NS_TEST_ASSERT_MSG_EQ(i.ReadU8(), j.ReadU8(), "Different byte " << k);
+        }
+        NS_TEST_ASSERT_MSG_EQ(compat.GetOptionTsValue(), 1234, "Wrong timestamp value");
+        NS_TEST_ASSERT_MSG_EQ(compat.GetOptionSackBlocks().size(), 1, "Wrong SACK blocks");
+    }
+}
+
 /**
  * @ingroup internet-test
  *
@@ -456,6 +595,8 @@ class TcpHeaderTestSuite : public TestSuite
                     TestCase::Duration::QUICK);
         AddTestCase(new TcpHeaderFlagsToString("Test flags to string function"),
                     TestCase::Duration::QUICK);
+        AddTestCase(new TcpHeaderInlineOptionsTestCase("Test for the standard options"),
+                    TestCase::Duration::QUICK);
     }
 };
 
@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "tcp-general-test.h"
+
+#include "ns3/gso-tag.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/tcp-header.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpTsoTestSuite");
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief TCP segmentation offload emulation test
+ *
+ * The sender transmits data in super-segments larger than the MTU. The test checks that the
+ * super-segments are made of full-sized segments, are tagged with a GsoTag and do not exceed the
+ * configured maximum size, and that all the data is delivered to the receiver.
+ */
+class TcpTsoTestCase : public TcpGeneralTest
+{
+  public:
+    /**
+     * Constructor.
+     * @param desc Test description.
+     * @param tsoMaxSize Maximum payload size of the super-segments.
+     */
+    TcpTsoTestCase(const std::string& desc, uint32_t tsoMaxSize)
+        : TcpGeneralTest(desc),
+          m_tsoMaxSize(tsoMaxSize)
+    {
+    }
+
+  protected:
+    Ptr<TcpSocketMsgBase> CreateSenderSocket(Ptr<Node> node) override;
+    void ConfigureEnvironment() override;
+    void Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void FinalChecks() override;
+
+  private:
+    uint32_t m_tsoMaxSize;       //!< Maximum payload size of the super-segments
+    uint32_t m_superSegments{0}; //!< Number of super-segments sent
+    uint32_t m_dataPackets{0};   //!< Number of data packets sent
+    uint32_t m_bytesReceived{0}; //!< Number of bytes received by the receiver
+    uint32_t m_maxPacketSize{0}; //!< Largest payload sent
+};
+
+void
+TcpTsoTestCase::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktCount(200);
+    SetAppPktSize(500);
+    SetAppPktInterval(MicroSeconds(10));
+    SetMTU(1500);
+}
+
+Ptr<TcpSocketMsgBase>
+TcpTsoTestCase::CreateSenderSocket(Ptr<Node> node)
+{
+    auto socket = TcpGeneralTest::CreateSenderSocket(node);
+    socket->SetAttribute("TsoMaxSize", UintegerValue(m_tsoMaxSize));
+    return socket;
+}
+
+void
+TcpTsoTestCase::Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who != SENDER || p->GetSize() == 0)
+    {
+        return;
+    }
+
+    ++m_dataPackets;
+    m_maxPacketSize = std::max(m_maxPacketSize, p->GetSize());
+    const auto segmentSize = GetSegSize(SENDER);
+    GsoTag gso;
+    if (p->GetSize() <= segmentSize)
+    {
+        NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(gso), false, "Segment should not be tagged");
+        return;
+    }
+
+    ++m_superSegments;
+    NS_TEST_ASSERT_MSG_EQ(p->PeekPacketTag(gso), true, "Super-segment should be tagged");
+    NS_TEST_EXPECT_MSG_EQ(gso.GetSegmentSize(), segmentSize, "Unexpected segment size");
+    NS_TEST_EXPECT_MSG_EQ(gso.GetPayloadSize(), p->GetSize(), "Unexpected payload size");
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize() % segmentSize,
+                          0,
+                          "Super-segment should be made of full-sized segments");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(p->GetSize(), m_tsoMaxSize, "Super-segment is too large");
+}
+
+void
+TcpTsoTestCase::Rx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (who == RECEIVER)
+    {
+        m_bytesReceived += p->GetSize();
+    }
+}
+
+void
+TcpTsoTestCase::FinalChecks()
+{
+    NS_TEST_EXPECT_MSG_EQ(m_bytesReceived,
+                          GetPktSize() * GetPktCount(),
+                          "The receiver should have received all the data");
+    if (m_tsoMaxSize > GetSegSize(SENDER))
+    {
+        NS_TEST_EXPECT_MSG_GT(m_superSegments, 0, "Super-segments should have been sent");
+        NS_TEST_EXPECT_MSG_GT(m_maxPacketSize, GetMtu(), "Super-segments should exceed the MTU");
+        NS_TEST_EXPECT_MSG_LT(m_dataPackets,
+                              GetPktSize() * GetPktCount() / GetSegSize(SENDER),
+                              "Fewer packets than segments should have been sent");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_superSegments, 0, "No super-segment should have been sent");
+    }
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief TestSuite: TCP segmentation offload emulation
+ */
+class TcpTsoTestSuite : public TestSuite
+{
+  public:
+    TcpTsoTestSuite()
+        : TestSuite("tcp-tso", Type::UNIT)
+    {
+        AddTestCase(new TcpTsoTestCase("TSO disabled", 0), TestCase::Duration::QUICK);
+        AddTestCase(new TcpTsoTestCase("TSO with 4000 bytes super-segments", 4000),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new TcpTsoTestCase("TSO with 65000 bytes super-segments", 65000),
+                    TestCase::Duration::QUICK);
+    }
+};
+
+static TcpTsoTestSuite g_tcpTsoTestSuite; //!< Static variable for test initialization
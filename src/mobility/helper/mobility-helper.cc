@@ -238,4 +238,18 @@ MobilityHelper::GetDistanceSquaredBetween(Ptr<Node> n1, Ptr<Node> n2)
     return distSq;
 }
 
+void
+MobilityHelper::GetPositions(const NodeContainer& c, std::vector<Vector>& positions)
+{
+    NS_LOG_FUNCTION_NOARGS();
+    positions.resize(c.GetN());
+    auto position = positions.begin();
+    for (auto it = c.Begin(); it != c.End(); ++it, ++position)
+    {
+        auto mobility = (*it)->GetObject<MobilityModel>();
+        NS_ABORT_MSG_IF(!mobility, "Node " << (*it)->GetId() << " has no MobilityModel");
+        *position = mobility->GetPosition();
+    }
+}
+
 } // namespace ns3
@@ -218,6 +218,17 @@ class MobilityHelper
      */
     static double GetDistanceSquaredBetween(Ptr<Node> n1, Ptr<Node> n2);
 
+    /**
+     * Get the current positions of a set of nodes, e.g., to be consumed by channel models or
+     * spatial indexes. The vector is resized to the number of nodes and reused across calls,
+     * so that no allocation is needed if its capacity is large enough.
+     *
+     * @param c the set of nodes, each of which must have a MobilityModel aggregated
+     * @param positions the vector storing, on return, the position of each node, in the order
+     *                  in which nodes are stored in the container
+     */
+    static void GetPositions(const NodeContainer& c, std::vector<Vector>& positions);
+
   private:
     /**
      * Output course change events from mobility model to output stream
@@ -36,15 +36,20 @@ GeocentricConstantPositionMobilityModel::GetTypeId()
                 "latitude, longitude and "
                 "altitude",
                 Vector3DValue({0, 0, 0}),
-                MakeVector3DAccessor(&GeocentricConstantPositionMobilityModel::m_position),
+                MakeVector3DAccessor(
+                    &GeocentricConstantPositionMobilityModel::SetGeographicPosition,
+                    &GeocentricConstantPositionMobilityModel::GetGeographicPosition),
                 MakeVector3DChecker())
-            .AddAttribute("GeographicReferencePoint",
-                          "The point, in meters, taken as reference when converting from "
-                          "geographic to topographic.",
-                          Vector3DValue({0, 0, 0}),
-                          MakeVector3DAccessor(
-                              &GeocentricConstantPositionMobilityModel::m_geographicReferencePoint),
-                          MakeVector3DChecker());
+            .AddAttribute(
+                "GeographicReferencePoint",
+                "The point, in meters, taken as reference when converting from "
+                "geographic to topographic.",
+                Vector3DValue({0, 0, 0}),
+                MakeVector3DAccessor(&GeocentricConstantPositionMobilityModel::
+                                         SetCoordinateTranslationReferencePoint,
+                                     &GeocentricConstantPositionMobilityModel::
+                                         GetCoordinateTranslationReferencePoint),
+                MakeVector3DChecker());
     return tid;
 }
 
@@ -219,6 +224,8 @@ GeocentricConstantPositionMobilityModel::DoSetCoordinateTranslationReferencePoin
     const Vector& refPoint)
 {
     m_geographicReferencePoint = refPoint;
+    // the topocentric position changes without a course change
+    InvalidatePositionCache();
 }
 
 Vector
@@ -66,6 +66,7 @@ HierarchicalMobilityModel::SetChild(Ptr<MobilityModel> model)
     m_child->TraceConnectWithoutContext(
         "CourseChange",
         MakeCallback(&HierarchicalMobilityModel::ChildChanged, this));
+    InvalidatePositionCache();
 
     // if we had a child before, then we had a valid position before;
     // try to preserve the old absolute position.
@@ -99,6 +100,7 @@ HierarchicalMobilityModel::SetParent(Ptr<MobilityModel> model)
             "CourseChange",
             MakeCallback(&HierarchicalMobilityModel::ParentChanged, this));
     }
+    InvalidatePositionCache();
     // try to preserve the old position across parent changes
     if (m_child)
     {
@@ -8,6 +8,7 @@
 
 #include "mobility-model.h"
 
+#include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 
 #include <cmath>
@@ -55,7 +56,17 @@ MobilityModel::~MobilityModel()
 Vector
 MobilityModel::GetPosition() const
 {
-    return DoGetPosition();
+    const auto now = Simulator::Now().GetTimeStep();
+    if (m_cachedPositionValid && m_cachedPositionTime == now)
+    {
+        return m_cachedPosition;
+    }
+    // DoGetPosition() may notify a course change, hence the position is cached afterwards
+    auto position = DoGetPosition();
+    m_cachedPosition = position;
+    m_cachedPositionTime = now;
+    m_cachedPositionValid = true;
+    return position;
 }
 
 Vector
@@ -81,13 +92,15 @@ void
 MobilityModel::SetPosition(const Vector& position)
 {
     DoSetPosition(position);
+    // the position may be set without notifying a course change
+    InvalidatePositionCache();
 }
 
 double
 MobilityModel::GetDistanceFrom(Ptr<const MobilityModel> other) const
 {
-    Vector oPosition = other->DoGetPosition();
-    Vector position = DoGetPosition();
+    Vector oPosition = other->GetPosition();
+    Vector position = GetPosition();
     return CalculateDistance(position, oPosition);
 }
 
@@ -100,9 +113,16 @@ MobilityModel::GetRelativeSpeed(Ptr<const MobilityModel> other) const
 void
 MobilityModel::NotifyCourseChange() const
 {
+    InvalidatePositionCache();
     m_courseChangeTrace(this);
 }
 
+void
+MobilityModel::InvalidatePositionCache() const
+{
+    m_cachedPositionValid = false;
+}
+
 int64_t
 MobilityModel::AssignStreams(int64_t start)
 {
@@ -25,6 +25,12 @@ namespace ns3
  * metric international units.
  *
  * This is a base class for all specific mobility models.
+ *
+ * The position returned by GetPosition() is cached and the cached position is returned by
+ * subsequent calls made at the same simulation time, until the course of the object changes
+ * (i.e., NotifyCourseChange() is called) or the position is set. Subclasses that change the
+ * value returned by DoGetPosition() without notifying a course change must call
+ * InvalidatePositionCache().
  */
 class MOBILITY_EXPORT MobilityModel : public Object
 {
@@ -95,6 +101,12 @@ class MOBILITY_EXPORT MobilityModel : public Object
      */
     void NotifyCourseChange() const;
 
+    /**
+     * Must be invoked by subclasses when the position returned by DoGetPosition() at the
+     * current simulation time changes without a course change being notified.
+     */
+    void InvalidatePositionCache() const;
+
   private:
     /**
      * @return the current position.
@@ -139,6 +151,10 @@ class MOBILITY_EXPORT MobilityModel : public Object
      * or position has occurred.
      */
     ns3::TracedCallback<Ptr<const MobilityModel>> m_courseChangeTrace;
+
+    mutable Vector m_cachedPosition;           //!< position returned by the last DoGetPosition()
+    mutable int64_t m_cachedPositionTime{0};   //!< the time step at which the position was cached
+    mutable bool m_cachedPositionValid{false}; //!< whether the cached position is valid
 };
 
 } // namespace ns3
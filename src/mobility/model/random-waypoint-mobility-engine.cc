@@ -0,0 +1,460 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#include "random-waypoint-mobility-engine.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("RandomWaypointMobilityEngine");
+
+NS_OBJECT_ENSURE_REGISTERED(RandomWaypointMobilityEngine);
+NS_OBJECT_ENSURE_REGISTERED(RandomWaypointEngineMobilityModel);
+
+TypeId
+RandomWaypointMobilityEngine::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::RandomWaypointMobilityEngine")
+            .SetParent<Object>()
+            .SetGroupName("Mobility")
+            .AddConstructor<RandomWaypointMobilityEngine>()
+            .AddAttribute("Speed",
+                          "A random variable used to pick the speed of a random waypoint model.",
+                          StringValue("ns3::UniformRandomVariable[Min=0.3|Max=0.7]"),
+                          MakePointerAccessor(&RandomWaypointMobilityEngine::m_speed),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("Pause",
+                          "A random variable used to pick the pause of a random waypoint model.",
+                          StringValue("ns3::ConstantRandomVariable[Constant=2.0]"),
+                          MakePointerAccessor(&RandomWaypointMobilityEngine::m_pause),
+                          MakePointerChecker<RandomVariableStream>())
+            .AddAttribute("PositionAllocator",
+                          "The position model used to pick a destination point.",
+                          PointerValue(),
+                          MakePointerAccessor(&RandomWaypointMobilityEngine::m_position),
+                          MakePointerChecker<PositionAllocator>())
+            .AddAttribute("BatchInterval",
+                          "If strictly positive, the start of every pause and walk is delayed "
+                          "to the next multiple of this interval, so that the transitions of "
+                          "many nodes are processed by the same event.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&RandomWaypointMobilityEngine::m_batchInterval),
+                          MakeTimeChecker(Time(0)));
+    return tid;
+}
+
+RandomWaypointMobilityEngine::RandomWaypointMobilityEngine()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RandomWaypointMobilityEngine::~RandomWaypointMobilityEngine()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+RandomWaypointMobilityEngine::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_event.Cancel();
+    m_eventTime = -1;
+    m_transitions = {};
+    m_batch.clear();
+    m_position = nullptr;
+    m_speed = nullptr;
+    m_pause = nullptr;
+    Object::DoDispose();
+}
+
+uint32_t
+RandomWaypointMobilityEngine::GetNNodes() const
+{
+    return m_nNodes;
+}
+
+void
+RandomWaypointMobilityEngine::GetPositions(std::vector<Vector>& positions,
+                                           std::vector<Ptr<MobilityModel>>* models) const
+{
+    NS_LOG_FUNCTION(this << models);
+    const auto now = Simulator::Now().GetTimeStep();
+    const auto secondsPerStep = TimeStep(1).GetSeconds();
+    const std::size_t n = m_x.size();
+    positions.resize(m_nNodes);
+    if (models)
+    {
+        models->resize(m_nNodes);
+    }
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!m_models[i])
+        {
+            continue;
+        }
+        const auto t = static_cast<double>(std::min(now, m_legEnd[i]) - m_legStart[i]) *
+                       secondsPerStep;
+        positions[j].x = m_x[i] + m_vx[i] * t;
+        positions[j].y = m_y[i] + m_vy[i] * t;
+        positions[j].z = m_z[i] + m_vz[i] * t;
+        if (models)
+        {
+            (*models)[j] = m_models[i];
+        }
+        ++j;
+    }
+    NS_ASSERT(j == m_nNodes);
+}
+
+int64_t
+RandomWaypointMobilityEngine::AssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    m_speed->SetStream(stream);
+    m_pause->SetStream(stream + 1);
+    NS_ASSERT_MSG(m_position, "No position allocator added before using this engine");
+    int64_t positionStreamsAllocated = m_position->AssignStreams(stream + 2);
+    return (2 + positionStreamsAllocated);
+}
+
+uint32_t
+RandomWaypointMobilityEngine::Attach(RandomWaypointEngineMobilityModel* model)
+{
+    NS_LOG_FUNCTION(this << model);
+    const auto now = Simulator::Now().GetTimeStep();
+    ++m_nNodes;
+    if (!m_freeSlots.empty())
+    {
+        // reuse the index of a detached node; its generation is not reset, so that the
+        // transitions still queued for the detached node remain cancelled
+        const auto index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_x[index] = m_y[index] = m_z[index] = 0;
+        m_vx[index] = m_vy[index] = m_vz[index] = 0;
+        m_legStart[index] = m_legEnd[index] = now;
+        m_walking[index] = 0;
+        m_started[index] = 0;
+        m_models[index] = model;
+        return index;
+    }
+    const auto index = static_cast<uint32_t>(m_models.size());
+    m_x.push_back(0);
+    m_y.push_back(0);
+    m_z.push_back(0);
+    m_vx.push_back(0);
+    m_vy.push_back(0);
+    m_vz.push_back(0);
+    m_legStart.push_back(now);
+    m_legEnd.push_back(now);
+    m_generation.push_back(0);
+    m_walking.push_back(0);
+    m_started.push_back(0);
+    m_models.push_back(model);
+    return index;
+}
+
+void
+RandomWaypointMobilityEngine::Detach(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    NS_ASSERT(index < m_models.size() && m_models[index]);
+    // cancel the scheduled transition of the node, if any, and make its index available
+    ++m_generation[index];
+    m_models[index] = nullptr;
+    m_freeSlots.push_back(index);
+    --m_nNodes;
+    ScheduleEvent();
+}
+
+void
+RandomWaypointMobilityEngine::Start(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    m_started[index] = 1;
+    BeginPause(index);
+}
+
+double
+RandomWaypointMobilityEngine::GetWalkTime(uint32_t index, int64_t now) const
+{
+    return static_cast<double>(std::min(now, m_legEnd[index]) - m_legStart[index]) *
+           TimeStep(1).GetSeconds();
+}
+
+Vector
+RandomWaypointMobilityEngine::GetPosition(uint32_t index) const
+{
+    const auto t = GetWalkTime(index, Simulator::Now().GetTimeStep());
+    return Vector(m_x[index] + m_vx[index] * t,
+                  m_y[index] + m_vy[index] * t,
+                  m_z[index] + m_vz[index] * t);
+}
+
+void
+RandomWaypointMobilityEngine::SetPosition(uint32_t index, const Vector& position)
+{
+    NS_LOG_FUNCTION(this << index << position);
+    m_x[index] = position.x;
+    m_y[index] = position.y;
+    m_z[index] = position.z;
+    m_vx[index] = m_vy[index] = m_vz[index] = 0;
+    m_legStart[index] = m_legEnd[index] = Simulator::Now().GetTimeStep();
+    if (m_started[index])
+    {
+        // as done by the RandomWaypointMobilityModel, start a new pause now
+        m_walking[index] = 1;
+        ScheduleTransition(index, Time(0));
+    }
+}
+
+Vector
+RandomWaypointMobilityEngine::GetVelocity(uint32_t index) const
+{
+    if (Simulator::Now().GetTimeStep() >= m_legEnd[index])
+    {
+        return Vector(0, 0, 0);
+    }
+    return Vector(m_vx[index], m_vy[index], m_vz[index]);
+}
+
+void
+RandomWaypointMobilityEngine::BeginPause(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    const auto position = GetPosition(index);
+    m_x[index] = position.x;
+    m_y[index] = position.y;
+    m_z[index] = position.z;
+    m_vx[index] = m_vy[index] = m_vz[index] = 0;
+    m_legStart[index] = m_legEnd[index] = Simulator::Now().GetTimeStep();
+    m_walking[index] = 0;
+    ScheduleTransition(index, Seconds(m_pause->GetValue()));
+    m_models[index]->NotifyCourseChange();
+}
+
+void
+RandomWaypointMobilityEngine::BeginWalk(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+    const auto now = Simulator::Now().GetTimeStep();
+    const auto current = GetPosition(index);
+    NS_ASSERT_MSG(m_position, "No position allocator added before using this engine");
+    Vector destination = m_position->GetNext();
+    Vector delta = destination - current;
+    double distance = delta.GetLength();
+    double speed = m_speed->GetValue();
+
+    NS_ASSERT_MSG(speed > 0, "Speed must be strictly positive.");
+
+    // Note: the following two lines are needed to prevent corner cases where
+    // the distance is null (and the Velocity is undefined).
+    double k = distance ? speed / distance : 0;
+    Time travelDelay = distance ? Seconds(distance / speed) : Time(0);
+
+    m_x[index] = current.x;
+    m_y[index] = current.y;
+    m_z[index] = current.z;
+    m_vx[index] = k * delta.x;
+    m_vy[index] = k * delta.y;
+    m_vz[index] = k * delta.z;
+    m_legStart[index] = now;
+    m_legEnd[index] = now + travelDelay.GetTimeStep();
+    m_walking[index] = 1;
+    ScheduleTransition(index, travelDelay);
+    m_models[index]->NotifyCourseChange();
+}
+
+void
+RandomWaypointMobilityEngine::ScheduleTransition(uint32_t index, Time delay)
+{
+    NS_LOG_FUNCTION(this << index << delay);
+    auto time = (Simulator::Now() + delay).GetTimeStep();
+    if (m_batchInterval.IsStrictlyPositive())
+    {
+        const auto interval = m_batchInterval.GetTimeStep();
+        time = (time + interval - 1) / interval * interval;
+    }
+    // a new generation invalidates the transition previously scheduled for the node, if any
+    m_transitions.push({time, index, ++m_generation[index]});
+    ScheduleEvent();
+}
+
+void
+RandomWaypointMobilityEngine::ScheduleEvent()
+{
+    // discard the cancelled transitions on top of the queue
+    while (!m_transitions.empty())
+    {
+        const auto& top = m_transitions.top();
+        if (m_models[top.index] && m_generation[top.index] == top.generation)
+        {
+            break;
+        }
+        m_transitions.pop();
+    }
+
+    if (m_transitions.empty())
+    {
+        m_event.Cancel();
+        m_eventTime = -1;
+        return;
+    }
+
+    const auto time = m_transitions.top().time;
+    if (m_event.IsPending() && m_eventTime <= time)
+    {
+        return;
+    }
+    m_event.Cancel();
+    m_eventTime = time;
+    m_event = Simulator::Schedule(TimeStep(time) - Simulator::Now(),
+                                  &RandomWaypointMobilityEngine::ProcessTransitions,
+                                  this);
+}
+
+void
+RandomWaypointMobilityEngine::ProcessTransitions()
+{
+    NS_LOG_FUNCTION(this);
+    const auto now = Simulator::Now().GetTimeStep();
+    m_eventTime = -1;
+
+    // extract all the due transitions first, ordered by node index, so that the transitions
+    // scheduled while processing the batch are handled by a subsequent event
+    m_batch.clear();
+    while (!m_transitions.empty() && m_transitions.top().time <= now)
+    {
+        m_batch.push_back(m_transitions.top());
+        m_transitions.pop();
+    }
+    NS_LOG_DEBUG("Processing " << m_batch.size() << " transitions");
+
+    for (const auto& transition : m_batch)
+    {
+        const auto index = transition.index;
+        // the transition may have been cancelled while processing the batch (e.g., by a
+        // course change callback setting the position of the node)
+        if (!m_models[index] || m_generation[index] != transition.generation)
+        {
+            continue;
+        }
+        if (m_walking[index])
+        {
+            BeginPause(index);
+        }
+        else
+        {
+            BeginWalk(index);
+        }
+    }
+    ScheduleEvent();
+}
+
+TypeId
+RandomWaypointEngineMobilityModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::RandomWaypointEngineMobilityModel")
+            .SetParent<MobilityModel>()
+            .SetGroupName("Mobility")
+            .AddConstructor<RandomWaypointEngineMobilityModel>()
+            .AddAttribute("Engine",
+                          "The engine moving the node according to the random waypoint model.",
+                          PointerValue(),
+                          MakePointerAccessor(&RandomWaypointEngineMobilityModel::SetEngine,
+                                              &RandomWaypointEngineMobilityModel::GetEngine),
+                          MakePointerChecker<RandomWaypointMobilityEngine>());
+    return tid;
+}
+
+RandomWaypointEngineMobilityModel::RandomWaypointEngineMobilityModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RandomWaypointEngineMobilityModel::~RandomWaypointEngineMobilityModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+RandomWaypointEngineMobilityModel::SetEngine(Ptr<RandomWaypointMobilityEngine> engine)
+{
+    NS_LOG_FUNCTION(this << engine);
+    if (engine == m_engine)
+    {
+        return;
+    }
+    Vector position;
+    if (m_engine)
+    {
+        position = m_engine->GetPosition(m_index);
+        m_engine->Detach(m_index);
+    }
+    m_engine = engine;
+    if (m_engine)
+    {
+        m_index = m_engine->Attach(this);
+        m_engine->SetPosition(m_index, position);
+    }
+}
+
+Ptr<RandomWaypointMobilityEngine>
+RandomWaypointEngineMobilityModel::GetEngine() const
+{
+    return m_engine;
+}
+
+void
+RandomWaypointEngineMobilityModel::DoInitialize()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(!m_engine, "No engine set before using this model");
+    m_engine->Start(m_index);
+    MobilityModel::DoInitialize();
+}
+
+void
+RandomWaypointEngineMobilityModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_engine)
+    {
+        m_engine->Detach(m_index);
+        m_engine = nullptr;
+    }
+    MobilityModel::DoDispose();
+}
+
+Vector
+RandomWaypointEngineMobilityModel::DoGetPosition() const
+{
+    NS_ASSERT_MSG(m_engine, "No engine set before using this model");
+    return m_engine->GetPosition(m_index);
+}
+
+void
+RandomWaypointEngineMobilityModel::DoSetPosition(const Vector& position)
+{
+    NS_ASSERT_MSG(m_engine, "No engine set before using this model");
+    m_engine->SetPosition(m_index, position);
+}
+
+Vector
+RandomWaypointEngineMobilityModel::DoGetVelocity() const
+{
+    NS_ASSERT_MSG(m_engine, "No engine set before using this model");
+    return m_engine->GetVelocity(m_index);
+}
+
+} // namespace ns3
@@ -0,0 +1,284 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+#ifndef RANDOM_WAYPOINT_MOBILITY_ENGINE_H
+#define RANDOM_WAYPOINT_MOBILITY_ENGINE_H
+
+#include "mobility-model.h"
+#include "position-allocator.h"
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+namespace ns3
+{
+
+class RandomWaypointEngineMobilityModel;
+
+/**
+ * @ingroup mobility
+ * @brief Centralized engine moving a (possibly large) population of nodes according to the
+ * random waypoint model.
+ *
+ * The engine implements the same process as the RandomWaypointMobilityModel: each node starts
+ * by pausing for a duration drawn from the "Pause" random variable, then picks a destination
+ * via the PositionAllocator and a speed via the "Speed" random variable and moves towards the
+ * destination at constant speed; when the destination is reached, the process starts over.
+ *
+ * Differently from the RandomWaypointMobilityModel, the state of all the nodes (position and
+ * time at the start of the current leg, velocity, arrival time and time of the next pause/walk
+ * transition) is stored in a structure of arrays owned by the engine, and the transitions of
+ * all the nodes are handled by a single scheduled event at a time, which processes all the
+ * nodes whose transition is due in a batch. The "BatchInterval" attribute can be used to align
+ * transitions to a time grid, so that more nodes are processed by each event; a node reaching
+ * its destination between two grid points stays there until the next grid point.
+ *
+ * Nodes are attached to the engine through RandomWaypointEngineMobilityModel objects, which
+ * implement the MobilityModel interface on top of the engine and can be installed on nodes
+ * by the MobilityHelper, e.g.:
+ *
+ * @code
+ *   auto engine = CreateObject<RandomWaypointMobilityEngine>();
+ *   engine->SetAttribute("PositionAllocator", PointerValue(positionAllocator));
+ *   MobilityHelper mobility;
+ *   mobility.SetMobilityModel("ns3::RandomWaypointEngineMobilityModel",
+ *                             "Engine",
+ *                             PointerValue(engine));
+ *   mobility.Install(nodes);
+ * @endcode
+ *
+ * Random variables are drawn by the engine in the order in which nodes are processed (i.e.,
+ * by increasing transition time and, for equal transition times, by increasing node index
+ * within the engine), hence the trajectories differ from those generated by independent
+ * RandomWaypointMobilityModel objects.
+ */
+class RandomWaypointMobilityEngine : public Object
+{
+  public:
+    /**
+     * Register this type with the TypeId system.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    RandomWaypointMobilityEngine();
+    ~RandomWaypointMobilityEngine() override;
+
+    /**
+     * @return the number of nodes currently attached to this engine
+     */
+    uint32_t GetNNodes() const;
+
+    /**
+     * Get the current positions of all the nodes attached to this engine, in the order of
+     * their index within the engine. The index of a detached node is reused by the next node
+     * attached to the engine, hence this order is the order of attachment only as long as no
+     * node is detached.
+     *
+     * @param positions the vector storing, on return, the positions of the nodes
+     * @param models if not null, the vector storing, on return, the mobility models of the
+     *               nodes, in the same order as the positions
+     */
+    void GetPositions(std::vector<Vector>& positions,
+                      std::vector<Ptr<MobilityModel>>* models = nullptr) const;
+
+    /**
+     * Assign a fixed random variable stream number to the random variables used by this
+     * engine.
+     *
+     * @param stream first stream index to use
+     * @return the number of stream indices assigned by this engine
+     */
+    int64_t AssignStreams(int64_t stream);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    friend class RandomWaypointEngineMobilityModel;
+
+    /**
+     * Attach a node to this engine.
+     *
+     * @param model the mobility model of the node
+     * @return the index of the node within this engine
+     */
+    uint32_t Attach(RandomWaypointEngineMobilityModel* model);
+
+    /**
+     * Detach a node from this engine. The index of the node is reused by the next node
+     * attached to this engine.
+     *
+     * @param index the index of the node within this engine
+     */
+    void Detach(uint32_t index);
+
+    /**
+     * Start the random waypoint process for a node, by making it pause.
+     *
+     * @param index the index of the node within this engine
+     */
+    void Start(uint32_t index);
+
+    /**
+     * @param index the index of the node within this engine
+     * @return the current position of the node
+     */
+    Vector GetPosition(uint32_t index) const;
+
+    /**
+     * Set the position of a node. If the node has been started, it starts pausing.
+     *
+     * @param index the index of the node within this engine
+     * @param position the position of the node
+     */
+    void SetPosition(uint32_t index, const Vector& position);
+
+    /**
+     * @param index the index of the node within this engine
+     * @return the current velocity of the node
+     */
+    Vector GetVelocity(uint32_t index) const;
+
+    /**
+     * Make a node pause at its current position and schedule the start of its next walk.
+     *
+     * @param index the index of the node within this engine
+     */
+    void BeginPause(uint32_t index);
+
+    /**
+     * Make a node walk towards a new destination and schedule the start of its next pause.
+     *
+     * @param index the index of the node within this engine
+     */
+    void BeginWalk(uint32_t index);
+
+    /**
+     * Schedule the next transition of a node.
+     *
+     * @param index the index of the node within this engine
+     * @param delay the delay after which the transition is due
+     */
+    void ScheduleTransition(uint32_t index, Time delay);
+
+    /**
+     * Make sure that the event of this engine is scheduled at the time of the earliest
+     * transition.
+     */
+    void ScheduleEvent();
+
+    /**
+     * Process all the transitions that are due.
+     */
+    void ProcessTransitions();
+
+    /**
+     * @param index the index of a node within this engine
+     * @param now the current time step
+     * @return the number of seconds the node has been walking in the current leg
+     */
+    double GetWalkTime(uint32_t index, int64_t now) const;
+
+    /// A transition scheduled for a node
+    struct Transition
+    {
+        int64_t time;        //!< time step at which the transition is due
+        uint32_t index;      //!< index of the node within this engine
+        uint32_t generation; //!< generation of the node when the transition was scheduled
+
+        /**
+         * @param other another transition
+         * @return whether this transition is due after the other transition
+         */
+        bool operator>(const Transition& other) const
+        {
+            return time > other.time || (time == other.time && index > other.index);
+        }
+    };
+
+    Ptr<PositionAllocator> m_position; //!< pointer to position allocator
+    Ptr<RandomVariableStream> m_speed; //!< random variable to generate speeds
+    Ptr<RandomVariableStream> m_pause; //!< random variable to generate pauses
+    Time m_batchInterval;              //!< transitions are aligned to multiples of this interval
+
+    // state of the nodes, stored as a structure of arrays
+    std::vector<double> m_x;               //!< x coordinate at the start of the current leg
+    std::vector<double> m_y;               //!< y coordinate at the start of the current leg
+    std::vector<double> m_z;               //!< z coordinate at the start of the current leg
+    std::vector<double> m_vx;              //!< x component of the velocity
+    std::vector<double> m_vy;              //!< y component of the velocity
+    std::vector<double> m_vz;              //!< z component of the velocity
+    std::vector<int64_t> m_legStart;       //!< time step at the start of the current leg
+    std::vector<int64_t> m_legEnd;         //!< time step at which the node stops moving
+    std::vector<uint32_t> m_generation;    //!< incremented to cancel scheduled transitions
+    std::vector<uint8_t> m_walking;        //!< whether the next transition starts a pause
+    std::vector<uint8_t> m_started;        //!< whether the node has been started
+    /// attached mobility models (null if detached)
+    std::vector<RandomWaypointEngineMobilityModel*> m_models;
+
+    uint32_t m_nNodes{0};              //!< number of nodes currently attached
+    std::vector<uint32_t> m_freeSlots; //!< indices of the detached nodes, to be reused
+
+    /// scheduled transitions, the earliest on top
+    std::priority_queue<Transition, std::vector<Transition>, std::greater<>> m_transitions;
+    EventId m_event;                 //!< event processing the earliest transitions
+    int64_t m_eventTime{-1};         //!< time step of the scheduled event
+    std::vector<Transition> m_batch; //!< transitions processed by the current event
+};
+
+/**
+ * @ingroup mobility
+ * @brief Mobility model of a node moved by a RandomWaypointMobilityEngine.
+ *
+ * This mobility model stores no state besides the index of the node within the engine, which
+ * is set through the "Engine" attribute, and forwards all the operations to the engine.
+ */
+class RandomWaypointEngineMobilityModel : public MobilityModel
+{
+  public:
+    /**
+     * Register this type with the TypeId system.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    RandomWaypointEngineMobilityModel();
+    ~RandomWaypointEngineMobilityModel() override;
+
+    /**
+     * Attach this mobility model to the given engine.
+     *
+     * @param engine the engine moving the node
+     */
+    void SetEngine(Ptr<RandomWaypointMobilityEngine> engine);
+
+    /**
+     * @return the engine moving the node
+     */
+    Ptr<RandomWaypointMobilityEngine> GetEngine() const;
+
+  protected:
+    void DoInitialize() override;
+    void DoDispose() override;
+
+  private:
+    friend class RandomWaypointMobilityEngine;
+
+    Vector DoGetPosition() const override;
+    void DoSetPosition(const Vector& position) override;
+    Vector DoGetVelocity() const override;
+
+    Ptr<RandomWaypointMobilityEngine> m_engine; //!< the engine moving the node
+    uint32_t m_index{0};                        //!< index of the node within the engine
+};
+
+} // namespace ns3
+
+#endif /* RANDOM_WAYPOINT_MOBILITY_ENGINE_H */
@@ -12,6 +12,8 @@
  */
 
 #include "ns3/boolean.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/geocentric-constant-position-mobility-model.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/mobility-model.h"
 #include "ns3/scheduler.h"
@@ -20,6 +22,8 @@
 #include "ns3/vector.h"
 #include "ns3/waypoint-mobility-model.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -461,6 +465,149 @@ WaypointMobilityModelViaHelper::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Mobility model moving along the x axis at 1 m/s, which counts the calls to
+ * DoGetPosition()
+ */
+class CountingMobilityModel : public MobilityModel
+{
+  public:
+    /**
+     * Notify a course change without changing the course
+     */
+    void ChangeCourse()
+    {
+        NotifyCourseChange();
+    }
+
+    mutable uint32_t m_nCalls{0}; ///< number of calls to DoGetPosition()
+
+  private:
+    Vector DoGetPosition() const override
+    {
+        m_nCalls++;
+        return Vector(Simulator::Now().GetSeconds() + m_offset, 0, 0);
+    }
+
+    void DoSetPosition(const Vector& position) override
+    {
+        m_offset = position.x - Simulator::Now().GetSeconds();
+    }
+
+    Vector DoGetVelocity() const override
+    {
+        return Vector(1, 0, 0);
+    }
+
+    double m_offset{0}; ///< position at time zero
+};
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Test that positions are cached until the simulation time advances, the course
+ * changes or the position is set, and test the batched position query of the MobilityHelper
+ */
+class MobilityPositionCacheTest : public TestCase
+{
+  public:
+    MobilityPositionCacheTest();
+
+  private:
+    /**
+     * Check the position returned by the mobility model and the number of calls to
+     * DoGetPosition().
+     *
+     * @param expectedX the expected x coordinate
+     * @param expectedCalls the expected number of calls to DoGetPosition()
+     */
+    void CheckPosition(double expectedX, uint32_t expectedCalls);
+    void DoRun() override;
+
+    Ptr<CountingMobilityModel> m_mob; ///< mobility model
+};
+
+MobilityPositionCacheTest::MobilityPositionCacheTest()
+    : TestCase("Test the caching of positions and the batched position query")
+{
+}
+
+void
+MobilityPositionCacheTest::CheckPosition(double expectedX, uint32_t expectedCalls)
+{
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ_TOL(m_mob->GetPosition().x, expectedX, 1e-9, "Unexpected position");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_mob->m_nCalls, expectedCalls, "Unexpected number of calls");
+}
+
+void
+MobilityPositionCacheTest::DoRun()
+{
+    m_mob = CreateObject<CountingMobilityModel>();
+
+    CheckPosition(0, 1);
+    // the cached position is discarded when the position is set
+    m_mob->SetPosition(Vector(5, 0, 0));
+    CheckPosition(5, 2);
+    // the cached position is discarded when the course changes
+    m_mob->ChangeCourse();
+    CheckPosition(5, 3);
+    // the cached position is discarded when the time advances
+    Simulator::Schedule(Seconds(1), &MobilityPositionCacheTest::CheckPosition, this, 6, 4);
+    Simulator::Schedule(Seconds(2), &MobilityPositionCacheTest::CheckPosition, this, 7, 5);
+
+    // the cached position is discarded when the position or the reference point of a
+    // geocentric model are set through its attributes
+    auto geo = CreateObject<GeocentricConstantPositionMobilityModel>();
+    uint32_t nCourseChanges = 0;
+    geo->TraceConnectWithoutContext("CourseChange",
+                                    Callback<void, Ptr<const MobilityModel>>(
+                                        [&](Ptr<const MobilityModel>) { ++nCourseChanges; }));
+    geo->SetAttribute("GeographicReferencePoint", Vector3DValue(Vector(45, 10, 0)));
+    geo->SetAttribute("PositionLatLongAlt", Vector3DValue(Vector(45, 10, 0)));
+    NS_TEST_EXPECT_MSG_EQ(nCourseChanges, 1, "Setting the position must notify a course change");
+    auto position = geo->MobilityModel::GetPosition();
+    NS_TEST_EXPECT_MSG_LT(position.GetLength(), 1e-3, "Position must be the reference point");
+    geo->SetAttribute("PositionLatLongAlt", Vector3DValue(Vector(45, 10, 1000)));
+    NS_TEST_EXPECT_MSG_EQ(nCourseChanges, 2, "Setting the position must notify a course change");
+    position = geo->MobilityModel::GetPosition();
+    NS_TEST_EXPECT_MSG_EQ_TOL(position.z, 1000, 1e-3, "Cached position not discarded");
+    geo->SetAttribute("GeographicReferencePoint", Vector3DValue(Vector(45, 10, 500)));
+    position = geo->MobilityModel::GetPosition();
+    NS_TEST_EXPECT_MSG_EQ_TOL(position.z, 500, 1e-3, "Cached position not discarded");
+
+    NodeContainer nodes;
+    nodes.Create(3);
+    MobilityHelper mobility;
+    auto positionAlloc = CreateObject<ListPositionAllocator>();
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        positionAlloc->Add(Vector(i, 2.0 * i, 3.0 * i));
+    }
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+    nodes.Get(1)->GetObject<ConstantVelocityMobilityModel>()->SetVelocity(Vector(1, 0, 0));
+
+    Simulator::Schedule(Seconds(2), [&]() {
+        std::vector<Vector> positions{Vector(-1, -1, -1)};
+        MobilityHelper::GetPositions(nodes, positions);
+        NS_TEST_ASSERT_MSG_EQ(positions.size(), nodes.GetN(), "Unexpected number of positions");
+        for (uint32_t i = 0; i < nodes.GetN(); ++i)
+        {
+            Vector expected(i + (i == 1 ? 2.0 : 0.0), 2.0 * i, 3.0 * i);
+            NS_TEST_EXPECT_MSG_EQ(positions[i], expected, "Unexpected position of node " << i);
+        }
+    });
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup mobility-test
  *
@@ -479,6 +626,7 @@ MobilityTestSuite::MobilityTestSuite()
     AddTestCase(new WaypointLazyNotifyTrue, TestCase::Duration::QUICK);
     AddTestCase(new WaypointInitialPositionIsWaypoint, TestCase::Duration::QUICK);
     AddTestCase(new WaypointMobilityModelViaHelper, TestCase::Duration::QUICK);
+    AddTestCase(new MobilityPositionCacheTest, TestCase::Duration::QUICK);
 }
 
 /**
@@ -0,0 +1,337 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/pointer.h"
+#include "ns3/position-allocator.h"
+#include "ns3/random-waypoint-mobility-engine.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Create an engine moving nodes within the square [0, 100] x [0, 100].
+ *
+ * @param pause the random variable used to pick the pauses
+ * @return the engine
+ */
+static Ptr<RandomWaypointMobilityEngine>
+CreateEngine(const std::string& pause)
+{
+    auto positionAllocator = CreateObject<RandomRectanglePositionAllocator>();
+    positionAllocator->SetAttribute("X",
+                                    StringValue("ns3::UniformRandomVariable[Min=0|Max=100]"));
+    positionAllocator->SetAttribute("Y",
+                                    StringValue("ns3::UniformRandomVariable[Min=0|Max=100]"));
+    auto engine = CreateObject<RandomWaypointMobilityEngine>();
+    engine->SetAttribute("PositionAllocator", PointerValue(positionAllocator));
+    engine->SetAttribute("Speed", StringValue("ns3::UniformRandomVariable[Min=5|Max=10]"));
+    engine->SetAttribute("Pause", StringValue(pause));
+    return engine;
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Check that the nodes moved by a RandomWaypointMobilityEngine stay within the area
+ * covered by the position allocator, that their speed is in the range of the Speed random
+ * variable and that the positions returned by the engine match those returned by the mobility
+ * models of the nodes.
+ */
+class RandomWaypointMobilityEngineTest : public TestCase
+{
+  public:
+    RandomWaypointMobilityEngineTest()
+        : TestCase("Check positions and velocities of nodes moved by a random waypoint engine")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /// Check the positions and velocities of all the nodes
+    void CheckNodes();
+
+    Ptr<RandomWaypointMobilityEngine> m_engine; ///< the engine
+    NodeContainer m_nodes;                      ///< the nodes moved by the engine
+    uint32_t m_nMoving{0};                      ///< number of times a node was found moving
+};
+
+void
+RandomWaypointMobilityEngineTest::CheckNodes()
+{
+    std::vector<Vector> positions;
+    m_engine->GetPositions(positions);
+    NS_TEST_ASSERT_MSG_EQ(positions.size(), m_nodes.GetN(), "Unexpected number of positions");
+
+    for (uint32_t i = 0; i < m_nodes.GetN(); ++i)
+    {
+        auto model = m_nodes.Get(i)->GetObject<MobilityModel>();
+        auto position = model->GetPosition();
+        NS_TEST_EXPECT_MSG_EQ_TOL(positions[i].x, position.x, 1e-9, "Unexpected x for " << i);
+        NS_TEST_EXPECT_MSG_EQ_TOL(positions[i].y, position.y, 1e-9, "Unexpected y for " << i);
+        NS_TEST_EXPECT_MSG_EQ(position.z, 0, "Unexpected z for node " << i);
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(position.x, -1e-6, "Node " << i << " out of the area");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(position.x, 100 + 1e-6, "Node " << i << " out of the area");
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(position.y, -1e-6, "Node " << i << " out of the area");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(position.y, 100 + 1e-6, "Node " << i << " out of the area");
+
+        auto speed = model->GetVelocity().GetLength();
+        if (speed > 0)
+        {
+            ++m_nMoving;
+            NS_TEST_EXPECT_MSG_GT_OR_EQ(speed, 5 - 1e-9, "Unexpected speed for node " << i);
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(speed, 10 + 1e-9, "Unexpected speed for node " << i);
+        }
+    }
+}
+
+void
+RandomWaypointMobilityEngineTest::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    m_engine = CreateEngine("ns3::UniformRandomVariable[Min=0|Max=2]");
+    m_engine->AssignStreams(1);
+    m_nodes.Create(50);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::RandomRectanglePositionAllocator",
+                                  "X",
+                                  StringValue("ns3::UniformRandomVariable[Min=0|Max=100]"),
+                                  "Y",
+                                  StringValue("ns3::UniformRandomVariable[Min=0|Max=100]"));
+    mobility.SetMobilityModel("ns3::RandomWaypointEngineMobilityModel",
+                              "Engine",
+                              PointerValue(m_engine));
+    mobility.Install(m_nodes);
+
+    NS_TEST_ASSERT_MSG_EQ(m_engine->GetNNodes(), m_nodes.GetN(), "Unexpected number of nodes");
+
+    for (uint32_t i = 1; i <= 200; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(373 * i),
+                            &RandomWaypointMobilityEngineTest::CheckNodes,
+                            this);
+    }
+    Simulator::Stop(Seconds(80));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_GT(m_nMoving, 0, "Nodes never moved");
+
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(m_engine->GetNNodes(), 0, "Nodes not detached on dispose");
+    m_engine = nullptr;
+    m_nodes = NodeContainer();
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Check that the pauses and walks of the nodes moved by a RandomWaypointMobilityEngine
+ * start at multiples of the BatchInterval and that the nodes stay within the area covered by
+ * the position allocator.
+ */
+class RandomWaypointMobilityEngineBatchTest : public TestCase
+{
+  public:
+    RandomWaypointMobilityEngineBatchTest()
+        : TestCase("Check that random waypoint engine transitions are aligned to the batch "
+                   "interval")
+    {
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Course change callback.
+     *
+     * @param model the mobility model whose course changed
+     */
+    void CourseChange(Ptr<const MobilityModel> model);
+
+    uint32_t m_nCourseChanges{0}; ///< number of course changes
+};
+
+void
+RandomWaypointMobilityEngineBatchTest::CourseChange(Ptr<const MobilityModel> model)
+{
+    ++m_nCourseChanges;
+    auto now = Simulator::Now();
+    NS_TEST_EXPECT_MSG_EQ((now % Seconds(1)).IsZero(),
+                          true,
+                          "Course change at " << now << " not aligned to the batch interval");
+
+    auto position = model->GetPosition();
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(position.x, -1e-6, "Node out of the area");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(position.x, 100 + 1e-6, "Node out of the area");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(position.y, -1e-6, "Node out of the area");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(position.y, 100 + 1e-6, "Node out of the area");
+}
+
+void
+RandomWaypointMobilityEngineBatchTest::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(2);
+
+    auto engine = CreateEngine("ns3::ConstantRandomVariable[Constant=0.5]");
+    engine->SetAttribute("BatchInterval", TimeValue(Seconds(1)));
+    engine->AssignStreams(1);
+
+    std::vector<Ptr<MobilityModel>> models;
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        auto model = CreateObject<RandomWaypointEngineMobilityModel>();
+        model->SetAttribute("Engine", PointerValue(engine));
+        model->SetPosition(Vector(50, 50, 0));
+        model->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&RandomWaypointMobilityEngineBatchTest::CourseChange, this));
+        models.push_back(model);
+    }
+
+    // start the nodes at a multiple of the batch interval
+    m_nCourseChanges = 0;
+    for (auto& model : models)
+    {
+        Simulator::Schedule(Seconds(1), &MobilityModel::Initialize, model);
+    }
+    Simulator::Stop(Seconds(60));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_GT(m_nCourseChanges, 2 * models.size(), "Too few course changes");
+
+    for (auto& model : models)
+    {
+        model->Dispose();
+    }
+    NS_TEST_EXPECT_MSG_EQ(engine->GetNNodes(), 0, "Nodes not detached on dispose");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Check that the positions returned by a RandomWaypointMobilityEngine do not include
+ * the detached nodes and that the indices of the detached nodes are reused by the nodes
+ * attached later.
+ */
+class RandomWaypointMobilityEngineDetachTest : public TestCase
+{
+  public:
+    RandomWaypointMobilityEngineDetachTest()
+        : TestCase("Check that a random waypoint engine reuses the indices of detached nodes")
+    {
+    }
+
+  private:
+    void DoRun() override;
+};
+
+void
+RandomWaypointMobilityEngineDetachTest::DoRun()
+{
+    auto engine = CreateEngine("ns3::ConstantRandomVariable[Constant=1]");
+    engine->AssignStreams(1);
+
+    std::vector<Ptr<MobilityModel>> models;
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        auto model = CreateObject<RandomWaypointEngineMobilityModel>();
+        model->SetAttribute("Engine", PointerValue(engine));
+        model->SetPosition(Vector(i, 0, 0));
+        models.push_back(model);
+    }
+
+    // detach the second and the fourth node
+    models[1]->Dispose();
+    models[3]->Dispose();
+    NS_TEST_ASSERT_MSG_EQ(engine->GetNNodes(), 3, "Unexpected number of nodes");
+
+    std::vector<Vector> positions;
+    std::vector<Ptr<MobilityModel>> attached;
+    engine->GetPositions(positions, &attached);
+    NS_TEST_ASSERT_MSG_EQ(positions.size(), 3, "Positions returned for detached nodes");
+    NS_TEST_ASSERT_MSG_EQ(attached.size(), 3, "Models returned for detached nodes");
+    const std::vector<uint32_t> expected{0, 2, 4};
+    for (std::size_t j = 0; j < expected.size(); ++j)
+    {
+        NS_TEST_EXPECT_MSG_EQ(attached[j], models[expected[j]], "Unexpected model " << j);
+        NS_TEST_EXPECT_MSG_EQ(positions[j].x, expected[j], "Unexpected position " << j);
+    }
+
+    // the new nodes take the indices of the detached nodes, the last detached first
+    auto model5 = CreateObject<RandomWaypointEngineMobilityModel>();
+    model5->SetAttribute("Engine", PointerValue(engine));
+    model5->SetPosition(Vector(5, 0, 0));
+    auto model6 = CreateObject<RandomWaypointEngineMobilityModel>();
+    model6->SetAttribute("Engine", PointerValue(engine));
+    model6->SetPosition(Vector(6, 0, 0));
+    NS_TEST_ASSERT_MSG_EQ(engine->GetNNodes(), 5, "Unexpected number of nodes");
+
+    engine->GetPositions(positions, &attached);
+    NS_TEST_ASSERT_MSG_EQ(positions.size(), 5, "Unexpected number of positions");
+    NS_TEST_EXPECT_MSG_EQ(attached[1], model6, "Index of the second node not reused");
+    NS_TEST_EXPECT_MSG_EQ(positions[1].x, 6, "Unexpected position of the reused index");
+    NS_TEST_EXPECT_MSG_EQ(attached[3], model5, "Index of the fourth node not reused");
+    NS_TEST_EXPECT_MSG_EQ(positions[3].x, 5, "Unexpected position of the reused index");
+
+    // the nodes attached to reused indices move as the others
+    models[1] = model6;
+    models[3] = model5;
+    for (auto& model : models)
+    {
+        model->Initialize();
+    }
+    Simulator::Stop(Seconds(30));
+    Simulator::Run();
+    engine->GetPositions(positions, &attached);
+    for (std::size_t j = 0; j < models.size(); ++j)
+    {
+        NS_TEST_EXPECT_MSG_EQ(attached[j], models[j], "Unexpected model " << j);
+        auto position = models[j]->GetPosition();
+        NS_TEST_EXPECT_MSG_EQ_TOL(positions[j].x, position.x, 1e-9, "Unexpected x for " << j);
+        NS_TEST_EXPECT_MSG_EQ_TOL(positions[j].y, position.y, 1e-9, "Unexpected y for " << j);
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(position.y, -1e-6, "Node " << j << " out of the area");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(position.y, 100 + 1e-6, "Node " << j << " out of the area");
+    }
+
+    for (auto& model : models)
+    {
+        model->Dispose();
+    }
+    NS_TEST_EXPECT_MSG_EQ(engine->GetNNodes(), 0, "Nodes not detached on dispose");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mobility-test
+ *
+ * @brief Random waypoint mobility engine Test Suite
+ */
+class RandomWaypointMobilityEngineTestSuite : public TestSuite
+{
+  public:
+    RandomWaypointMobilityEngineTestSuite()
+        : TestSuite("random-waypoint-mobility-engine", Type::UNIT)
+    {
+        AddTestCase(new RandomWaypointMobilityEngineTest, TestCase::Duration::QUICK);
+        AddTestCase(new RandomWaypointMobilityEngineBatchTest, TestCase::Duration::QUICK);
+        AddTestCase(new RandomWaypointMobilityEngineDetachTest, TestCase::Duration::QUICK);
+    }
+};
+
+static RandomWaypointMobilityEngineTestSuite
+    g_randomWaypointMobilityEngineTestSuite; ///< the test suite
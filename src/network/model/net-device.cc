@@ -9,6 +9,7 @@
 #include "net-device.h"
 
 #include "ns3/log.h"
+#include "ns3/queue-item.h"
 
 namespace ns3
 {
@@ -29,4 +30,19 @@ NetDevice::~NetDevice()
     NS_LOG_FUNCTION(this);
 }
 
+std::size_t
+NetDevice::SendBatch(std::span<const Ptr<QueueDiscItem>> items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+    std::size_t sent = 0;
+    for (const auto& item : items)
+    {
+        if (Send(item->GetPacket(), item->GetAddress(), item->GetProtocol()))
+        {
+            ++sent;
+        }
+    }
+    return sent;
+}
+
 } // namespace ns3
@@ -18,6 +18,7 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <span>
 #include <stdint.h>
 
 namespace ns3
@@ -25,6 +26,7 @@ namespace ns3
 
 class Node;
 class Channel;
+class QueueDiscItem;
 
 /**
  * @ingroup network
@@ -253,6 +255,18 @@ class NetDevice : public Object
                           const Address& source,
                           const Address& dest,
                           uint16_t protocolNumber) = 0;
+    /**
+     * @param items packets sent from above down to Network Device, along with
+     *        their destination address and protocol number
+     *
+     *  Called from higher layer to send a batch of packets into Network Device.
+     *  The default implementation calls Send for each packet. Devices can
+     *  override this method to process the whole batch before starting a
+     *  transmission.
+     *
+     * @return the number of packets whose Send operation succeeded
+     */
+    virtual std::size_t SendBatch(std::span<const Ptr<QueueDiscItem>> items);
     /**
      * @returns the node base class which contains this network
      *          interface.
@@ -0,0 +1,118 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "gso-tag.h"
+
+#include "ns3/assert.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(GsoTag);
+
+TypeId
+GsoTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::GsoTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("Network")
+                            .AddConstructor<GsoTag>();
+    return tid;
+}
+
+TypeId
+GsoTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+GsoTag::GsoTag() = default;
+
+GsoTag::GsoTag(uint16_t segmentSize, uint32_t payloadSize)
+    : m_segmentSize(segmentSize),
+      m_payloadSize(payloadSize)
+{
+}
+
+uint32_t
+GsoTag::GetSerializedSize() const
+{
+    return 6;
+}
+
+void
+GsoTag::Serialize(TagBuffer i) const
+{
+    i.WriteU16(m_segmentSize);
+    i.WriteU32(m_payloadSize);
+}
+
+void
+GsoTag::Deserialize(TagBuffer i)
+{
+    m_segmentSize = i.ReadU16();
+    m_payloadSize = i.ReadU32();
+}
+
+void
+GsoTag::Print(std::ostream& os) const
+{
+    os << "segmentSize=" << m_segmentSize << " payloadSize=" << m_payloadSize;
+}
+
+void
+GsoTag::SetSegmentSize(uint16_t segmentSize)
+{
+    m_segmentSize = segmentSize;
+}
+
+uint16_t
+GsoTag::GetSegmentSize() const
+{
+    return m_segmentSize;
+}
+
+void
+GsoTag::SetPayloadSize(uint32_t payloadSize)
+{
+    m_payloadSize = payloadSize;
+}
+
+uint32_t
+GsoTag::GetPayloadSize() const
+{
+    return m_payloadSize;
+}
+
+uint32_t
+GsoTag::GetNSegments() const
+{
+    if (m_segmentSize == 0 || m_payloadSize == 0)
+    {
+        return 1;
+    }
+    return (m_payloadSize + m_segmentSize - 1) / m_segmentSize;
+}
+
+uint32_t
+GsoTag::GetSegmentedSize(uint32_t packetSize, uint32_t overhead) const
+{
+    NS_ASSERT_MSG(packetSize >= m_payloadSize, "The packet is smaller than its payload");
+    return packetSize + (GetNSegments() - 1) * (packetSize - m_payloadSize + overhead);
+}
+
+uint32_t
+GsoTag::GetLargestSegmentSize(uint32_t packetSize) const
+{
+    NS_ASSERT_MSG(packetSize >= m_payloadSize, "The packet is smaller than its payload");
+    if (m_segmentSize == 0)
+    {
+        return packetSize;
+    }
+    return packetSize - m_payloadSize + std::min<uint32_t>(m_segmentSize, m_payloadSize);
+}
+
+} // namespace ns3
@@ -0,0 +1,96 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef GSO_TAG_H
+#define GSO_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * @ingroup network
+ *
+ * Tag marking a packet as a super-segment, i.e., a packet whose payload is made of multiple
+ * segments that share the same headers and that would be sent as separate packets without
+ * segmentation offload. The segmentation is emulated by the NetDevices, which do not actually
+ * split the packet but account for the headers of every segment when computing the transmission
+ * time, and by the IP layer, which does not fragment super-segments whose segments fit the MTU.
+ *
+ * The headers of a segment are all the bytes of the packet that do not belong to the payload.
+ */
+class GsoTag : public Tag
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    GsoTag();
+
+    /**
+     * Construct a GsoTag with the given segment and payload size
+     *
+     * @param segmentSize the size of the payload of every segment but the last one
+     * @param payloadSize the size of the payload of the super-segment
+     */
+    GsoTag(uint16_t segmentSize, uint32_t payloadSize);
+
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+    uint32_t GetSerializedSize() const override;
+    void Print(std::ostream& os) const override;
+
+    /**
+     * @param segmentSize the size of the payload of every segment but the last one
+     */
+    void SetSegmentSize(uint16_t segmentSize);
+
+    /**
+     * @return the size of the payload of every segment but the last one
+     */
+    uint16_t GetSegmentSize() const;
+
+    /**
+     * @param payloadSize the size of the payload of the super-segment
+     */
+    void SetPayloadSize(uint32_t payloadSize);
+
+    /**
+     * @return the size of the payload of the super-segment
+     */
+    uint32_t GetPayloadSize() const;
+
+    /**
+     * @return the number of segments the super-segment is made of
+     */
+    uint32_t GetNSegments() const;
+
+    /**
+     * @param packetSize the size of the tagged packet, including the headers
+     * @param overhead the number of bytes added to every segment in addition to the headers
+     *        included in the packet (e.g., the inter-frame gap)
+     * @return the total size of the segments, i.e., the given packet size plus the size of the
+     *         headers and of the overhead of every segment but the first one
+     */
+    uint32_t GetSegmentedSize(uint32_t packetSize, uint32_t overhead = 0) const;
+
+    /**
+     * @param packetSize the size of the tagged packet, including the headers
+     * @return the size of the largest segment, including the headers
+     */
+    uint32_t GetLargestSegmentSize(uint32_t packetSize) const;
+
+  private:
+    uint16_t m_segmentSize{0}; //!< size of the payload of every segment but the last one
+    uint32_t m_payloadSize{0}; //!< size of the payload of the super-segment
+};
+
+} // namespace ns3
+
+#endif /* GSO_TAG_H */
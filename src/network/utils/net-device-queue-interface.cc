@@ -14,6 +14,8 @@
 #include "ns3/abort.h"
 #include "ns3/uinteger.h"
 
+#include <limits>
+
 namespace ns3
 {
 
@@ -32,6 +34,8 @@ NetDeviceQueue::GetTypeId()
 NetDeviceQueue::NetDeviceQueue()
     : m_stoppedByDevice(false),
       m_stoppedByQueueLimits(false),
+      m_inBatch(false),
+      m_batchBytes(0),
       NS_LOG_TEMPLATE_DEFINE("NetDeviceQueueInterface")
 {
     NS_LOG_FUNCTION(this);
@@ -44,6 +48,7 @@ NetDeviceQueue::~NetDeviceQueue()
     m_queueLimits = nullptr;
     m_wakeCallback.Nullify();
     m_device = nullptr;
+    m_availablePackets = nullptr;
 }
 
 bool
@@ -135,6 +140,35 @@ NetDeviceQueue::NotifyTransmittedBytes(uint32_t bytes)
     }
 }
 
+void
+NetDeviceQueue::StartBatch()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(!m_inBatch, "A batch is already being sent");
+    m_inBatch = true;
+    m_batchBytes = 0;
+}
+
+void
+NetDeviceQueue::EndBatch()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(m_inBatch, "No batch is being sent");
+    m_inBatch = false;
+    NotifyQueuedBytes(m_batchBytes);
+}
+
+uint32_t
+NetDeviceQueue::GetAvailablePackets() const
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_availablePackets)
+    {
+        return std::numeric_limits<uint32_t>::max();
+    }
+    return m_availablePackets();
+}
+
 void
 NetDeviceQueue::ResetQueueLimits()
 {
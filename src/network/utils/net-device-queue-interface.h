@@ -14,6 +14,7 @@
 #include "ns3/object-factory.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/queue-size.h"
 #include "ns3/simulator.h"
 
 #include <functional>
@@ -121,6 +122,35 @@ class NetDeviceQueue : public Object
      */
     virtual void NotifyTransmittedBytes(uint32_t bytes);
 
+    /**
+     * @brief Start a batch of packets sent to the device
+     *
+     * Called by the queue disc before sending a batch of packets to the device.
+     * Until EndBatch is called, the bytes queued to the device queue are
+     * accumulated and reported to the queue limits object once, when the batch
+     * ends.
+     */
+    void StartBatch();
+
+    /**
+     * @brief End a batch of packets sent to the device
+     *
+     * Report the number of bytes queued to the device queue during the batch.
+     */
+    void EndBatch();
+
+    /**
+     * @brief Get the number of packets that can be sent to the device
+     * @return the number of packets that can be queued to the device queue
+     *         before the device queue is stopped
+     *
+     * Called by queue discs to determine the size of the batches of packets
+     * sent to the device. Every packet is assumed to have a size equal to the
+     * MTU of the device. If no queue is connected to this transmission queue
+     * (see ConnectQueueTraces), the number of packets is unlimited.
+     */
+    uint32_t GetAvailablePackets() const;
+
     /**
      * @brief Reset queue limits state
      */
@@ -199,6 +229,10 @@ class NetDeviceQueue : public Object
     Ptr<QueueLimits> m_queueLimits; //!< Queue limits object
     WakeCallback m_wakeCallback;    //!< Wake callback
     Ptr<NetDevice> m_device;        //!< the netdevice aggregated to the NetDeviceQueueInterface
+    bool m_inBatch;                 //!< True if a batch of packets is being sent to the device
+    uint32_t m_batchBytes;          //!< Bytes queued to the device queue in the current batch
+    /// Function returning the number of packets that can be queued to the device queue
+    std::function<uint32_t()> m_availablePackets;
 
     NS_LOG_TEMPLATE_DECLARE; //!< redefinition of the log component
 };
@@ -323,6 +357,18 @@ NetDeviceQueue::ConnectQueueTraces(Ptr<QueueType> queue)
     queue->TraceConnectWithoutContext(
         "DropBeforeEnqueue",
         MakeCallback(&NetDeviceQueue::PacketDiscarded<QueueType>, this).Bind(PeekPointer(queue)));
+
+    m_availablePackets = [this, q = PeekPointer(queue)]() -> uint32_t {
+        NS_ASSERT_MSG(m_device, "Aggregated NetDevice not set");
+        const auto maxSize = q->GetMaxSize();
+        const auto currentSize = q->GetCurrentSize().GetValue();
+        if (currentSize >= maxSize.GetValue())
+        {
+            return 0;
+        }
+        const auto room = maxSize.GetValue() - currentSize;
+        return maxSize.GetUnit() == QueueSizeUnit::PACKETS ? room : room / m_device->GetMtu();
+    };
 }
 
 template <typename QueueType>
@@ -331,8 +377,15 @@ NetDeviceQueue::PacketEnqueued(QueueType* queue, Ptr<const typename QueueType::I
 {
     NS_LOG_FUNCTION(this << queue << item);
 
-    // Inform BQL
-    NotifyQueuedBytes(item->GetSize());
+    // Inform BQL (at the end of the batch, if a batch is being sent)
+    if (m_inBatch)
+    {
+        m_batchBytes += item->GetSize();
+    }
+    else
+    {
+        NotifyQueuedBytes(item->GetSize());
+    }
 
     NS_ASSERT_MSG(m_device, "Aggregated NetDevice not set");
     // After enqueuing a packet, we need to check whether the queue is able to
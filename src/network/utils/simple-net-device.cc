@@ -8,6 +8,7 @@
 #include "simple-net-device.h"
 
 #include "error-model.h"
+#include "gso-tag.h"
 #include "queue.h"
 #include "simple-channel.h"
 
@@ -422,7 +423,13 @@ SimpleNetDevice::SendFrom(Ptr<Packet> p,
                           uint16_t protocolNumber)
 {
     NS_LOG_FUNCTION(this << p << source << dest << protocolNumber);
-    if (p->GetSize() > GetMtu())
+    uint32_t size = p->GetSize();
+    if (GsoTag gso; p->PeekPacketTag(gso))
+    {
+        // super-segments are segmented by the device
+        size = gso.GetLargestSegmentSize(size);
+    }
+    if (size > GetMtu())
     {
         return false;
     }
@@ -474,7 +481,12 @@ SimpleNetDevice::StartTransmission()
     Time txTime = Time(0);
     if (m_bps > DataRate(0))
     {
-        txTime = m_bps.CalculateBytesTxTime(packet->GetSize());
+        uint32_t size = packet->GetSize();
+        if (GsoTag gso; packet->PeekPacketTag(gso))
+        {
+            size = gso.GetSegmentedSize(size);
+        }
+        txTime = m_bps.CalculateBytesTxTime(size);
     }
     FinishTransmissionEvent =
         Simulator::Schedule(txTime, &SimpleNetDevice::FinishTransmission, this, packet);
@@ -10,10 +10,12 @@
 #include "ppp-header.h"
 
 #include "ns3/error-model.h"
+#include "ns3/gso-tag.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
 #include "ns3/mac48-address.h"
 #include "ns3/pointer.h"
+#include "ns3/queue-item.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
@@ -238,7 +240,16 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     m_currentPkt = p;
     m_phyTxBeginTrace(m_currentPkt);
 
-    Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+    // a super-segment takes as long as the segments it is made of
+    uint32_t size = p->GetSize();
+    uint32_t nSegments = 1;
+    if (GsoTag gso; p->PeekPacketTag(gso))
+    {
+        size = gso.GetSegmentedSize(size);
+        nSegments = gso.GetNSegments();
+    }
+
+    Time txTime = m_bps.CalculateBytesTxTime(size) + m_tInterframeGap * (nSegments - 1);
     Time txCompleteTime = txTime + m_tInterframeGap;
 
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
@@ -548,6 +559,45 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     return false;
 }
 
+std::size_t
+PointToPointNetDevice::SendBatch(std::span<const Ptr<QueueDiscItem>> items)
+{
+    NS_LOG_FUNCTION(this << items.size());
+
+    std::size_t sent = 0;
+    for (const auto& item : items)
+    {
+        Ptr<Packet> packet = item->GetPacket();
+        if (!IsLinkUp())
+        {
+            m_macTxDropTrace(packet);
+            continue;
+        }
+
+        AddHeader(packet, item->GetProtocol());
+        m_macTxTrace(packet);
+
+        if (!m_queue->Enqueue(packet))
+        {
+            m_macTxDropTrace(packet);
+            continue;
+        }
+        ++sent;
+    }
+
+    //
+    // Start a transmission only after that the whole batch has been enqueued
+    //
+    if (m_txMachineState == READY && !m_queue->IsEmpty())
+    {
+        Ptr<Packet> packet = m_queue->Dequeue();
+        m_snifferTrace(packet);
+        m_promiscSnifferTrace(packet);
+        TransmitStart(packet);
+    }
+    return sent;
+}
+
 bool
 PointToPointNetDevice::SendFrom(Ptr<Packet> packet,
                                 const Address& source,
@@ -175,6 +175,15 @@ class PointToPointNetDevice : public NetDevice
                   const Address& dest,
                   uint16_t protocolNumber) override;
 
+    /**
+     * Enqueue all the packets of the batch in the device queue and then start
+     * transmitting, if the device is idle.
+     *
+     * @param items the packets to send
+     * @return the number of packets enqueued in the device queue
+     */
+    std::size_t SendBatch(std::span<const Ptr<QueueDiscItem>> items) override;
+
     Ptr<Node> GetNode() const override;
     void SetNode(Ptr<Node> node) override;
 
@@ -0,0 +1,182 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "cached-propagation-loss-model.h"
+
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/pointer.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CachedPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid = AddCacheAttributes(
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("Model",
+                          "The (head of the chain of) propagation loss model(s) whose losses "
+                          "are cached.",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationLossModel::SetModel,
+                                              &CachedPropagationLossModel::GetModel),
+                          MakePointerChecker<PropagationLossModel>()));
+    return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CachedPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& mobility : m_mobilityModels)
+    {
+        mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&CachedPropagationLossModel::NotifyCourseChange, this));
+    }
+    m_mobilityModels.clear();
+    m_courseChanges.clear();
+    m_propagationCache.Cleanup();
+    m_stages.clear();
+    m_model = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+void
+CachedPropagationLossModel::SetModel(Ptr<PropagationLossModel> model)
+{
+    NS_LOG_FUNCTION(this << model);
+    m_model = model;
+    Clear();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel() const
+{
+    return m_model;
+}
+
+void
+CachedPropagationLossModel::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_propagationCache.Cleanup();
+    m_stages.clear();
+}
+
+uint32_t
+CachedPropagationLossModel::GetCourseChangeCount(Ptr<MobilityModel> mobility) const
+{
+    auto [it, inserted] = m_courseChanges.try_emplace(PeekPointer(mobility), 0);
+    if (inserted)
+    {
+        mobility->TraceConnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&CachedPropagationLossModel::NotifyCourseChange, this));
+        m_mobilityModels.push_back(mobility);
+    }
+    return it->second;
+}
+
+void
+CachedPropagationLossModel::NotifyCourseChange(Ptr<const MobilityModel> mobility) const
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_courseChanges.find(PeekPointer(mobility));
+    NS_ASSERT(it != m_courseChanges.end());
+    ++it->second;
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this << txPowerDbm << a << b);
+    NS_ASSERT_MSG(m_model, "No propagation loss model to wrap has been set");
+
+    if (m_stages.empty())
+    {
+        for (auto model = m_model; model; model = model->GetNext())
+        {
+            m_stages.emplace_back(model, model->IsLossCacheable());
+            NS_LOG_DEBUG(model->GetInstanceTypeId().GetName()
+                         << (m_stages.back().second ? " is" : " is not") << " cacheable");
+        }
+    }
+
+    Ptr<PathLoss> pathLoss;
+    std::size_t dir = 0;
+
+    if (a->GetVelocity() == Vector() && b->GetVelocity() == Vector())
+    {
+        dir = (a < b) ? 0 : 1;
+        auto courseChanges = std::make_pair(GetCourseChangeCount(a), GetCourseChangeCount(b));
+        if (dir == 1)
+        {
+            std::swap(courseChanges.first, courseChanges.second);
+        }
+
+        pathLoss = m_propagationCache.GetPathData(a, b, 0);
+        if (!pathLoss)
+        {
+            pathLoss = Create<PathLoss>();
+            pathLoss->courseChanges = courseChanges;
+            m_propagationCache.AddPathData(pathLoss, a, b, 0);
+        }
+        else if (pathLoss->courseChanges != courseChanges)
+        {
+            NS_LOG_DEBUG("Course changed, invalidating cached losses");
+            pathLoss->courseChanges = courseChanges;
+            pathLoss->gains[0].clear();
+            pathLoss->gains[1].clear();
+        }
+    }
+
+    double rxPowerDbm = txPowerDbm;
+    std::size_t index = 0;
+
+    for (const auto& [model, cacheable] : m_stages)
+    {
+        if (!pathLoss || !cacheable)
+        {
+            rxPowerDbm = CalcRxPowerNoChain(model, rxPowerDbm, a, b);
+            continue;
+        }
+        auto& gains = pathLoss->gains[dir];
+        if (index == gains.size())
+        {
+            gains.push_back(CalcRxPowerNoChain(model, 0, a, b));
+        }
+        rxPowerDbm += gains[index++];
+    }
+
+    return rxPowerDbm;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    return m_model ? m_model->AssignStreams(stream) : 0;
+}
+
+} // namespace ns3
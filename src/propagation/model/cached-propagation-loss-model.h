@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include "propagation-cache.h"
+#include "propagation-loss-model.h"
+
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+class MobilityModel;
+
+/**
+ * @ingroup propagation
+ *
+ * @brief Caches the losses computed by a chain of propagation loss models for static nodes
+ *
+ * This model wraps a chain of propagation loss models (set through the Model attribute) and
+ * stores, for every pair of nodes, the loss computed by each model in the chain that declares
+ * its loss as cacheable (see PropagationLossModel::IsLossCacheable()). The other models in the
+ * chain (e.g., NakagamiPropagationLossModel) are evaluated for every packet, in the order they
+ * appear in the chain, hence the Rx power is the same that the wrapped chain would compute.
+ *
+ * The losses cached for a pair of nodes are invalidated when the CourseChange trace source of
+ * the mobility model of either node fires. No loss is cached for a pair of nodes if any of the
+ * two nodes has a non-null velocity.
+ *
+ * The chain of wrapped models is inspected the first time the Rx power is computed. If the
+ * chain or the attributes of the wrapped models are changed afterwards, Clear() must be called.
+ */
+class CachedPropagationLossModel
+    : public PropagationLossModel,
+      public PropagationCacheOwner<CachedPropagationLossModel>
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    CachedPropagationLossModel();
+    ~CachedPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CachedPropagationLossModel(const CachedPropagationLossModel&) = delete;
+    CachedPropagationLossModel& operator=(const CachedPropagationLossModel&) = delete;
+
+    /**
+     * Set the (head of the chain of) propagation loss model(s) whose losses are cached.
+     *
+     * @param model the wrapped propagation loss model
+     */
+    void SetModel(Ptr<PropagationLossModel> model);
+
+    /**
+     * @return the (head of the chain of) propagation loss model(s) whose losses are cached
+     */
+    Ptr<PropagationLossModel> GetModel() const;
+
+    /**
+     * Drop all the cached losses and inspect again the chain of wrapped models the next time
+     * the Rx power is computed.
+     */
+    void Clear();
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    friend class PropagationCacheOwner<CachedPropagationLossModel>;
+
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    /**
+     * Get the number of course changes notified by the given mobility model since the latter
+     * has been seen for the first time. The first time a mobility model is seen, this object
+     * connects to its CourseChange trace source.
+     *
+     * @param mobility the given mobility model
+     * @return the number of course changes notified by the given mobility model
+     */
+    uint32_t GetCourseChangeCount(Ptr<MobilityModel> mobility) const;
+
+    /**
+     * Callback connected to the CourseChange trace source of the mobility models.
+     *
+     * @param mobility the mobility model that changed course
+     */
+    void NotifyCourseChange(Ptr<const MobilityModel> mobility) const;
+
+    /**
+     * The losses cached for a pair of nodes
+     */
+    class PathLoss : public SimpleRefCount<PathLoss>
+    {
+      public:
+        /// Required by PropagationCache, no resources to release
+        void Dispose()
+        {
+        }
+
+        /// number of course changes of the two mobility models (sorted by address) when the
+        /// losses were computed
+        std::pair<uint32_t, uint32_t> courseChanges;
+        /// Rx power (dBm) returned by each cacheable model in the chain for a Tx power of 0 dBm,
+        /// for each direction (the first direction is from the mobility model having the lower
+        /// address to the other one)
+        std::array<std::vector<double>, 2> gains;
+    };
+
+    Ptr<PropagationLossModel> m_model; //!< the wrapped (head of the chain of) model(s)
+
+    /// the models in the wrapped chain, each paired with a flag indicating whether its loss
+    /// can be cached
+    mutable std::vector<std::pair<Ptr<const PropagationLossModel>, bool>> m_stages;
+
+    /// the losses cached for each pair of nodes
+    mutable PropagationCache<PathLoss> m_propagationCache;
+
+    /// number of course changes notified by each mobility model that has been seen
+    mutable std::unordered_map<const MobilityModel*, uint32_t> m_courseChanges;
+    /// the mobility models whose CourseChange trace source this object is connected to
+    mutable std::vector<Ptr<MobilityModel>> m_mobilityModels;
+};
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
@@ -61,6 +61,21 @@ const std::map<int, double> SuburbanRuralLOSProb{
     {90, {0.998}},
 };
 
+/**
+ * @param key the key of a pair of nodes
+ * @return the hash of the key, computed by the finalizer of MurmurHash3
+ */
+uint64_t
+HashNodePair(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
 } // namespace
 
 namespace ns3
@@ -344,6 +359,14 @@ ThreeGppChannelConditionModel::GetTypeId()
                 TimeValue(MilliSeconds(0)),
                 MakeTimeAccessor(&ThreeGppChannelConditionModel::m_updatePeriod),
                 MakeTimeChecker())
+            .AddAttribute("BatchUpdate",
+                          "If true (and the UpdatePeriod is not 0), the channel conditions that "
+                          "were retrieved since they were generated are regenerated together, "
+                          "in a pass scheduled every UpdatePeriod, rather than when they are "
+                          "retrieved after the UpdatePeriod has elapsed.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ThreeGppChannelConditionModel::m_batchUpdate),
+                          MakeBooleanChecker())
             .AddAttribute("O2iThreshold",
                           "Specifies what will be the ratio of O2I channel "
                           "conditions. Default value is 0 that corresponds to 0 O2I losses.",
@@ -387,7 +410,9 @@ ThreeGppChannelConditionModel::~ThreeGppChannelConditionModel()
 void
 ThreeGppChannelConditionModel::DoDispose()
 {
-    m_channelConditionMap.clear();
+    m_updateEvent.Cancel();
+    m_items.clear();
+    m_slots.clear();
     m_updatePeriod = Seconds(0);
 }
 
@@ -397,22 +422,25 @@ ThreeGppChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
 {
     Ptr<ChannelCondition> cond;
 
+    // the channel conditions are stored in a cache, for this reason you see a const_cast
+    auto self = const_cast<ThreeGppChannelConditionModel*>(this);
+
     // get the key for this channel
-    uint32_t key = GetKey(a, b);
+    uint64_t key = GetKey(a, b);
 
-    bool notFound = false; // indicates if the channel condition is not present in the map
-    bool update = false;   // indicates if the channel condition has to be updated
+    bool update = false; // indicates if the channel condition has to be updated
 
-    // look for the channel condition in m_channelConditionMap
-    auto mapItem = m_channelConditionMap.find(key);
-    if (mapItem != m_channelConditionMap.end())
+    // look for the channel condition in the hash table
+    auto index = Find(key);
+    if (index != NONE)
     {
         NS_LOG_DEBUG("found the channel condition in the map");
-        cond = mapItem->second.m_condition;
+        auto& item = self->m_items[index];
+        cond = item.m_condition;
+        item.m_used = true;
 
         // check if it has to be updated
-        if (!m_updatePeriod.IsZero() &&
-            Simulator::Now() - mapItem->second.m_generatedTime > m_updatePeriod)
+        if (!m_updatePeriod.IsZero() && Simulator::Now() - item.m_generatedTime > m_updatePeriod)
         {
             NS_LOG_DEBUG("it has to be updated");
             update = true;
@@ -421,25 +449,142 @@ ThreeGppChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
     else
     {
         NS_LOG_DEBUG("channel condition not found");
-        notFound = true;
     }
 
     // if the channel condition was not found or if it has to be updated
     // generate a new channel condition
-    if (notFound || update)
+    if (index == NONE || update)
     {
         cond = ComputeChannelCondition(a, b);
-        // store the channel condition in m_channelConditionMap, used as cache.
-        // For this reason you see a const_cast.
-        Item mapItem;
-        mapItem.m_condition = cond;
-        mapItem.m_generatedTime = Simulator::Now();
-        const_cast<ThreeGppChannelConditionModel*>(this)->m_channelConditionMap[key] = mapItem;
+        if (index == NONE)
+        {
+            // the mobility models are only needed to regenerate the condition in batches
+            self->Insert({key,
+                          cond,
+                          Simulator::Now(),
+                          m_batchUpdate ? a : nullptr,
+                          m_batchUpdate ? b : nullptr,
+                          true});
+        }
+        else
+        {
+            self->m_items[index].m_condition = cond;
+            self->m_items[index].m_generatedTime = Simulator::Now();
+        }
+    }
+
+    if (m_batchUpdate && !m_updatePeriod.IsZero() && !m_updateEvent.IsPending())
+    {
+        self->m_updateEvent =
+            Simulator::Schedule(m_updatePeriod,
+                                &ThreeGppChannelConditionModel::UpdateChannelConditions,
+                                self);
     }
 
     return cond;
 }
 
+void
+ThreeGppChannelConditionModel::UpdateChannelConditions()
+{
+    NS_LOG_FUNCTION(this);
+
+    // collect the channel conditions to regenerate
+    std::vector<uint32_t> stale;
+    bool used = false;
+    for (uint32_t i = 0; i < m_items.size(); ++i)
+    {
+        auto& item = m_items[i];
+        if (item.m_used && Simulator::Now() - item.m_generatedTime >= m_updatePeriod)
+        {
+            stale.push_back(i);
+        }
+        used |= item.m_used;
+        item.m_used = false;
+    }
+    NS_LOG_DEBUG("Regenerating " << stale.size() << " out of " << m_items.size()
+                                 << " channel conditions");
+
+    // compute all the LOS and NLOS probabilities, then draw all the random values. Since each
+    // random variable is only used for the channel conditions, the values drawn for each
+    // channel condition are the same as if the channel conditions were regenerated one by one
+    std::vector<double> pLos(stale.size());
+    std::vector<double> pNlos(stale.size());
+    std::vector<double> pRef(stale.size());
+    for (std::size_t j = 0; j < stale.size(); ++j)
+    {
+        const auto& item = m_items[stale[j]];
+        pLos[j] = ComputePlos(item.m_a, item.m_b);
+        pNlos[j] = ComputePnlos(item.m_a, item.m_b);
+    }
+    for (std::size_t j = 0; j < stale.size(); ++j)
+    {
+        pRef[j] = m_uniformVar->GetValue();
+    }
+    for (std::size_t j = 0; j < stale.size(); ++j)
+    {
+        auto& item = m_items[stale[j]];
+        item.m_condition = MakeChannelCondition(item.m_a, item.m_b, pLos[j], pNlos[j], pRef[j]);
+        item.m_generatedTime = Simulator::Now();
+    }
+
+    // stop the passes if no channel condition was retrieved since the previous pass; they are
+    // restarted when a channel condition is retrieved
+    if (used)
+    {
+        m_updateEvent = Simulator::Schedule(m_updatePeriod,
+                                            &ThreeGppChannelConditionModel::UpdateChannelConditions,
+                                            this);
+    }
+}
+
+uint32_t
+ThreeGppChannelConditionModel::Find(uint64_t key) const
+{
+    if (m_slots.empty())
+    {
+        return NONE;
+    }
+    auto mask = m_slots.size() - 1;
+    for (auto slot = HashNodePair(key) & mask; m_slots[slot] != NONE; slot = (slot + 1) & mask)
+    {
+        if (m_items[m_slots[slot]].m_key == key)
+        {
+            return m_slots[slot];
+        }
+    }
+    return NONE;
+}
+
+void
+ThreeGppChannelConditionModel::Insert(Item item)
+{
+    // keep the load factor of the hash table below 1/2
+    if (2 * (m_items.size() + 1) > m_slots.size())
+    {
+        m_slots.assign(std::max<std::size_t>(2 * m_slots.size(), 16), NONE);
+        auto mask = m_slots.size() - 1;
+        for (uint32_t i = 0; i < m_items.size(); ++i)
+        {
+            auto slot = HashNodePair(m_items[i].m_key) & mask;
+            while (m_slots[slot] != NONE)
+            {
+                slot = (slot + 1) & mask;
+            }
+            m_slots[slot] = i;
+        }
+    }
+
+    auto mask = m_slots.size() - 1;
+    auto slot = HashNodePair(item.m_key) & mask;
+    while (m_slots[slot] != NONE)
+    {
+        slot = (slot + 1) & mask;
+    }
+    m_slots[slot] = m_items.size();
+    m_items.push_back(std::move(item));
+}
+
 ChannelCondition::O2iConditionValue
 ThreeGppChannelConditionModel::ComputeO2i(Ptr<const MobilityModel> a,
                                           Ptr<const MobilityModel> b) const
@@ -477,7 +622,6 @@ ThreeGppChannelConditionModel::ComputeChannelCondition(Ptr<const MobilityModel>
                                                        Ptr<const MobilityModel> b) const
 {
     NS_LOG_FUNCTION(this << a << b);
-    Ptr<ChannelCondition> cond = CreateObject<ChannelCondition>();
 
     // compute the LOS probability
     double pLos = ComputePlos(a, b);
@@ -486,6 +630,18 @@ ThreeGppChannelConditionModel::ComputeChannelCondition(Ptr<const MobilityModel>
     // draw a random value
     double pRef = m_uniformVar->GetValue();
 
+    return MakeChannelCondition(a, b, pLos, pNlos, pRef);
+}
+
+Ptr<ChannelCondition>
+ThreeGppChannelConditionModel::MakeChannelCondition(Ptr<const MobilityModel> a,
+                                                    Ptr<const MobilityModel> b,
+                                                    double pLos,
+                                                    double pNlos,
+                                                    double pRef) const
+{
+    Ptr<ChannelCondition> cond = CreateObject<ChannelCondition>();
+
     NS_LOG_DEBUG("pRef " << pRef << " pLos " << pLos << " pNlos " << pNlos);
 
     // get the channel condition
@@ -558,18 +714,15 @@ ThreeGppChannelConditionModel::Calculate2dDistance(const Vector& a, const Vector
     return distance2D;
 }
 
-uint32_t
+uint64_t
 ThreeGppChannelConditionModel::GetKey(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b)
 {
     // use the nodes ids to obtain a unique key for the channel between a and b
     // sort the nodes ids so that the key is reciprocal
-    uint32_t x1 = std::min(a->GetObject<Node>()->GetId(), b->GetObject<Node>()->GetId());
-    uint32_t x2 = std::max(a->GetObject<Node>()->GetId(), b->GetObject<Node>()->GetId());
-
-    // use the cantor function to obtain the key
-    uint32_t key = (((x1 + x2) * (x1 + x2 + 1)) / 2) + x2;
+    uint64_t x1 = std::min(a->GetObject<Node>()->GetId(), b->GetObject<Node>()->GetId());
+    uint64_t x2 = std::max(a->GetObject<Node>()->GetId(), b->GetObject<Node>()->GetId());
 
-    return key;
+    return (x1 << 32) | x2;
 }
 
 std::tuple<double, double>
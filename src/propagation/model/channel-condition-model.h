@@ -8,13 +8,15 @@
 #ifndef CHANNEL_CONDITION_MODEL_H
 #define CHANNEL_CONDITION_MODEL_H
 
+#include "ns3/event-id.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/vector.h"
 
+#include <limits>
 #include <map>
-#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -427,6 +429,13 @@ class NeverLosVehicleChannelConditionModel : public ChannelConditionModel
  *
  * @brief Base class for the 3GPP channel condition models
  *
+ * The channel conditions are stored in an open addressing hash table keyed by the pair of
+ * node IDs. By default, a channel condition older than the "UpdatePeriod" is regenerated
+ * when it is retrieved. If the "BatchUpdate" attribute is true, the channel conditions that
+ * were retrieved since they were generated are instead regenerated together, in a pass
+ * scheduled every "UpdatePeriod", so that the LOS probabilities of all of them are computed
+ * in a single loop. In such a case, a channel condition retrieved between two passes may be
+ * up to twice as old as the update period.
  */
 class ThreeGppChannelConditionModel : public ChannelConditionModel
 {
@@ -522,6 +531,30 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
     Ptr<ChannelCondition> ComputeChannelCondition(Ptr<const MobilityModel> a,
                                                   Ptr<const MobilityModel> b) const;
 
+    /**
+     * Create a channel condition, given the LOS and NLOS probabilities and the value drawn
+     * from the uniform random variable, and determine its O2I condition
+     *
+     * @param a tx mobility model
+     * @param b rx mobility model
+     * @param pLos the LOS probability
+     * @param pNlos the NLOS probability
+     * @param pRef the value drawn from the uniform random variable
+     * @return the channel condition
+     */
+    Ptr<ChannelCondition> MakeChannelCondition(Ptr<const MobilityModel> a,
+                                               Ptr<const MobilityModel> b,
+                                               double pLos,
+                                               double pNlos,
+                                               double pRef) const;
+
+    /**
+     * Regenerate the channel conditions that were retrieved since they were generated and
+     * whose age is at least the update period, and schedule the next pass if any channel
+     * condition was retrieved since the previous pass.
+     */
+    void UpdateChannelConditions();
+
     /**
      * Compute the LOS probability.
      *
@@ -556,20 +589,43 @@ class ThreeGppChannelConditionModel : public ChannelConditionModel
      * @param b rx mobility model
      * @return channel key
      */
-    static uint32_t GetKey(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b);
+    static uint64_t GetKey(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b);
 
     /**
-     * Struct to store the channel condition in the m_channelConditionMap
+     * Struct to store the channel condition in m_items
      */
     struct Item
     {
+        uint64_t m_key;                    //!< the key of the pair of nodes
         Ptr<ChannelCondition> m_condition; //!< the channel condition
         Time m_generatedTime;              //!< the time when the condition was generated
+        Ptr<const MobilityModel> m_a;      //!< first mobility model (only for batch updates)
+        Ptr<const MobilityModel> m_b;      //!< second mobility model (only for batch updates)
+        bool m_used;                       //!< whether retrieved since the previous update pass
     };
 
-    std::unordered_map<uint32_t, Item>
-        m_channelConditionMap; //!< map to store the channel conditions
-    Time m_updatePeriod;       //!< the update period for the channel condition
+    /**
+     * @param key the key of a pair of nodes
+     * @return the index of the item storing the channel condition of the given pair of nodes,
+     * if present, or NONE, otherwise
+     */
+    uint32_t Find(uint64_t key) const;
+
+    /**
+     * Store a new item, growing the hash table if needed.
+     *
+     * @param item the item to store
+     */
+    void Insert(Item item);
+
+    /// Value used to indicate an empty slot of the hash table
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    std::vector<Item> m_items;     //!< the channel conditions, in order of creation
+    std::vector<uint32_t> m_slots; //!< hash table (with linear probing) of the indices of the items
+    Time m_updatePeriod;           //!< the update period for the channel condition
+    bool m_batchUpdate{false};     //!< whether channel conditions are regenerated in batches
+    EventId m_updateEvent;         //!< the event of the next batch update pass
 
     double m_o2iThreshold{
         0}; //!< the threshold for determining what is the ratio of channels with O2I
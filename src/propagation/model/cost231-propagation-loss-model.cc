@@ -178,4 +178,10 @@ Cost231PropagationLossModel::DoAssignStreams(int64_t stream)
     return 0;
 }
 
+bool
+Cost231PropagationLossModel::IsLossCacheable() const
+{
+    return true;
+}
+
 } // namespace ns3
@@ -117,6 +117,8 @@ class Cost231PropagationLossModel : public PropagationLossModel
      */
     void SetShadowing(double shadowing);
 
+    bool IsLossCacheable() const override;
+
   private:
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
@@ -98,4 +98,10 @@ ItuR1411LosPropagationLossModel::DoAssignStreams(int64_t stream)
 {
     return 0;
 }
+
+bool
+ItuR1411LosPropagationLossModel::IsLossCacheable() const
+{
+    return true;
+}
 } // namespace ns3
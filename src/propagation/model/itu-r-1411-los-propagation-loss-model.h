@@ -61,6 +61,8 @@ class ItuR1411LosPropagationLossModel : public PropagationLossModel
      */
     double GetLoss(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    bool IsLossCacheable() const override;
+
   private:
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
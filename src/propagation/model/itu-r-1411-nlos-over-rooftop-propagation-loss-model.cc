@@ -230,4 +230,10 @@ ItuR1411NlosOverRooftopPropagationLossModel::DoAssignStreams(int64_t stream)
     return 0;
 }
 
+bool
+ItuR1411NlosOverRooftopPropagationLossModel::IsLossCacheable() const
+{
+    return true;
+}
+
 } // namespace ns3
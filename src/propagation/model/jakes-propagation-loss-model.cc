@@ -32,10 +32,10 @@ JakesPropagationLossModel::~JakesPropagationLossModel()
 TypeId
 JakesPropagationLossModel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::JakesPropagationLossModel")
-                            .SetParent<PropagationLossModel>()
-                            .SetGroupName("Propagation")
-                            .AddConstructor<JakesPropagationLossModel>();
+    static TypeId tid = AddCacheAttributes(TypeId("ns3::JakesPropagationLossModel")
+                                               .SetParent<PropagationLossModel>()
+                                               .SetGroupName("Propagation")
+                                               .AddConstructor<JakesPropagationLossModel>());
     return tid;
 }
 
@@ -12,6 +12,8 @@
 #include "propagation-cache.h"
 #include "propagation-loss-model.h"
 
+#include "ns3/nstime.h"
+
 namespace ns3
 {
 /**
@@ -21,7 +23,9 @@ namespace ns3
  * Symmetrical cache for JakesProcess
  */
 
-class JakesPropagationLossModel : public PropagationLossModel
+class JakesPropagationLossModel
+    : public PropagationLossModel,
+      public PropagationCacheOwner<JakesPropagationLossModel>
 {
   public:
     /**
@@ -41,6 +45,7 @@ class JakesPropagationLossModel : public PropagationLossModel
 
   private:
     friend class JakesProcess;
+    friend class PropagationCacheOwner<JakesPropagationLossModel>;
 
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
@@ -65,4 +65,10 @@ Kun2600MhzPropagationLossModel::DoAssignStreams(int64_t stream)
     return 0;
 }
 
+bool
+Kun2600MhzPropagationLossModel::IsLossCacheable() const
+{
+    return true;
+}
+
 } // namespace ns3
@@ -51,6 +51,8 @@ class Kun2600MhzPropagationLossModel : public PropagationLossModel
      */
     double GetLoss(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    bool IsLossCacheable() const override;
+
   private:
     // inherited from PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
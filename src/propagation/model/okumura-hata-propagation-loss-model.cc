@@ -160,4 +160,10 @@ OkumuraHataPropagationLossModel::DoAssignStreams(int64_t stream)
     return 0;
 }
 
+bool
+OkumuraHataPropagationLossModel::IsLossCacheable() const
+{
+    return true;
+}
+
 } // namespace ns3
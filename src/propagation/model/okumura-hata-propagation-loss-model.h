@@ -53,6 +53,8 @@ class OkumuraHataPropagationLossModel : public PropagationLossModel
      */
     double GetLoss(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    bool IsLossCacheable() const override;
+
   private:
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
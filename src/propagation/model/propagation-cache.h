@@ -9,16 +9,40 @@
 #define PROPAGATION_CACHE_H_
 
 #include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/type-id.h"
+#include "ns3/uinteger.h"
 
-#include <map>
+#include <cstdint>
+#include <limits>
+#include <vector>
 
 namespace ns3
 {
+/**
+ * @ingroup propagation
+ * @brief Statistics of a PropagationCache
+ */
+struct PropagationCacheStats
+{
+    std::size_t size{0};   //!< number of paths currently stored in the cache
+    uint64_t hits{0};      //!< number of lookups that found the path in the cache
+    uint64_t misses{0};    //!< number of lookups that did not find the path in the cache
+    uint64_t evictions{0}; //!< number of paths removed due to the size or age limits
+};
+
 /**
  * @ingroup propagation
  * @brief Constructs a cache of objects, where each object is responsible for a single propagation
  * path loss calculations. Propagation path a-->b and b-->a is the same thing. Propagation path is
  * identified by a couple of MobilityModels and a spectrum model UID
+ *
+ * Paths are stored in an open addressing hash table with linear probing. The number of paths
+ * stored in the cache can be limited by setting a maximum size, in which case the least recently
+ * used path is evicted to make room for a new path. The paths that have not been used for more
+ * than a maximum age can also be evicted. By default, the size and the age of the paths are not
+ * limited. The objects associated with evicted paths are disposed (T::Dispose() is called).
  */
 template <class T>
 class PropagationCache
@@ -32,6 +56,55 @@ class PropagationCache
     {
     }
 
+    /**
+     * Set the maximum number of paths stored in the cache. If the cache currently stores more
+     * paths, the least recently used paths are evicted.
+     *
+     * @param maxSize the maximum number of paths stored in the cache (zero means no limit)
+     */
+    void SetMaxSize(std::size_t maxSize)
+    {
+        m_maxSize = maxSize;
+        while (m_maxSize > 0 && m_stats.size > m_maxSize)
+        {
+            Evict(m_lruTail);
+        }
+    }
+
+    /**
+     * @return the maximum number of paths stored in the cache (zero means no limit)
+     */
+    std::size_t GetMaxSize() const
+    {
+        return m_maxSize;
+    }
+
+    /**
+     * Set the maximum amount of time a path can be stored in the cache without being used.
+     *
+     * @param maxAge the maximum age of the paths stored in the cache (zero means no limit)
+     */
+    void SetMaxAge(Time maxAge)
+    {
+        m_maxAge = maxAge;
+    }
+
+    /**
+     * @return the maximum age of the paths stored in the cache (zero means no limit)
+     */
+    Time GetMaxAge() const
+    {
+        return m_maxAge;
+    }
+
+    /**
+     * @return the statistics of this cache
+     */
+    const PropagationCacheStats& GetStats() const
+    {
+        return m_stats;
+    }
+
     /**
      * Get the model associated with the path
      * @param a 1st node mobility model
@@ -41,13 +114,18 @@ class PropagationCache
      */
     Ptr<T> GetPathData(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
     {
+        EvictExpired();
         PropagationPathIdentifier key = PropagationPathIdentifier(a, b, modelUid);
-        auto it = m_pathCache.find(key);
-        if (it == m_pathCache.end())
+        auto slot = Find(key, Hash(key));
+        if (slot == NONE)
         {
+            m_stats.misses++;
             return nullptr;
         }
-        return it->second;
+        m_stats.hits++;
+        auto index = m_slots[slot];
+        Touch(index);
+        return m_entries[index].data;
     }
 
     /**
@@ -62,9 +140,48 @@ class PropagationCache
                      Ptr<const MobilityModel> b,
                      uint32_t modelUid)
     {
+        EvictExpired();
         PropagationPathIdentifier key = PropagationPathIdentifier(a, b, modelUid);
-        NS_ASSERT(m_pathCache.find(key) == m_pathCache.end());
-        m_pathCache.insert(std::make_pair(key, data));
+        auto hash = Hash(key);
+        NS_ASSERT(Find(key, hash) == NONE);
+
+        if (m_maxSize > 0 && m_stats.size >= m_maxSize)
+        {
+            Evict(m_lruTail);
+        }
+        if (2 * (m_stats.size + 1) > m_slots.size())
+        {
+            Rehash(std::max<std::size_t>(2 * m_slots.size(), 16));
+        }
+
+        uint32_t index;
+        if (m_freeEntries.empty())
+        {
+            index = m_entries.size();
+            m_entries.emplace_back();
+        }
+        else
+        {
+            index = m_freeEntries.back();
+            m_freeEntries.pop_back();
+        }
+        auto& entry = m_entries[index];
+        entry.key = key;
+        entry.hash = hash;
+        entry.data = data;
+        entry.prev = NONE;
+        entry.next = NONE;
+        LinkFront(index);
+        entry.lastAccess = Simulator::Now();
+
+        auto mask = m_slots.size() - 1;
+        auto slot = hash & mask;
+        while (m_slots[slot] != NONE)
+        {
+            slot = (slot + 1) & mask;
+        }
+        m_slots[slot] = index;
+        m_stats.size++;
     }
 
     /**
@@ -72,19 +189,28 @@ class PropagationCache
      */
     void Cleanup()
     {
-        for (auto i : m_pathCache)
+        for (auto index = m_lruHead; index != NONE; index = m_entries[index].next)
         {
-            i.second->Dispose();
+            m_entries[index].data->Dispose();
         }
-        m_pathCache.clear();
+        m_entries.clear();
+        m_freeEntries.clear();
+        m_slots.clear();
+        m_lruHead = NONE;
+        m_lruTail = NONE;
+        m_stats.size = 0;
     }
 
   private:
     /// Each path is identified by
     struct PropagationPathIdentifier
     {
+        PropagationPathIdentifier() = default;
+
         /**
-         * Constructor
+         * Constructor. Links are supposed to be symmetrical, hence the mobility models are
+         * stored in address order.
+         *
          * @param a 1st node mobility model
          * @param b 2nd node mobility model
          * @param modelUid model UID
@@ -92,57 +218,319 @@ class PropagationCache
         PropagationPathIdentifier(Ptr<const MobilityModel> a,
                                   Ptr<const MobilityModel> b,
                                   uint32_t modelUid)
-            : m_srcMobility(a),
-              m_dstMobility(b),
+            : m_srcMobility(std::min(a, b)),
+              m_dstMobility(std::max(a, b)),
               m_spectrumModelUid(modelUid)
         {
         }
 
-        Ptr<const MobilityModel> m_srcMobility; //!< 1st node mobility model
-        Ptr<const MobilityModel> m_dstMobility; //!< 2nd node mobility model
-        uint32_t m_spectrumModelUid;            //!< model UID
+        Ptr<const MobilityModel> m_srcMobility; //!< node mobility model with the lower address
+        Ptr<const MobilityModel> m_dstMobility; //!< node mobility model with the higher address
+        uint32_t m_spectrumModelUid{0};         //!< model UID
 
         /**
-         * Less-than operator.
-         *
-         * The goal of this operator is just to provide a stable comparison
-         * to be used in containers requiring a order (of any kind).
-         *
-         * If the models are different, the comparison is based on their Uid.
-         * Otherwise, the comparison is based on the pointers of the Mobility models.
+         * Equality operator.
          *
          * @param other Right value of the operator.
-         * @returns True if the Left value is less than the Right value.
+         * @returns True if the two identifiers refer to the same path.
          */
-        bool operator<(const PropagationPathIdentifier& other) const
+        bool operator==(const PropagationPathIdentifier& other) const
+        {
+            return m_spectrumModelUid == other.m_spectrumModelUid &&
+                   m_srcMobility == other.m_srcMobility && m_dstMobility == other.m_dstMobility;
+        }
+    };
+
+    /// Value used to indicate an empty slot or the end of the LRU list
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    /// A path stored in the cache
+    struct Entry
+    {
+        PropagationPathIdentifier key; //!< path identifier
+        std::size_t hash{0};           //!< hash of the path identifier
+        Ptr<T> data;                   //!< the object associated with the path
+        Time lastAccess;               //!< time the path was last used
+        uint32_t prev{NONE};           //!< index of the previous (more recently used) entry
+        uint32_t next{NONE};           //!< index of the next (less recently used) entry
+    };
+
+    /**
+     * @param key a path identifier
+     * @return the hash of the given path identifier
+     */
+    static std::size_t Hash(const PropagationPathIdentifier& key)
+    {
+        auto mix = [](uint64_t h) {
+            // finalizer of MurmurHash3
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        };
+        uint64_t h = mix(reinterpret_cast<uintptr_t>(PeekPointer(key.m_srcMobility)));
+        h = mix(h ^ reinterpret_cast<uintptr_t>(PeekPointer(key.m_dstMobility)));
+        return mix(h ^ key.m_spectrumModelUid);
+    }
+
+    /**
+     * @param key a path identifier
+     * @param hash the hash of the given path identifier
+     * @return the index of the slot storing the given path, if present, or NONE, otherwise
+     */
+    std::size_t Find(const PropagationPathIdentifier& key, std::size_t hash) const
+    {
+        if (m_slots.empty())
         {
-            if (m_spectrumModelUid != other.m_spectrumModelUid)
+            return NONE;
+        }
+        auto mask = m_slots.size() - 1;
+        for (auto slot = hash & mask; m_slots[slot] != NONE; slot = (slot + 1) & mask)
+        {
+            const auto& entry = m_entries[m_slots[slot]];
+            if (entry.hash == hash && entry.key == key)
             {
-                return m_spectrumModelUid < other.m_spectrumModelUid;
+                return slot;
             }
-            /// Links are supposed to be symmetrical!
-            if (std::min(m_dstMobility, m_srcMobility) !=
-                std::min(other.m_dstMobility, other.m_srcMobility))
+        }
+        return NONE;
+    }
+
+    /**
+     * Resize the hash table and reinsert all the stored paths.
+     *
+     * @param nSlots the new number of slots (a power of two)
+     */
+    void Rehash(std::size_t nSlots)
+    {
+        m_slots.assign(nSlots, NONE);
+        auto mask = nSlots - 1;
+        for (auto index = m_lruHead; index != NONE; index = m_entries[index].next)
+        {
+            auto slot = m_entries[index].hash & mask;
+            while (m_slots[slot] != NONE)
             {
-                return std::min(m_dstMobility, m_srcMobility) <
-                       std::min(other.m_dstMobility, other.m_srcMobility);
+                slot = (slot + 1) & mask;
             }
-            if (std::max(m_dstMobility, m_srcMobility) !=
-                std::max(other.m_dstMobility, other.m_srcMobility))
+            m_slots[slot] = index;
+        }
+    }
+
+    /**
+     * Insert the given entry at the head of the LRU list.
+     *
+     * @param index the index of the given entry
+     */
+    void LinkFront(uint32_t index)
+    {
+        auto& entry = m_entries[index];
+        entry.prev = NONE;
+        entry.next = m_lruHead;
+        if (m_lruHead != NONE)
+        {
+            m_entries[m_lruHead].prev = index;
+        }
+        m_lruHead = index;
+        if (m_lruTail == NONE)
+        {
+            m_lruTail = index;
+        }
+    }
+
+    /**
+     * Remove the given entry from the LRU list.
+     *
+     * @param index the index of the given entry
+     */
+    void Unlink(uint32_t index)
+    {
+        auto& entry = m_entries[index];
+        (entry.prev != NONE ? m_entries[entry.prev].next : m_lruHead) = entry.next;
+        (entry.next != NONE ? m_entries[entry.next].prev : m_lruTail) = entry.prev;
+        entry.prev = NONE;
+        entry.next = NONE;
+    }
+
+    /**
+     * Mark the given entry as the most recently used one.
+     *
+     * @param index the index of the given entry
+     */
+    void Touch(uint32_t index)
+    {
+        if (m_lruHead != index)
+        {
+            Unlink(index);
+            LinkFront(index);
+        }
+        m_entries[index].lastAccess = Simulator::Now();
+    }
+
+    /**
+     * Remove the given entry from the cache and dispose of the associated object.
+     *
+     * @param index the index of the given entry
+     */
+    void Evict(uint32_t index)
+    {
+        auto& entry = m_entries[index];
+        auto slot = Find(entry.key, entry.hash);
+        NS_ASSERT(slot != NONE);
+
+        // backward shift deletion: move back the entries following the removed one that are
+        // not in their home slot, so that lookups do not stop at the freed slot
+        auto mask = m_slots.size() - 1;
+        for (auto next = (slot + 1) & mask; m_slots[next] != NONE; next = (next + 1) & mask)
+        {
+            auto home = m_entries[m_slots[next]].hash & mask;
+            if (((next - home) & mask) >= ((next - slot) & mask))
             {
-                return std::max(m_dstMobility, m_srcMobility) <
-                       std::max(other.m_dstMobility, other.m_srcMobility);
+                m_slots[slot] = m_slots[next];
+                slot = next;
             }
-            return false;
         }
-    };
+        m_slots[slot] = NONE;
+
+        Unlink(index);
+        entry.data->Dispose();
+        entry.data = nullptr;
+        entry.key = PropagationPathIdentifier();
+        m_freeEntries.push_back(index);
+        m_stats.size--;
+        m_stats.evictions++;
+    }
+
+    /**
+     * Evict the paths that have not been used for more than the maximum age.
+     */
+    void EvictExpired()
+    {
+        if (m_maxAge.IsZero())
+        {
+            return;
+        }
+        auto now = Simulator::Now();
+        while (m_lruTail != NONE && now - m_entries[m_lruTail].lastAccess > m_maxAge)
+        {
+            Evict(m_lruTail);
+        }
+    }
+
+    std::vector<Entry> m_entries;        //!< stored paths, linked in a LRU list
+    std::vector<uint32_t> m_freeEntries; //!< indices of the unused elements of m_entries
+    std::vector<uint32_t> m_slots;       //!< hash table storing indices of m_entries
+    uint32_t m_lruHead{NONE};            //!< index of the most recently used entry
+    uint32_t m_lruTail{NONE};            //!< index of the least recently used entry
+    std::size_t m_maxSize{0};            //!< maximum number of paths (zero means no limit)
+    Time m_maxAge;                       //!< maximum age of the paths (zero means no limit)
+    PropagationCacheStats m_stats;       //!< cache statistics
+};
+
+/**
+ * @ingroup propagation
+ * @brief Base class of the propagation loss models storing path data in a PropagationCache.
+ *
+ * This class provides the methods to limit the size and the age of the cache and to retrieve
+ * its statistics. The corresponding "CacheMaxSize" and "CacheMaxAge" attributes are registered
+ * by calling AddCacheAttributes() on the TypeId of the derived class. The derived class must
+ * store the cache in a (mutable) member variable named m_propagationCache and declare this
+ * class as a friend.
+ *
+ * @tparam Derived the derived class (an ObjectBase)
+ */
+template <class Derived>
+class PropagationCacheOwner
+{
+  public:
+    /**
+     * Set the maximum number of paths stored in the propagation cache.
+     *
+     * @param maxSize the maximum number of paths (zero means no limit)
+     */
+    void SetCacheMaxSize(uint32_t maxSize)
+    {
+        GetPropagationCache().SetMaxSize(maxSize);
+    }
+
+    /**
+     * @return the maximum number of paths stored in the propagation cache
+     */
+    uint32_t GetCacheMaxSize() const
+    {
+        return GetPropagationCache().GetMaxSize();
+    }
+
+    /**
+     * Set the maximum amount of time a path can be stored in the propagation cache without
+     * being used.
+     *
+     * @param maxAge the maximum age of the paths (zero means no limit)
+     */
+    void SetCacheMaxAge(Time maxAge)
+    {
+        GetPropagationCache().SetMaxAge(maxAge);
+    }
+
+    /**
+     * @return the maximum age of the paths stored in the propagation cache
+     */
+    Time GetCacheMaxAge() const
+    {
+        return GetPropagationCache().GetMaxAge();
+    }
+
+    /**
+     * @return the statistics of the propagation cache
+     */
+    const PropagationCacheStats& GetCacheStats() const
+    {
+        return GetPropagationCache().GetStats();
+    }
 
-    /// Typedef: PropagationPathIdentifier, Ptr<T>
-    typedef std::map<PropagationPathIdentifier, Ptr<T>> PathCache;
+  protected:
+    /**
+     * Add the "CacheMaxSize" and "CacheMaxAge" attributes to the given TypeId.
+     *
+     * @param tid the TypeId of the derived class
+     * @return the given TypeId
+     */
+    static TypeId AddCacheAttributes(TypeId tid)
+    {
+        // the accessors are bound to the derived class, as required by the attribute system
+        using Setter = void (Derived::*)(uint32_t);
+        using Getter = uint32_t (Derived::*)() const;
+        using AgeSetter = void (Derived::*)(Time);
+        using AgeGetter = Time (Derived::*)() const;
+        return tid
+            .AddAttribute("CacheMaxSize",
+                          "The maximum number of paths stored in the propagation cache. When the "
+                          "cache is full, the least recently used path is evicted. Zero means "
+                          "no limit.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(static_cast<Setter>(&Derived::SetCacheMaxSize),
+                                               static_cast<Getter>(&Derived::GetCacheMaxSize)),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("CacheMaxAge",
+                          "The paths stored in the propagation cache that have not been used "
+                          "for more than this amount of time are evicted. Zero means no limit.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(static_cast<AgeSetter>(&Derived::SetCacheMaxAge),
+                                           static_cast<AgeGetter>(&Derived::GetCacheMaxAge)),
+                          MakeTimeChecker());
+    }
 
   private:
-    PathCache m_pathCache; //!< Path cache
+    /**
+     * @return the propagation cache of the derived class
+     */
+    auto& GetPropagationCache() const
+    {
+        return static_cast<const Derived*>(this)->m_propagationCache;
+    }
 };
+
 } // namespace ns3
 
 #endif // PROPAGATION_CACHE_H_
@@ -11,14 +11,23 @@
 
 #include "propagation-loss-model.h"
 
+#include "ns3/abort.h"
 #include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
+#include "ns3/node.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <tuple>
 
 namespace ns3
 {
@@ -71,6 +80,63 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
     return self;
 }
 
+void
+PropagationLossModel::CalcRxPower(double txPowerDbm,
+                                  Ptr<MobilityModel> a,
+                                  const std::vector<Ptr<MobilityModel>>& b,
+                                  std::vector<double>& rxPowerDbm) const
+{
+    NS_LOG_FUNCTION(this << txPowerDbm << a << b.size());
+    rxPowerDbm.assign(b.size(), txPowerDbm);
+    if (b.empty())
+    {
+        return;
+    }
+    for (const PropagationLossModel* model = this; model; model = PeekPointer(model->m_next))
+    {
+        model->DoCalcRxPowerBatch(a, b, rxPowerDbm);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                         const std::vector<Ptr<MobilityModel>>& b,
+                                         std::vector<double>& rxPowerDbm) const
+{
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        rxPowerDbm[i] = DoCalcRxPower(rxPowerDbm[i], a, b[i]);
+    }
+}
+
+const std::vector<double>&
+PropagationLossModel::GetDistances(Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel>>& b) const
+{
+    const auto position = a->GetPosition();
+    m_distances.resize(b.size());
+    for (std::size_t i = 0; i < b.size(); ++i)
+    {
+        m_distances[i] = CalculateDistance(position, b[i]->GetPosition());
+    }
+    return m_distances;
+}
+
+double
+PropagationLossModel::CalcRxPowerNoChain(Ptr<const PropagationLossModel> model,
+                                         double txPowerDbm,
+                                         Ptr<MobilityModel> a,
+                                         Ptr<MobilityModel> b)
+{
+    return model->DoCalcRxPower(txPowerDbm, a, b);
+}
+
+bool
+PropagationLossModel::IsLossCacheable() const
+{
+    return false;
+}
+
 int64_t
 PropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -272,12 +338,54 @@ FriisPropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - std::max(lossDb, m_minLoss);
 }
 
+void
+FriisPropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                              const std::vector<Ptr<MobilityModel>>& b,
+                                              std::vector<double>& rxPowerDbm) const
+{
+    // same computation as DoCalcRxPower, written as a branch-free loop over contiguous arrays
+    const auto& distances = GetDistances(a, b);
+    const double numerator = m_lambda * m_lambda;
+    const double minLoss = m_minLoss;
+    const double systemLoss = m_systemLoss;
+    const std::size_t n = distances.size();
+    double* rx = rxPowerDbm.data();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double distance = distances[i];
+        const double denominator = 16 * M_PI * M_PI * distance * distance * systemLoss;
+        const double lossDb = -10 * log10(numerator / denominator);
+        rx[i] -= (distance <= 0 ? minLoss : std::max(lossDb, minLoss));
+    }
+    // logging is kept out of the loop above; the far field warning is emitted once per batch
+    if (std::any_of(distances.begin(), distances.end(), [this](double d) {
+            return d < 3 * m_lambda;
+        }))
+    {
+        NS_LOG_WARN(
+            "distance not within the far field region => inaccurate propagation loss value");
+    }
+    for (const auto distance : distances)
+    {
+        NS_LOG_DEBUG("distance=" << distance << "m, loss="
+                                 << -10 * log10(numerator / (16 * M_PI * M_PI * distance *
+                                                             distance * systemLoss))
+                                 << "dB");
+    }
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams(int64_t stream)
 {
     return 0;
 }
 
+bool
+FriisPropagationLossModel::IsLossCacheable() const
+{
+    return true;
+}
+
 // ------------------------------------------------------------------------- //
 // -- Two-Ray Ground Model ported from NS-2 -- tomhewer@mac.com -- Nov09 //
 
@@ -461,6 +569,12 @@ TwoRayGroundPropagationLossModel::DoAssignStreams(int64_t stream)
     return 0;
 }
 
+bool
+TwoRayGroundPropagationLossModel::IsLossCacheable() const
+{
+    return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED(LogDistancePropagationLossModel);
@@ -549,12 +663,51 @@ LogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm + rxc;
 }
 
+void
+LogDistancePropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                                    const std::vector<Ptr<MobilityModel>>& b,
+                                                    std::vector<double>& rxPowerDbm) const
+{
+    // same computation as DoCalcRxPower, written as a branch-free loop over contiguous arrays
+    const auto& distances = GetDistances(a, b);
+    const double referenceDistance = m_referenceDistance;
+    const double referenceLoss = m_referenceLoss;
+    const double exponent = m_exponent;
+    const std::size_t n = distances.size();
+    double* rx = rxPowerDbm.data();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double distance = distances[i];
+        const double pathLossDb = 10 * exponent * std::log10(distance / referenceDistance);
+        const double rxc = -referenceLoss - pathLossDb;
+        rx[i] = (distance <= referenceDistance ? rx[i] - referenceLoss : rx[i] + rxc);
+    }
+    // logging is kept out of the loop above
+    for (const auto distance : distances)
+    {
+        NS_LOG_DEBUG("distance=" << distance << "m, reference-attenuation=" << -referenceLoss
+                                 << "dB, attenuation coefficient="
+                                 << (distance <= referenceDistance
+                                         ? -referenceLoss
+                                         : -referenceLoss - 10 * exponent *
+                                                                std::log10(distance /
+                                                                           referenceDistance))
+                                 << "db");
+    }
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
     return 0;
 }
 
+bool
+LogDistancePropagationLossModel::IsLossCacheable() const
+{
+    return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED(ThreeLogDistancePropagationLossModel);
@@ -648,12 +801,57 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - pathLossDb;
 }
 
+void
+ThreeLogDistancePropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                                         const std::vector<Ptr<MobilityModel>>& b,
+                                                         std::vector<double>& rxPowerDbm) const
+{
+    // same computation as DoCalcRxPower, with the loss accumulated over the fields that are
+    // fully traversed computed once for the whole batch
+    const auto& distances = GetDistances(a, b);
+    const double loss1 = m_referenceLoss + 10 * m_exponent0 * std::log10(m_distance1 / m_distance0);
+    const double loss2 = loss1 + 10 * m_exponent1 * std::log10(m_distance2 / m_distance1);
+    const std::size_t n = distances.size();
+    double* rx = rxPowerDbm.data();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double distance = distances[i];
+        NS_ASSERT(distance >= 0);
+        double pathLossDb;
+        if (distance < m_distance0)
+        {
+            pathLossDb = 0;
+        }
+        else if (distance < m_distance1)
+        {
+            pathLossDb = m_referenceLoss + 10 * m_exponent0 * std::log10(distance / m_distance0);
+        }
+        else if (distance < m_distance2)
+        {
+            pathLossDb = loss1 + 10 * m_exponent1 * std::log10(distance / m_distance1);
+        }
+        else
+        {
+            pathLossDb = loss2 + 10 * m_exponent2 * std::log10(distance / m_distance2);
+        }
+        NS_LOG_DEBUG("ThreeLogDistance distance=" << distance << "m, "
+                                                  << "attenuation=" << pathLossDb << "dB");
+        rx[i] -= pathLossDb;
+    }
+}
+
 int64_t
 ThreeLogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
     return 0;
 }
 
+bool
+ThreeLogDistancePropagationLossModel::IsLossCacheable() const
+{
+    return true;
+}
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED(NakagamiPropagationLossModel);
@@ -835,13 +1033,21 @@ MatrixPropagationLossModel::GetTypeId()
                           "The default value for propagation loss, dB.",
                           DoubleValue(std::numeric_limits<double>::max()),
                           MakeDoubleAccessor(&MatrixPropagationLossModel::m_default),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("MaxLoss",
+                          "The losses (dB) loaded from a file that are greater than this value "
+                          "are not stored, hence the corresponding pairs of nodes are "
+                          "unreachable. Only affects the files loaded afterwards.",
+                          DoubleValue(std::numeric_limits<double>::max()),
+                          MakeDoubleAccessor(&MatrixPropagationLossModel::m_maxLoss),
                           MakeDoubleChecker<double>());
     return tid;
 }
 
 MatrixPropagationLossModel::MatrixPropagationLossModel()
     : PropagationLossModel(),
-      m_default(std::numeric_limits<double>::max())
+      m_default(std::numeric_limits<double>::max()),
+      m_maxLoss(std::numeric_limits<double>::max())
 {
 }
 
@@ -881,20 +1087,186 @@ MatrixPropagationLossModel::SetLoss(Ptr<MobilityModel> ma,
     }
 }
 
+void
+MatrixPropagationLossModel::LoadLosses(const std::string& filename, bool symmetric)
+{
+    NS_LOG_FUNCTION(this << filename << symmetric);
+
+    // read the whole file with a single call
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    NS_ABORT_MSG_UNLESS(file.is_open(), "Cannot open the propagation loss file " << filename);
+    std::vector<char> data(file.tellg());
+    file.seekg(0);
+    file.read(data.data(), data.size());
+    NS_ABORT_MSG_UNLESS(file, "Cannot read the propagation loss file " << filename);
+
+    struct Entry
+    {
+        uint32_t src; //!< ID of the source node
+        uint32_t dst; //!< ID of the destination node
+        double loss;  //!< loss (dB)
+    };
+
+    std::vector<Entry> entries;
+    uint32_t nNodes = 0;
+    auto addLoss = [&](uint32_t src, uint32_t dst, double loss) {
+        NS_ABORT_MSG_IF(std::max(src, dst) == NO_INDEX, "Invalid node ID in " << filename);
+        nNodes = std::max({nNodes, src + 1, dst + 1});
+        entries.push_back({src, dst, loss});
+        if (symmetric && src != dst)
+        {
+            entries.push_back({dst, src, loss});
+        }
+    };
+
+    const std::string magic{"ns3-loss"};
+    if (data.size() >= magic.size() && std::equal(magic.begin(), magic.end(), data.begin()))
+    {
+        constexpr std::size_t recordSize = 2 * sizeof(uint32_t) + sizeof(float);
+        NS_ABORT_MSG_IF((data.size() - magic.size()) % recordSize != 0,
+                        "Truncated propagation loss file " << filename);
+        entries.reserve((symmetric ? 2 : 1) * (data.size() - magic.size()) / recordSize);
+        for (auto p = data.data() + magic.size(); p < data.data() + data.size(); p += recordSize)
+        {
+            uint32_t src;
+            uint32_t dst;
+            float loss;
+            std::memcpy(&src, p, sizeof(uint32_t));
+            std::memcpy(&dst, p + sizeof(uint32_t), sizeof(uint32_t));
+            std::memcpy(&loss, p + 2 * sizeof(uint32_t), sizeof(float));
+            addLoss(src, dst, loss);
+        }
+    }
+    else
+    {
+        const char* p = data.data();
+        const char* end = data.data() + data.size();
+        auto skipSeparators = [](const char* q, const char* eol) {
+            while (q < eol && (*q == ',' || std::isspace(static_cast<unsigned char>(*q))))
+            {
+                ++q;
+            }
+            return q;
+        };
+        for (uint32_t line = 1; p < end; ++line)
+        {
+            const char* eol = std::find(p, end, '\n');
+            p = skipSeparators(p, eol);
+            if (p < eol && *p != '#')
+            {
+                uint32_t src;
+                uint32_t dst;
+                double loss;
+                auto [srcEnd, srcError] = std::from_chars(p, eol, src);
+                auto [dstEnd, dstError] = std::from_chars(skipSeparators(srcEnd, eol), eol, dst);
+                auto [lossEnd, lossError] =
+                    std::from_chars(skipSeparators(dstEnd, eol), eol, loss);
+                NS_ABORT_MSG_IF(srcError != std::errc() || dstError != std::errc() ||
+                                    lossError != std::errc() ||
+                                    skipSeparators(lossEnd, eol) != eol,
+                                "Invalid line " << line << " in " << filename);
+                addLoss(src, dst, loss);
+            }
+            p = (eol == end ? end : eol + 1);
+        }
+    }
+
+    // sort the losses by source and destination, keeping the order in which the losses of
+    // the same pair appear in the file, and store the last loss of each pair in rows indexed by
+    // source node ID
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+        return std::tie(lhs.src, lhs.dst) < std::tie(rhs.src, rhs.dst);
+    });
+
+    m_nNodes = nNodes;
+    m_rowStart.assign(nNodes + 1, 0);
+    m_destinations.clear();
+    m_tableLoss.clear();
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        const auto& entry = entries[i];
+        if ((i + 1 < entries.size() && entries[i + 1].src == entry.src &&
+             entries[i + 1].dst == entry.dst) ||
+            entry.loss > m_maxLoss)
+        {
+            continue;
+        }
+        ++m_rowStart[entry.src + 1];
+        m_destinations.push_back(entry.dst);
+        m_tableLoss.push_back(entry.loss);
+    }
+    std::partial_sum(m_rowStart.begin(), m_rowStart.end(), m_rowStart.begin());
+    m_destinations.shrink_to_fit();
+    m_tableLoss.shrink_to_fit();
+
+    NS_LOG_DEBUG("Loaded " << m_tableLoss.size() << " losses between " << m_nNodes
+                           << " nodes from " << filename);
+}
+
+uint32_t
+MatrixPropagationLossModel::GetTableIndex(Ptr<MobilityModel> mobility) const
+{
+    if (m_nNodes == 0)
+    {
+        return NO_INDEX;
+    }
+    auto node = mobility->GetObject<Node>();
+    if (!node || node->GetId() >= m_nNodes)
+    {
+        return NO_INDEX;
+    }
+    return node->GetId();
+}
+
+double
+MatrixPropagationLossModel::GetLoss(Ptr<MobilityModel> a,
+                                    uint32_t aIndex,
+                                    Ptr<MobilityModel> b) const
+{
+    if (!m_loss.empty())
+    {
+        if (auto i = m_loss.find(std::make_pair(a, b)); i != m_loss.end())
+        {
+            return i->second;
+        }
+    }
+
+    if (aIndex != NO_INDEX)
+    {
+        if (auto bIndex = GetTableIndex(b); bIndex != NO_INDEX)
+        {
+            auto first = m_destinations.begin() + m_rowStart[aIndex];
+            auto last = m_destinations.begin() + m_rowStart[aIndex + 1];
+            auto it = std::lower_bound(first, last, bIndex);
+            if (it == last || *it != bIndex)
+            {
+                // the loss is not stored, b is unreachable
+                return std::numeric_limits<double>::infinity();
+            }
+            return m_tableLoss[it - m_destinations.begin()];
+        }
+    }
+
+    return m_default;
+}
+
 double
 MatrixPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                           Ptr<MobilityModel> a,
                                           Ptr<MobilityModel> b) const
 {
-    auto i = m_loss.find(std::make_pair(a, b));
+    return txPowerDbm - GetLoss(a, GetTableIndex(a), b);
+}
 
-    if (i != m_loss.end())
-    {
-        return txPowerDbm - i->second;
-    }
-    else
+void
+MatrixPropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                               const std::vector<Ptr<MobilityModel>>& b,
+                                               std::vector<double>& rxPowerDbm) const
+{
+    const auto aIndex = GetTableIndex(a);
+    for (std::size_t i = 0; i < b.size(); ++i)
     {
-        return txPowerDbm - m_default;
+        rxPowerDbm[i] -= GetLoss(a, aIndex, b[i]);
     }
 }
 
@@ -943,6 +1315,21 @@ RangePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     }
 }
 
+void
+RangePropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                              const std::vector<Ptr<MobilityModel>>& b,
+                                              std::vector<double>& rxPowerDbm) const
+{
+    const auto& distances = GetDistances(a, b);
+    const double range = m_range;
+    const std::size_t n = distances.size();
+    double* rx = rxPowerDbm.data();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        rx[i] = (distances[i] <= range ? rx[i] : -1000);
+    }
+}
+
 int64_t
 RangePropagationLossModel::DoAssignStreams(int64_t stream)
 {
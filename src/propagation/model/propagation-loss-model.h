@@ -16,7 +16,10 @@
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 
+#include <limits>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -90,6 +93,24 @@ class PropagationLossModel : public Object
      */
     double CalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    /**
+     * Returns the Rx Power at a number of receivers of the same transmission, taking into
+     * account all the PropagationLossModel(s) chained to the current one. The result is the
+     * same as calling CalcRxPower() for each receiver in turn, but each model in the chain
+     * processes all the receivers in a single call, which models may implement as a loop
+     * over contiguous arrays.
+     *
+     * @param txPowerDbm current transmission power (in dBm)
+     * @param a the mobility model of the source
+     * @param b the mobility models of the destinations
+     * @param rxPowerDbm the vector storing, on return, the reception power at each destination
+     *                   after adding/multiplying propagation loss (in dBm)
+     */
+    void CalcRxPower(double txPowerDbm,
+                     Ptr<MobilityModel> a,
+                     const std::vector<Ptr<MobilityModel>>& b,
+                     std::vector<double>& rxPowerDbm) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -103,6 +124,17 @@ class PropagationLossModel : public Object
      */
     int64_t AssignStreams(int64_t stream);
 
+    /**
+     * Return whether the Rx power computed by this model (not including the models chained to
+     * it) is the Tx power minus a loss that only depends on the position of the two nodes, and
+     * hence can be cached as long as the nodes do not move. Models whose loss depends on random
+     * variables (that are not kept constant for a given pair of nodes), on the simulation time
+     * or on the Tx power must return false, which is the default.
+     *
+     * @return whether the loss computed by this model can be cached
+     */
+    virtual bool IsLossCacheable() const;
+
   protected:
     /**
      * Assign a fixed random variable stream number to the random variables used by this model.
@@ -115,6 +147,32 @@ class PropagationLossModel : public Object
      */
     virtual int64_t DoAssignStreams(int64_t stream) = 0;
 
+    /**
+     * Returns the Rx Power computed by the given model only, i.e., without taking into account
+     * the PropagationLossModel(s) chained to it.
+     *
+     * @param model the given model
+     * @param txPowerDbm current transmission power (in dBm)
+     * @param a the mobility model of the source
+     * @param b the mobility model of the destination
+     * @returns the reception power after adding/multiplying propagation loss (in dBm)
+     */
+    static double CalcRxPowerNoChain(Ptr<const PropagationLossModel> model,
+                                     double txPowerDbm,
+                                     Ptr<MobilityModel> a,
+                                     Ptr<MobilityModel> b);
+
+    /**
+     * Compute the distance between the source and each of the destinations. The distances
+     * are stored in a buffer owned by this model, which is overwritten by the next call.
+     *
+     * @param a the mobility model of the source
+     * @param b the mobility models of the destinations
+     * @returns the distance (in meters) between the source and each destination
+     */
+    const std::vector<double>& GetDistances(Ptr<MobilityModel> a,
+                                            const std::vector<Ptr<MobilityModel>>& b) const;
+
   private:
     /**
      * PropagationLossModel.
@@ -128,7 +186,22 @@ class PropagationLossModel : public Object
                                  Ptr<MobilityModel> a,
                                  Ptr<MobilityModel> b) const = 0;
 
-    Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
+    /**
+     * Apply the propagation loss computed by this model (without taking into account the
+     * models chained to it) to a number of receivers of the same transmission. The default
+     * implementation calls DoCalcRxPower() for each destination.
+     *
+     * @param a the mobility model of the source
+     * @param b the mobility models of the destinations
+     * @param rxPowerDbm the power (in dBm) at each destination, which is updated by adding
+     *                   the propagation loss computed by this model
+     */
+    virtual void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                    const std::vector<Ptr<MobilityModel>>& b,
+                                    std::vector<double>& rxPowerDbm) const;
+
+    Ptr<PropagationLossModel> m_next;        //!< Next propagation loss model in the list
+    mutable std::vector<double> m_distances; //!< Buffer storing the distances for batches
 };
 
 /**
@@ -290,10 +363,15 @@ class FriisPropagationLossModel : public PropagationLossModel
      */
     double GetSystemLoss() const;
 
+    bool IsLossCacheable() const override;
+
   private:
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& b,
+                            std::vector<double>& rxPowerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -402,6 +480,8 @@ class TwoRayGroundPropagationLossModel : public PropagationLossModel
      */
     void SetHeightAboveZ(double heightAboveZ);
 
+    bool IsLossCacheable() const override;
+
   private:
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
@@ -480,11 +560,16 @@ class LogDistancePropagationLossModel : public PropagationLossModel
      */
     void SetReference(double referenceDistance, double referenceLoss);
 
+    bool IsLossCacheable() const override;
+
   private:
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& b,
+                            std::vector<double>& rxPowerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -556,11 +641,16 @@ class ThreeLogDistancePropagationLossModel : public PropagationLossModel
 
     // Parameters are all accessible via attributes.
 
+    bool IsLossCacheable() const override;
+
   private:
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& b,
+                            std::vector<double>& rxPowerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     double m_distance0; //!< Beginning of the first (near) distance field
@@ -691,6 +781,12 @@ class FixedRssLossModel : public PropagationLossModel
  *
  * This is supposed to be used by synthetic tests. Note that by default propagation loss is assumed
  * to be symmetric.
+ *
+ * The losses between the nodes of large scenarios (e.g., measured or ray-traced attenuation
+ * tables) can be loaded from a file with LoadLosses(). Such losses are indexed by node ID and
+ * stored in a sparse matrix, where the losses greater than the MaxLoss attribute are not stored.
+ * The pairs of nodes covered by the loaded table whose loss is not stored are unreachable, i.e.,
+ * the Rx power computed for them is minus infinity, which allows channels to skip them.
  */
 class MatrixPropagationLossModel : public PropagationLossModel
 {
@@ -725,14 +821,62 @@ class MatrixPropagationLossModel : public PropagationLossModel
      */
     void SetDefaultLoss(double defaultLoss);
 
+    /**
+     * @brief Load the losses (in dB, positive) between pairs of nodes from a file, replacing
+     * the losses loaded by a previous call.
+     *
+     * The file is either a text file whose lines contain the ID of the source node, the ID of
+     * the destination node and the loss, separated by commas or whitespace (empty lines and
+     * lines starting with '#' are ignored), or a binary file starting with the "ns3-loss" magic
+     * string followed by records made of the IDs of the source and destination nodes (32-bit
+     * unsigned integers) and the loss (32-bit float), in the byte order of the host. If a pair
+     * of nodes appears more than once, the last loss is used.
+     *
+     * A pair of nodes is covered by the loaded table if the IDs of both nodes are not greater
+     * than the largest node ID in the file. The losses set by SetLoss() take precedence over
+     * those loaded from a file, while the default loss is used for the pairs of nodes that are
+     * not covered by the loaded table.
+     *
+     * @param filename the name of the file
+     * @param symmetric if true (default), the loss of each a->b path also applies to the b->a
+     *                  path
+     */
+    void LoadLosses(const std::string& filename, bool symmetric = true);
+
   private:
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& b,
+                            std::vector<double>& rxPowerDbm) const override;
+
     int64_t DoAssignStreams(int64_t stream) override;
 
+    /**
+     * @param mobility the mobility model of a node
+     * @return the ID of the node if it is covered by the loaded table, NO_INDEX otherwise
+     */
+    uint32_t GetTableIndex(Ptr<MobilityModel> mobility) const;
+
+    /**
+     * @param a the mobility model of the source
+     * @param aIndex the index of the source in the loaded table, as returned by GetTableIndex()
+     * @param b the mobility model of the destination
+     * @return the loss (in dB) from a to b, which is infinity if b is unreachable
+     */
+    double GetLoss(Ptr<MobilityModel> a, uint32_t aIndex, Ptr<MobilityModel> b) const;
+
+    static constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max(); //!< no index
+
     double m_default; //!< default loss
+    double m_maxLoss; //!< the losses loaded from a file that are greater than this are not stored
+
+    uint32_t m_nNodes{0};                 //!< number of nodes covered by the loaded table
+    std::vector<std::size_t> m_rowStart;  //!< offset of the first loss from each source node
+    std::vector<uint32_t> m_destinations; //!< sorted destination node IDs of each source node
+    std::vector<double> m_tableLoss;      //!< loss towards each destination of each source node
 
     /// Typedef: Mobility models pair
     typedef std::pair<const Ptr<MobilityModel>, const Ptr<MobilityModel>> MobilityPair;
@@ -790,6 +934,9 @@ class RangePropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& b,
+                            std::vector<double>& rxPowerDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     double m_range; //!< Maximum Transmission Range (meters)
@@ -376,6 +376,18 @@ ThreeGppPropagationLossModel::IsO2iLowPenetrationLoss(Ptr<const ChannelCondition
     return DoIsO2iLowPenetrationLoss(cond);
 }
 
+bool
+ThreeGppPropagationLossModel::IsLossCacheable() const
+{
+    if (m_doCalcRxPowerPrologueFunction || !m_channelConditionModel)
+    {
+        return false;
+    }
+    TimeValue updatePeriod;
+    return !m_channelConditionModel->GetAttributeFailSafe("UpdatePeriod", updatePeriod) ||
+           updatePeriod.Get().IsZero();
+}
+
 double
 ThreeGppPropagationLossModel::DoCalcRxPower(double txPowerDbm,
                                             Ptr<MobilityModel> c,
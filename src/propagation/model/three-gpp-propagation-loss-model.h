@@ -95,6 +95,14 @@ class ThreeGppPropagationLossModel : public PropagationLossModel
         m_doCalcRxPowerPrologueFunction = prologueFunction;
     }
 
+    /**
+     * The loss can be cached if the channel condition (hence the shadowing) is never updated
+     * and no prologue function replacing the transmitter mobility model is installed.
+     *
+     * @return whether the loss computed by this model can be cached
+     */
+    bool IsLossCacheable() const override;
+
   private:
     /**
      * Computes the received power by applying the pathloss model described in
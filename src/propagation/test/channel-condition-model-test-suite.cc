@@ -6,15 +6,19 @@
  */
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/channel-condition-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/node-container.h"
+#include "ns3/rng-seed-manager.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("ChannelConditionModelsTest");
@@ -266,6 +270,123 @@ ThreeGppChannelConditionModelTestCase::DoRun()
     }
 }
 
+/**
+ * @ingroup propagation-tests
+ *
+ * Test case for the batch update of the channel conditions of the 3GPP channel condition
+ * models. The channel conditions between a node and several other nodes are retrieved before
+ * and after the update period has elapsed, with and without batch updates. The test checks
+ * that, with batch updates, the channel conditions are regenerated by the scheduled pass
+ * rather than when they are retrieved, and that the regenerated channel conditions are the
+ * same in both cases.
+ */
+class ThreeGppChannelConditionBatchUpdateTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelConditionBatchUpdateTestCase();
+
+  private:
+    /**
+     * Builds the simulation scenario and perform the tests
+     */
+    void DoRun() override;
+
+    /**
+     * Retrieve the channel conditions of all the links at 10 ms, 60 ms and 150 ms, with an
+     * update period of 100 ms
+     * @param batchUpdate whether the channel conditions are regenerated in batches
+     * @return the LOS conditions of the links retrieved at 150 ms
+     */
+    std::vector<ChannelCondition::LosConditionValue> GetLosConditions(bool batchUpdate);
+};
+
+ThreeGppChannelConditionBatchUpdateTestCase::ThreeGppChannelConditionBatchUpdateTestCase()
+    : TestCase("Test case for the batch update of the 3GPP channel conditions")
+{
+}
+
+std::vector<ChannelCondition::LosConditionValue>
+ThreeGppChannelConditionBatchUpdateTestCase::GetLosConditions(bool batchUpdate)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    auto condModel = CreateObject<ThreeGppUmaChannelConditionModel>();
+    condModel->SetAttribute("UpdatePeriod", TimeValue(MilliSeconds(100)));
+    condModel->SetAttribute("BatchUpdate", BooleanValue(batchUpdate));
+    condModel->AssignStreams(1);
+
+    // a base station and several users at different distances, so that the LOS probability
+    // of each link is different
+    NodeContainer nodes;
+    nodes.Create(51);
+    std::vector<Ptr<MobilityModel>> mobs;
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        mobs.push_back(CreateObject<ConstantPositionMobilityModel>());
+        mobs.back()->SetPosition(i == 0 ? Vector(0, 0, 25.0) : Vector(10.0 + 5.0 * i, 0, 1.5));
+        nodes.Get(i)->AggregateObject(mobs.back());
+    }
+
+    std::vector<Ptr<ChannelCondition>> initial;
+    std::vector<ChannelCondition::LosConditionValue> result;
+
+    Simulator::Schedule(MilliSeconds(10), [&]() {
+        for (uint32_t i = 1; i < nodes.GetN(); ++i)
+        {
+            initial.push_back(condModel->GetChannelCondition(mobs[0], mobs[i]));
+        }
+    });
+    Simulator::Schedule(MilliSeconds(60), [&]() {
+        for (uint32_t i = 1; i < nodes.GetN(); ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(condModel->GetChannelCondition(mobs[i], mobs[0]),
+                                  initial[i - 1],
+                                  "The channel condition should not have been regenerated");
+        }
+    });
+    Simulator::Schedule(MilliSeconds(150), [&]() {
+        for (uint32_t i = 1; i < nodes.GetN(); ++i)
+        {
+            auto cond = condModel->GetChannelCondition(mobs[0], mobs[i]);
+            NS_TEST_EXPECT_MSG_NE(cond,
+                                  initial[i - 1],
+                                  "The channel condition should have been regenerated");
+            if (batchUpdate)
+            {
+                // regenerated by the pass scheduled at 110 ms
+                NS_TEST_EXPECT_MSG_EQ(condModel->GetChannelCondition(mobs[0], mobs[i]),
+                                      cond,
+                                      "The channel condition should not have been regenerated");
+            }
+            result.push_back(cond->GetLosCondition());
+        }
+    });
+
+    // with batch updates, the passes stop when no channel condition is retrieved, hence the
+    // simulation ends
+    Simulator::Run();
+    Simulator::Destroy();
+    return result;
+}
+
+void
+ThreeGppChannelConditionBatchUpdateTestCase::DoRun()
+{
+    auto lazy = GetLosConditions(false);
+    auto batch = GetLosConditions(true);
+    NS_TEST_ASSERT_MSG_EQ(batch.size(), lazy.size(), "Missing channel conditions");
+    for (std::size_t i = 0; i < lazy.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ((batch[i] == lazy[i]),
+                              true,
+                              "Batch updates should regenerate the same channel conditions");
+    }
+}
+
 /**
  * @ingroup propagation-tests
  *
@@ -281,6 +402,7 @@ ChannelConditionModelsTestSuite::ChannelConditionModelsTestSuite()
     : TestSuite("propagation-channel-condition-model", Type::UNIT)
 {
     AddTestCase(new ThreeGppChannelConditionModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppChannelConditionBatchUpdateTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
@@ -5,13 +5,27 @@
  */
 
 #include "ns3/abort.h"
+#include "ns3/cached-propagation-loss-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/jakes-propagation-loss-model.h"
 #include "ns3/log.h"
+#include "ns3/node-container.h"
+#include "ns3/propagation-cache.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
 
 using namespace ns3;
 
@@ -433,6 +447,132 @@ MatrixPropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief Test the losses loaded from a file by MatrixPropagationLossModel
+ */
+class MatrixPropagationLossModelLoadTestCase : public TestCase
+{
+  public:
+    MatrixPropagationLossModelLoadTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the losses between the nodes after loading the given file.
+     *
+     * @param filename the name of the file
+     * @param nodes the nodes
+     * @param format the format of the file, for the log messages
+     */
+    void CheckLosses(const std::string& filename, const NodeContainer& nodes, std::string format);
+};
+
+MatrixPropagationLossModelLoadTestCase::MatrixPropagationLossModelLoadTestCase()
+    : TestCase("Test MatrixPropagationLossModel losses loaded from a file")
+{
+}
+
+void
+MatrixPropagationLossModelLoadTestCase::CheckLosses(const std::string& filename,
+                                                    const NodeContainer& nodes,
+                                                    std::string format)
+{
+    std::vector<Ptr<MobilityModel>> m;
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        m.push_back(nodes.Get(i)->GetObject<MobilityModel>());
+    }
+    // a mobility model not aggregated to a node
+    m.push_back(CreateObject<ConstantPositionMobilityModel>());
+    const auto inf = std::numeric_limits<double>::infinity();
+
+    auto loss = CreateObjectWithAttributes<MatrixPropagationLossModel>("DefaultLoss",
+                                                                       DoubleValue(200),
+                                                                       "MaxLoss",
+                                                                       DoubleValue(100));
+    loss->LoadLosses(filename);
+    loss->SetLoss(m[0], m[3], 70, /*symmetric = */ false);
+
+    // expected Rx power (dBm) for a Tx power of 0 dBm
+    const std::vector<std::vector<double>> expected{
+        {-inf, -50, -40, -70, -200},
+        {-50, -inf, -inf, -200, -200},
+        {-40, -inf, -inf, -200, -200},
+        {-200, -200, -200, -200, -200},
+        {-200, -200, -200, -200, -200},
+    };
+    std::vector<double> rxPowers;
+    for (std::size_t i = 0; i < m.size(); ++i)
+    {
+        loss->CalcRxPower(0, m[i], m, rxPowers);
+        for (std::size_t j = 0; j < m.size(); ++j)
+        {
+            NS_TEST_EXPECT_MSG_EQ(loss->CalcRxPower(0, m[i], m[j]),
+                                  expected[i][j],
+                                  format << ": unexpected loss " << i << " -> " << j);
+            NS_TEST_EXPECT_MSG_EQ(rxPowers[j],
+                                  expected[i][j],
+                                  format << ": unexpected batch loss " << i << " -> " << j);
+        }
+    }
+}
+
+void
+MatrixPropagationLossModelLoadTestCase::DoRun()
+{
+    // the losses are indexed by node ID; the ID of the last node is not covered by the files
+    NodeContainer nodes(4);
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        nodes.Get(i)->AggregateObject(CreateObject<ConstantPositionMobilityModel>());
+    }
+    const auto id = [&](uint32_t i) { return nodes.Get(i)->GetId(); };
+
+    // {source, destination, loss}: the losses are symmetric and the last one overrides the
+    // loss between nodes 0 and 2; the loss between nodes 1 and 2 and the loss of node 2 to
+    // itself are above MaxLoss, while the losses of nodes 0 and 1 to themselves are not in
+    // the file, hence these pairs are unreachable
+    const std::vector<std::tuple<uint32_t, uint32_t, float>> losses{
+        {id(0), id(1), 50},
+        {id(0), id(2), 80},
+        {id(2), id(1), 120},
+        {id(2), id(2), 150},
+        {id(2), id(0), 40},
+    };
+
+    const auto textFile = CreateTempDirFilename("matrix-losses.csv");
+    {
+        std::ofstream os(textFile);
+        os << "# source, destination, loss (dB)\n\n";
+        for (const auto& [src, dst, loss] : losses)
+        {
+            os << src << ", " << dst << ", " << loss << "\n";
+        }
+    }
+    CheckLosses(textFile, nodes, "Text file");
+
+    const auto binaryFile = CreateTempDirFilename("matrix-losses.bin");
+    {
+        std::ofstream os(binaryFile, std::ios::binary);
+        os << "ns3-loss";
+        for (const auto& [src, dst, loss] : losses)
+        {
+            os.write(reinterpret_cast<const char*>(&src), sizeof(src));
+            os.write(reinterpret_cast<const char*>(&dst), sizeof(dst));
+            os.write(reinterpret_cast<const char*>(&loss), sizeof(loss));
+        }
+    }
+    CheckLosses(binaryFile, nodes, "Binary file");
+
+    std::remove(textFile.c_str());
+    std::remove(binaryFile.c_str());
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup propagation-tests
  *
@@ -478,6 +618,384 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief CachedPropagationLossModel Test
+ *
+ * Check that a CachedPropagationLossModel wrapping a chain including both deterministic and
+ * stochastic models returns the same Rx power as the chain itself, that the stochastic model is
+ * still evaluated for every packet and that cached losses are invalidated when a node moves.
+ */
+class CachedPropagationLossModelTestCase : public TestCase
+{
+  public:
+    CachedPropagationLossModelTestCase();
+    ~CachedPropagationLossModelTestCase() override;
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a chain made of a LogDistance, a Nakagami and a Range propagation loss model.
+     *
+     * @return the head of the chain
+     */
+    Ptr<PropagationLossModel> CreateChain() const;
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase()
+    : TestCase("Test CachedPropagationLossModel")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase()
+{
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModelTestCase::CreateChain() const
+{
+    auto logDistance = CreateObject<LogDistancePropagationLossModel>();
+    auto nakagami = CreateObject<NakagamiPropagationLossModel>();
+    auto range = CreateObject<RangePropagationLossModel>();
+    range->SetAttribute("MaxRange", DoubleValue(200));
+    logDistance->SetNext(nakagami);
+    nakagami->SetNext(range);
+    return logDistance;
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun()
+{
+    NS_TEST_ASSERT_MSG_EQ(LogDistancePropagationLossModel().IsLossCacheable(),
+                          true,
+                          "LogDistance loss expected to be cacheable");
+    NS_TEST_ASSERT_MSG_EQ(NakagamiPropagationLossModel().IsLossCacheable(),
+                          false,
+                          "Nakagami loss not expected to be cacheable");
+
+    auto chain = CreateChain();
+    auto cached = CreateObject<CachedPropagationLossModel>();
+    cached->SetModel(CreateChain());
+    chain->AssignStreams(1);
+    cached->AssignStreams(1);
+
+    Ptr<MobilityModel> m[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        m[i] = CreateObject<ConstantPositionMobilityModel>();
+        m[i]->SetPosition(Vector(i * 40, 0, 0));
+    }
+
+    auto check = [&](std::size_t from, std::size_t to, const std::string& msg) {
+        double txPowerDbm = 16.0206;
+        auto expected = chain->CalcRxPower(txPowerDbm, m[from], m[to]);
+        auto actual = cached->CalcRxPower(txPowerDbm, m[from], m[to]);
+        NS_TEST_EXPECT_MSG_EQ(actual, expected, msg);
+        return actual;
+    };
+
+    std::set<double> rxPowers;
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        rxPowers.insert(check(0, 1, "Unexpected Rx power from 0 to 1 (iteration " +
+                                        std::to_string(i) + ")"));
+        check(1, 0, "Unexpected Rx power from 1 to 0 (iteration " + std::to_string(i) + ")");
+        check(2, 0, "Unexpected Rx power from 2 to 0 (iteration " + std::to_string(i) + ")");
+    }
+    NS_TEST_EXPECT_MSG_GT(rxPowers.size(), 1, "Nakagami fading has not been applied");
+
+    // move node 2 farther from node 0, the cached losses must be recomputed
+    m[2]->SetPosition(Vector(150, 0, 0));
+    check(0, 2, "Unexpected Rx power from 0 to 2 after moving node 2");
+    check(2, 0, "Unexpected Rx power from 2 to 0 after moving node 2");
+
+    // move node 2 out of the range of node 0
+    m[2]->SetPosition(Vector(250, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ(check(2, 0, "Unexpected Rx power from 2 to 0 out of range"),
+                          -1000,
+                          "Node 2 expected to be out of range");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief PropagationCache Test
+ *
+ * Check that paths are symmetric, that the hash table keeps working after many insertions and
+ * evictions and that the size and age limits evict the expected paths.
+ */
+class PropagationCacheTestCase : public TestCase
+{
+  public:
+    PropagationCacheTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Data stored in the cache
+    struct PathData : public SimpleRefCount<PathData>
+    {
+        /// Called when the path is removed from the cache
+        void Dispose()
+        {
+            disposed = true;
+        }
+
+        bool disposed{false}; //!< whether Dispose() has been called
+    };
+
+    /// Check that paths that are not used for more than the max age are evicted
+    void CheckMaxAge();
+
+    PropagationCache<PathData> m_ageCache;     //!< cache used to check the max age
+    std::vector<Ptr<MobilityModel>> m_nodes;   //!< mobility models
+    std::vector<Ptr<PathData>> m_ageCacheData; //!< data stored in the cache used to check max age
+};
+
+PropagationCacheTestCase::PropagationCacheTestCase()
+    : TestCase("Test PropagationCache")
+{
+}
+
+void
+PropagationCacheTestCase::CheckMaxAge()
+{
+    // at 7 ms, path (0,1) was last used at 3 ms (not expired) and path (0,2) at 0 ms (expired)
+    NS_TEST_EXPECT_MSG_EQ(m_ageCache.GetPathData(m_nodes[1], m_nodes[0], 0),
+                          m_ageCacheData[0],
+                          "Path (0,1) should not have expired");
+    NS_TEST_EXPECT_MSG_EQ(m_ageCache.GetPathData(m_nodes[0], m_nodes[2], 0),
+                          nullptr,
+                          "Path (0,2) should have expired");
+    NS_TEST_EXPECT_MSG_EQ(m_ageCacheData[1]->disposed, true, "Expired path not disposed");
+    NS_TEST_EXPECT_MSG_EQ(m_ageCache.GetStats().size, 1, "Unexpected cache size");
+}
+
+void
+PropagationCacheTestCase::DoRun()
+{
+    const std::size_t nNodes = 40;
+    for (std::size_t i = 0; i < nNodes; ++i)
+    {
+        m_nodes.push_back(CreateObject<ConstantPositionMobilityModel>());
+    }
+
+    // fill the cache with all the paths and compare against a reference map
+    PropagationCache<PathData> cache;
+    std::map<std::tuple<std::size_t, std::size_t, uint32_t>, Ptr<PathData>> reference;
+    for (std::size_t i = 0; i < nNodes; ++i)
+    {
+        for (std::size_t j = i; j < nNodes; ++j)
+        {
+            for (uint32_t uid = 0; uid < 2; ++uid)
+            {
+                auto data = Create<PathData>();
+                cache.AddPathData(data, m_nodes[i], m_nodes[j], uid);
+                reference[{i, j, uid}] = data;
+            }
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(cache.GetStats().size, reference.size(), "Unexpected cache size");
+
+    for (const auto& [key, data] : reference)
+    {
+        auto [i, j, uid] = key;
+        NS_TEST_EXPECT_MSG_EQ(cache.GetPathData(m_nodes[i], m_nodes[j], uid),
+                              data,
+                              "Unexpected data for path (" << i << "," << j << "," << uid << ")");
+        NS_TEST_EXPECT_MSG_EQ(cache.GetPathData(m_nodes[j], m_nodes[i], uid),
+                              data,
+                              "Path (" << j << "," << i << "," << uid << ") is not symmetric");
+    }
+    NS_TEST_EXPECT_MSG_EQ(cache.GetStats().hits, 2 * reference.size(), "Unexpected hits");
+    NS_TEST_EXPECT_MSG_EQ(cache.GetStats().misses, 0, "Unexpected misses");
+
+    // limit the size of the cache: the least recently used paths (i.e., the first ones in the
+    // reference map, except the one that is used again now) are evicted
+    auto first = reference.begin();
+    NS_TEST_EXPECT_MSG_EQ(cache.GetPathData(m_nodes[0], m_nodes[0], 0),
+                          first->second,
+                          "Unexpected data for path (0,0,0)");
+    const std::size_t maxSize = reference.size() / 3;
+    cache.SetMaxSize(maxSize);
+    NS_TEST_ASSERT_MSG_EQ(cache.GetStats().size, maxSize, "Unexpected cache size");
+    NS_TEST_EXPECT_MSG_EQ(cache.GetStats().evictions,
+                          reference.size() - maxSize,
+                          "Unexpected evictions");
+
+    std::size_t n = 0;
+    for (auto it = std::next(first); it != reference.end(); ++it, ++n)
+    {
+        auto [i, j, uid] = it->first;
+        auto expected = (n < reference.size() - maxSize) ? nullptr : it->second;
+        NS_TEST_EXPECT_MSG_EQ(it->second->disposed,
+                              !expected,
+                              "Unexpected disposal of path (" << i << "," << j << "," << uid
+                                                              << ")");
+        NS_TEST_EXPECT_MSG_EQ(cache.GetPathData(m_nodes[j], m_nodes[i], uid),
+                              expected,
+                              "Unexpected data for path (" << i << "," << j << "," << uid << ")");
+    }
+    NS_TEST_EXPECT_MSG_EQ(cache.GetPathData(m_nodes[0], m_nodes[0], 0),
+                          first->second,
+                          "Most recently used path should not have been evicted");
+    NS_TEST_EXPECT_MSG_EQ(cache.GetStats().misses,
+                          reference.size() - maxSize,
+                          "Unexpected misses");
+
+    // adding a path to a full cache evicts the least recently used path
+    auto data = Create<PathData>();
+    cache.AddPathData(data, m_nodes[1], m_nodes[0], 7);
+    NS_TEST_EXPECT_MSG_EQ(cache.GetStats().size, maxSize, "Unexpected cache size");
+    NS_TEST_EXPECT_MSG_EQ(cache.GetPathData(m_nodes[0], m_nodes[1], 7),
+                          data,
+                          "Unexpected data for path (0,1,7)");
+    cache.Cleanup();
+    NS_TEST_EXPECT_MSG_EQ(data->disposed, true, "Path not disposed at cleanup");
+    NS_TEST_EXPECT_MSG_EQ(cache.GetStats().size, 0, "Cache not empty after cleanup");
+
+    // paths not used for more than 5 ms are evicted
+    m_ageCache.SetMaxAge(MilliSeconds(5));
+    m_ageCacheData = {Create<PathData>(), Create<PathData>()};
+    m_ageCache.AddPathData(m_ageCacheData[0], m_nodes[0], m_nodes[1], 0);
+    m_ageCache.AddPathData(m_ageCacheData[1], m_nodes[0], m_nodes[2], 0);
+    Simulator::Schedule(MilliSeconds(3), [this]() {
+        NS_TEST_EXPECT_MSG_EQ(m_ageCache.GetPathData(m_nodes[0], m_nodes[1], 0),
+                              m_ageCacheData[0],
+                              "Path (0,1) should not have expired");
+    });
+    Simulator::Schedule(MilliSeconds(7), &PropagationCacheTestCase::CheckMaxAge, this);
+    Simulator::Run();
+
+    m_ageCache.Cleanup();
+    m_ageCacheData.clear();
+    m_nodes.clear();
+    Simulator::Destroy();
+
+    // the limits of the cache of the models owning a propagation cache are set through
+    // the attributes registered by PropagationCacheOwner
+    for (const auto& model : std::vector<Ptr<PropagationLossModel>>{
+             CreateObject<JakesPropagationLossModel>(),
+             CreateObject<CachedPropagationLossModel>()})
+    {
+        model->SetAttribute("CacheMaxSize", UintegerValue(10));
+        model->SetAttribute("CacheMaxAge", TimeValue(Seconds(2)));
+        UintegerValue maxSize;
+        model->GetAttribute("CacheMaxSize", maxSize);
+        NS_TEST_EXPECT_MSG_EQ(maxSize.Get(), 10, "Unexpected CacheMaxSize");
+        TimeValue maxAge;
+        model->GetAttribute("CacheMaxAge", maxAge);
+        NS_TEST_EXPECT_MSG_EQ(maxAge.Get(), Seconds(2), "Unexpected CacheMaxAge");
+    }
+}
+
+/**
+ * @ingroup propagation-tests
+ *
+ * @brief Batch CalcRxPower Test
+ *
+ * Check that computing the Rx power at a number of receivers with a single call returns the
+ * same values as computing the Rx power at each receiver in turn, both for the models
+ * implementing a batch computation and for those relying on the default implementation,
+ * and for chains including a stochastic model.
+ */
+class BatchPropagationLossModelTestCase : public TestCase
+{
+  public:
+    BatchPropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that the batch and the per-receiver Rx powers computed by the given models match.
+     *
+     * @param batchModel the model used to compute the Rx powers in a batch
+     * @param model the model used to compute the Rx power at each receiver in turn
+     * @param name the name of the model
+     */
+    void CheckModel(Ptr<PropagationLossModel> batchModel,
+                    Ptr<PropagationLossModel> model,
+                    const std::string& name);
+
+    Ptr<MobilityModel> m_sender;                  //!< the mobility model of the sender
+    std::vector<Ptr<MobilityModel>> m_receivers; //!< the mobility models of the receivers
+};
+
+BatchPropagationLossModelTestCase::BatchPropagationLossModelTestCase()
+    : TestCase("Test the batch computation of the Rx power")
+{
+}
+
+void
+BatchPropagationLossModelTestCase::CheckModel(Ptr<PropagationLossModel> batchModel,
+                                              Ptr<PropagationLossModel> model,
+                                              const std::string& name)
+{
+    const double txPowerDbm = 20;
+    std::vector<double> rxPowersDbm{1, 2, 3}; // overwritten
+    batchModel->CalcRxPower(txPowerDbm, m_sender, m_receivers, rxPowersDbm);
+    NS_TEST_ASSERT_MSG_EQ(rxPowersDbm.size(),
+                          m_receivers.size(),
+                          "Unexpected number of Rx powers for " << name);
+    for (std::size_t i = 0; i < m_receivers.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(rxPowersDbm[i],
+                              model->CalcRxPower(txPowerDbm, m_sender, m_receivers[i]),
+                              "Unexpected Rx power at receiver " << i << " for " << name);
+    }
+
+    batchModel->CalcRxPower(txPowerDbm, m_sender, {}, rxPowersDbm);
+    NS_TEST_EXPECT_MSG_EQ(rxPowersDbm.empty(), true, "Expected no Rx power for " << name);
+}
+
+void
+BatchPropagationLossModelTestCase::DoRun()
+{
+    m_sender = CreateObject<ConstantPositionMobilityModel>();
+    m_sender->SetPosition(Vector(10, 20, 1.5));
+    // receivers within all the distance fields of the models, including the sender position
+    for (double distance : {0.0, 0.5, 1.0, 7.3, 100.0, 200.0, 350.0, 500.0, 1200.0})
+    {
+        Ptr<MobilityModel> receiver = CreateObject<ConstantPositionMobilityModel>();
+        receiver->SetPosition(Vector(10 + distance * 0.6, 20 + distance * 0.8, 1.5));
+        m_receivers.push_back(receiver);
+    }
+
+    for (const auto& typeId : {"ns3::FriisPropagationLossModel",
+                               "ns3::LogDistancePropagationLossModel",
+                               "ns3::ThreeLogDistancePropagationLossModel",
+                               "ns3::RangePropagationLossModel",
+                               "ns3::TwoRayGroundPropagationLossModel"})
+    {
+        ObjectFactory factory(typeId);
+        auto model = factory.Create<PropagationLossModel>();
+        CheckModel(model, model, typeId);
+    }
+
+    // a chain including a stochastic model: two chains using the same streams must return the
+    // same values, whether the Rx power is computed in a batch or for each receiver in turn
+    auto createChain = []() {
+        auto logDistance = CreateObject<LogDistancePropagationLossModel>();
+        auto nakagami = CreateObject<NakagamiPropagationLossModel>();
+        auto range = CreateObject<RangePropagationLossModel>();
+        range->SetAttribute("MaxRange", DoubleValue(400));
+        logDistance->SetNext(nakagami);
+        nakagami->SetNext(range);
+        logDistance->AssignStreams(1);
+        return logDistance;
+    };
+    CheckModel(createChain(), createChain(), "chain");
+
+    m_sender = nullptr;
+    m_receivers.clear();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup propagation-tests
  *
@@ -489,6 +1007,9 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - CachedPropagationLossModel
+ *   - PropagationCache
+ *   - Batch CalcRxPower
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -503,7 +1024,11 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new TwoRayGroundPropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::Duration::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MatrixPropagationLossModelLoadTestCase, TestCase::Duration::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new CachedPropagationLossModelTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new PropagationCacheTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BatchPropagationLossModelTestCase, TestCase::Duration::QUICK);
 }
 
 /// Static variable for test initialization
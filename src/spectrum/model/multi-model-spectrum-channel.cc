@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -268,6 +269,15 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
         convertedPsds.emplace(rxSpectrumModelUid, convertedTxPowerSpectrum);
     }
 
+    // the receivers whose received PSD will be computed by the phased array spectrum
+    // propagation loss model
+    Ptr<const PhasedArrayModel> txPhasedArrayModel;
+    std::vector<PhasedArraySpectrumPropagationLossModel::Receiver> phasedArrayReceivers;
+    if (m_phasedArraySpectrumPropagationLoss && !m_spectrumPropagationLoss)
+    {
+        txPhasedArrayModel = DynamicCast<PhasedArrayModel>(txParams->txPhy->GetAntenna());
+    }
+
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
@@ -331,6 +341,15 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     {
                         delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
                     }
+                    if (txPhasedArrayModel)
+                    {
+                        if (auto rxPhasedArrayModel =
+                                DynamicCast<PhasedArrayModel>((*rxPhyIterator)->GetAntenna()))
+                        {
+                            phasedArrayReceivers.push_back(
+                                {receiverMobility, rxPhasedArrayModel, rxParams->psd});
+                        }
+                    }
                 }
 
                 if (rxNetDevice)
@@ -363,6 +382,14 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             }
         }
     }
+
+    if (!phasedArrayReceivers.empty())
+    {
+        m_phasedArraySpectrumPropagationLoss->PrepareRxPowerSpectralDensities(
+            txMobility,
+            txPhasedArrayModel,
+            phasedArrayReceivers);
+    }
 }
 
 void
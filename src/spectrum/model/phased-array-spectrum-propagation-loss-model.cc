@@ -77,6 +77,30 @@ PhasedArraySpectrumPropagationLossModel::CalcRxPowerSpectralDensity(
     return rxParams;
 }
 
+void
+PhasedArraySpectrumPropagationLossModel::PrepareRxPowerSpectralDensities(
+    Ptr<const MobilityModel> a,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    const std::vector<Receiver>& receivers) const
+{
+    NS_LOG_FUNCTION(this << a << aPhasedArrayModel << receivers.size());
+    DoPrepareRxPowerSpectralDensities(a, aPhasedArrayModel, receivers);
+
+    if (m_next)
+    {
+        m_next->PrepareRxPowerSpectralDensities(a, aPhasedArrayModel, receivers);
+    }
+}
+
+void
+PhasedArraySpectrumPropagationLossModel::DoPrepareRxPowerSpectralDensities(
+    Ptr<const MobilityModel> a,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    const std::vector<Receiver>& receivers) const
+{
+    NS_LOG_FUNCTION(this << a << aPhasedArrayModel << receivers.size());
+}
+
 int64_t
 PhasedArraySpectrumPropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -14,6 +14,8 @@
 #include "ns3/object.h"
 #include "ns3/phased-array-model.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -78,6 +80,29 @@ class PhasedArraySpectrumPropagationLossModel : public Object
         Ptr<const PhasedArrayModel> aPhasedArrayModel,
         Ptr<const PhasedArrayModel> bPhasedArrayModel) const;
 
+    /// A receiver of a signal, whose received PSD is to be computed
+    struct Receiver
+    {
+        Ptr<const MobilityModel> mobility;            //!< the mobility of the receiver
+        Ptr<const PhasedArrayModel> phasedArrayModel; //!< the antenna array of the receiver
+        Ptr<const SpectrumValue> psd; //!< the PSD of the signal as seen by the receiver
+    };
+
+    /**
+     * Notify this model (and the chained ones) that a signal has been transmitted and that
+     * the received PSDs will be computed (by calling CalcRxPowerSpectralDensity) when the
+     * signal reaches the given receivers. Models can use this notification to compute ahead
+     * of time the terms that do not depend on the reception time, as long as the received
+     * PSDs do not change.
+     *
+     * @param a sender mobility
+     * @param aPhasedArrayModel the instance of the phased antenna array of the sender
+     * @param receivers the receivers of the signal
+     */
+    void PrepareRxPowerSpectralDensities(Ptr<const MobilityModel> a,
+                                         Ptr<const PhasedArrayModel> aPhasedArrayModel,
+                                         const std::vector<Receiver>& receivers) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -124,6 +149,18 @@ class PhasedArraySpectrumPropagationLossModel : public Object
         Ptr<const PhasedArrayModel> aPhasedArrayModel,
         Ptr<const PhasedArrayModel> bPhasedArrayModel) const = 0;
 
+    /**
+     * Subclasses can override this method to compute ahead of time the terms of the received
+     * PSDs that do not depend on the reception time. The default implementation does nothing.
+     *
+     * @param a sender mobility
+     * @param aPhasedArrayModel the instance of the phased antenna array of the sender
+     * @param receivers the receivers of the signal
+     */
+    virtual void DoPrepareRxPowerSpectralDensities(Ptr<const MobilityModel> a,
+                                                   Ptr<const PhasedArrayModel> aPhasedArrayModel,
+                                                   const std::vector<Receiver>& receivers) const;
+
     Ptr<PhasedArraySpectrumPropagationLossModel>
         m_next; //!< PhasedArraySpectrumPropagationLossModel chained to this one.
 };
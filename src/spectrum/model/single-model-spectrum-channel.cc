@@ -27,6 +27,8 @@
 #include "ns3/simulator.h"
 
 #include <algorithm>
+#include <iterator>
+#include <vector>
 
 namespace ns3
 {
@@ -112,11 +114,17 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     }
 
     Ptr<MobilityModel> senderMobility = txParams->txPhy->GetMobility();
+    Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
 
-    for (auto rxPhyIterator = m_phyList.begin(); rxPhyIterator != m_phyList.end(); ++rxPhyIterator)
+    // select the receivers first, so that the propagation loss to all the receivers having
+    // a mobility model is computed with a single call to the propagation loss model
+    std::vector<Ptr<SpectrumPhy>> receivers;
+    std::vector<Ptr<MobilityModel>> receiverMobilities;
+    receivers.reserve(m_phyList.size());
+    receiverMobilities.reserve(m_phyList.size());
+    for (const auto& rxPhy : m_phyList)
     {
-        Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
-        Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
+        Ptr<NetDevice> rxNetDevice = rxPhy->GetDevice();
 
         if (rxNetDevice && txNetDevice)
         {
@@ -129,94 +137,108 @@ SingleModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             }
         }
 
-        if (m_filter && m_filter->Filter(txParams, *rxPhyIterator))
+        if (m_filter && m_filter->Filter(txParams, rxPhy))
         {
             continue;
         }
 
-        if ((*rxPhyIterator) != txParams->txPhy)
+        if (rxPhy != txParams->txPhy)
         {
-            Time delay;
+            receivers.push_back(rxPhy);
+            receiverMobilities.push_back(rxPhy->GetMobility());
+        }
+    }
+
+    std::vector<Ptr<MobilityModel>> lossMobilities;
+    std::vector<double> propagationGainsDb;
+    if (senderMobility && m_propagationLoss)
+    {
+        lossMobilities.reserve(receiverMobilities.size());
+        std::copy_if(receiverMobilities.cbegin(),
+                     receiverMobilities.cend(),
+                     std::back_inserter(lossMobilities),
+                     [](const Ptr<MobilityModel>& mobility) { return mobility != nullptr; });
+        m_propagationLoss->CalcRxPower(0, senderMobility, lossMobilities, propagationGainsDb);
+    }
 
-            Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
-            NS_LOG_LOGIC("copying signal parameters " << txParams);
-            Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+    std::size_t lossIndex = 0;
+    for (std::size_t i = 0; i < receivers.size(); ++i)
+    {
+        const auto& rxPhy = receivers[i];
+        Time delay;
+
+        const auto& receiverMobility = receiverMobilities[i];
+        NS_LOG_LOGIC("copying signal parameters " << txParams);
+        Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
 
-            if (senderMobility && receiverMobility)
+        if (senderMobility && receiverMobility)
+        {
+            double txAntennaGain = 0;
+            double rxAntennaGain = 0;
+            double propagationGainDb = 0;
+            double pathLossDb = 0;
+            if (rxParams->txAntenna)
             {
-                double txAntennaGain = 0;
-                double rxAntennaGain = 0;
-                double propagationGainDb = 0;
-                double pathLossDb = 0;
-                if (rxParams->txAntenna)
-                {
-                    Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
-                    txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
-                    NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
-                    pathLossDb -= txAntennaGain;
-                }
-                Ptr<AntennaModel> rxAntenna =
-                    DynamicCast<AntennaModel>((*rxPhyIterator)->GetAntenna());
-                if (rxAntenna)
-                {
-                    Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
-                    rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
-                    NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
-                    pathLossDb -= rxAntennaGain;
-                }
-                if (m_propagationLoss)
-                {
-                    propagationGainDb =
-                        m_propagationLoss->CalcRxPower(0, senderMobility, receiverMobility);
-                    NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
-                    pathLossDb -= propagationGainDb;
-                }
-                NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
-                // Gain trace
-                m_gainTrace(senderMobility,
-                            receiverMobility,
-                            txAntennaGain,
-                            rxAntennaGain,
-                            propagationGainDb,
-                            pathLossDb);
-                // Pathloss trace
-                m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
-                if (pathLossDb > m_maxLossDb)
-                {
-                    // beyond range
-                    continue;
-                }
-                double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                *(rxParams->psd) *= pathGainLinear;
-
-                if (m_propagationDelay)
-                {
-                    delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
-                }
+                Angles txAngles(receiverMobility->GetPosition(), senderMobility->GetPosition());
+                txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
+                NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
+                pathLossDb -= txAntennaGain;
             }
-
-            if (rxNetDevice)
+            Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(rxPhy->GetAntenna());
+            if (rxAntenna)
+            {
+                Angles rxAngles(senderMobility->GetPosition(), receiverMobility->GetPosition());
+                rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
+                NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
+                pathLossDb -= rxAntennaGain;
+            }
+            if (m_propagationLoss)
             {
-                // the receiver has a NetDevice, so we expect that it is attached to a Node
-                uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                Simulator::ScheduleWithContext(dstNode,
-                                               delay,
-                                               &SingleModelSpectrumChannel::StartRx,
-                                               this,
-                                               rxParams,
-                                               *rxPhyIterator);
+                propagationGainDb = propagationGainsDb[lossIndex++];
+                NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
+                pathLossDb -= propagationGainDb;
             }
-            else
+            NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
+            // Gain trace
+            m_gainTrace(senderMobility,
+                        receiverMobility,
+                        txAntennaGain,
+                        rxAntennaGain,
+                        propagationGainDb,
+                        pathLossDb);
+            // Pathloss trace
+            m_pathLossTrace(txParams->txPhy, rxPhy, pathLossDb);
+            if (pathLossDb > m_maxLossDb)
+            {
+                // beyond range
+                continue;
+            }
+            double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+            *(rxParams->psd) *= pathGainLinear;
+
+            if (m_propagationDelay)
             {
-                // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                // attached to a node
-                Simulator::Schedule(delay,
-                                    &SingleModelSpectrumChannel::StartRx,
-                                    this,
-                                    rxParams,
-                                    *rxPhyIterator);
+                delay = m_propagationDelay->GetDelay(senderMobility, receiverMobility);
             }
         }
+
+        if (Ptr<NetDevice> rxNetDevice = rxPhy->GetDevice())
+        {
+            // the receiver has a NetDevice, so we expect that it is attached to a Node
+            uint32_t dstNode = rxNetDevice->GetNode()->GetId();
+            Simulator::ScheduleWithContext(dstNode,
+                                           delay,
+                                           &SingleModelSpectrumChannel::StartRx,
+                                           this,
+                                           rxParams,
+                                           rxPhy);
+        }
+        else
+        {
+            // the receiver is not attached to a NetDevice, so we cannot assume that it is
+            // attached to a node
+            Simulator::Schedule(delay, &SingleModelSpectrumChannel::StartRx, this, rxParams, rxPhy);
+        }
     }
 }
 
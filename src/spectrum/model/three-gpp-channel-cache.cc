@@ -0,0 +1,246 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "three-gpp-channel-cache.h"
+
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ThreeGppChannelCache");
+
+NS_OBJECT_ENSURE_REGISTERED(ThreeGppChannelCache);
+
+TypeId
+ThreeGppChannelCache::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ThreeGppChannelCache")
+            .SetGroupName("Spectrum")
+            .SetParent<Object>()
+            .AddConstructor<ThreeGppChannelCache>()
+            .AddAttribute("MaxSize",
+                          "The maximum number of channel matrices stored in the cache. When the "
+                          "cache is full, the least recently used matrix is evicted. The value 0 "
+                          "means that the number of stored matrices is not limited.",
+                          UintegerValue(4096),
+                          MakeUintegerAccessor(&ThreeGppChannelCache::SetMaxSize,
+                                               &ThreeGppChannelCache::GetMaxSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("NumWorkerThreads",
+                          "The number of worker threads used to generate the channel matrices "
+                          "of all the links between a pair of nodes when the channel parameters "
+                          "of the pair of nodes are regenerated. The value 0 disables the "
+                          "generation of channel matrices ahead of time.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppChannelCache::m_nThreads),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+ThreeGppChannelCache::ThreeGppChannelCache()
+    : m_maxSize(0),
+      m_nThreads(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ThreeGppChannelCache::~ThreeGppChannelCache()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ThreeGppChannelCache::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+    Object::DoDispose();
+}
+
+std::size_t
+ThreeGppChannelCache::KeyHash::operator()(const ParamsKey& key) const
+{
+    auto hash = std::hash<uint64_t>()(key.nodePair);
+    hash ^= std::hash<double>()(key.frequency) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<std::string>()(key.scenario) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+std::size_t
+ThreeGppChannelCache::KeyHash::operator()(const ChannelKey& key) const
+{
+    auto hash = std::hash<uint64_t>()(key.nodePair);
+    hash ^= std::hash<uint64_t>()(key.lowerHash) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<uint64_t>()(key.higherHash) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<double>()(key.frequency) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+Ptr<MatrixBasedChannelModel::ChannelParams>
+ThreeGppChannelCache::GetParams(uint64_t nodePair,
+                                double frequency,
+                                const std::string& scenario) const
+{
+    NS_LOG_FUNCTION(this << nodePair << frequency << scenario);
+    auto it = m_params.find({nodePair, frequency, scenario});
+    return it != m_params.end() ? it->second : nullptr;
+}
+
+void
+ThreeGppChannelCache::SetParams(uint64_t nodePair,
+                                double frequency,
+                                const std::string& scenario,
+                                Ptr<MatrixBasedChannelModel::ChannelParams> params)
+{
+    NS_LOG_FUNCTION(this << nodePair << frequency << scenario << params);
+    m_params[{nodePair, frequency, scenario}] = params;
+}
+
+Ptr<const MatrixBasedChannelModel::ChannelMatrix>
+ThreeGppChannelCache::GetChannel(const ChannelKey& key,
+                                 Ptr<const MatrixBasedChannelModel::ChannelParams> params)
+{
+    NS_LOG_FUNCTION(this << key.nodePair << key.lowerHash << key.higherHash << key.frequency);
+
+    auto it = m_channels.find(key);
+    if (it == m_channels.end() || it->second->params != params)
+    {
+        NS_LOG_DEBUG("Channel matrix not found or generated from other channel params");
+        m_stats.misses++;
+        return nullptr;
+    }
+    m_stats.hits++;
+    // move the entry to the front of the LRU list
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->channel;
+}
+
+void
+ThreeGppChannelCache::AddChannel(const ChannelKey& key,
+                                 Ptr<const MatrixBasedChannelModel::ChannelParams> params,
+                                 Ptr<const MatrixBasedChannelModel::ChannelMatrix> channel)
+{
+    NS_LOG_FUNCTION(this << key.nodePair << key.lowerHash << key.higherHash << key.frequency);
+
+    if (auto it = m_channels.find(key); it != m_channels.end())
+    {
+        it->second->params = params;
+        it->second->channel = channel;
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        return;
+    }
+
+    if (m_maxSize > 0 && m_lru.size() >= m_maxSize)
+    {
+        EvictLru();
+    }
+    m_lru.push_front({key, params, channel});
+    m_channels.emplace(key, m_lru.begin());
+    m_stats.size = m_lru.size();
+}
+
+void
+ThreeGppChannelCache::EvictLru()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_lru.empty());
+    m_channels.erase(m_lru.back().key);
+    m_lru.pop_back();
+    m_stats.evictions++;
+    m_stats.size = m_lru.size();
+}
+
+void
+ThreeGppChannelCache::SetMaxSize(uint32_t maxSize)
+{
+    NS_LOG_FUNCTION(this << maxSize);
+    m_maxSize = maxSize;
+    while (m_maxSize > 0 && m_lru.size() > m_maxSize)
+    {
+        EvictLru();
+    }
+}
+
+uint32_t
+ThreeGppChannelCache::GetMaxSize() const
+{
+    return m_maxSize;
+}
+
+const PropagationCacheStats&
+ThreeGppChannelCache::GetStats() const
+{
+    return m_stats;
+}
+
+void
+ThreeGppChannelCache::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    m_params.clear();
+    m_channels.clear();
+    m_lru.clear();
+    m_stats.size = 0;
+}
+
+uint32_t
+ThreeGppChannelCache::GetNumWorkerThreads() const
+{
+    return m_nThreads;
+}
+
+void
+ThreeGppChannelCache::RunJobs(std::size_t nJobs, const std::function<void(std::size_t)>& job) const
+{
+    NS_LOG_FUNCTION(this << nJobs);
+    RunJobs(m_nThreads, nJobs, job);
+}
+
+void
+ThreeGppChannelCache::RunJobs(uint32_t nThreads,
+                              std::size_t nJobs,
+                              const std::function<void(std::size_t)>& job)
+{
+    NS_LOG_FUNCTION(nThreads << nJobs);
+
+    auto nWorkers = std::min<std::size_t>(nThreads, nJobs);
+    if (nWorkers <= 1)
+    {
+        for (std::size_t i = 0; i < nJobs; ++i)
+        {
+            job(i);
+        }
+        return;
+    }
+
+    // each thread repeatedly picks the next job to run until all the jobs have been picked
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (auto i = next++; i < nJobs; i = next++)
+        {
+            job(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nWorkers);
+    for (std::size_t t = 0; t < nWorkers; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+} // namespace ns3
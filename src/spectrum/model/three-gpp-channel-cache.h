@@ -0,0 +1,240 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef THREE_GPP_CHANNEL_CACHE_H
+#define THREE_GPP_CHANNEL_CACHE_H
+
+#include "matrix-based-channel-model.h"
+
+#include "ns3/object.h"
+#include "ns3/propagation-cache.h"
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace ns3
+{
+
+/**
+ * @ingroup spectrum
+ * @brief Storage of 3GPP channel parameters and channel matrices shared among
+ * ThreeGppChannelModel instances.
+ *
+ * By default, each ThreeGppChannelModel generates and stores the channel parameters of every
+ * pair of nodes and the channel matrix of every pair of antenna arrays. When the same pair of
+ * nodes is connected by several links (e.g., several PHYs, each with its own channel model
+ * and antenna arrays), the same computations are repeated for every link. When a
+ * ThreeGppChannelCache is set as the "ChannelCache" attribute of several channel models:
+ *
+ * - the channel parameters of a pair of nodes are shared among all the channel models using
+ *   the same scenario and the same center frequency, i.e., they are generated by the first
+ *   channel model needing them and then used by all the others (until one of the channel
+ *   models regenerates them);
+ * - the channel matrices are stored in a bounded cache, keyed by the pair of nodes, the
+ *   configuration hash (see PhasedArrayModel::GetConfigHash) of the antenna arrays of the
+ *   two nodes and the center frequency. A channel matrix generated for a pair of antenna
+ *   arrays is reused for any other pair of antenna arrays of the same nodes having the same
+ *   configuration, as long as the channel parameters it was generated from are in use.
+ *   The least recently used matrix is evicted when the cache is full.
+ *
+ * Channel models sharing a cache should also share the channel condition model, otherwise
+ * the channel parameters are regenerated every time they are used by a channel model seeing
+ * a different channel condition. Note that links sharing channel parameters or channel
+ * matrices experience correlated (in fact, identical) small-scale fading.
+ *
+ * Finally, when the "NumWorkerThreads" attribute is not zero, the channel models using this
+ * cache generate the channel matrices of all the links between a pair of nodes as soon as the
+ * channel parameters of the pair of nodes are regenerated, using the given number of worker
+ * threads, rather than waiting for each link to be used (see
+ * ThreeGppChannelModel::GetChannel).
+ */
+class ThreeGppChannelCache : public Object
+{
+  public:
+    /**
+     * Get the type ID
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    ThreeGppChannelCache();
+    ~ThreeGppChannelCache() override;
+
+    /// Key identifying a channel matrix stored in the cache
+    struct ChannelKey
+    {
+        uint64_t nodePair;   //!< reciprocal key of the pair of nodes
+        uint64_t lowerHash;  //!< antenna config hash of the node with the lower ID
+        uint64_t higherHash; //!< antenna config hash of the node with the higher ID
+        double frequency;    //!< the center frequency in Hz
+
+        /**
+         * @param other another key
+         * @return whether the two keys are equal
+         */
+        bool operator==(const ChannelKey& other) const = default;
+    };
+
+    /**
+     * Get the channel parameters shared for a pair of nodes.
+     *
+     * @param nodePair the reciprocal key of the pair of nodes
+     * @param frequency the center frequency in Hz
+     * @param scenario the 3GPP scenario
+     * @return the channel parameters, or a null pointer if not present
+     */
+    Ptr<MatrixBasedChannelModel::ChannelParams> GetParams(uint64_t nodePair,
+                                                          double frequency,
+                                                          const std::string& scenario) const;
+
+    /**
+     * Store (or replace) the channel parameters shared for a pair of nodes.
+     *
+     * @param nodePair the reciprocal key of the pair of nodes
+     * @param frequency the center frequency in Hz
+     * @param scenario the 3GPP scenario
+     * @param params the channel parameters
+     */
+    void SetParams(uint64_t nodePair,
+                   double frequency,
+                   const std::string& scenario,
+                   Ptr<MatrixBasedChannelModel::ChannelParams> params);
+
+    /**
+     * Look for a channel matrix generated from the given channel parameters.
+     *
+     * @param key the key of the channel matrix
+     * @param params the channel parameters the channel matrix must be generated from
+     * @return the channel matrix, or a null pointer if not present
+     */
+    Ptr<const MatrixBasedChannelModel::ChannelMatrix> GetChannel(
+        const ChannelKey& key,
+        Ptr<const MatrixBasedChannelModel::ChannelParams> params);
+
+    /**
+     * Store (or replace) a channel matrix, possibly evicting the least recently used one.
+     *
+     * @param key the key of the channel matrix
+     * @param params the channel parameters the channel matrix was generated from
+     * @param channel the channel matrix
+     */
+    void AddChannel(const ChannelKey& key,
+                    Ptr<const MatrixBasedChannelModel::ChannelParams> params,
+                    Ptr<const MatrixBasedChannelModel::ChannelMatrix> channel);
+
+    /**
+     * @return the statistics about the usage of the cache of channel matrices (the size is
+     * the number of channel matrices stored, a hit is a lookup finding a channel matrix
+     * generated from the given channel parameters)
+     */
+    const PropagationCacheStats& GetStats() const;
+
+    /**
+     * Remove all the channel parameters and channel matrices.
+     */
+    void Clear();
+
+    /**
+     * @return the number of worker threads used to generate channel matrices ahead of time
+     */
+    uint32_t GetNumWorkerThreads() const;
+
+    /**
+     * Run the given number of jobs on at most NumWorkerThreads worker threads (or on the
+     * calling thread, if NumWorkerThreads is zero) and wait for all of them to complete.
+     * The jobs must be independent of each other and must not interact with the simulator.
+     *
+     * @param nJobs the number of jobs
+     * @param job the function running the job with the given index
+     */
+    void RunJobs(std::size_t nJobs, const std::function<void(std::size_t)>& job) const;
+
+    /**
+     * Run the given number of jobs on at most the given number of worker threads (or on the
+     * calling thread, if the number of threads is zero) and wait for all of them to complete.
+     * The jobs must be independent of each other and must not interact with the simulator.
+     *
+     * @param nThreads the maximum number of worker threads
+     * @param nJobs the number of jobs
+     * @param job the function running the job with the given index
+     */
+    static void RunJobs(uint32_t nThreads,
+                        std::size_t nJobs,
+                        const std::function<void(std::size_t)>& job);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * Set the maximum number of channel matrices stored, evicting the least recently used
+     * matrices if needed.
+     *
+     * @param maxSize the maximum number of channel matrices, 0 means unlimited
+     */
+    void SetMaxSize(uint32_t maxSize);
+
+    /**
+     * @return the maximum number of channel matrices stored, 0 means unlimited
+     */
+    uint32_t GetMaxSize() const;
+
+    /// Evict the least recently used channel matrix
+    void EvictLru();
+
+    /// Key identifying the channel parameters shared for a pair of nodes
+    struct ParamsKey
+    {
+        uint64_t nodePair;    //!< reciprocal key of the pair of nodes
+        double frequency;     //!< the center frequency in Hz
+        std::string scenario; //!< the 3GPP scenario
+
+        /**
+         * @param other another key
+         * @return whether the two keys are equal
+         */
+        bool operator==(const ParamsKey& other) const = default;
+    };
+
+    /// Hash function for the keys
+    struct KeyHash
+    {
+        /**
+         * @param key the key of the channel parameters
+         * @return the hash of the key
+         */
+        std::size_t operator()(const ParamsKey& key) const;
+
+        /**
+         * @param key the key of the channel matrix
+         * @return the hash of the key
+         */
+        std::size_t operator()(const ChannelKey& key) const;
+    };
+
+    /// A channel matrix stored in the cache
+    struct Entry
+    {
+        ChannelKey key; //!< the key of the channel matrix
+        Ptr<const MatrixBasedChannelModel::ChannelParams>
+            params; //!< the channel parameters the matrix was generated from
+        Ptr<const MatrixBasedChannelModel::ChannelMatrix> channel; //!< the channel matrix
+    };
+
+    std::unordered_map<ParamsKey, Ptr<MatrixBasedChannelModel::ChannelParams>, KeyHash>
+        m_params;           //!< the shared channel parameters
+    std::list<Entry> m_lru; //!< the channel matrices, the most recently used first
+    std::unordered_map<ChannelKey, std::list<Entry>::iterator, KeyHash>
+        m_channels;                //!< the channel matrices, by key
+    uint32_t m_maxSize;            //!< the maximum number of channel matrices, 0 means unlimited
+    uint32_t m_nThreads;           //!< the number of worker threads
+    PropagationCacheStats m_stats; //!< the statistics about the cache of channel matrices
+};
+
+} // namespace ns3
+
+#endif /* THREE_GPP_CHANNEL_CACHE_H */
@@ -26,6 +26,7 @@
 #include <array>
 #include <map>
 #include <random>
+#include <vector>
 
 namespace ns3
 {
@@ -1092,7 +1093,9 @@ ThreeGppChannelModel::DoDispose()
     }
     m_channelMatrixMap.clear();
     m_channelParamsMap.clear();
+    m_links.clear();
     m_channelConditionModel = nullptr;
+    m_channelCache = nullptr;
 }
 
 TypeId
@@ -1123,6 +1126,16 @@ ThreeGppChannelModel::GetTypeId()
                           MakePointerAccessor(&ThreeGppChannelModel::SetChannelConditionModel,
                                               &ThreeGppChannelModel::GetChannelConditionModel),
                           MakePointerChecker<ChannelConditionModel>())
+            .AddAttribute("ChannelCache",
+                          "Pointer to the cache used to share the channel parameters and the "
+                          "channel matrices with other channel models. If null, the channel "
+                          "parameters and the channel matrices are not shared. Note that channel "
+                          "matrices generated ahead of time (see the NumWorkerThreads attribute "
+                          "of the ThreeGppChannelCache) are always generated using the procedure "
+                          "of this class, even if GetNewChannel is overridden by a subclass.",
+                          PointerValue(),
+                          MakePointerAccessor(&ThreeGppChannelModel::m_channelCache),
+                          MakePointerChecker<ThreeGppChannelCache>())
             .AddAttribute("UpdatePeriod",
                           "Specify the channel coherence time",
                           TimeValue(MilliSeconds(0)),
@@ -2478,8 +2491,9 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     NS_LOG_FUNCTION(this);
 
     // Compute the channel params key. The key is reciprocal, i.e., key (a, b) = key (b, a)
-    uint64_t channelParamsKey =
-        GetKey(aMob->GetObject<Node>()->GetId(), bMob->GetObject<Node>()->GetId());
+    uint32_t aNodeId = aMob->GetObject<Node>()->GetId();
+    uint32_t bNodeId = bMob->GetObject<Node>()->GetId();
+    uint64_t channelParamsKey = GetKey(aNodeId, bNodeId);
     // Compute the channel matrix key. The key is reciprocal, i.e., key (a, b) = key (b, a)
     uint64_t channelMatrixKey = GetKey(aAntenna->GetId(), bAntenna->GetId());
 
@@ -2496,6 +2510,23 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     Ptr<ChannelMatrix> channelMatrix;
     Ptr<ThreeGppChannelParams> channelParams;
 
+    if (m_channelCache)
+    {
+        // use the channel params shared with the other channel models, if any
+        auto sharedParams = DynamicCast<ThreeGppChannelParams>(
+            m_channelCache->GetParams(channelParamsKey, m_frequency, m_scenario));
+        if (sharedParams)
+        {
+            m_channelParamsMap[channelParamsKey] = sharedParams;
+        }
+        if (m_channelCache->GetNumWorkerThreads() > 0)
+        {
+            // keep track of the links between each pair of nodes, so that their channel
+            // matrices can be generated ahead of time
+            m_links[channelParamsKey][channelMatrixKey] = {aMob, bMob, aAntenna, bAntenna};
+        }
+    }
+
     if (m_channelParamsMap.find(channelParamsKey) != m_channelParamsMap.end())
     {
         channelParams = m_channelParamsMap[channelParamsKey];
@@ -2524,6 +2555,17 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
         channelParams = GenerateChannelParameters(condition, table3gpp, aMob, bMob);
         // store or replace the channel parameters
         m_channelParamsMap[channelParamsKey] = channelParams;
+
+        if (m_channelCache)
+        {
+            m_channelCache->SetParams(channelParamsKey, m_frequency, m_scenario, channelParams);
+            if (m_channelCache->GetNumWorkerThreads() > 0)
+            {
+                // the channel matrices of all the links between the two nodes are now out of
+                // date, generate them in parallel
+                GenerateChannelsAhead(channelParamsKey, channelParams, table3gpp);
+            }
+        }
     }
 
     if (m_channelMatrixMap.find(channelMatrixKey) != m_channelMatrixMap.end())
@@ -2544,12 +2586,34 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     // generate a new realization
     if (notFoundMatrix || updateMatrix)
     {
-        // channel matrix not found or has to be updated, generate a new one
-        channelMatrix = GetNewChannel(channelParams, table3gpp, aMob, bMob, aAntenna, bAntenna);
-        channelMatrix->m_antennaPair =
-            std::make_pair(aAntenna->GetId(),
-                           bAntenna->GetId()); // save antenna pair, with the exact order of s and u
-                                               // antennas at the moment of the channel generation
+        ThreeGppChannelCache::ChannelKey cacheKey{};
+        Ptr<const ChannelMatrix> sharedChannel;
+        if (m_channelCache)
+        {
+            // look for a channel matrix generated from the same channel params for another pair
+            // of antenna arrays with the same configuration
+            cacheKey = GetCacheKey(aNodeId, bNodeId, aAntenna, bAntenna);
+            sharedChannel = m_channelCache->GetChannel(cacheKey, channelParams);
+        }
+
+        if (sharedChannel)
+        {
+            channelMatrix = CopyChannel(sharedChannel, aNodeId, aAntenna, bAntenna);
+        }
+        else
+        {
+            // channel matrix not found or has to be updated, generate a new one
+            channelMatrix =
+                GetNewChannel(channelParams, table3gpp, aMob, bMob, aAntenna, bAntenna);
+            channelMatrix->m_antennaPair = std::make_pair(
+                aAntenna->GetId(),
+                bAntenna->GetId()); // save antenna pair, with the exact order of s and u
+                                    // antennas at the moment of the channel generation
+            if (m_channelCache)
+            {
+                m_channelCache->AddChannel(cacheKey, channelParams, channelMatrix);
+            }
+        }
 
         // store or replace the channel matrix in the channel map
         m_channelMatrixMap[channelMatrixKey] = channelMatrix;
@@ -2558,6 +2622,136 @@ ThreeGppChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
     return channelMatrix;
 }
 
+ThreeGppChannelCache::ChannelKey
+ThreeGppChannelModel::GetCacheKey(uint32_t aNodeId,
+                                  uint32_t bNodeId,
+                                  Ptr<const PhasedArrayModel> aAntenna,
+                                  Ptr<const PhasedArrayModel> bAntenna) const
+{
+    uint64_t aHash = aAntenna->GetConfigHash();
+    uint64_t bHash = bAntenna->GetConfigHash();
+    if (aNodeId > bNodeId)
+    {
+        std::swap(aHash, bHash);
+    }
+    return {GetKey(aNodeId, bNodeId), aHash, bHash, m_frequency};
+}
+
+Ptr<MatrixBasedChannelModel::ChannelMatrix>
+ThreeGppChannelModel::CopyChannel(Ptr<const ChannelMatrix> channelMatrix,
+                                  uint32_t aNodeId,
+                                  Ptr<const PhasedArrayModel> aAntenna,
+                                  Ptr<const PhasedArrayModel> bAntenna)
+{
+    auto copy = Create<ChannelMatrix>(*channelMatrix);
+    // the antennas have the same configuration as those used to generate the channel matrix,
+    // just keep the order of s and u antennas used for the generation
+    copy->m_antennaPair = (channelMatrix->m_nodeIds.first == aNodeId)
+                              ? std::make_pair(aAntenna->GetId(), bAntenna->GetId())
+                              : std::make_pair(bAntenna->GetId(), aAntenna->GetId());
+    return copy;
+}
+
+void
+ThreeGppChannelModel::GenerateChannelsAhead(uint64_t channelParamsKey,
+                                            Ptr<const ThreeGppChannelParams> channelParams,
+                                            Ptr<const ParamsTable> table3gpp)
+{
+    NS_LOG_FUNCTION(this << channelParamsKey);
+
+    /// A channel matrix to generate
+    struct Job
+    {
+        ThreeGppChannelCache::ChannelKey cacheKey; //!< the key in the channel cache
+        Ptr<const PhasedArrayModel> sAntenna;      //!< the antenna array of node s
+        Ptr<const PhasedArrayModel> uAntenna;      //!< the antenna array of node u
+        Vector sPos;                               //!< the position of node s
+        Vector uPos;                               //!< the position of node u
+        std::pair<uint32_t, uint32_t> nodeIds;     //!< the IDs of node s and node u
+        Ptr<ChannelMatrix> channelMatrix;          //!< the generated channel matrix
+    };
+
+    std::vector<Job> jobs;
+    std::vector<std::pair<uint64_t, std::size_t>> linkJobs; // channel matrix key, job index
+
+    // everything involving the simulator, the nodes or the mobility models is done here, the
+    // worker threads only run the generation of the channel matrices
+    for (const auto& [channelMatrixKey, link] : m_links[channelParamsKey])
+    {
+        uint32_t aNodeId = link.aMob->GetObject<Node>()->GetId();
+        uint32_t bNodeId = link.bMob->GetObject<Node>()->GetId();
+        auto cacheKey = GetCacheKey(aNodeId, bNodeId, link.aAntenna, link.bAntenna);
+        // the channel matrix is generated using the current antenna settings
+        link.aAntenna->IsChannelOutOfDate(link.bAntenna);
+
+        auto job = std::find_if(jobs.begin(), jobs.end(), [&cacheKey](const Job& other) {
+            return other.cacheKey == cacheKey;
+        });
+        if (job == jobs.end())
+        {
+            job = jobs.insert(jobs.end(),
+                              {cacheKey,
+                               link.aAntenna,
+                               link.bAntenna,
+                               link.aMob->GetPosition(),
+                               link.bMob->GetPosition(),
+                               {aNodeId, bNodeId},
+                               nullptr});
+        }
+        linkJobs.emplace_back(channelMatrixKey, job - jobs.begin());
+    }
+    NS_LOG_DEBUG("Generating " << jobs.size() << " channel matrices for " << linkJobs.size()
+                               << " links");
+
+    auto now = Simulator::Now();
+    auto generate = [&](std::size_t i) {
+        auto& job = jobs[i];
+        job.channelMatrix = GenerateChannelMatrix(PeekPointer(channelParams),
+                                                  PeekPointer(table3gpp),
+                                                  job.sPos,
+                                                  job.uPos,
+                                                  job.nodeIds,
+                                                  PeekPointer(job.sAntenna),
+                                                  PeekPointer(job.uAntenna),
+                                                  now);
+    };
+
+    // logging is not thread safe and the antenna arrays and elements may log while computing
+    // their field patterns, hence the channel matrices are generated by this thread if any
+    // log component is enabled
+    const auto& components = *LogComponent::GetComponentList();
+    if (std::all_of(components.cbegin(), components.cend(), [](const auto& component) {
+            return component.second->IsNoneEnabled();
+        }))
+    {
+        m_channelCache->RunJobs(jobs.size(), generate);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < jobs.size(); ++i)
+        {
+            generate(i);
+        }
+    }
+
+    for (auto& job : jobs)
+    {
+        LogChannelMatrix(job.channelMatrix, job.sAntenna, job.uAntenna);
+        job.channelMatrix->m_antennaPair =
+            std::make_pair(job.sAntenna->GetId(), job.uAntenna->GetId());
+        m_channelCache->AddChannel(job.cacheKey, channelParams, job.channelMatrix);
+    }
+    for (const auto& [channelMatrixKey, index] : linkJobs)
+    {
+        const auto& link = m_links[channelParamsKey][channelMatrixKey];
+        const auto& job = jobs[index];
+        m_channelMatrixMap[channelMatrixKey] =
+            (link.aAntenna == job.sAntenna && link.bAntenna == job.uAntenna)
+                ? job.channelMatrix
+                : CopyChannel(job.channelMatrix, job.nodeIds.first, link.aAntenna, link.bAntenna);
+    }
+}
+
 Ptr<const MatrixBasedChannelModel::ChannelParams>
 ThreeGppChannelModel::GetParams(Ptr<const MobilityModel> aMob, Ptr<const MobilityModel> bMob) const
 {
@@ -3238,14 +3432,36 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
 {
     NS_LOG_FUNCTION(this);
 
+    auto channelMatrix = GenerateChannelMatrix(
+        PeekPointer(channelParams),
+        PeekPointer(table3gpp),
+        sMob->GetPosition(),
+        uMob->GetPosition(),
+        std::make_pair(sMob->GetObject<Node>()->GetId(), uMob->GetObject<Node>()->GetId()),
+        PeekPointer(sAntenna),
+        PeekPointer(uAntenna),
+        Simulator::Now());
+    LogChannelMatrix(channelMatrix, sAntenna, uAntenna);
+    return channelMatrix;
+}
+
+Ptr<MatrixBasedChannelModel::ChannelMatrix>
+ThreeGppChannelModel::GenerateChannelMatrix(const ThreeGppChannelParams* channelParams,
+                                            const ParamsTable* table3gpp,
+                                            const Vector& sPos,
+                                            const Vector& uPos,
+                                            std::pair<uint32_t, uint32_t> nodeIds,
+                                            const PhasedArrayModel* sAntenna,
+                                            const PhasedArrayModel* uAntenna,
+                                            Time generatedTime) const
+{
     NS_ASSERT_MSG(m_frequency > 0.0, "Set the operating frequency first!");
 
     // create a channel matrix instance
     Ptr<ChannelMatrix> channelMatrix = Create<ChannelMatrix>();
-    channelMatrix->m_generatedTime = Simulator::Now();
+    channelMatrix->m_generatedTime = generatedTime;
     // save in which order is generated this matrix
-    channelMatrix->m_nodeIds =
-        std::make_pair(sMob->GetObject<Node>()->GetId(), uMob->GetObject<Node>()->GetId());
+    channelMatrix->m_nodeIds = nodeIds;
     // check if channelParams structure is generated in direction s-to-u or u-to-s
     bool isSameDirection = (channelParams->m_nodeIds == channelMatrix->m_nodeIds);
 
@@ -3303,18 +3519,18 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
     NS_ASSERT(table3gpp->m_raysPerCluster <= rayAoaRadian[0].size());
     NS_ASSERT(table3gpp->m_raysPerCluster <= rayAodRadian[0].size());
 
-    double x = sMob->GetPosition().x - uMob->GetPosition().x;
-    double y = sMob->GetPosition().y - uMob->GetPosition().y;
+    double x = sPos.x - uPos.x;
+    double y = sPos.y - uPos.y;
     double distance2D = sqrt(x * x + y * y);
     // NOTE we assume hUT = min (height(a), height(b)) and
     // hBS = max (height (a), height (b))
-    double hUt = std::min(sMob->GetPosition().z, uMob->GetPosition().z);
-    double hBs = std::max(sMob->GetPosition().z, uMob->GetPosition().z);
+    double hUt = std::min(sPos.z, uPos.z);
+    double hBs = std::max(sPos.z, uPos.z);
     // compute the 3D distance using eq. 7.4-1
     double distance3D = std::sqrt(distance2D * distance2D + (hBs - hUt) * (hBs - hUt));
 
-    Angles sAngle(uMob->GetPosition(), sMob->GetPosition());
-    Angles uAngle(sMob->GetPosition(), uMob->GetPosition());
+    Angles sAngle(uPos, sPos);
+    Angles uAngle(sPos, uPos);
 
     Double2DVector sinCosA; // cached multiplications of sin and cos of the ZoA and AoA angles
     Double2DVector sinSinA; // cached multiplications of sines of the ZoA and AoA angles
@@ -3579,6 +3795,16 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
         }
     }
 
+    channelMatrix->m_channel = hUsn;
+    return channelMatrix;
+}
+
+void
+ThreeGppChannelModel::LogChannelMatrix(Ptr<const ChannelMatrix> channelMatrix,
+                                       Ptr<const PhasedArrayModel> sAntenna,
+                                       Ptr<const PhasedArrayModel> uAntenna) const
+{
+    const auto& hUsn = channelMatrix->m_channel;
     NS_LOG_DEBUG("Husn (sAntenna, uAntenna):" << sAntenna->GetId() << ", " << uAntenna->GetId());
     for (size_t cIndex = 0; cIndex < hUsn.GetNumPages(); cIndex++)
     {
@@ -3594,8 +3820,6 @@ ThreeGppChannelModel::GetNewChannel(Ptr<const ThreeGppChannelParams> channelPara
     NS_LOG_INFO("size of coefficient matrix (rows, columns, clusters) = ("
                 << hUsn.GetNumRows() << ", " << hUsn.GetNumCols() << ", " << hUsn.GetNumPages()
                 << ")");
-    channelMatrix->m_channel = hUsn;
-    return channelMatrix;
 }
 
 std::pair<double, double>
@@ -11,6 +11,7 @@
 #define THREE_GPP_CHANNEL_H
 
 #include "matrix-based-channel-model.h"
+#include "three-gpp-channel-cache.h"
 
 #include "ns3/angles.h"
 #include "ns3/boolean.h"
@@ -97,6 +98,14 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
      * be updated, it generates a new uncorrelated channel matrix using the
      * method GetNewChannel and updates m_channelMap.
      *
+     * If a ThreeGppChannelCache is set through the ChannelCache attribute, the channel params
+     * are shared with the other channel models using the same cache, scenario and frequency,
+     * and a channel matrix which has to be generated is first looked for in the cache, where
+     * it may have been stored for another pair of antenna arrays of the same nodes with the
+     * same configuration. If the cache has worker threads, the channel matrices of all the
+     * links between the two nodes are generated in parallel as soon as the channel params
+     * are regenerated.
+     *
      * @param aMob mobility model of the a device
      * @param bMob mobility model of the b device
      * @param aAntenna antenna of the a device
@@ -286,6 +295,81 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
                                              const Ptr<const MobilityModel> uMob,
                                              Ptr<const PhasedArrayModel> sAntenna,
                                              Ptr<const PhasedArrayModel> uAntenna) const;
+
+    /**
+     * Compute the channel matrix between two nodes s and u, and their antenna arrays
+     * sAntenna and uAntenna, using the procedure described in 3GPP TR 38.901. This method
+     * only reads its arguments and the configuration of this channel model and does not log,
+     * hence it can be run in parallel on different worker threads for different pairs of
+     * antenna arrays (provided that the antenna arrays do not log either).
+     *
+     * @param channelParams the channel parameters previously generated for the pair of
+     * nodes s and u
+     * @param table3gpp the 3gpp parameters table
+     * @param sPos the position of node s
+     * @param uPos the position of node u
+     * @param nodeIds the IDs of node s and node u
+     * @param sAntenna the antenna array of node s
+     * @param uAntenna the antenna array of node u
+     * @param generatedTime the generation time of the channel realization
+     * @return the channel realization
+     */
+    Ptr<ChannelMatrix> GenerateChannelMatrix(const ThreeGppChannelParams* channelParams,
+                                             const ParamsTable* table3gpp,
+                                             const Vector& sPos,
+                                             const Vector& uPos,
+                                             std::pair<uint32_t, uint32_t> nodeIds,
+                                             const PhasedArrayModel* sAntenna,
+                                             const PhasedArrayModel* uAntenna,
+                                             Time generatedTime) const;
+
+    /**
+     * Log the coefficients and the size of a channel matrix
+     * @param channelMatrix the channel matrix
+     * @param sAntenna the antenna array of node s
+     * @param uAntenna the antenna array of node u
+     */
+    void LogChannelMatrix(Ptr<const ChannelMatrix> channelMatrix,
+                          Ptr<const PhasedArrayModel> sAntenna,
+                          Ptr<const PhasedArrayModel> uAntenna) const;
+
+    /**
+     * Compute the key of the channel matrix between two antenna arrays in the channel cache
+     * @param aNodeId the ID of node a
+     * @param bNodeId the ID of node b
+     * @param aAntenna the antenna array of node a
+     * @param bAntenna the antenna array of node b
+     * @return the key of the channel matrix in the channel cache
+     */
+    ThreeGppChannelCache::ChannelKey GetCacheKey(uint32_t aNodeId,
+                                                 uint32_t bNodeId,
+                                                 Ptr<const PhasedArrayModel> aAntenna,
+                                                 Ptr<const PhasedArrayModel> bAntenna) const;
+
+    /**
+     * Copy a channel matrix generated for a pair of antenna arrays to be used for another
+     * pair of antenna arrays of the same nodes with the same configuration
+     * @param channelMatrix the channel matrix
+     * @param aNodeId the ID of node a
+     * @param aAntenna the antenna array of node a
+     * @param bAntenna the antenna array of node b
+     * @return the copy of the channel matrix, associated with aAntenna and bAntenna
+     */
+    static Ptr<ChannelMatrix> CopyChannel(Ptr<const ChannelMatrix> channelMatrix,
+                                          uint32_t aNodeId,
+                                          Ptr<const PhasedArrayModel> aAntenna,
+                                          Ptr<const PhasedArrayModel> bAntenna);
+
+    /**
+     * Generate, using the worker threads of the channel cache, the channel matrices of all
+     * the links between a pair of nodes after their channel params have been regenerated
+     * @param channelParamsKey the key of the pair of nodes
+     * @param channelParams the channel params of the pair of nodes
+     * @param table3gpp the 3gpp parameters table
+     */
+    void GenerateChannelsAhead(uint64_t channelParamsKey,
+                               Ptr<const ThreeGppChannelParams> channelParams,
+                               Ptr<const ParamsTable> table3gpp);
     /**
      * Applies the blockage model A described in 3GPP TR 38.901
      * @param channelParams the channel parameters structure
@@ -337,6 +421,21 @@ class ThreeGppChannelModel : public MatrixBasedChannelModel
         m_channelParamsMap; //!< map containing the common channel parameters per pair of nodes, the
                             //!< key of this map is reciprocal and uniquely identifies a pair of
                             //!< nodes
+    /// A link between two nodes, for which a channel matrix has been requested
+    struct Link
+    {
+        Ptr<const MobilityModel> aMob;        //!< the mobility model of node a
+        Ptr<const MobilityModel> bMob;        //!< the mobility model of node b
+        Ptr<const PhasedArrayModel> aAntenna; //!< the antenna array of node a
+        Ptr<const PhasedArrayModel> bAntenna; //!< the antenna array of node b
+    };
+
+    std::unordered_map<uint64_t, std::unordered_map<uint64_t, Link>>
+        m_links; //!< the links for which a channel matrix has been requested, by pair of nodes
+                 //!< and by pair of antenna arrays; only used to generate the channel matrices
+                 //!< ahead of time
+    Ptr<ThreeGppChannelCache> m_channelCache; //!< the cache shared with other channel models
+
     Time m_updatePeriod;    //!< the channel update period
     double m_frequency;     //!< the operating frequency
     std::string m_scenario; //!< the 3GPP scenario
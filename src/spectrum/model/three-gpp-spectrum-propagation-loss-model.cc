@@ -11,6 +11,7 @@
 #include "three-gpp-spectrum-propagation-loss-model.h"
 
 #include "spectrum-signal-parameters.h"
+#include "three-gpp-channel-cache.h"
 #include "three-gpp-channel-model.h"
 
 #include "ns3/double.h"
@@ -20,7 +21,9 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <map>
 
 namespace ns3
@@ -31,6 +34,7 @@ NS_LOG_COMPONENT_DEFINE("ThreeGppSpectrumPropagationLossModel");
 NS_OBJECT_ENSURE_REGISTERED(ThreeGppSpectrumPropagationLossModel);
 
 ThreeGppSpectrumPropagationLossModel::ThreeGppSpectrumPropagationLossModel()
+    : m_nThreads(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -44,6 +48,7 @@ void
 ThreeGppSpectrumPropagationLossModel::DoDispose()
 {
     m_longTermMap.clear();
+    m_pendingLongTerms.clear();
     m_channelModel = nullptr;
 }
 
@@ -61,7 +66,15 @@ ThreeGppSpectrumPropagationLossModel::GetTypeId()
                 StringValue("ns3::ThreeGppChannelModel"),
                 MakePointerAccessor(&ThreeGppSpectrumPropagationLossModel::SetChannelModel,
                                     &ThreeGppSpectrumPropagationLossModel::GetChannelModel),
-                MakePointerChecker<MatrixBasedChannelModel>());
+                MakePointerChecker<MatrixBasedChannelModel>())
+            .AddAttribute("NumWorkerThreads",
+                          "The number of worker threads used to compute, when a signal is "
+                          "transmitted, the long term components and the delay terms of the "
+                          "links towards the receivers of the signal. The value 0 disables the "
+                          "computation of such terms ahead of time.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&ThreeGppSpectrumPropagationLossModel::m_nThreads),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -106,29 +119,37 @@ ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
     Ptr<const PhasedArrayModel> uAnt) const
 {
     NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG((sAnt != nullptr) && (uAnt != nullptr), "Improper call to the method");
+    return CalcLongTerm(*params, *sAnt, *uAnt);
+}
 
-    const PhasedArrayModel::ComplexVector& sW = sAnt->GetBeamformingVectorRef();
-    const PhasedArrayModel::ComplexVector& uW = uAnt->GetBeamformingVectorRef();
+Ptr<MatrixBasedChannelModel::Complex3DVector>
+ThreeGppSpectrumPropagationLossModel::CalcLongTerm(
+    const MatrixBasedChannelModel::ChannelMatrix& params,
+    const PhasedArrayModel& sAnt,
+    const PhasedArrayModel& uAnt) const
+{
+    const PhasedArrayModel::ComplexVector& sW = sAnt.GetBeamformingVectorRef();
+    const PhasedArrayModel::ComplexVector& uW = uAnt.GetBeamformingVectorRef();
     size_t sAntNumElems = sW.GetSize();
     size_t uAntNumElems = uW.GetSize();
-    NS_ASSERT(uAntNumElems == params->m_channel.GetNumRows());
-    NS_ASSERT(sAntNumElems == params->m_channel.GetNumCols());
+    NS_ASSERT(uAntNumElems == params.m_channel.GetNumRows());
+    NS_ASSERT(sAntNumElems == params.m_channel.GetNumCols());
     NS_LOG_DEBUG("CalcLongTerm with " << uW.GetSize() << " u antenna elements and " << sW.GetSize()
                                       << " s antenna elements, and with "
-                                      << " s ports: " << sAnt->GetNumPorts()
-                                      << " u ports: " << uAnt->GetNumPorts());
-    NS_ASSERT_MSG((sAnt != nullptr) && (uAnt != nullptr), "Improper call to the method");
-    size_t numClusters = params->m_channel.GetNumPages();
+                                      << " s ports: " << sAnt.GetNumPorts()
+                                      << " u ports: " << uAnt.GetNumPorts());
+    size_t numClusters = params.m_channel.GetNumPages();
     // create and initialize the size of the longTerm 3D matrix
     Ptr<MatrixBasedChannelModel::Complex3DVector> longTerm =
-        Create<MatrixBasedChannelModel::Complex3DVector>(uAnt->GetNumPorts(),
-                                                         sAnt->GetNumPorts(),
+        Create<MatrixBasedChannelModel::Complex3DVector>(uAnt.GetNumPorts(),
+                                                         sAnt.GetNumPorts(),
                                                          numClusters);
     // Calculate long term uW * Husn * sW, the result is a matrix
     // with the dimensions #uPorts, #sPorts, #cluster
-    for (auto sPortIdx = 0; sPortIdx < sAnt->GetNumPorts(); sPortIdx++)
+    for (auto sPortIdx = 0; sPortIdx < sAnt.GetNumPorts(); sPortIdx++)
     {
-        for (auto uPortIdx = 0; uPortIdx < uAnt->GetNumPorts(); uPortIdx++)
+        for (auto uPortIdx = 0; uPortIdx < uAnt.GetNumPorts(); uPortIdx++)
         {
             for (size_t cIndex = 0; cIndex < numClusters; cIndex++)
             {
@@ -150,12 +171,24 @@ ThreeGppSpectrumPropagationLossModel::CalculateLongTermComponent(
     uint16_t cIndex) const
 {
     NS_LOG_FUNCTION(this);
-    const PhasedArrayModel::ComplexVector& sW = sAnt->GetBeamformingVectorRef();
-    const PhasedArrayModel::ComplexVector& uW = uAnt->GetBeamformingVectorRef();
-    auto sPortElems = sAnt->GetNumElemsPerPort();
-    auto uPortElems = uAnt->GetNumElemsPerPort();
-    auto startS = sAnt->ArrayIndexFromPortIndex(sPortIdx, 0);
-    auto startU = uAnt->ArrayIndexFromPortIndex(uPortIdx, 0);
+    return CalculateLongTermComponent(*params, *sAnt, *uAnt, sPortIdx, uPortIdx, cIndex);
+}
+
+std::complex<double>
+ThreeGppSpectrumPropagationLossModel::CalculateLongTermComponent(
+    const MatrixBasedChannelModel::ChannelMatrix& params,
+    const PhasedArrayModel& sAnt,
+    const PhasedArrayModel& uAnt,
+    uint16_t sPortIdx,
+    uint16_t uPortIdx,
+    uint16_t cIndex) const
+{
+    const PhasedArrayModel::ComplexVector& sW = sAnt.GetBeamformingVectorRef();
+    const PhasedArrayModel::ComplexVector& uW = uAnt.GetBeamformingVectorRef();
+    auto sPortElems = sAnt.GetNumElemsPerPort();
+    auto uPortElems = uAnt.GetNumElemsPerPort();
+    auto startS = sAnt.ArrayIndexFromPortIndex(sPortIdx, 0);
+    auto startU = uAnt.ArrayIndexFromPortIndex(uPortIdx, 0);
     std::complex<double> txSum(0, 0);
     // limiting multiplication operations to the port location
     auto sIndex = startS;
@@ -163,20 +196,20 @@ ThreeGppSpectrumPropagationLossModel::CalculateLongTermComponent(
     // as described in Section 5.2.2 of 3GPP TR 36.897,
     // and so equal beam weights are used for all the ports.
     // Support of the full-connection model for TXRU virtualization would need extensions.
-    const auto uElemsPerPort = uAnt->GetHElemsPerPort();
-    const auto sElemsPerPort = sAnt->GetHElemsPerPort();
+    const auto uElemsPerPort = uAnt.GetHElemsPerPort();
+    const auto sElemsPerPort = sAnt.GetHElemsPerPort();
     for (size_t tIndex = 0; tIndex < sPortElems; tIndex++, sIndex++)
     {
         std::complex<double> rxSum(0, 0);
         auto uIndex = startU;
         for (size_t rIndex = 0; rIndex < uPortElems; rIndex++, uIndex++)
         {
-            rxSum += uW[uIndex - startU] * params->m_channel(uIndex, sIndex, cIndex);
+            rxSum += uW[uIndex - startU] * params.m_channel(uIndex, sIndex, cIndex);
             auto testV = (rIndex % uElemsPerPort);
             auto ptInc = uElemsPerPort - 1;
             if (testV == ptInc)
             {
-                auto incVal = uAnt->GetNumColumns() - uElemsPerPort;
+                auto incVal = uAnt.GetNumColumns() - uElemsPerPort;
                 uIndex += incVal; // Increment by a factor to reach next column in a port
             }
         }
@@ -186,7 +219,7 @@ ThreeGppSpectrumPropagationLossModel::CalculateLongTermComponent(
         auto ptInc = sElemsPerPort - 1;
         if (testV == ptInc)
         {
-            size_t incVal = sAnt->GetNumColumns() - sElemsPerPort;
+            size_t incVal = sAnt.GetNumColumns() - sElemsPerPort;
             sIndex += incVal; // Increment by a factor to reach next column in a port
         }
     }
@@ -351,30 +384,7 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
     Ptr<MatrixBasedChannelModel::Complex3DVector> chanSpct =
         Create<MatrixBasedChannelModel::Complex3DVector>(numRxPorts, numTxPorts, (uint16_t)numRb);
 
-    // Precompute the delay until numRb, numCluster or RB width changes
-    // Whenever the channelParams is updated, the number of numRbs, numClusters
-    // and RB width (12*SCS) are reset, ensuring these values are updated too
-    double rbWidth = inPsd->ConstBandsBegin()->fh - inPsd->ConstBandsBegin()->fl;
-
-    if (channelParams->m_cachedDelaySincos.GetNumRows() != numRb ||
-        channelParams->m_cachedDelaySincos.GetNumCols() != numCluster ||
-        channelParams->m_cachedRbWidth != rbWidth)
-    {
-        channelParams->m_cachedRbWidth = rbWidth;
-        channelParams->m_cachedDelaySincos = ComplexMatrixArray(numRb, numCluster);
-        auto sbit = inPsd->ConstBandsBegin(); // band iterator
-        for (unsigned i = 0; i < numRb; i++)
-        {
-            double fsb = (*sbit).fc; // center frequency of the sub-band
-            for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
-            {
-                double delay = -2 * M_PI * fsb * (channelParams->m_delay[cIndex]);
-                channelParams->m_cachedDelaySincos(i, cIndex) =
-                    std::complex<double>(cos(delay), sin(delay));
-            }
-            sbit++;
-        }
-    }
+    CacheDelaySincos(*inPsd, *channelParams, numCluster);
 
     // Compute the product between the doppler and the delay sincos
     auto delaySincosCopy = channelParams->m_cachedDelaySincos;
@@ -420,6 +430,40 @@ ThreeGppSpectrumPropagationLossModel::GenSpectrumChannelMatrix(
     return chanSpct;
 }
 
+void
+ThreeGppSpectrumPropagationLossModel::CacheDelaySincos(
+    const SpectrumValue& inPsd,
+    const MatrixBasedChannelModel::ChannelParams& channelParams,
+    std::size_t numCluster)
+{
+    auto numRb = inPsd.GetValuesN();
+
+    // Precompute the delay until numRb, numCluster or RB width changes
+    // Whenever the channelParams is updated, the number of numRbs, numClusters
+    // and RB width (12*SCS) are reset, ensuring these values are updated too
+    double rbWidth = inPsd.ConstBandsBegin()->fh - inPsd.ConstBandsBegin()->fl;
+
+    if (channelParams.m_cachedDelaySincos.GetNumRows() != numRb ||
+        channelParams.m_cachedDelaySincos.GetNumCols() != numCluster ||
+        channelParams.m_cachedRbWidth != rbWidth)
+    {
+        channelParams.m_cachedRbWidth = rbWidth;
+        channelParams.m_cachedDelaySincos = ComplexMatrixArray(numRb, numCluster);
+        auto sbit = inPsd.ConstBandsBegin(); // band iterator
+        for (unsigned i = 0; i < numRb; i++)
+        {
+            double fsb = (*sbit).fc; // center frequency of the sub-band
+            for (std::size_t cIndex = 0; cIndex < numCluster; cIndex++)
+            {
+                double delay = -2 * M_PI * fsb * (channelParams.m_delay[cIndex]);
+                channelParams.m_cachedDelaySincos(i, cIndex) =
+                    std::complex<double>(cos(delay), sin(delay));
+            }
+            sbit++;
+        }
+    }
+}
+
 Ptr<const MatrixBasedChannelModel::Complex3DVector>
 ThreeGppSpectrumPropagationLossModel::GetLongTerm(
     Ptr<const MatrixBasedChannelModel::ChannelMatrix> channelMatrix,
@@ -477,18 +521,36 @@ ThreeGppSpectrumPropagationLossModel::GetLongTerm(
 
     if (update || notFound)
     {
-        NS_LOG_DEBUG("compute the long term");
-        // compute the long term component
-        longTerm = CalcLongTerm(channelMatrix, sAntenna, uAntenna);
-        Ptr<LongTerm> longTermItem = Create<LongTerm>();
-        longTermItem->m_longTerm = longTerm;
-        longTermItem->m_channel = channelMatrix;
-        longTermItem->m_sW = std::move(sW);
-        longTermItem->m_uW = std::move(uW);
-        // store the long term to reduce computation load
-        // only the small scale fading needs to be updated if the large scale parameters and antenna
-        // weights remain unchanged.
-        m_longTermMap[longTermId] = longTermItem;
+        // use the long term component computed ahead of time, if it was computed from the
+        // current channel matrix and beamforming vectors
+        auto pendingIt = m_pendingLongTerms.find(longTermId);
+        if (pendingIt != m_pendingLongTerms.end() &&
+            pendingIt->second->m_channel == channelMatrix && pendingIt->second->m_sW == sW &&
+            pendingIt->second->m_uW == uW)
+        {
+            NS_LOG_DEBUG("use the long term computed ahead of time");
+            longTerm = pendingIt->second->m_longTerm;
+            m_longTermMap[longTermId] = pendingIt->second;
+        }
+        else
+        {
+            NS_LOG_DEBUG("compute the long term");
+            // compute the long term component
+            longTerm = CalcLongTerm(channelMatrix, sAntenna, uAntenna);
+            Ptr<LongTerm> longTermItem = Create<LongTerm>();
+            longTermItem->m_longTerm = longTerm;
+            longTermItem->m_channel = channelMatrix;
+            longTermItem->m_sW = std::move(sW);
+            longTermItem->m_uW = std::move(uW);
+            // store the long term to reduce computation load
+            // only the small scale fading needs to be updated if the large scale parameters and
+            // antenna weights remain unchanged.
+            m_longTermMap[longTermId] = longTermItem;
+        }
+        if (pendingIt != m_pendingLongTerms.end())
+        {
+            m_pendingLongTerms.erase(pendingIt);
+        }
     }
 
     return longTerm;
@@ -536,6 +598,124 @@ ThreeGppSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity(
                                isReverse);
 }
 
+void
+ThreeGppSpectrumPropagationLossModel::DoPrepareRxPowerSpectralDensities(
+    Ptr<const MobilityModel> a,
+    Ptr<const PhasedArrayModel> aPhasedArrayModel,
+    const std::vector<Receiver>& receivers) const
+{
+    NS_LOG_FUNCTION(this << a << aPhasedArrayModel << receivers.size());
+
+    if (m_nThreads == 0)
+    {
+        return;
+    }
+
+    // a long term component to compute, from the channel matrix last used for a link and the
+    // current beamforming vectors
+    struct LongTermJob
+    {
+        Ptr<LongTerm> item;                   // the long term item to fill
+        Ptr<const PhasedArrayModel> sAntenna; // the antenna of the s device
+        Ptr<const PhasedArrayModel> uAntenna; // the antenna of the u device
+    };
+
+    // the delay terms to compute for the given channel parameters
+    struct DelayJob
+    {
+        Ptr<const MatrixBasedChannelModel::ChannelParams> channelParams; // the channel params
+        Ptr<const SpectrumValue> psd;                                      // the received PSD
+        std::size_t numCluster;                                            // number of clusters
+    };
+
+    std::vector<std::pair<uint64_t, LongTermJob>> longTermJobs;
+    std::vector<DelayJob> delayJobs;
+
+    for (const auto& receiver : receivers)
+    {
+        auto longTermId = MatrixBasedChannelModel::GetKey(aPhasedArrayModel->GetId(),
+                                                          receiver.phasedArrayModel->GetId());
+        auto longTermIt = m_longTermMap.find(longTermId);
+        if (longTermIt == m_longTermMap.end())
+        {
+            // the channel matrix will be generated upon reception
+            continue;
+        }
+        const auto& channelMatrix = longTermIt->second->m_channel;
+        auto isReverse = channelMatrix->IsReverse(aPhasedArrayModel->GetId(),
+                                                  receiver.phasedArrayModel->GetId());
+        auto sAntenna = isReverse ? receiver.phasedArrayModel : aPhasedArrayModel;
+        auto uAntenna = isReverse ? aPhasedArrayModel : receiver.phasedArrayModel;
+        const auto& sW = sAntenna->GetBeamformingVectorRef();
+        const auto& uW = uAntenna->GetBeamformingVectorRef();
+
+        auto pendingIt = m_pendingLongTerms.find(longTermId);
+        if ((longTermIt->second->m_sW != sW || longTermIt->second->m_uW != uW) &&
+            sW.GetSize() == channelMatrix->m_channel.GetNumCols() &&
+            uW.GetSize() == channelMatrix->m_channel.GetNumRows() &&
+            (pendingIt == m_pendingLongTerms.end() ||
+             pendingIt->second->m_channel != channelMatrix || pendingIt->second->m_sW != sW ||
+             pendingIt->second->m_uW != uW))
+        {
+            auto item = Create<LongTerm>();
+            item->m_channel = channelMatrix;
+            item->m_sW = sW;
+            item->m_uW = uW;
+            longTermJobs.emplace_back(longTermId, LongTermJob{item, sAntenna, uAntenna});
+        }
+
+        auto channelParams = m_channelModel->GetParams(a, receiver.mobility);
+        if (channelParams &&
+            std::none_of(delayJobs.cbegin(), delayJobs.cend(), [&](const DelayJob& job) {
+                return job.channelParams == channelParams;
+            }))
+        {
+            delayJobs.push_back(
+                {channelParams, receiver.psd, channelMatrix->m_channel.GetNumPages()});
+        }
+    }
+    NS_LOG_DEBUG("Computing " << longTermJobs.size() << " long term components and the delay "
+                              << "terms of " << delayJobs.size() << " channel params");
+
+    // the jobs only access the objects through references, so that the reference counts of the
+    // objects shared among jobs (e.g., the antenna of the sender) are not modified concurrently
+    auto run = [&](std::size_t i) {
+        if (i < longTermJobs.size())
+        {
+            auto& job = longTermJobs[i].second;
+            job.item->m_longTerm =
+                CalcLongTerm(*job.item->m_channel, *job.sAntenna, *job.uAntenna);
+        }
+        else
+        {
+            const auto& job = delayJobs[i - longTermJobs.size()];
+            CacheDelaySincos(*job.psd, *job.channelParams, job.numCluster);
+        }
+    };
+
+    // logging is not thread safe, hence the jobs are run by this thread if any log component
+    // is enabled
+    const auto& components = *LogComponent::GetComponentList();
+    if (std::all_of(components.cbegin(), components.cend(), [](const auto& component) {
+            return component.second->IsNoneEnabled();
+        }))
+    {
+        ThreeGppChannelCache::RunJobs(m_nThreads, longTermJobs.size() + delayJobs.size(), run);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < longTermJobs.size() + delayJobs.size(); ++i)
+        {
+            run(i);
+        }
+    }
+
+    for (auto& [longTermId, job] : longTermJobs)
+    {
+        m_pendingLongTerms[longTermId] = job.item;
+    }
+}
+
 int64_t
 ThreeGppSpectrumPropagationLossModel::DoAssignStreams(int64_t stream)
 {
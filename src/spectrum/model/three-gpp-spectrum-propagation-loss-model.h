@@ -21,6 +21,7 @@
 
 class ThreeGppCalcLongTermMultiPortTest;
 class ThreeGppMimoPolarizationTest;
+class ThreeGppSpectrumPrepareTest;
 
 namespace ns3
 {
@@ -37,6 +38,15 @@ class NetDevice;
  * the mobility models of the transmitting node and receiving node, and
  * returns the PSD of the received signal.
  *
+ * When the "NumWorkerThreads" attribute is not zero, the long term components of the links
+ * towards the receivers of a signal whose beamforming vectors have changed, as well as the
+ * delay terms of each cluster at the frequency of each RB, are computed by worker threads when
+ * the signal is transmitted (see PrepareRxPowerSpectralDensities). The long term components
+ * are only used when the PSD is received if the channel matrix and the beamforming vectors
+ * they were computed from are still in use, while the Doppler terms, which depend on the
+ * reception time, are always computed upon reception; hence, the received PSDs are exactly
+ * the same as those computed with no worker threads.
+ *
  * @see MatrixBasedChannelModel
  * @see PhasedArrayModel
  * @see ChannelCondition
@@ -45,6 +55,7 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
 {
     friend class ::ThreeGppCalcLongTermMultiPortTest;
     friend class ::ThreeGppMimoPolarizationTest;
+    friend class ::ThreeGppSpectrumPrepareTest;
 
   public:
     /**
@@ -190,6 +201,19 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
         Ptr<const PhasedArrayModel> sAnt,
         Ptr<const PhasedArrayModel> uAnt) const;
 
+    /**
+     * Computes the long term component. This overload does not copy smart pointers to the
+     * given objects, hence it can be called by worker threads sharing the same objects.
+     * @param channelMatrix the channel matrix H
+     * @param sAnt the antenna of the s device
+     * @param uAnt the antenna of the u device
+     * @return the long term component
+     */
+    Ptr<MatrixBasedChannelModel::Complex3DVector> CalcLongTerm(
+        const MatrixBasedChannelModel::ChannelMatrix& channelMatrix,
+        const PhasedArrayModel& sAnt,
+        const PhasedArrayModel& uAnt) const;
+
     /**
      * @brief Computes a longTerm component from a specific port of s device to the
      * specific port of u device and for a specific cluster index
@@ -209,6 +233,38 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
         uint16_t uPortIdx,
         uint16_t cIndex) const;
 
+    /**
+     * @brief Computes a longTerm component from a specific port of s device to the
+     * specific port of u device and for a specific cluster index, without copying smart
+     * pointers to the given objects
+     * @param params The params that include the channel matrix
+     * @param sAnt the first antenna
+     * @param uAnt the second antenna
+     * @param sPortIdx the port index of the s device
+     * @param uPortIdx the port index of the u device
+     * @param cIndex the cluster index
+     * @return longTerm component for port pair and for a specific cluster index
+     */
+    std::complex<double> CalculateLongTermComponent(
+        const MatrixBasedChannelModel::ChannelMatrix& params,
+        const PhasedArrayModel& sAnt,
+        const PhasedArrayModel& uAnt,
+        uint16_t sPortIdx,
+        uint16_t uPortIdx,
+        uint16_t cIndex) const;
+
+    /**
+     * Computes the delay term of each cluster at the center frequency of each RB of the given
+     * PSD and caches them in the given channel parameters, unless the cached terms were
+     * computed for the same number of RBs, number of clusters and RB width
+     * @param inPsd the PSD
+     * @param channelParams the channel parameters, including delays
+     * @param numCluster the number of clusters
+     */
+    static void CacheDelaySincos(const SpectrumValue& inPsd,
+                                 const MatrixBasedChannelModel::ChannelParams& channelParams,
+                                 std::size_t numCluster);
+
     /**
      * @brief Computes the beamforming gain and applies it to the TX PSD
      * @param params SpectrumSignalParameters holding TX PSD
@@ -235,9 +291,16 @@ class ThreeGppSpectrumPropagationLossModel : public PhasedArraySpectrumPropagati
 
     int64_t DoAssignStreams(int64_t stream) override;
 
+    void DoPrepareRxPowerSpectralDensities(Ptr<const MobilityModel> a,
+                                           Ptr<const PhasedArrayModel> aPhasedArrayModel,
+                                           const std::vector<Receiver>& receivers) const override;
+
+    mutable std::unordered_map<uint64_t, Ptr<const LongTerm>>
+        m_longTermMap; //!< map containing the long term components
     mutable std::unordered_map<uint64_t, Ptr<const LongTerm>>
-        m_longTermMap;                           //!< map containing the long term components
+        m_pendingLongTerms; //!< the long term components computed ahead of time, not used yet
     Ptr<MatrixBasedChannelModel> m_channelModel; //!< the model to generate the channel matrix
+    uint32_t m_nThreads; //!< the number of worker threads used to compute ahead of time
 };
 } // namespace ns3
 
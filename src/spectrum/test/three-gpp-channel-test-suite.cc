@@ -22,12 +22,14 @@
 #include "ns3/string.h"
 #include "ns3/test.h"
 #include "ns3/three-gpp-antenna-model.h"
+#include "ns3/three-gpp-channel-cache.h"
 #include "ns3/three-gpp-channel-model.h"
 #include "ns3/three-gpp-spectrum-propagation-loss-model.h"
 #include "ns3/uinteger.h"
 #include "ns3/uniform-planar-array.h"
 
 #include <valarray>
+#include <vector>
 
 using namespace ns3;
 
@@ -1450,6 +1452,397 @@ ThreeGppMimoPolarizationTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup spectrum-tests
+ *
+ * Test case for the ThreeGppChannelCache class.
+ * 1) checks that the channel params of a pair of nodes are shared among the channel models
+ *    using the same cache
+ * 2) checks that a channel matrix is reused, in both directions, for antenna arrays with the
+ *    same configuration and not for antenna arrays with a different configuration
+ * 3) checks that the channel matrices generated ahead of time by worker threads are equal
+ *    to those generated when the links are used
+ */
+class ThreeGppChannelCacheTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppChannelCacheTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    /**
+     * Check the sharing of channel params and channel matrices
+     */
+    void CheckSharing();
+
+    /**
+     * Get the channel matrices of three links between the same pair of nodes after the
+     * regeneration of the channel params
+     * @param nThreads the number of worker threads of the channel cache
+     * @return the channel matrices of the three links
+     */
+    std::vector<Ptr<const ThreeGppChannelModel::ChannelMatrix>> GetChannels(uint32_t nThreads);
+
+    /**
+     * Create two nodes with mobility models
+     * @param nodes the container storing, on return, the two nodes
+     */
+    static void CreateNodes(NodeContainer& nodes);
+
+    /**
+     * Create a channel model
+     * @param cache the channel cache
+     * @param channelConditionModel the channel condition model
+     * @return the channel model
+     */
+    static Ptr<ThreeGppChannelModel> CreateChannelModel(
+        Ptr<ThreeGppChannelCache> cache,
+        Ptr<ChannelConditionModel> channelConditionModel);
+
+    /**
+     * Create an antenna array
+     * @param nColumns the number of columns of the antenna array
+     * @return the antenna array
+     */
+    static Ptr<PhasedArrayModel> CreateAntenna(uint32_t nColumns);
+};
+
+ThreeGppChannelCacheTest::ThreeGppChannelCacheTest()
+    : TestCase("Check the sharing of channel params and channel matrices among links")
+{
+}
+
+void
+ThreeGppChannelCacheTest::CreateNodes(NodeContainer& nodes)
+{
+    nodes.Create(2);
+    Ptr<MobilityModel> txMob = CreateObject<ConstantPositionMobilityModel>();
+    txMob->SetPosition(Vector(0.0, 0.0, 10.0));
+    Ptr<MobilityModel> rxMob = CreateObject<ConstantPositionMobilityModel>();
+    rxMob->SetPosition(Vector(100.0, 0.0, 1.6));
+    nodes.Get(0)->AggregateObject(txMob);
+    nodes.Get(1)->AggregateObject(rxMob);
+}
+
+Ptr<ThreeGppChannelModel>
+ThreeGppChannelCacheTest::CreateChannelModel(Ptr<ThreeGppChannelCache> cache,
+                                             Ptr<ChannelConditionModel> channelConditionModel)
+{
+    Ptr<ThreeGppChannelModel> channelModel = CreateObject<ThreeGppChannelModel>();
+    channelModel->SetAttribute("Frequency", DoubleValue(28.0e9));
+    channelModel->SetAttribute("Scenario", StringValue("UMa"));
+    channelModel->SetAttribute("ChannelConditionModel", PointerValue(channelConditionModel));
+    channelModel->SetAttribute("UpdatePeriod", TimeValue(MilliSeconds(100)));
+    channelModel->SetAttribute("ChannelCache", PointerValue(cache));
+    channelModel->AssignStreams(1);
+    return channelModel;
+}
+
+Ptr<PhasedArrayModel>
+ThreeGppChannelCacheTest::CreateAntenna(uint32_t nColumns)
+{
+    return CreateObjectWithAttributes<UniformPlanarArray>(
+        "NumColumns",
+        UintegerValue(nColumns),
+        "NumRows",
+        UintegerValue(2),
+        "AntennaElement",
+        PointerValue(CreateObject<ThreeGppAntennaModel>()));
+}
+
+void
+ThreeGppChannelCacheTest::CheckSharing()
+{
+    NodeContainer nodes;
+    CreateNodes(nodes);
+    auto txMob = nodes.Get(0)->GetObject<MobilityModel>();
+    auto rxMob = nodes.Get(1)->GetObject<MobilityModel>();
+
+    auto cache = CreateObject<ThreeGppChannelCache>();
+    Ptr<ChannelConditionModel> channelConditionModel =
+        CreateObject<AlwaysLosChannelConditionModel>();
+    auto channelModel1 = CreateChannelModel(cache, channelConditionModel);
+    auto channelModel2 = CreateChannelModel(cache, channelConditionModel);
+
+    // the first channel matrix is generated and stored in the cache
+    auto txAntenna1 = CreateAntenna(4);
+    auto rxAntenna1 = CreateAntenna(2);
+    auto channel1 = channelModel1->GetChannel(txMob, rxMob, txAntenna1, rxAntenna1);
+    NS_TEST_ASSERT_MSG_EQ(cache->GetStats().misses, 1, "The cache should have been missed");
+    NS_TEST_ASSERT_MSG_EQ(cache->GetStats().size, 1, "The matrix should have been stored");
+
+    // the channel params and the channel matrix are shared with the second channel model,
+    // since the antenna arrays have the same configuration
+    auto txAntenna2 = CreateAntenna(4);
+    auto rxAntenna2 = CreateAntenna(2);
+    NS_TEST_ASSERT_MSG_EQ(txAntenna1->GetConfigHash(),
+                          txAntenna2->GetConfigHash(),
+                          "Antennas with the same configuration should have the same hash");
+    auto channel2 = channelModel2->GetChannel(txMob, rxMob, txAntenna2, rxAntenna2);
+    NS_TEST_ASSERT_MSG_EQ(channelModel1->GetParams(txMob, rxMob),
+                          channelModel2->GetParams(txMob, rxMob),
+                          "The channel params should be shared");
+    NS_TEST_ASSERT_MSG_EQ(cache->GetStats().hits, 1, "The cache should have been hit");
+    NS_TEST_ASSERT_MSG_EQ((channel1->m_channel == channel2->m_channel),
+                          true,
+                          "The channel matrix should be shared");
+    NS_TEST_ASSERT_MSG_EQ(channel2->IsReverse(txAntenna2->GetId(), rxAntenna2->GetId()),
+                          false,
+                          "The channel matrix should be in the direct direction");
+
+    // the channel matrix is also reused when the link is used in the reverse direction
+    auto txAntenna3 = CreateAntenna(4);
+    auto rxAntenna3 = CreateAntenna(2);
+    auto channel3 = channelModel1->GetChannel(rxMob, txMob, rxAntenna3, txAntenna3);
+    NS_TEST_ASSERT_MSG_EQ(cache->GetStats().hits, 2, "The cache should have been hit");
+    NS_TEST_ASSERT_MSG_EQ((channel1->m_channel == channel3->m_channel),
+                          true,
+                          "The channel matrix should be shared");
+    NS_TEST_ASSERT_MSG_EQ(channel3->IsReverse(rxAntenna3->GetId(), txAntenna3->GetId()),
+                          true,
+                          "The channel matrix should be in the reverse direction");
+
+    // antenna arrays with a different configuration need a different channel matrix
+    auto txAntenna4 = CreateAntenna(3);
+    NS_TEST_ASSERT_MSG_NE(txAntenna1->GetConfigHash(),
+                          txAntenna4->GetConfigHash(),
+                          "Antennas with a different configuration should have different hashes");
+    auto channel4 = channelModel2->GetChannel(txMob, rxMob, txAntenna4, rxAntenna2);
+    NS_TEST_ASSERT_MSG_EQ(cache->GetStats().misses, 2, "The cache should have been missed");
+    NS_TEST_ASSERT_MSG_EQ(channel4->m_channel.GetNumCols(),
+                          6,
+                          "The channel matrix has not the correct number of columns");
+    NS_TEST_ASSERT_MSG_EQ(cache->GetStats().size, 2, "The matrix should have been stored");
+
+    Simulator::Destroy();
+}
+
+std::vector<Ptr<const ThreeGppChannelModel::ChannelMatrix>>
+ThreeGppChannelCacheTest::GetChannels(uint32_t nThreads)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer nodes;
+    CreateNodes(nodes);
+    auto txMob = nodes.Get(0)->GetObject<MobilityModel>();
+    auto rxMob = nodes.Get(1)->GetObject<MobilityModel>();
+
+    auto cache = CreateObjectWithAttributes<ThreeGppChannelCache>("NumWorkerThreads",
+                                                                 UintegerValue(nThreads));
+    auto channelModel =
+        CreateChannelModel(cache, CreateObject<AlwaysLosChannelConditionModel>());
+
+    // three links with different antenna configurations
+    std::vector<std::pair<Ptr<PhasedArrayModel>, Ptr<PhasedArrayModel>>> links;
+    for (uint32_t nColumns = 2; nColumns <= 4; ++nColumns)
+    {
+        links.emplace_back(CreateAntenna(nColumns), CreateAntenna(2));
+    }
+
+    std::vector<Ptr<const ThreeGppChannelModel::ChannelMatrix>> channels;
+    auto getChannels = [&](bool store) {
+        for (const auto& [txAntenna, rxAntenna] : links)
+        {
+            auto channel = channelModel->GetChannel(txMob, rxMob, txAntenna, rxAntenna);
+            if (store)
+            {
+                channels.push_back(channel);
+            }
+        }
+    };
+    Simulator::Schedule(MilliSeconds(1), [&]() { getChannels(false); });
+    // the channel params are regenerated, together with the channel matrices of all the
+    // links if worker threads are used
+    Simulator::Schedule(MilliSeconds(150), [&]() { getChannels(true); });
+    Simulator::Run();
+    Simulator::Destroy();
+    return channels;
+}
+
+void
+ThreeGppChannelCacheTest::DoRun()
+{
+    CheckSharing();
+
+    auto lazyChannels = GetChannels(0);
+    auto aheadChannels = GetChannels(2);
+    NS_TEST_ASSERT_MSG_EQ(aheadChannels.size(), lazyChannels.size(), "Missing channel matrices");
+    for (std::size_t i = 0; i < lazyChannels.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(aheadChannels[i]->m_generatedTime,
+                              MilliSeconds(150),
+                              "Unexpected generation time of the channel matrix");
+        NS_TEST_EXPECT_MSG_EQ((aheadChannels[i]->m_channel == lazyChannels[i]->m_channel),
+                              true,
+                              "The channel matrix generated ahead of time should be equal to "
+                              "the channel matrix generated when the link is used");
+    }
+}
+
+/**
+ * @ingroup spectrum-tests
+ *
+ * Test case for the computation ahead of time of the long term components and the delay terms
+ * by the ThreeGppSpectrumPropagationLossModel class. The beamforming vector of a transmitter
+ * is changed and the received PSDs at two receivers are computed with and without worker
+ * threads. The test checks that:
+ * 1) the long term components are computed ahead of time and used upon reception when
+ *    worker threads are used
+ * 2) the received PSDs and the frequency domain channel matrices are the same with and
+ *    without worker threads
+ */
+class ThreeGppSpectrumPrepareTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    ThreeGppSpectrumPrepareTest();
+
+  private:
+    /**
+     * Build the test scenario
+     */
+    void DoRun() override;
+
+    /**
+     * Compute the received signal parameters at two receivers after changing the beamforming
+     * vector of the transmitter
+     * @param nThreads the number of worker threads of the spectrum propagation loss model
+     * @return the received signal parameters at the two receivers
+     */
+    std::vector<Ptr<SpectrumSignalParameters>> GetRxParams(uint32_t nThreads);
+};
+
+ThreeGppSpectrumPrepareTest::ThreeGppSpectrumPrepareTest()
+    : TestCase("Check the computation of the received PSDs ahead of time")
+{
+}
+
+std::vector<Ptr<SpectrumSignalParameters>>
+ThreeGppSpectrumPrepareTest::GetRxParams(uint32_t nThreads)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    auto lossModel =
+        CreateObjectWithAttributes<ThreeGppSpectrumPropagationLossModel>("NumWorkerThreads",
+                                                                          UintegerValue(nThreads));
+    lossModel->SetChannelModelAttribute("Frequency", DoubleValue(2.4e9));
+    lossModel->SetChannelModelAttribute("Scenario", StringValue("UMa"));
+    lossModel->SetChannelModelAttribute(
+        "ChannelConditionModel",
+        PointerValue(CreateObject<AlwaysLosChannelConditionModel>()));
+    DynamicCast<ThreeGppChannelModel>(lossModel->GetChannelModel())->AssignStreams(1);
+
+    // a transmitter and two receivers
+    NodeContainer nodes;
+    nodes.Create(3);
+    std::vector<Ptr<MobilityModel>> mobs;
+    std::vector<Ptr<PhasedArrayModel>> antennas;
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        mobs.push_back(CreateObject<ConstantPositionMobilityModel>());
+        mobs.back()->SetPosition(Vector(15.0 * i, 5.0 * i * i, 10.0));
+        nodes.Get(i)->AggregateObject(mobs.back());
+        antennas.push_back(CreateObjectWithAttributes<UniformPlanarArray>(
+            "NumColumns",
+            UintegerValue(4),
+            "NumRows",
+            UintegerValue(4),
+            "AntennaElement",
+            PointerValue(CreateObject<IsotropicAntennaModel>()),
+            "NumVerticalPorts",
+            UintegerValue(2),
+            "NumHorizontalPorts",
+            UintegerValue(2)));
+    }
+
+    // point the beam of the transmitter towards the given receiver
+    auto doBeamforming = [&](uint32_t rx) {
+        Angles angles(mobs[rx]->GetPosition(), mobs[0]->GetPosition());
+        antennas[0]->SetBeamformingVector(antennas[0]->GetBeamformingVector(angles));
+    };
+    for (uint32_t rx = 1; rx < nodes.GetN(); ++rx)
+    {
+        Angles angles(mobs[0]->GetPosition(), mobs[rx]->GetPosition());
+        antennas[rx]->SetBeamformingVector(antennas[rx]->GetBeamformingVector(angles));
+    }
+
+    SpectrumValue5MhzFactory sf;
+    auto txParams = Create<SpectrumSignalParameters>();
+    txParams->psd = sf.CreateTxPowerSpectralDensity(0.1, 1);
+
+    std::vector<Ptr<SpectrumSignalParameters>> rxParams;
+    auto receive = [&](bool store) {
+        for (uint32_t rx = 1; rx < nodes.GetN(); ++rx)
+        {
+            auto params = lossModel->DoCalcRxPowerSpectralDensity(txParams,
+                                                                  mobs[0],
+                                                                  mobs[rx],
+                                                                  antennas[0],
+                                                                  antennas[rx]);
+            if (store)
+            {
+                rxParams.push_back(params);
+            }
+        }
+    };
+
+    Simulator::Schedule(MilliSeconds(1), [&]() {
+        doBeamforming(1);
+        receive(false);
+    });
+    Simulator::Schedule(MilliSeconds(2), [&]() {
+        doBeamforming(2);
+        std::vector<PhasedArraySpectrumPropagationLossModel::Receiver> receivers;
+        for (uint32_t rx = 1; rx < nodes.GetN(); ++rx)
+        {
+            receivers.push_back({mobs[rx], antennas[rx], txParams->psd});
+        }
+        lossModel->PrepareRxPowerSpectralDensities(mobs[0], antennas[0], receivers);
+        NS_TEST_EXPECT_MSG_EQ(lossModel->m_pendingLongTerms.size(),
+                              (nThreads > 0 ? 2 : 0),
+                              "Unexpected number of long term components computed ahead of time");
+    });
+    // the signal is received after some time
+    Simulator::Schedule(MilliSeconds(2) + NanoSeconds(100), [&]() {
+        receive(true);
+        NS_TEST_EXPECT_MSG_EQ(lossModel->m_pendingLongTerms.size(),
+                              0,
+                              "The long term components computed ahead of time were not used");
+    });
+    Simulator::Run();
+    Simulator::Destroy();
+    return rxParams;
+}
+
+void
+ThreeGppSpectrumPrepareTest::DoRun()
+{
+    auto serialParams = GetRxParams(0);
+    auto parallelParams = GetRxParams(2);
+    NS_TEST_ASSERT_MSG_EQ(parallelParams.size(), serialParams.size(), "Missing received PSDs");
+    for (std::size_t i = 0; i < serialParams.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ((*parallelParams[i]->psd == *serialParams[i]->psd),
+                              true,
+                              "The received PSD should not depend on the worker threads");
+        NS_TEST_EXPECT_MSG_EQ(
+            (*parallelParams[i]->spectrumChannelMatrix == *serialParams[i]->spectrumChannelMatrix),
+            true,
+            "The channel matrix should not depend on the worker threads");
+    }
+}
+
 /**
  * @ingroup spectrum-tests
  *
@@ -1486,6 +1879,8 @@ ThreeGppChannelTestSuite::ThreeGppChannelTestSuite()
     AddTestCase(new ThreeGppSpectrumPropagationLossModelTest(4, 2, 2, 1),
                 TestCase::Duration::QUICK);
     AddTestCase(new ThreeGppCalcLongTermMultiPortTest(), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppChannelCacheTest(), TestCase::Duration::QUICK);
+    AddTestCase(new ThreeGppSpectrumPrepareTest(), TestCase::Duration::QUICK);
 
     /**
      *  The TX and RX antennas are configured face-to-face.
@@ -100,6 +100,18 @@ FqCobaltFlow::GetIndex() const
     return m_index;
 }
 
+void
+FqCobaltFlow::SetNextFlow(FqCobaltFlow* next)
+{
+    m_nextFlow = next;
+}
+
+FqCobaltFlow*
+FqCobaltFlow::GetNextFlow() const
+{
+    return m_nextFlow;
+}
+
 NS_OBJECT_ENSURE_REGISTERED(FqCobaltQueueDisc);
 
 TypeId
@@ -201,6 +213,16 @@ FqCobaltQueueDisc::~FqCobaltQueueDisc()
     NS_LOG_FUNCTION(this);
 }
 
+void
+FqCobaltQueueDisc::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_newFlows = FqFlowList<FqCobaltFlow>();
+    m_oldFlows = FqFlowList<FqCobaltFlow>();
+    m_flowTable.clear();
+    QueueDisc::DoDispose();
+}
+
 void
 FqCobaltQueueDisc::SetQuantum(uint32_t quantum)
 {
@@ -225,12 +247,8 @@ FqCobaltQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
-
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCobaltFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqCobaltFlow::INACTIVE)
+        if (!m_flowTable[i] || m_tags[i] == flowHash ||
+            m_flowTable[i]->GetStatus() == FqCobaltFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
@@ -282,7 +300,7 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     }
 
     Ptr<FqCobaltFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (!m_flowTable[h])
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqCobaltFlow>();
@@ -301,23 +319,23 @@ FqCobaltQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         flow->SetIndex(h);
         AddQueueDiscClass(flow);
 
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+        m_flowTable[h] = flow;
     }
     else
     {
-        flow = StaticCast<FqCobaltFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        flow = m_flowTable[h];
     }
 
     if (flow->GetStatus() == FqCobaltFlow::INACTIVE)
     {
         flow->SetStatus(FqCobaltFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_newFlows.PushBack(PeekPointer(flow));
     }
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h);
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -333,24 +351,23 @@ FqCobaltQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqCobaltFlow> flow;
+    FqCobaltFlow* flow = nullptr;
     Ptr<QueueDiscItem> item;
 
     do
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_newFlows.IsEmpty())
         {
-            flow = m_newFlows.front();
+            flow = m_newFlows.Front();
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqCobaltFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_newFlows.MoveFrontTo(m_oldFlows);
             }
             else
             {
@@ -359,16 +376,15 @@ FqCobaltQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_oldFlows.IsEmpty())
         {
-            flow = m_oldFlows.front();
+            flow = m_oldFlows.Front();
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
+                m_oldFlows.MoveFrontTo(m_oldFlows);
             }
             else
             {
@@ -388,16 +404,15 @@ FqCobaltQueueDisc::DoDequeue()
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_newFlows.IsEmpty())
             {
                 flow->SetStatus(FqCobaltFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_newFlows.MoveFrontTo(m_oldFlows);
             }
             else
             {
                 flow->SetStatus(FqCobaltFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_oldFlows.PopFront();
             }
         }
         else
@@ -471,6 +486,9 @@ FqCobaltQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
+    m_flowTable.assign(m_flows, nullptr);
+    m_tags.assign(m_flows, 0);
+
     m_flowFactory.SetTypeId("ns3::FqCobaltFlow");
 
     m_queueDiscFactory.SetTypeId("ns3::CobaltQueueDisc");
@@ -16,12 +16,12 @@
 #ifndef FQ_COBALT_QUEUE_DISC
 #define FQ_COBALT_QUEUE_DISC
 
+#include "fq-flow-list.h"
 #include "queue-disc.h"
 
 #include "ns3/object-factory.h"
 
-#include <list>
-#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -94,10 +94,23 @@ class FqCobaltFlow : public QueueDiscClass
      */
     uint32_t GetIndex() const;
 
+    /**
+     * @brief Set the next flow in the list of new or old flows this flow belongs to
+     * @param next the next flow
+     */
+    void SetNextFlow(FqCobaltFlow* next);
+
+    /**
+     * @brief Get the next flow in the list of new or old flows this flow belongs to
+     * @return the next flow, or a null pointer if this flow is the last one of the list
+     */
+    FqCobaltFlow* GetNextFlow() const;
+
   private:
-    int32_t m_deficit;   //!< the deficit for this flow
-    FlowStatus m_status; //!< the status of this flow
-    uint32_t m_index;    //!< the index for this flow
+    int32_t m_deficit;                 //!< the deficit for this flow
+    FlowStatus m_status;               //!< the status of this flow
+    uint32_t m_index;                  //!< the index for this flow
+    FqCobaltFlow* m_nextFlow{nullptr}; //!< the next flow in the list of new or old flows
 };
 
 /**
@@ -143,6 +156,7 @@ class FqCobaltQueueDisc : public QueueDisc
     static constexpr const char* OVERLIMIT_DROP = "Overlimit drop"; //!< Overlimit dropped packets
 
   private:
+    void DoDispose() override;
     bool DoEnqueue(Ptr<QueueDiscItem> item) override;
     Ptr<QueueDiscItem> DoDequeue() override;
     bool CheckConfig() override;
@@ -179,11 +193,11 @@ class FqCobaltQueueDisc : public QueueDisc
     double m_Pdrop;       //!< Drop Probability
     Time m_blueThreshold; //!< Threshold to enable blue enhancement
 
-    std::list<Ptr<FqCobaltFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqCobaltFlow>> m_oldFlows; //!< The list of old flows
+    FqFlowList<FqCobaltFlow> m_newFlows; //!< The list of new flows
+    FqFlowList<FqCobaltFlow> m_oldFlows; //!< The list of old flows
 
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    std::vector<Ptr<FqCobaltFlow>> m_flowTable; //!< The flow queues, indexed by flow index
+    std::vector<uint32_t> m_tags;               //!< Tags used by set associative hash
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
@@ -94,6 +94,18 @@ FqCoDelFlow::GetIndex() const
     return m_index;
 }
 
+void
+FqCoDelFlow::SetNextFlow(FqCoDelFlow* next)
+{
+    m_nextFlow = next;
+}
+
+FqCoDelFlow*
+FqCoDelFlow::GetNextFlow() const
+{
+    return m_nextFlow;
+}
+
 NS_OBJECT_ENSURE_REGISTERED(FqCoDelQueueDisc);
 
 TypeId
@@ -175,6 +187,16 @@ FqCoDelQueueDisc::~FqCoDelQueueDisc()
     NS_LOG_FUNCTION(this);
 }
 
+void
+FqCoDelQueueDisc::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_newFlows = FqFlowList<FqCoDelFlow>();
+    m_oldFlows = FqFlowList<FqCoDelFlow>();
+    m_flowTable.clear();
+    QueueDisc::DoDispose();
+}
+
 void
 FqCoDelQueueDisc::SetQuantum(uint32_t quantum)
 {
@@ -199,12 +221,8 @@ FqCoDelQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
-
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCoDelFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqCoDelFlow::INACTIVE)
+        if (!m_flowTable[i] || m_tags[i] == flowHash ||
+            m_flowTable[i]->GetStatus() == FqCoDelFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
@@ -256,7 +274,7 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     }
 
     Ptr<FqCoDelFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (!m_flowTable[h])
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqCoDelFlow>();
@@ -274,23 +292,23 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         flow->SetIndex(h);
         AddQueueDiscClass(flow);
 
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+        m_flowTable[h] = flow;
     }
     else
     {
-        flow = StaticCast<FqCoDelFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        flow = m_flowTable[h];
     }
 
     if (flow->GetStatus() == FqCoDelFlow::INACTIVE)
     {
         flow->SetStatus(FqCoDelFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_newFlows.PushBack(PeekPointer(flow));
     }
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h);
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -306,23 +324,23 @@ FqCoDelQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqCoDelFlow> flow;
+    FqCoDelFlow* flow = nullptr;
     Ptr<QueueDiscItem> item;
 
     do
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_newFlows.IsEmpty())
         {
-            flow = m_newFlows.front();
+            flow = m_newFlows.Front();
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.splice(m_oldFlows.end(), m_newFlows, m_newFlows.begin());
+                m_newFlows.MoveFrontTo(m_oldFlows);
             }
             else
             {
@@ -331,15 +349,15 @@ FqCoDelQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_oldFlows.IsEmpty())
         {
-            flow = m_oldFlows.front();
+            flow = m_oldFlows.Front();
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.splice(m_oldFlows.end(), m_oldFlows, m_oldFlows.begin());
+                m_oldFlows.MoveFrontTo(m_oldFlows);
             }
             else
             {
@@ -359,16 +377,15 @@ FqCoDelQueueDisc::DoDequeue()
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_newFlows.IsEmpty())
             {
                 flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_newFlows.MoveFrontTo(m_oldFlows);
             }
             else
             {
                 flow->SetStatus(FqCoDelFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_oldFlows.PopFront();
             }
         }
         else
@@ -442,6 +459,9 @@ FqCoDelQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
+    m_flowTable.assign(m_flows, nullptr);
+    m_tags.assign(m_flows, 0);
+
     m_flowFactory.SetTypeId("ns3::FqCoDelFlow");
 
     m_queueDiscFactory.SetTypeId("ns3::CoDelQueueDisc");
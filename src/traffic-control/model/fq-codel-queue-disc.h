@@ -10,12 +10,12 @@
 #ifndef FQ_CODEL_QUEUE_DISC
 #define FQ_CODEL_QUEUE_DISC
 
+#include "fq-flow-list.h"
 #include "queue-disc.h"
 
 #include "ns3/object-factory.h"
 
-#include <list>
-#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -88,10 +88,23 @@ class FqCoDelFlow : public QueueDiscClass
      */
     uint32_t GetIndex() const;
 
+    /**
+     * @brief Set the next flow in the list of new or old flows this flow belongs to
+     * @param next the next flow
+     */
+    void SetNextFlow(FqCoDelFlow* next);
+
+    /**
+     * @brief Get the next flow in the list of new or old flows this flow belongs to
+     * @return the next flow, or a null pointer if this flow is the last one of the list
+     */
+    FqCoDelFlow* GetNextFlow() const;
+
   private:
-    int32_t m_deficit;   //!< the deficit for this flow
-    FlowStatus m_status; //!< the status of this flow
-    uint32_t m_index;    //!< the index for this flow
+    int32_t m_deficit;                //!< the deficit for this flow
+    FlowStatus m_status;              //!< the status of this flow
+    uint32_t m_index;                 //!< the index for this flow
+    FqCoDelFlow* m_nextFlow{nullptr}; //!< the next flow in the list of new or old flows
 };
 
 /**
@@ -137,6 +150,7 @@ class FqCoDelQueueDisc : public QueueDisc
     static constexpr const char* OVERLIMIT_DROP = "Overlimit drop"; //!< Overlimit dropped packets
 
   private:
+    void DoDispose() override;
     bool DoEnqueue(Ptr<QueueDiscItem> item) override;
     Ptr<QueueDiscItem> DoDequeue() override;
     bool CheckConfig() override;
@@ -169,11 +183,11 @@ class FqCoDelQueueDisc : public QueueDisc
     bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
     bool m_useL4s; //!< True if L4S is used (ECT1 packets are marked at CE threshold)
 
-    std::list<Ptr<FqCoDelFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqCoDelFlow>> m_oldFlows; //!< The list of old flows
+    FqFlowList<FqCoDelFlow> m_newFlows; //!< The list of new flows
+    FqFlowList<FqCoDelFlow> m_oldFlows; //!< The list of old flows
 
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    std::vector<Ptr<FqCoDelFlow>> m_flowTable; //!< The flow queues, indexed by flow index
+    std::vector<uint32_t> m_tags;              //!< Tags used by set associative hash
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
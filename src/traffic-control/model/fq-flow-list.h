@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FQ_FLOW_LIST_H
+#define FQ_FLOW_LIST_H
+
+#include "ns3/assert.h"
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic-control
+ *
+ * @brief Intrusive FIFO list of flow queues
+ *
+ * This class stores the lists of new and old flows of the flow queuing
+ * disciplines (FqCoDelQueueDisc, FqCobaltQueueDisc and FqPieQueueDisc).
+ * The flows are linked through a pointer stored in the flows themselves,
+ * hence adding and removing flows does not allocate memory. A flow can
+ * belong to at most one list at a time. The list does not hold a reference
+ * to its flows, which are owned by the queue disc as queue disc classes.
+ *
+ * @tparam Flow the flow class, which must provide the SetNextFlow and
+ *         GetNextFlow methods
+ */
+template <class Flow>
+class FqFlowList
+{
+  public:
+    /**
+     * @brief Check whether the list is empty
+     * @return true if the list is empty
+     */
+    bool IsEmpty() const;
+
+    /**
+     * @brief Get the flow at the head of the list
+     * @return the flow at the head of the list, which must not be empty
+     */
+    Flow* Front() const;
+
+    /**
+     * @brief Append a flow to the list
+     * @param flow the flow, which must not belong to any list
+     */
+    void PushBack(Flow* flow);
+
+    /**
+     * @brief Remove the flow at the head of the list, which must not be empty
+     */
+    void PopFront();
+
+    /**
+     * @brief Move the flow at the head of this list to the tail of the given list
+     *
+     * The given list can be this list, in which case the head flow becomes the
+     * tail flow.
+     *
+     * @param other the list the flow is appended to
+     */
+    void MoveFrontTo(FqFlowList& other);
+
+  private:
+    Flow* m_head{nullptr}; //!< the flow at the head of the list
+    Flow* m_tail{nullptr}; //!< the flow at the tail of the list
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <class Flow>
+bool
+FqFlowList<Flow>::IsEmpty() const
+{
+    return m_head == nullptr;
+}
+
+template <class Flow>
+Flow*
+FqFlowList<Flow>::Front() const
+{
+    NS_ASSERT_MSG(m_head, "The list of flows is empty");
+    return m_head;
+}
+
+template <class Flow>
+void
+FqFlowList<Flow>::PushBack(Flow* flow)
+{
+    NS_ASSERT(flow->GetNextFlow() == nullptr && flow != m_tail);
+    if (m_tail)
+    {
+        m_tail->SetNextFlow(flow);
+    }
+    else
+    {
+        m_head = flow;
+    }
+    m_tail = flow;
+}
+
+template <class Flow>
+void
+FqFlowList<Flow>::PopFront()
+{
+    NS_ASSERT_MSG(m_head, "The list of flows is empty");
+    Flow* flow = m_head;
+    m_head = flow->GetNextFlow();
+    flow->SetNextFlow(nullptr);
+    if (!m_head)
+    {
+        m_tail = nullptr;
+    }
+}
+
+template <class Flow>
+void
+FqFlowList<Flow>::MoveFrontTo(FqFlowList& other)
+{
+    Flow* flow = Front();
+    PopFront();
+    other.PushBack(flow);
+}
+
+} // namespace ns3
+
+#endif /* FQ_FLOW_LIST_H */
@@ -99,6 +99,18 @@ FqPieFlow::GetIndex() const
     return m_index;
 }
 
+void
+FqPieFlow::SetNextFlow(FqPieFlow* next)
+{
+    m_nextFlow = next;
+}
+
+FqPieFlow*
+FqPieFlow::GetNextFlow() const
+{
+    return m_nextFlow;
+}
+
 NS_OBJECT_ENSURE_REGISTERED(FqPieQueueDisc);
 
 TypeId
@@ -230,6 +242,16 @@ FqPieQueueDisc::~FqPieQueueDisc()
     NS_LOG_FUNCTION(this);
 }
 
+void
+FqPieQueueDisc::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_newFlows = FqFlowList<FqPieFlow>();
+    m_oldFlows = FqFlowList<FqPieFlow>();
+    m_flowTable.clear();
+    QueueDisc::DoDispose();
+}
+
 void
 FqPieQueueDisc::SetQuantum(uint32_t quantum)
 {
@@ -254,12 +276,8 @@ FqPieQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
-
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqPieFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqPieFlow::INACTIVE)
+        if (!m_flowTable[i] || m_tags[i] == flowHash ||
+            m_flowTable[i]->GetStatus() == FqPieFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
@@ -311,7 +329,7 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
     }
 
     Ptr<FqPieFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    if (!m_flowTable[h])
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqPieFlow>();
@@ -329,23 +347,23 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         flow->SetIndex(h);
         AddQueueDiscClass(flow);
 
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
+        m_flowTable[h] = flow;
     }
     else
     {
-        flow = StaticCast<FqPieFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        flow = m_flowTable[h];
     }
 
     if (flow->GetStatus() == FqPieFlow::INACTIVE)
     {
         flow->SetStatus(FqPieFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_newFlows.PushBack(PeekPointer(flow));
     }
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h);
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -361,24 +379,23 @@ FqPieQueueDisc::DoDequeue()
 {
     NS_LOG_FUNCTION(this);
 
-    Ptr<FqPieFlow> flow;
+    FqPieFlow* flow = nullptr;
     Ptr<QueueDiscItem> item;
 
     do
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_newFlows.IsEmpty())
         {
-            flow = m_newFlows.front();
+            flow = m_newFlows.Front();
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_newFlows.MoveFrontTo(m_oldFlows);
             }
             else
             {
@@ -387,16 +404,15 @@ FqPieQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_oldFlows.IsEmpty())
         {
-            flow = m_oldFlows.front();
+            flow = m_oldFlows.Front();
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
+                m_oldFlows.MoveFrontTo(m_oldFlows);
             }
             else
             {
@@ -416,16 +432,15 @@ FqPieQueueDisc::DoDequeue()
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_newFlows.IsEmpty())
             {
                 flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_newFlows.MoveFrontTo(m_oldFlows);
             }
             else
             {
                 flow->SetStatus(FqPieFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_oldFlows.PopFront();
             }
         }
         else
@@ -499,6 +514,9 @@ FqPieQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
+    m_flowTable.assign(m_flows, nullptr);
+    m_tags.assign(m_flows, 0);
+
     m_flowFactory.SetTypeId("ns3::FqPieFlow");
 
     m_queueDiscFactory.SetTypeId("ns3::PieQueueDisc");
@@ -15,12 +15,12 @@
 #ifndef FQ_PIE_QUEUE_DISC
 #define FQ_PIE_QUEUE_DISC
 
+#include "fq-flow-list.h"
 #include "queue-disc.h"
 
 #include "ns3/object-factory.h"
 
-#include <list>
-#include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -93,10 +93,23 @@ class FqPieFlow : public QueueDiscClass
      */
     uint32_t GetIndex() const;
 
+    /**
+     * @brief Set the next flow in the list of new or old flows this flow belongs to
+     * @param next the next flow
+     */
+    void SetNextFlow(FqPieFlow* next);
+
+    /**
+     * @brief Get the next flow in the list of new or old flows this flow belongs to
+     * @return the next flow, or a null pointer if this flow is the last one of the list
+     */
+    FqPieFlow* GetNextFlow() const;
+
   private:
-    int32_t m_deficit;   //!< the deficit for this flow
-    FlowStatus m_status; //!< the status of this flow
-    uint32_t m_index;    //!< the index for this flow
+    int32_t m_deficit;              //!< the deficit for this flow
+    FlowStatus m_status;            //!< the status of this flow
+    uint32_t m_index;               //!< the index for this flow
+    FqPieFlow* m_nextFlow{nullptr}; //!< the next flow in the list of new or old flows
 };
 
 /**
@@ -142,6 +155,7 @@ class FqPieQueueDisc : public QueueDisc
     static constexpr const char* OVERLIMIT_DROP = "Overlimit drop"; //!< Overlimit dropped packets
 
   private:
+    void DoDispose() override;
     bool DoEnqueue(Ptr<QueueDiscItem> item) override;
     Ptr<QueueDiscItem> DoDequeue() override;
     bool CheckConfig() override;
@@ -189,11 +203,11 @@ class FqPieQueueDisc : public QueueDisc
     uint32_t m_perturbation;         //!< hash perturbation value
     bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
 
-    std::list<Ptr<FqPieFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqPieFlow>> m_oldFlows; //!< The list of old flows
+    FqFlowList<FqPieFlow> m_newFlows; //!< The list of new flows
+    FqFlowList<FqPieFlow> m_oldFlows; //!< The list of old flows
 
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    std::vector<Ptr<FqPieFlow>> m_flowTable; //!< The flow queues, indexed by flow index
+    std::vector<uint32_t> m_tags;            //!< Tags used by set associative hash
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
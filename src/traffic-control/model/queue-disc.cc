@@ -13,11 +13,15 @@
 #include "ns3/object-vector.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
+#include "ns3/queue-limits.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
 #include "ns3/socket.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace ns3
 {
 
@@ -246,6 +250,12 @@ QueueDisc::GetTypeId()
                           UintegerValue(DEFAULT_QUOTA),
                           MakeUintegerAccessor(&QueueDisc::SetQuota, &QueueDisc::GetQuota),
                           MakeUintegerChecker<uint32_t>())
+            .AddAttribute("MaxBatchSize",
+                          "The maximum number of packets sent to the device at once in a "
+                          "qdisc run. Packets are sent one at a time if this value is one.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&QueueDisc::m_maxBatchSize),
+                          MakeUintegerChecker<uint32_t>(1))
             .AddAttribute("InternalQueueList",
                           "The list of internal queues.",
                           ObjectVectorValue(),
@@ -370,6 +380,8 @@ QueueDisc::DoDispose()
     m_classes.clear();
     m_devQueueIface = nullptr;
     m_send = nullptr;
+    m_sendBatch = nullptr;
+    m_batch.clear();
     m_requeued = nullptr;
     m_internalQueueDbeFunctor = nullptr;
     m_internalQueueDadFunctor = nullptr;
@@ -544,6 +556,20 @@ QueueDisc::GetSendCallback() const
     return m_send;
 }
 
+void
+QueueDisc::SetSendBatchCallback(SendBatchCallback func)
+{
+    NS_LOG_FUNCTION(this);
+    m_sendBatch = func;
+}
+
+QueueDisc::SendBatchCallback
+QueueDisc::GetSendBatchCallback() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_sendBatch;
+}
+
 void
 QueueDisc::SetQuota(const uint32_t quota)
 {
@@ -905,6 +931,46 @@ QueueDisc::Dequeue()
     return item;
 }
 
+std::size_t
+QueueDisc::DequeueBatch(std::vector<Ptr<QueueDiscItem>>& batch,
+                        uint32_t maxPackets,
+                        uint32_t maxBytes)
+{
+    NS_LOG_FUNCTION(this << maxPackets << maxBytes);
+
+    const bool multiQueue = m_devQueueIface && m_devQueueIface->GetNTxQueues() > 1;
+    std::size_t txq = 0;
+    uint32_t nPackets = 0;
+    uint64_t nBytes = 0;
+
+    while (nPackets < maxPackets && (nPackets == 0 || nBytes < maxBytes))
+    {
+        // packets destined to distinct device transmission queues are sent in
+        // distinct batches
+        if (multiQueue && nPackets > 0)
+        {
+            Ptr<const QueueDiscItem> next = Peek();
+            if (!next || next->GetTxQueueIndex() != txq)
+            {
+                break;
+            }
+        }
+
+        Ptr<QueueDiscItem> item = Dequeue();
+        if (!item)
+        {
+            break;
+        }
+        txq = item->GetTxQueueIndex();
+        nBytes += item->GetSize();
+        nPackets++;
+        batch.push_back(item);
+    }
+
+    NS_LOG_LOGIC("Dequeued a batch of " << nPackets << " packets (" << nBytes << " bytes)");
+    return nPackets;
+}
+
 Ptr<const QueueDiscItem>
 QueueDisc::Peek()
 {
@@ -938,13 +1004,22 @@ QueueDisc::Run()
     if (RunBegin())
     {
         uint32_t quota = m_quota;
-        while (Restart())
+        if (m_sendBatch && m_maxBatchSize > 1)
         {
-            quota -= 1;
-            if (quota <= 0)
+            while (quota > 0 && RestartBatch(quota))
             {
-                /// @todo netif_schedule (q);
-                break;
+            }
+        }
+        else
+        {
+            while (Restart())
+            {
+                quota -= 1;
+                if (quota <= 0)
+                {
+                    /// @todo netif_schedule (q);
+                    break;
+                }
             }
         }
         RunEnd();
@@ -985,6 +1060,92 @@ QueueDisc::Restart()
     return Transmit(item);
 }
 
+bool
+QueueDisc::RestartBatch(uint32_t& quota)
+{
+    NS_LOG_FUNCTION(this << quota);
+
+    // A packet requeued because the device queue was stopped already had its
+    // header added, hence send it alone
+    if (m_requeued && !m_peeked)
+    {
+        quota--;
+        return Restart();
+    }
+
+    // If the device is multi-queue, the batch is destined to the transmission
+    // queue of the next packet
+    std::size_t txq = 0;
+    if (m_devQueueIface && m_devQueueIface->GetNTxQueues() > 1)
+    {
+        Ptr<const QueueDiscItem> next = Peek();
+        if (!next)
+        {
+            NS_LOG_LOGIC("No packet to send");
+            return false;
+        }
+        txq = next->GetTxQueueIndex();
+    }
+
+    uint32_t maxPackets = std::min(quota, m_maxBatchSize);
+    uint32_t maxBytes = std::numeric_limits<uint32_t>::max();
+    Ptr<NetDeviceQueue> devQueue;
+
+    if (m_devQueueIface)
+    {
+        devQueue = m_devQueueIface->GetTxQueue(txq);
+        if (devQueue->IsStopped())
+        {
+            NS_LOG_LOGIC("The device queue is stopped");
+            return false;
+        }
+        // a device queue that is not stopped can receive at least one packet
+        maxPackets = std::clamp(devQueue->GetAvailablePackets(), 1U, maxPackets);
+        if (Ptr<QueueLimits> ql = devQueue->GetQueueLimits())
+        {
+            maxBytes = std::max(ql->Available(), 0);
+        }
+    }
+
+    DequeueBatch(m_batch, maxPackets, maxBytes);
+    if (m_batch.empty())
+    {
+        NS_LOG_LOGIC("No packet to send");
+        return false;
+    }
+
+    for (auto& item : m_batch)
+    {
+        item->AddHeader();
+        // a single queue device makes no use of the priority tag
+        // a device that does not install a device queue interface likely makes no use of it
+        if (!m_devQueueIface || m_devQueueIface->GetNTxQueues() == 1)
+        {
+            SocketPriorityTag priorityTag;
+            item->GetPacket()->RemovePacketTag(priorityTag);
+        }
+    }
+
+    // BQL accounting is performed once for the whole batch. As in Transmit, all the
+    // packets are assumed to be consumed by the device
+    if (devQueue)
+    {
+        devQueue->StartBatch();
+    }
+    m_sendBatch(m_batch);
+    if (devQueue)
+    {
+        devQueue->EndBatch();
+    }
+
+    quota -= m_batch.size();
+    m_batch.clear();
+
+    // if the queue disc is empty or the device queue is now stopped, return false so
+    // that the Run method does not attempt to dequeue other packets and exits
+    return !(GetNPackets() == 0 || (devQueue && devQueue->IsStopped()));
+}
+
 Ptr<QueueDiscItem>
 QueueDisc::DequeuePacket()
 {
@@ -19,6 +19,7 @@
 
 #include <functional>
 #include <map>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -367,6 +368,26 @@ class QueueDisc : public Object
      */
     SendCallback GetSendCallback() const;
 
+    /// Callback invoked to send a batch of packets to the receiving object when Run is called
+    typedef std::function<void(std::span<const Ptr<QueueDiscItem>>)> SendBatchCallback;
+
+    /**
+     * @param func the callback to send a batch of packets to the receiving object.
+     *
+     * Set the callback used by the Run method to send a batch of packets to the
+     * receiving object. Batches are only sent if the MaxBatchSize attribute is
+     * greater than one.
+     */
+    void SetSendBatchCallback(SendBatchCallback func);
+
+    /**
+     * @return the callback to send a batch of packets to the receiving object.
+     *
+     * Get the callback used by the Run method to send a batch of packets to the
+     * receiving object.
+     */
+    SendBatchCallback GetSendBatchCallback() const;
+
     /**
      * @brief Set the maximum number of dequeue operations following a packet enqueue
      * @param quota the maximum number of dequeue operations following a packet enqueue.
@@ -397,6 +418,24 @@ class QueueDisc : public Object
      */
     Ptr<QueueDiscItem> Dequeue();
 
+    /**
+     * Modelled after the Linux function try_bulk_dequeue_skb (net/sched/sch_generic.c)
+     * Dequeue packets (by calling Dequeue) and append them to the given batch,
+     * until maxPackets packets have been dequeued, the size of the dequeued
+     * packets reaches maxBytes or the queue disc is empty. At least one packet
+     * is dequeued, if available, regardless of its size. If the receiving object
+     * has multiple transmission queues, dequeuing also stops before a packet
+     * destined to a transmission queue other than that of the first packet.
+     *
+     * @param batch the vector the dequeued items are appended to
+     * @param maxPackets the maximum number of packets to dequeue
+     * @param maxBytes the number of bytes after which dequeuing stops
+     * @return the number of dequeued packets
+     */
+    std::size_t DequeueBatch(std::vector<Ptr<QueueDiscItem>>& batch,
+                             uint32_t maxPackets,
+                             uint32_t maxBytes);
+
     /**
      * Get a copy of the next packet the queue discipline will extract. This
      * function only calls the (private) DoPeek function. This base class provides
@@ -637,6 +676,17 @@ class QueueDisc : public Object
      */
     bool Restart();
 
+    /**
+     * Dequeue a batch of packets (by calling DequeueBatch) and send it to the device
+     * (by calling the send batch callback). The size of the batch is limited by the
+     * given quota, the MaxBatchSize attribute, the room in the device queue and the
+     * bytes allowed by the queue limits of the device queue, if any.
+     * @param quota the maximum number of packets that can be dequeued, which is
+     *        decreased by the number of packets sent to the device
+     * @return true if the device queue is not stopped and the queue disc is not empty
+     */
+    bool RestartBatch(uint32_t& quota);
+
     /**
      * Modelled after the Linux function dequeue_skb (net/sched/sch_generic.c)
      * @return the requeued packet, if any, or the packet dequeued by the queue disc, otherwise.
@@ -685,10 +735,13 @@ class QueueDisc : public Object
     TracedCallback<Time> m_sojourn;   //!< Sojourn time of the latest dequeued packet
     QueueSize m_maxSize;              //!< max queue size
 
-    Stats m_stats;    //!< The collected statistics
-    uint32_t m_quota; //!< Maximum number of packets dequeued in a qdisc run
+    Stats m_stats;           //!< The collected statistics
+    uint32_t m_quota;        //!< Maximum number of packets dequeued in a qdisc run
+    uint32_t m_maxBatchSize; //!< Maximum number of packets sent to the device at once
     Ptr<NetDeviceQueueInterface> m_devQueueIface; //!< NetDevice queue interface
     SendCallback m_send;           //!< Callback used to send a packet to the receiving object
+    SendBatchCallback m_sendBatch; //!< Callback used to send a batch of packets
+    std::vector<Ptr<QueueDiscItem>> m_batch; //!< The batch of packets being sent
     bool m_running;                //!< The queue disc is performing multiple dequeue operations
     Ptr<QueueDiscItem> m_requeued; //!< The last packet that failed to be transmitted
     bool m_peeked;                 //!< A packet was dequeued because Peek was called
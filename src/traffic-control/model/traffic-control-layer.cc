@@ -195,6 +195,8 @@ TrafficControlLayer::ScanDevices()
                 q->SetSendCallback([dev](Ptr<QueueDiscItem> item) {
                     dev->Send(item->GetPacket(), item->GetAddress(), item->GetProtocol());
                 });
+                q->SetSendBatchCallback(
+                    [dev](std::span<const Ptr<QueueDiscItem>> items) { dev->SendBatch(items); });
             }
         }
     }
@@ -259,6 +261,7 @@ TrafficControlLayer::DeleteRootQueueDiscOnDevice(Ptr<NetDevice> device)
     {
         q->SetNetDeviceQueueInterface(nullptr);
         q->SetSendCallback(nullptr);
+        q->SetSendBatchCallback(nullptr);
     }
     ndi->second.m_queueDiscsToWake.clear();
 
@@ -10,6 +10,7 @@
 #include "ns3/config.h"
 #include "ns3/data-rate.h"
 #include "ns3/double.h"
+#include "ns3/fifo-queue-disc.h"
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/node-container.h"
@@ -25,6 +26,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -87,8 +89,12 @@ class TcFlowControlTestCase : public TestCase
      * @param tt the test type
      * @param deviceQueueLength the queue length of the device
      * @param totalTxPackets the total number of packets to transmit
+     * @param maxBatchSize the maximum number of packets sent to the device at once
      */
-    TcFlowControlTestCase(QueueSizeUnit tt, uint32_t deviceQueueLength, uint32_t totalTxPackets);
+    TcFlowControlTestCase(QueueSizeUnit tt,
+                          uint32_t deviceQueueLength,
+                          uint32_t totalTxPackets,
+                          uint32_t maxBatchSize = 1);
     ~TcFlowControlTestCase() override;
 
   private:
@@ -123,15 +129,19 @@ class TcFlowControlTestCase : public TestCase
     QueueSizeUnit m_type;         //!< the test type
     uint32_t m_deviceQueueLength; //!< the queue length of the device
     uint32_t m_totalTxPackets;    //!< the toal number of packets to transmit
+    uint32_t m_maxBatchSize;      //!< the maximum number of packets sent to the device at once
 };
 
 TcFlowControlTestCase::TcFlowControlTestCase(QueueSizeUnit tt,
                                              uint32_t deviceQueueLength,
-                                             uint32_t totalTxPackets)
-    : TestCase("Test the operation of the flow control mechanism"),
+                                             uint32_t totalTxPackets,
+                                             uint32_t maxBatchSize)
+    : TestCase("Test the operation of the flow control mechanism (max batch size: " +
+               std::to_string(maxBatchSize) + ")"),
       m_type(tt),
       m_deviceQueueLength(deviceQueueLength),
-      m_totalTxPackets(totalTxPackets)
+      m_totalTxPackets(totalTxPackets),
+      m_maxBatchSize(maxBatchSize)
 {
 }
 
@@ -207,6 +217,9 @@ TcFlowControlTestCase::DoRun()
 
     TrafficControlHelper tch = TrafficControlHelper::Default();
     tch.Install(txDev);
+    n.Get(0)->GetObject<TrafficControlLayer>()->GetRootQueueDiscOnDevice(txDev)->SetAttribute(
+        "MaxBatchSize",
+        UintegerValue(m_maxBatchSize));
 
     // transmit 10 packets at time 0
     Simulator::Schedule(Seconds(0),
@@ -481,6 +494,69 @@ TcFlowControlTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Queue Disc Dequeue Batch Test Case
+ *
+ * Check that QueueDisc::DequeueBatch stops dequeuing packets when the maximum
+ * number of packets or bytes is reached or the queue disc is empty, and that
+ * at least one packet is dequeued regardless of its size.
+ */
+class QueueDiscDequeueBatchTestCase : public TestCase
+{
+  public:
+    QueueDiscDequeueBatchTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+QueueDiscDequeueBatchTestCase::QueueDiscDequeueBatchTestCase()
+    : TestCase("Test the dequeue of batches of packets from a queue disc")
+{
+}
+
+void
+QueueDiscDequeueBatchTestCase::DoRun()
+{
+    Ptr<QueueDisc> qdisc = CreateObjectWithAttributes<FifoQueueDisc>("MaxSize", StringValue("20p"));
+    qdisc->Initialize();
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        qdisc->Enqueue(Create<QueueDiscTestItem>(Create<Packet>(1000)));
+    }
+
+    std::vector<Ptr<QueueDiscItem>> batch;
+    NS_TEST_EXPECT_MSG_EQ(qdisc->DequeueBatch(batch, 4, 100000),
+                          4,
+                          "The batch must be limited by the maximum number of packets");
+    NS_TEST_EXPECT_MSG_EQ(batch.size(), 4, "The dequeued packets must be appended to the batch");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->GetNPackets(),
+                          6,
+                          "Unexpected number of packets in the queue disc");
+
+    NS_TEST_EXPECT_MSG_EQ(qdisc->DequeueBatch(batch, 10, 2500),
+                          3,
+                          "Dequeuing must stop after that the maximum number of bytes is reached");
+    NS_TEST_EXPECT_MSG_EQ(batch.size(), 7, "The dequeued packets must be appended to the batch");
+
+    NS_TEST_EXPECT_MSG_EQ(qdisc->DequeueBatch(batch, 10, 0),
+                          1,
+                          "At least one packet must be dequeued");
+
+    NS_TEST_EXPECT_MSG_EQ(qdisc->DequeueBatch(batch, 10, 100000),
+                          2,
+                          "Dequeuing must stop when the queue disc is empty");
+    NS_TEST_EXPECT_MSG_EQ(qdisc->DequeueBatch(batch, 10, 100000),
+                          0,
+                          "No packet can be dequeued from an empty queue disc");
+    NS_TEST_EXPECT_MSG_EQ(batch.size(), 10, "All the packets must have been dequeued");
+
+    qdisc->Dispose();
+}
+
 /**
  * @ingroup traffic-control-test
  *
@@ -515,5 +591,21 @@ static class TcFlowControlTestSuite : public TestSuite
         // also be made parametric.
         AddTestCase(new TcFlowControlTestCase(QueueSizeUnit::BYTES, 5000, 10),
                     TestCase::Duration::QUICK);
+
+        // the same invariants hold when the queue disc sends batches of packets to the device
+        for (uint32_t maxBatchSize : {2, 4, 64})
+        {
+            for (uint32_t deviceQueueLength : {1, 5, 9, 10, 11, 15})
+            {
+                AddTestCase(new TcFlowControlTestCase(QueueSizeUnit::PACKETS,
+                                                      deviceQueueLength,
+                                                      10,
+                                                      maxBatchSize),
+                            TestCase::Duration::QUICK);
+            }
+            AddTestCase(new TcFlowControlTestCase(QueueSizeUnit::BYTES, 5000, 10, maxBatchSize),
+                        TestCase::Duration::QUICK);
+        }
+        AddTestCase(new QueueDiscDequeueBatchTestCase(), TestCase::Duration::QUICK);
     }
 } g_tcFlowControlTestSuite; ///< the test suite
@@ -11,6 +11,7 @@
 #include "ap-wifi-mac.h"
 
 #include "amsdu-subframe-header.h"
+#include "beacon-digest-tag.h"
 #include "channel-access-manager.h"
 #include "gcr-manager.h"
 #include "mac-rx-middle.h"
@@ -27,6 +28,7 @@
 #include "ns3/ap-emlsr-manager.h"
 #include "ns3/eht-configuration.h"
 #include "ns3/eht-frame-exchange-manager.h"
+#include "ns3/hash.h"
 #include "ns3/he-configuration.h"
 #include "ns3/ht-configuration.h"
 #include "ns3/log.h"
@@ -74,6 +76,26 @@ ApWifiMac::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&ApWifiMac::SetBeaconGeneration),
                           MakeBooleanChecker())
+            .AddAttribute("AbstractBeacons",
+                          "Whether Beacon frames and FILS Discovery frames are abstracted. While "
+                          "the state of the AP determining the content of these frames does not "
+                          "change, they are transmitted as placeholder frames, which have the "
+                          "same size (hence occupy the same airtime) as the last frames sent in "
+                          "full, but carry no content. Beacon frames carry a digest of their "
+                          "content, which allows associated stations to skip the processing of "
+                          "the Beacon frames whose content did not change.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&ApWifiMac::m_abstractBeacons),
+                          MakeBooleanChecker())
+            .AddAttribute("FullBeaconPeriod",
+                          "In abstracted beacon mode, one Beacon frame every this number of "
+                          "Beacon frames is sent in full even if the state of the AP did not "
+                          "change, so that stations can discover the AP by passive scanning and "
+                          "learn about changes that do not affect the state of the AP checked "
+                          "before every Beacon frame (e.g., a change of the EDCA parameters).",
+                          UintegerValue(10),
+                          MakeUintegerAccessor(&ApWifiMac::m_fullBeaconPeriod),
+                          MakeUintegerChecker<uint32_t>(1))
             .AddAttribute("FdBeaconInterval6GHz",
                           "Time between a Beacon frame and a FILS Discovery (FD) frame or between "
                           "two FD frames to be sent on a 6GHz link. A value of zero disables the "
@@ -210,6 +232,9 @@ ApWifiMac::GetTimeAccessParamsChecker()
 
 ApWifiMac::ApWifiMac()
     : m_enableBeaconGeneration(false),
+      m_abstractBeacons(false),
+      m_fullBeaconPeriod(10),
+      m_nStaListChanges(0),
       m_grpAddrBuIndicExp(0)
 {
     NS_LOG_FUNCTION(this);
@@ -1446,6 +1471,7 @@ ApWifiMac::SetAid(MgtAssocResponseHeader& assoc, const LinkIdStaAddrMap& linkIdS
 
         if (const auto [it, inserted] = link.staList.emplace(aid, staAddr); inserted)
         {
+            m_nStaListChanges++;
             // the STA on this link had no AID assigned
             link.stationManager->SetAssociationId(staAddr, aid);
 
@@ -1559,7 +1585,78 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
     hdr.SetAddr3(link.feManager->GetAddress());
     hdr.SetDsNotFrom();
     hdr.SetDsNotTo();
-    Ptr<Packet> packet = Create<Packet>();
+    GetWifiRemoteStationManager(linkId)->SetShortPreambleEnabled(link.shortPreambleEnabled);
+    GetWifiRemoteStationManager(linkId)->SetShortSlotTimeEnabled(link.shortSlotTimeEnabled);
+
+    Ptr<Packet> packet;
+    if (!m_abstractBeacons)
+    {
+        packet = Create<Packet>();
+        packet->AddHeader(GetBeacon(linkId));
+    }
+    else if (auto state = GetBeaconState(linkId);
+             link.beaconState != state || link.nPlaceholders + 1 >= m_fullBeaconPeriod)
+    {
+        packet = Create<Packet>();
+        packet->AddHeader(GetBeacon(linkId));
+        // the digest covers the frame body, except for the Timestamp field, which has a
+        // different value in every Beacon frame. The digest is only computed for the Beacon
+        // frames sent in full, i.e., when the state of the AP changes and once every
+        // FullBeaconPeriod Beacon frames
+        constexpr std::size_t timestampSize = 8;
+        std::vector<uint8_t> buffer(packet->GetSize());
+        packet->CopyData(buffer.data(), buffer.size());
+        NS_ASSERT(buffer.size() > timestampSize);
+        link.beaconDigest = Hash32(reinterpret_cast<const char*>(buffer.data()) + timestampSize,
+                                   buffer.size() - timestampSize);
+        link.beaconSize = packet->GetSize();
+        link.nPlaceholders = 0;
+        if (link.beaconState != state)
+        {
+            // the content of the FILS Discovery frames may have changed as well
+            link.beaconState = std::move(state);
+            link.fdSize = 0;
+        }
+        packet->AddPacketTag(BeaconDigestTag(link.beaconDigest));
+    }
+    else
+    {
+        NS_LOG_DEBUG("State of the AP unchanged, send a placeholder Beacon frame");
+        link.nPlaceholders++;
+        packet = Create<Packet>(link.beaconSize);
+        packet->AddPacketTag(BeaconDigestTag(link.beaconDigest, true));
+    }
+
+    NS_LOG_INFO("Generating beacon from " << link.feManager->GetAddress() << " linkID " << +linkId);
+    // The beacon has it's own special queue, so we load it in there
+    m_beaconTxop->Queue(Create<WifiMpdu>(packet, hdr));
+    link.beaconEvent =
+        Simulator::Schedule(GetBeaconInterval(), &ApWifiMac::SendOneBeacon, this, linkId);
+
+    ScheduleFilsDiscOrUnsolProbeRespFrames(linkId);
+
+    // If a STA that does not support Short Slot Time associates,
+    // the AP shall use long slot time beginning at the first Beacon
+    // subsequent to the association of the long slot time STA.
+    if (GetErpSupported(linkId))
+    {
+        if (link.shortSlotTimeEnabled)
+        {
+            // Enable short slot time
+            GetWifiPhy(linkId)->SetSlot(MicroSeconds(9));
+        }
+        else
+        {
+            // Disable short slot time
+            GetWifiPhy(linkId)->SetSlot(MicroSeconds(20));
+        }
+    }
+}
+
+MgtBeaconHeader
+ApWifiMac::GetBeacon(uint8_t linkId)
+{
+    NS_LOG_FUNCTION(this << +linkId);
     MgtBeaconHeader beacon;
     beacon.Get<Ssid>() = GetSsid();
     auto supportedRates = GetSupportedRates(linkId);
@@ -1567,8 +1664,6 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
     beacon.Get<ExtendedSupportedRatesIE>() = supportedRates.extendedRates;
     beacon.SetBeaconIntervalUs(GetBeaconInterval().GetMicroSeconds());
     beacon.Capabilities() = GetCapabilities(linkId);
-    GetWifiRemoteStationManager(linkId)->SetShortPreambleEnabled(link.shortPreambleEnabled);
-    GetWifiRemoteStationManager(linkId)->SetShortSlotTimeEnabled(link.shortSlotTimeEnabled);
     if (GetDsssSupported(linkId))
     {
         beacon.Get<DsssParameterSet>() = GetDsssParameterSet(linkId);
@@ -1634,36 +1729,25 @@ ApWifiMac::SendOneBeacon(uint8_t linkId)
             beacon.Get<MultiLinkElement>() = GetMultiLinkElement(linkId, WIFI_MAC_MGT_BEACON);
         }
     }
-    packet->AddHeader(beacon);
-
-    NS_LOG_INFO("Generating beacon from " << link.feManager->GetAddress() << " linkID " << +linkId);
-    // The beacon has it's own special queue, so we load it in there
-    m_beaconTxop->Queue(Create<WifiMpdu>(packet, hdr));
-    link.beaconEvent =
-        Simulator::Schedule(GetBeaconInterval(), &ApWifiMac::SendOneBeacon, this, linkId);
-
-    ScheduleFilsDiscOrUnsolProbeRespFrames(linkId);
+    return beacon;
+}
 
-    // If a STA that does not support Short Slot Time associates,
-    // the AP shall use long slot time beginning at the first Beacon
-    // subsequent to the association of the long slot time STA.
-    if (GetErpSupported(linkId))
-    {
-        if (link.shortSlotTimeEnabled)
-        {
-            // Enable short slot time
-            GetWifiPhy(linkId)->SetSlot(MicroSeconds(9));
-        }
-        else
-        {
-            // Disable short slot time
-            GetWifiPhy(linkId)->SetSlot(MicroSeconds(20));
-        }
-    }
+ApWifiMac::BeaconState
+ApWifiMac::GetBeaconState(uint8_t linkId) const
+{
+    const auto& link = GetLink(linkId);
+    return {.ssid = GetSsid().PeekString(),
+            .beaconInterval = GetBeaconInterval(),
+            .channel = link.phy->GetOperatingChannel(),
+            .nStaListChanges = m_nStaListChanges,
+            .numNonHtStations = link.numNonHtStations,
+            .numNonErpStations = link.numNonErpStations,
+            .shortSlotTimeEnabled = link.shortSlotTimeEnabled,
+            .shortPreambleEnabled = link.shortPreambleEnabled};
 }
 
 Ptr<WifiMpdu>
-ApWifiMac::GetFilsDiscovery(uint8_t linkId) const
+ApWifiMac::GetFilsDiscovery(uint8_t linkId, bool placeholder) const
 {
     WifiMacHeader hdr(WIFI_MAC_MGT_ACTION);
     hdr.SetAddr1(Mac48Address::GetBroadcast());
@@ -1678,6 +1762,15 @@ ApWifiMac::GetFilsDiscovery(uint8_t linkId) const
     action.publicAction = WifiActionHeader::FILS_DISCOVERY;
     actionHdr.SetAction(WifiActionHeader::PUBLIC, action);
 
+    if (placeholder)
+    {
+        NS_ASSERT(link.fdSize > actionHdr.GetSerializedSize());
+        auto packet = Create<Packet>(link.fdSize - actionHdr.GetSerializedSize());
+        packet->AddHeader(actionHdr);
+        packet->AddPacketTag(BeaconDigestTag(link.beaconDigest, true));
+        return Create<WifiMpdu>(packet, hdr);
+    }
+
     FilsDiscHeader fils;
     fils.SetSsid(GetSsid().PeekString());
     fils.m_beaconInt = (m_beaconInterval / WIFI_TU).GetHigh();
@@ -1698,6 +1791,27 @@ ApWifiMac::GetFilsDiscovery(uint8_t linkId) const
     return Create<WifiMpdu>(packet, hdr);
 }
 
+void
+ApWifiMac::SendFilsDiscovery(uint8_t linkId)
+{
+    NS_LOG_FUNCTION(this << +linkId);
+    auto& link = GetLink(linkId);
+
+    if (m_abstractBeacons && link.fdSize > 0 && link.beaconState == GetBeaconState(linkId))
+    {
+        NS_LOG_DEBUG("State of the AP unchanged, send a placeholder FILS Discovery frame");
+        m_beaconTxop->Queue(GetFilsDiscovery(linkId, true));
+        return;
+    }
+
+    auto mpdu = GetFilsDiscovery(linkId);
+    if (m_abstractBeacons && link.beaconState == GetBeaconState(linkId))
+    {
+        link.fdSize = mpdu->GetPacket()->GetSize();
+    }
+    m_beaconTxop->Queue(mpdu);
+}
+
 void
 ApWifiMac::ScheduleFilsDiscOrUnsolProbeRespFrames(uint8_t linkId)
 {
@@ -1728,7 +1842,9 @@ ApWifiMac::ScheduleFilsDiscOrUnsolProbeRespFrames(uint8_t linkId)
         else
         {
             Simulator::Schedule(fdBeaconInterval * count,
-                                [=, this]() { m_beaconTxop->Queue(GetFilsDiscovery(linkId)); });
+                                &ApWifiMac::SendFilsDiscovery,
+                                this,
+                                linkId);
         }
     }
 }
@@ -1865,7 +1981,7 @@ ApWifiMac::TxFailed(WifiMacDropReason timeoutReason, Ptr<const WifiMpdu> mpdu)
         for (const auto& [id, lnk] : GetLinks())
         {
             auto& link = GetLink(id);
-            link.staList.erase(aid);
+            m_nStaListChanges += link.staList.erase(aid);
         }
     }
 }
@@ -2112,6 +2228,7 @@ ApWifiMac::Receive(Ptr<const WifiMpdu> mpdu, uint8_t linkId)
                     if (it->second == from)
                     {
                         staList.erase(it);
+                        m_nStaListChanges++;
                         m_deAssocLogger(it->first, it->second);
                         if (GetWifiRemoteStationManager(linkId)->GetDsssSupported(from) &&
                             !GetWifiRemoteStationManager(linkId)->GetErpOfdmSupported(from))
@@ -13,11 +13,14 @@
 
 #include "wifi-mac-header.h"
 #include "wifi-mac.h"
+#include "wifi-phy-operating-channel.h"
 
 #include "ns3/attribute-container.h"
 #include "ns3/enum.h"
 #include "ns3/pair.h"
 
+#include <optional>
+#include <string>
 #include <unordered_map>
 #include <variant>
 
@@ -260,6 +263,30 @@ class ApWifiMac : public WifiMac
     static Ptr<const AttributeChecker> GetTimeAccessParamsChecker();
 
   protected:
+    /**
+     * The state of the AP determining the content of the Beacon frames sent on a link. In
+     * abstracted beacon mode, a change in this state causes the next Beacon frame to be sent
+     * in full.
+     */
+    struct BeaconState
+    {
+        std::string ssid;                //!< the SSID
+        Time beaconInterval;             //!< the beacon interval
+        WifiPhyOperatingChannel channel; //!< the operating channel of the link
+        uint64_t nStaListChanges;        //!< the number of changes to the lists of associated
+                                         //!< stations (on all the links)
+        uint16_t numNonHtStations;       //!< the number of non-HT stations associated on the link
+        uint16_t numNonErpStations;      //!< the number of non-ERP stations associated on the link
+        bool shortSlotTimeEnabled;       //!< whether short slot time is enabled on the link
+        bool shortPreambleEnabled;       //!< whether short preamble is enabled on the link
+
+        /**
+         * @param other another state
+         * @return whether the two states are equal
+         */
+        bool operator==(const BeaconState& other) const = default;
+    };
+
     /**
      * Structure holding information specific to a single link. Here, the meaning of
      * "link" is that of the 11be amendment which introduced multi-link devices. For
@@ -279,6 +306,15 @@ class ApWifiMac : public WifiMac
         bool shortSlotTimeEnabled{
             false}; //!< Flag whether short slot time is enabled within the BSS
         bool shortPreambleEnabled{false}; //!< Flag whether short preamble is enabled in the BSS
+
+        std::optional<BeaconState> beaconState; //!< the state of the AP when the last full Beacon
+                                                //!< frame was generated (abstracted beacon mode)
+        uint32_t beaconSize{0};    //!< the size of the body of the last full Beacon frame
+        uint32_t beaconDigest{0};  //!< the digest of the content of the last full Beacon frame
+        uint32_t nPlaceholders{0}; //!< the number of placeholder Beacon frames sent since the
+                                   //!< last full Beacon frame
+        uint32_t fdSize{0}; //!< the size of the body of the last full FILS Discovery frame, or 0
+                            //!< if none was sent since the last change of the state of the AP
     };
 
     /**
@@ -471,12 +507,40 @@ class ApWifiMac : public WifiMac
     void SendOneBeacon(uint8_t linkId);
 
     /**
-     * Get the FILS Discovery frame to send on the given link.
+     * Get the Beacon frame to send on the given link.
      *
      * @param linkId the ID of the given link
+     * @return the Beacon frame to send on the given link
+     */
+    MgtBeaconHeader GetBeacon(uint8_t linkId);
+
+    /**
+     * @param linkId the ID of the given link
+     * @return the current state of the AP determining the content of the Beacon frames sent on
+     *         the given link
+     */
+    BeaconState GetBeaconState(uint8_t linkId) const;
+
+    /**
+     * Get the FILS Discovery frame to send on the given link. If <i>placeholder</i> is true,
+     * the body of the FILS Discovery frame (after the Action field) is replaced by zeros, so
+     * that the frame has the same size as the last FILS Discovery frame sent in full on the
+     * given link.
+     *
+     * @param linkId the ID of the given link
+     * @param placeholder whether to return a placeholder FILS Discovery frame
      * @return the FILS Discovery frame to send on the given link
      */
-    Ptr<WifiMpdu> GetFilsDiscovery(uint8_t linkId) const;
+    Ptr<WifiMpdu> GetFilsDiscovery(uint8_t linkId, bool placeholder = false) const;
+
+    /**
+     * Enqueue a FILS Discovery frame to send on the given link. In abstracted beacon mode,
+     * a placeholder FILS Discovery frame is enqueued if the state of the AP did not change
+     * since the last FILS Discovery frame sent in full.
+     *
+     * @param linkId the ID of the given link
+     */
+    void SendFilsDiscovery(uint8_t linkId);
 
     /**
      * Schedule the transmission of FILS Discovery frames or unsolicited Probe Response frames
@@ -654,6 +718,10 @@ class ApWifiMac : public WifiMac
     Ptr<UniformRandomVariable>
         m_beaconJitter; //!< UniformRandomVariable used to randomize the time of the first beacon
     bool m_enableBeaconJitter; //!< Flag whether the first beacon should be generated at random time
+    bool m_abstractBeacons;    //!< Flag whether beacons are abstracted
+    uint32_t m_fullBeaconPeriod; //!< in abstracted beacon mode, one Beacon frame every this
+                                 //!< number of Beacon frames is sent in full
+    uint64_t m_nStaListChanges;  //!< number of changes to the lists of associated stations
     bool m_enableNonErpProtection; //!< Flag whether protection mechanism is used or not when
                                    //!< non-ERP STAs are present within the BSS
     Time m_bsrLifetime;            //!< Lifetime of Buffer Status Reports
@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "beacon-digest-tag.h"
+
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(BeaconDigestTag);
+
+TypeId
+BeaconDigestTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::BeaconDigestTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("Wifi")
+                            .AddConstructor<BeaconDigestTag>()
+                            .AddAttribute("Digest",
+                                          "The digest of the content of the Beacon frame",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(&BeaconDigestTag::Get),
+                                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+TypeId
+BeaconDigestTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+BeaconDigestTag::BeaconDigestTag()
+    : m_digest(0),
+      m_placeholder(false)
+{
+}
+
+BeaconDigestTag::BeaconDigestTag(uint32_t digest, bool placeholder)
+    : m_digest(digest),
+      m_placeholder(placeholder)
+{
+}
+
+uint32_t
+BeaconDigestTag::GetSerializedSize() const
+{
+    return sizeof(uint32_t) + sizeof(uint8_t);
+}
+
+void
+BeaconDigestTag::Serialize(TagBuffer i) const
+{
+    i.WriteU32(m_digest);
+    i.WriteU8(m_placeholder ? 1 : 0);
+}
+
+void
+BeaconDigestTag::Deserialize(TagBuffer i)
+{
+    m_digest = i.ReadU32();
+    m_placeholder = (i.ReadU8() == 1);
+}
+
+void
+BeaconDigestTag::Print(std::ostream& os) const
+{
+    os << "Digest=" << m_digest << " Placeholder=" << m_placeholder;
+}
+
+void
+BeaconDigestTag::Set(uint32_t digest)
+{
+    m_digest = digest;
+}
+
+uint32_t
+BeaconDigestTag::Get() const
+{
+    return m_digest;
+}
+
+bool
+BeaconDigestTag::IsPlaceholder() const
+{
+    return m_placeholder;
+}
+
+} // namespace ns3
@@ -0,0 +1,78 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BEACON_DIGEST_TAG_H
+#define BEACON_DIGEST_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * @ingroup wifi
+ *
+ * A tag attached by an AP operating in abstracted beacon mode to the Beacon frames and the
+ * placeholder FILS Discovery frames it transmits. The tag carries a digest of the content of
+ * the last Beacon frame sent in full (excluding the Timestamp field), which allows an
+ * associated station to detect that the content of a received Beacon frame did not change
+ * since the last Beacon frame it processed, and hence to skip the deserialization and the
+ * processing of the Beacon frame. The tag also indicates whether the frame is a placeholder,
+ * i.e., a frame of the same size as the frame sent in full but carrying no content, which
+ * must not be deserialized.
+ */
+class BeaconDigestTag : public Tag
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * Create a BeaconDigestTag with a null digest
+     */
+    BeaconDigestTag();
+
+    /**
+     * Create a BeaconDigestTag with the given digest
+     *
+     * @param digest the digest of the content of the Beacon frame
+     * @param placeholder whether the frame carrying the tag is a placeholder
+     */
+    BeaconDigestTag(uint32_t digest, bool placeholder = false);
+
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+    void Print(std::ostream& os) const override;
+
+    /**
+     * Set the digest of the content of the Beacon frame.
+     *
+     * @param digest the digest of the content of the Beacon frame
+     */
+    void Set(uint32_t digest);
+    /**
+     * Return the digest of the content of the Beacon frame.
+     *
+     * @return the digest of the content of the Beacon frame
+     */
+    uint32_t Get() const;
+
+    /**
+     * @return whether the frame carrying the tag is a placeholder
+     */
+    bool IsPlaceholder() const;
+
+  private:
+    uint32_t m_digest;  //!< digest of the content of the Beacon frame
+    bool m_placeholder; //!< whether the frame carrying the tag is a placeholder
+};
+
+} // namespace ns3
+
+#endif /* BEACON_DIGEST_TAG_H */
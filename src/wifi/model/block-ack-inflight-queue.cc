@@ -0,0 +1,178 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "block-ack-inflight-queue.h"
+
+#include "wifi-mpdu.h"
+#include "wifi-utils.h"
+
+#include "ns3/assert.h"
+
+namespace ns3
+{
+
+BlockAckInflightQueue::iterator
+BlockAckInflightQueue::begin()
+{
+    return m_mpdus.begin();
+}
+
+BlockAckInflightQueue::iterator
+BlockAckInflightQueue::end()
+{
+    return m_mpdus.end();
+}
+
+BlockAckInflightQueue::const_iterator
+BlockAckInflightQueue::begin() const
+{
+    return m_mpdus.begin();
+}
+
+BlockAckInflightQueue::const_iterator
+BlockAckInflightQueue::end() const
+{
+    return m_mpdus.end();
+}
+
+BlockAckInflightQueue::reverse_iterator
+BlockAckInflightQueue::rbegin()
+{
+    return m_mpdus.rbegin();
+}
+
+BlockAckInflightQueue::reverse_iterator
+BlockAckInflightQueue::rend()
+{
+    return m_mpdus.rend();
+}
+
+std::size_t
+BlockAckInflightQueue::size() const
+{
+    return m_mpdus.size();
+}
+
+bool
+BlockAckInflightQueue::empty() const
+{
+    return m_mpdus.empty();
+}
+
+std::size_t
+BlockAckInflightQueue::GetTableSize() const
+{
+    return m_table.size();
+}
+
+bool
+BlockAckInflightQueue::Index(iterator pos)
+{
+    const auto seqNumber = (*pos)->GetHeader().GetSequenceNumber();
+    auto& entry = m_table[seqNumber & (m_table.size() - 1)];
+
+    if (!entry.has_value())
+    {
+        entry = pos;
+        return true;
+    }
+    if ((**entry)->GetHeader().GetSequenceNumber() != seqNumber)
+    {
+        return false;
+    }
+    // MPDUs with the same sequence number are adjacent; the entry must point to the first one
+    if (std::next(pos) == *entry)
+    {
+        entry = pos;
+    }
+    return true;
+}
+
+void
+BlockAckInflightQueue::Rebuild(std::size_t size)
+{
+    for (bool collision = true; collision; size *= 2)
+    {
+        m_table.assign(size, std::nullopt);
+        collision = false;
+        // the table entry of every sequence number is set when the first MPDU having
+        // that sequence number is visited
+        for (auto it = m_mpdus.begin(); it != m_mpdus.end(); ++it)
+        {
+            const auto seqNumber = (*it)->GetHeader().GetSequenceNumber();
+            if (auto& entry = m_table[seqNumber & (size - 1)]; !entry.has_value())
+            {
+                entry = it;
+            }
+            else if ((**entry)->GetHeader().GetSequenceNumber() != seqNumber)
+            {
+                NS_ASSERT_MSG(size < SEQNO_SPACE_SIZE, "No collision expected");
+                collision = true;
+                break;
+            }
+        }
+    }
+}
+
+BlockAckInflightQueue::iterator
+BlockAckInflightQueue::insert(const_iterator pos, Ptr<WifiMpdu> mpdu)
+{
+    auto it = m_mpdus.insert(pos, mpdu);
+
+    if (m_table.empty())
+    {
+        Rebuild(MIN_TABLE_SIZE);
+    }
+    else if (!Index(it))
+    {
+        Rebuild(m_table.size() * 2);
+    }
+    return it;
+}
+
+BlockAckInflightQueue::iterator
+BlockAckInflightQueue::erase(iterator pos)
+{
+    const auto seqNumber = (*pos)->GetHeader().GetSequenceNumber();
+    auto& entry = m_table[seqNumber & (m_table.size() - 1)];
+    const bool indexed = (entry == pos);
+    auto next = m_mpdus.erase(pos);
+
+    if (indexed)
+    {
+        if (next != m_mpdus.end() && (*next)->GetHeader().GetSequenceNumber() == seqNumber)
+        {
+            entry = next;
+        }
+        else
+        {
+            entry.reset();
+        }
+    }
+    return next;
+}
+
+void
+BlockAckInflightQueue::clear()
+{
+    m_mpdus.clear();
+    m_table.clear();
+}
+
+BlockAckInflightQueue::iterator
+BlockAckInflightQueue::Find(uint16_t seqNumber)
+{
+    if (m_table.empty())
+    {
+        return m_mpdus.end();
+    }
+    if (const auto& entry = m_table[seqNumber & (m_table.size() - 1)];
+        entry.has_value() && (**entry)->GetHeader().GetSequenceNumber() == seqNumber)
+    {
+        return *entry;
+    }
+    return m_mpdus.end();
+}
+
+} // namespace ns3
@@ -0,0 +1,134 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BLOCK_ACK_INFLIGHT_QUEUE_H
+#define BLOCK_ACK_INFLIGHT_QUEUE_H
+
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <vector>
+
+namespace ns3
+{
+
+class WifiMpdu;
+
+/**
+ * @ingroup wifi
+ * @brief Queue of the in flight MPDUs of an originator block ack agreement
+ *
+ * This class stores the MPDUs that have been transmitted under an originator block ack
+ * agreement and are waiting to be acknowledged. MPDUs are kept in a list sorted by
+ * sequence number (relative to the starting sequence number of the agreement) and
+ * fragment number, so that the MPDUs having the same sequence number are adjacent.
+ *
+ * In addition, this class maintains a table indexed by sequence number (modulo the
+ * table size) that points to the first MPDU in the list having a given sequence
+ * number, so that an in flight MPDU can be found in constant time. The table size
+ * is a power of two that is initially small and is doubled (up to the size of the
+ * sequence number space) whenever two MPDUs with distinct sequence numbers would be
+ * mapped to the same entry of the table.
+ */
+class BlockAckInflightQueue
+{
+  public:
+    /// the list storing the in flight MPDUs
+    using List = std::list<Ptr<WifiMpdu>>;
+    /// iterator type
+    using iterator = List::iterator;
+    /// const iterator type
+    using const_iterator = List::const_iterator;
+    /// reverse iterator type
+    using reverse_iterator = List::reverse_iterator;
+
+    BlockAckInflightQueue() = default;
+    BlockAckInflightQueue(const BlockAckInflightQueue&) = delete;
+    BlockAckInflightQueue& operator=(const BlockAckInflightQueue&) = delete;
+    /// Move constructor (iterators to the stored MPDUs remain valid)
+    BlockAckInflightQueue(BlockAckInflightQueue&&) = default;
+    /// Move assignment operator (iterators to the stored MPDUs remain valid)
+    /// @return a reference to this object
+    BlockAckInflightQueue& operator=(BlockAckInflightQueue&&) = default;
+
+    /// @return an iterator to the first MPDU
+    iterator begin();
+    /// @return an iterator past the last MPDU
+    iterator end();
+    /// @return a const iterator to the first MPDU
+    const_iterator begin() const;
+    /// @return a const iterator past the last MPDU
+    const_iterator end() const;
+    /// @return a reverse iterator to the last MPDU
+    reverse_iterator rbegin();
+    /// @return a reverse iterator before the first MPDU
+    reverse_iterator rend();
+
+    /// @return the number of in flight MPDUs
+    std::size_t size() const;
+    /// @return whether there is no in flight MPDU
+    bool empty() const;
+
+    /**
+     * Insert the given MPDU before the given position. The caller must ensure that
+     * the list stays sorted.
+     *
+     * @param pos the given position
+     * @param mpdu the given MPDU
+     * @return an iterator to the inserted MPDU
+     */
+    iterator insert(const_iterator pos, Ptr<WifiMpdu> mpdu);
+    /**
+     * Remove the MPDU at the given position.
+     *
+     * @param pos the given position
+     * @return an iterator to the MPDU following the removed one
+     */
+    iterator erase(iterator pos);
+    /**
+     * Remove all the MPDUs.
+     */
+    void clear();
+
+    /**
+     * Get an iterator to the first MPDU having the given sequence number.
+     *
+     * @param seqNumber the given sequence number
+     * @return an iterator to the first MPDU having the given sequence number, if any,
+     *         or end(), otherwise
+     */
+    iterator Find(uint16_t seqNumber);
+
+    /// @return the current size of the table indexed by sequence number
+    std::size_t GetTableSize() const;
+
+  private:
+    /**
+     * Resize the table indexed by sequence number to the given size and populate it
+     * again. The table is further doubled in size until there is no collision.
+     *
+     * @param size the new size of the table
+     */
+    void Rebuild(std::size_t size);
+    /**
+     * Add the MPDU at the given position to the table indexed by sequence number, if
+     * it is the first MPDU having that sequence number.
+     *
+     * @param pos the given position
+     * @return false if the table entry corresponding to the sequence number of the MPDU
+     *         points to an MPDU having a different sequence number, true otherwise
+     */
+    bool Index(iterator pos);
+
+    static constexpr std::size_t MIN_TABLE_SIZE = 64; //!< initial size of the table
+
+    List m_mpdus;                              //!< the in flight MPDUs
+    std::vector<std::optional<iterator>> m_table; //!< table indexed by sequence number
+};
+
+} // namespace ns3
+
+#endif /* BLOCK_ACK_INFLIGHT_QUEUE_H */
@@ -528,14 +528,11 @@ BlockAckManager::NotifyGotAck(uint8_t linkId, Ptr<const WifiMpdu> mpdu)
     }
 
     // remove the acknowledged frame from the queue of outstanding packets
-    for (auto queueIt = it->second.second.begin(); queueIt != it->second.second.end(); ++queueIt)
+    if (auto queueIt = it->second.second.Find(mpdu->GetHeader().GetSequenceNumber());
+        queueIt != it->second.second.end())
     {
-        if ((*queueIt)->GetHeader().GetSequenceNumber() == mpdu->GetHeader().GetSequenceNumber())
-        {
-            m_queue->DequeueIfQueued({*queueIt});
-            HandleInFlightMpdu(linkId, queueIt, ACKNOWLEDGED, it, Simulator::Now());
-            break;
-        }
+        m_queue->DequeueIfQueued({*queueIt});
+        HandleInFlightMpdu(linkId, queueIt, ACKNOWLEDGED, it, Simulator::Now());
     }
 }
 
@@ -571,13 +568,10 @@ BlockAckManager::NotifyMissedAck(uint8_t linkId, Ptr<WifiMpdu> mpdu)
 
     // remove the frame from the queue of outstanding packets (it will be re-inserted
     // if retransmitted)
-    for (auto queueIt = it->second.second.begin(); queueIt != it->second.second.end(); ++queueIt)
+    if (auto queueIt = it->second.second.Find(mpdu->GetHeader().GetSequenceNumber());
+        queueIt != it->second.second.end())
     {
-        if ((*queueIt)->GetHeader().GetSequenceNumber() == mpdu->GetHeader().GetSequenceNumber())
-        {
-            HandleInFlightMpdu(linkId, queueIt, TO_RETRANSMIT, it, Simulator::Now());
-            break;
-        }
+        HandleInFlightMpdu(linkId, queueIt, TO_RETRANSMIT, it, Simulator::Now());
     }
 }
 
@@ -9,6 +9,7 @@
 #ifndef BLOCK_ACK_MANAGER_H
 #define BLOCK_ACK_MANAGER_H
 
+#include "block-ack-inflight-queue.h"
 #include "block-ack-type.h"
 #include "gcr-manager.h"
 #include "originator-block-ack-agreement.h"
@@ -571,13 +572,13 @@ class BlockAckManager : public Object
                        std::optional<Mac48Address> gcrGroupAddr = std::nullopt);
 
     /**
-     * typedef for a list of WifiMpdu.
+     * typedef for the queue of in flight MPDUs.
      */
-    using PacketQueue = std::list<Ptr<WifiMpdu>>;
+    using PacketQueue = BlockAckInflightQueue;
     /**
      * typedef for an iterator for PacketQueue.
      */
-    using PacketQueueI = std::list<Ptr<WifiMpdu>>::iterator;
+    using PacketQueueI = BlockAckInflightQueue::iterator;
 
     /// AgreementKey-indexed map of originator block ack agreements
     using OriginatorAgreements =
@@ -12,13 +12,48 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <bit>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("BlockAckWindow");
 
+BlockAckWindow::Reference::Reference(uint64_t& word, uint64_t mask)
+    : m_word(word),
+      m_mask(mask)
+{
+}
+
+BlockAckWindow::Reference::operator bool() const
+{
+    return (m_word & m_mask) != 0;
+}
+
+BlockAckWindow::Reference&
+BlockAckWindow::Reference::operator=(bool value)
+{
+    if (value)
+    {
+        m_word |= m_mask;
+    }
+    else
+    {
+        m_word &= ~m_mask;
+    }
+    return *this;
+}
+
+BlockAckWindow::Reference&
+BlockAckWindow::Reference::operator=(const Reference& other)
+{
+    return *this = static_cast<bool>(other);
+}
+
 BlockAckWindow::BlockAckWindow()
     : m_winStart(0),
+      m_winSize(0),
       m_head(0)
 {
 }
@@ -28,14 +63,15 @@ BlockAckWindow::Init(uint16_t winStart, uint16_t winSize)
 {
     NS_LOG_FUNCTION(this << winStart << winSize);
     m_winStart = winStart;
-    m_window.assign(winSize, false);
+    m_winSize = winSize;
+    m_bits.assign((winSize + WORD_SIZE - 1) / WORD_SIZE, 0);
     m_head = 0;
 }
 
 void
 BlockAckWindow::Reset(uint16_t winStart)
 {
-    Init(winStart, m_window.size());
+    Init(winStart, m_winSize);
 }
 
 uint16_t
@@ -47,29 +83,31 @@ BlockAckWindow::GetWinStart() const
 uint16_t
 BlockAckWindow::GetWinEnd() const
 {
-    return (m_winStart + m_window.size() - 1) % SEQNO_SPACE_SIZE;
+    return (m_winStart + m_winSize - 1) % SEQNO_SPACE_SIZE;
 }
 
 std::size_t
 BlockAckWindow::GetWinSize() const
 {
-    return m_window.size();
+    return m_winSize;
 }
 
-std::vector<bool>::reference
+BlockAckWindow::Reference
 BlockAckWindow::At(std::size_t distance)
 {
-    NS_ASSERT(distance < m_window.size());
+    NS_ASSERT(distance < m_winSize);
 
-    return m_window.at((m_head + distance) % m_window.size());
+    auto index = (m_head + distance) % m_winSize;
+    return Reference(m_bits[index / WORD_SIZE], uint64_t{1} << (index % WORD_SIZE));
 }
 
-std::vector<bool>::const_reference
+bool
 BlockAckWindow::At(std::size_t distance) const
 {
-    NS_ASSERT(distance < m_window.size());
+    NS_ASSERT(distance < m_winSize);
 
-    return m_window.at((m_head + distance) % m_window.size());
+    auto index = (m_head + distance) % m_winSize;
+    return (m_bits[index / WORD_SIZE] >> (index % WORD_SIZE)) & 1;
 }
 
 void
@@ -77,18 +115,112 @@ BlockAckWindow::Advance(std::size_t count)
 {
     NS_LOG_FUNCTION(this << count);
 
-    if (count >= m_window.size())
+    if (count >= m_winSize)
     {
         Reset((m_winStart + count) % SEQNO_SPACE_SIZE);
         return;
     }
 
-    for (std::size_t i = 0; i < count; i++)
+    if (auto tail = m_head + count; tail <= m_winSize)
+    {
+        Clear(m_head, tail);
+        m_head = tail % m_winSize;
+    }
+    else
     {
-        m_window[m_head] = false;
-        m_head = (m_head + 1) % m_window.size();
+        Clear(m_head, m_winSize);
+        Clear(0, tail - m_winSize);
+        m_head = tail - m_winSize;
     }
     m_winStart = (m_winStart + count) % SEQNO_SPACE_SIZE;
 }
 
+std::size_t
+BlockAckWindow::FindFirstSet(std::size_t from) const
+{
+    return FindFrom(true, from);
+}
+
+std::size_t
+BlockAckWindow::FindFirstUnset(std::size_t from) const
+{
+    return FindFrom(false, from);
+}
+
+std::size_t
+BlockAckWindow::Count() const
+{
+    std::size_t count = 0;
+    for (const auto word : m_bits)
+    {
+        count += std::popcount(word);
+    }
+    return count;
+}
+
+std::size_t
+BlockAckWindow::FindFrom(bool value, std::size_t from) const
+{
+    if (from >= m_winSize)
+    {
+        return m_winSize;
+    }
+
+    // the window is split into two ranges of the bitmap: [m_head, m_winSize) and [0, m_head)
+    auto first = (m_head + from) % m_winSize;
+    auto last = (first >= m_head ? m_winSize : m_head);
+
+    if (auto index = Find(value, first, last); index < last)
+    {
+        return (index + m_winSize - m_head) % m_winSize;
+    }
+    if (first >= m_head && m_head > 0)
+    {
+        if (auto index = Find(value, 0, m_head); index < m_head)
+        {
+            return index + m_winSize - m_head;
+        }
+    }
+    return m_winSize;
+}
+
+std::size_t
+BlockAckWindow::Find(bool value, std::size_t first, std::size_t last) const
+{
+    NS_ASSERT(first <= last && last <= m_winSize);
+
+    auto wordIdx = first / WORD_SIZE;
+    // mask out the bits preceding the first element in the first word
+    auto mask = ~uint64_t{0} << (first % WORD_SIZE);
+
+    while (wordIdx * WORD_SIZE < last)
+    {
+        auto word = (value ? m_bits[wordIdx] : ~m_bits[wordIdx]) & mask;
+        if (word != 0)
+        {
+            auto index = wordIdx * WORD_SIZE + std::countr_zero(word);
+            return std::min(index, last);
+        }
+        mask = ~uint64_t{0};
+        ++wordIdx;
+    }
+    return last;
+}
+
+void
+BlockAckWindow::Clear(std::size_t first, std::size_t last)
+{
+    NS_ASSERT(first <= last && last <= m_winSize);
+
+    while (first < last)
+    {
+        auto wordIdx = first / WORD_SIZE;
+        auto offset = first % WORD_SIZE;
+        auto nBits = std::min(WORD_SIZE - offset, last - first);
+        auto mask = (nBits == WORD_SIZE ? ~uint64_t{0} : ((uint64_t{1} << nBits) - 1) << offset);
+        m_bits[wordIdx] &= ~mask;
+        first += nBits;
+    }
+}
+
 } // namespace ns3
@@ -24,10 +24,12 @@ namespace ns3
  * a given number of positions. This class can be used to implement both
  * an originator's window and a recipient's window.
  *
- * The window is implemented as a vector of bool and managed as a circular
- * queue. The window is moved forward by advancing the head of the queue and
- * clearing the elements that become part of the tail of the queue. Hence,
- * no element is required to be shifted when the window moves forward.
+ * The window is implemented as a bitmap packed into 64-bit words and managed as
+ * a circular queue. The window is moved forward by advancing the head of the queue
+ * and clearing the elements that become part of the tail of the queue. Hence,
+ * no element is required to be shifted when the window moves forward. Clearing
+ * elements and searching for the first set (or unset) element operate on a whole
+ * word at a time.
  *
  * Example:
  *
@@ -46,6 +48,43 @@ namespace ns3
 class BlockAckWindow
 {
   public:
+    /**
+     * Proxy class to access (and modify) an element of the window.
+     */
+    class Reference
+    {
+      public:
+        /**
+         * Constructor
+         *
+         * @param word the word storing the element
+         * @param mask the mask selecting the element in the word
+         */
+        Reference(uint64_t& word, uint64_t mask);
+        /**
+         * @return whether the element is set
+         */
+        operator bool() const;
+        /**
+         * Set or clear the element.
+         *
+         * @param value whether to set the element
+         * @return a reference to this object
+         */
+        Reference& operator=(bool value);
+        /**
+         * Set or clear the element based on the value of another element.
+         *
+         * @param other the other element
+         * @return a reference to this object
+         */
+        Reference& operator=(const Reference& other);
+
+      private:
+        uint64_t& m_word; ///< the word storing the element
+        uint64_t m_mask;  ///< the mask selecting the element in the word
+    };
+
     /**
      * Constructor
      */
@@ -91,28 +130,83 @@ class BlockAckWindow
      * @return a reference to the element in the window having the given distance
      *         from the current winStart
      */
-    std::vector<bool>::reference At(std::size_t distance);
+    Reference At(std::size_t distance);
     /**
      * Get a const reference to the element in the window having the given distance from
      * the current winStart. Note that the given distance must be less than the
      * window size.
      *
      * @param distance the given distance
-     * @return a const reference to the element in the window having the given distance
+     * @return the value of the element in the window having the given distance
      *         from the current winStart
      */
-    std::vector<bool>::const_reference At(std::size_t distance) const;
+    bool At(std::size_t distance) const;
     /**
      * Advance the current winStart by the given number of positions.
      *
      * @param count the number of positions the current winStart must be advanced by
      */
     void Advance(std::size_t count);
+    /**
+     * Get the distance from the current winStart of the first element that is set
+     * and whose distance from the current winStart is not less than the given value.
+     *
+     * @param from the distance from the current winStart where the search starts
+     * @return the distance of the first element that is set, or the window size if
+     *         no such element exists
+     */
+    std::size_t FindFirstSet(std::size_t from = 0) const;
+    /**
+     * Get the distance from the current winStart of the first element that is not set
+     * and whose distance from the current winStart is not less than the given value.
+     *
+     * @param from the distance from the current winStart where the search starts
+     * @return the distance of the first element that is not set, or the window size if
+     *         no such element exists
+     */
+    std::size_t FindFirstUnset(std::size_t from = 0) const;
+    /**
+     * @return the number of elements in the window that are set
+     */
+    std::size_t Count() const;
 
   private:
-    uint16_t m_winStart;        ///< window start (sequence number)
-    std::vector<bool> m_window; ///< window
-    std::size_t m_head;         ///< index of winStart in the vector
+    /**
+     * Get the index of the first element that is set (if <i>value</i> is true) or
+     * not set (if <i>value</i> is false) among the elements of the bitmap having
+     * an index in the range [<i>first</i>, <i>last</i>).
+     *
+     * @param value whether to search for an element that is set or not set
+     * @param first the index of the first element in the range
+     * @param last the index past the last element in the range
+     * @return the index of the first element found, or <i>last</i> if none is found
+     */
+    std::size_t Find(bool value, std::size_t first, std::size_t last) const;
+    /**
+     * Clear the elements of the bitmap having an index in the range [<i>first</i>,
+     * <i>last</i>).
+     *
+     * @param first the index of the first element in the range
+     * @param last the index past the last element in the range
+     */
+    void Clear(std::size_t first, std::size_t last);
+    /**
+     * Search the window for the first element that is set (if <i>value</i> is true)
+     * or not set (if <i>value</i> is false) starting at the given distance from the
+     * current winStart.
+     *
+     * @param value whether to search for an element that is set or not set
+     * @param from the distance from the current winStart where the search starts
+     * @return the distance of the first element found, or the window size if none is found
+     */
+    std::size_t FindFrom(bool value, std::size_t from) const;
+
+    static constexpr std::size_t WORD_SIZE = 64; //!< number of elements per word
+
+    uint16_t m_winStart;          ///< window start (sequence number)
+    std::vector<uint64_t> m_bits; ///< the bitmap storing the window elements
+    std::size_t m_winSize;        ///< window size
+    std::size_t m_head;           ///< index of winStart in the bitmap
 };
 
 } // namespace ns3
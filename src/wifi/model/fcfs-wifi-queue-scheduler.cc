@@ -13,6 +13,8 @@
 #include "ns3/enum.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -129,18 +131,34 @@ FcfsWifiQueueScheduler::DoNotifyEnqueue(AcIndex ac, Ptr<WifiMpdu> mpdu)
     SetPriority(ac, queueId, {item->GetTimestamp(), std::get<WifiContainerQueueType>(queueId)});
 }
 
-void
-FcfsWifiQueueScheduler::DoNotifyDequeue(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus)
+std::vector<WifiContainerQueueId>
+FcfsWifiQueueScheduler::GetSortedQueueIds(std::span<const Ptr<WifiMpdu>> mpdus)
 {
-    NS_LOG_FUNCTION(this << +ac << mpdus.size());
-
-    std::set<WifiContainerQueueId> queueIds;
+    std::vector<WifiContainerQueueId> queueIds;
+    queueIds.reserve(mpdus.size());
 
     for (const auto& mpdu : mpdus)
     {
-        queueIds.insert(WifiMacQueueContainer::GetQueueId(mpdu));
+        auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+        // MPDUs are commonly dequeued in batches belonging to the same container queue
+        if (queueIds.empty() || queueIds.back() != queueId)
+        {
+            queueIds.push_back(std::move(queueId));
+        }
     }
 
+    std::sort(queueIds.begin(), queueIds.end());
+    queueIds.erase(std::unique(queueIds.begin(), queueIds.end()), queueIds.end());
+    return queueIds;
+}
+
+void
+FcfsWifiQueueScheduler::DoNotifyDequeue(AcIndex ac, std::span<const Ptr<WifiMpdu>> mpdus)
+{
+    NS_LOG_FUNCTION(this << +ac << mpdus.size());
+
+    auto queueIds = GetSortedQueueIds(mpdus);
+
     for (const auto& queueId : queueIds)
     {
         if (auto item = GetWifiMacQueue(ac)->PeekByQueueId(queueId))
@@ -153,16 +171,11 @@ FcfsWifiQueueScheduler::DoNotifyDequeue(AcIndex ac, const std::list<Ptr<WifiMpdu
 }
 
 void
-FcfsWifiQueueScheduler::DoNotifyRemove(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus)
+FcfsWifiQueueScheduler::DoNotifyRemove(AcIndex ac, std::span<const Ptr<WifiMpdu>> mpdus)
 {
     NS_LOG_FUNCTION(this << +ac << mpdus.size());
 
-    std::set<WifiContainerQueueId> queueIds;
-
-    for (const auto& mpdu : mpdus)
-    {
-        queueIds.insert(WifiMacQueueContainer::GetQueueId(mpdu));
-    }
+    auto queueIds = GetSortedQueueIds(mpdus);
 
     for (const auto& queueId : queueIds)
     {
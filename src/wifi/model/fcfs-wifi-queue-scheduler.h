@@ -13,6 +13,8 @@
 
 #include "ns3/nstime.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -71,8 +73,15 @@ class FcfsWifiQueueScheduler : public WifiMacQueueSchedulerImpl<FcfsPrio>
   private:
     Ptr<WifiMpdu> HasToDropBeforeEnqueuePriv(AcIndex ac, Ptr<WifiMpdu> mpdu) override;
     void DoNotifyEnqueue(AcIndex ac, Ptr<WifiMpdu> mpdu) override;
-    void DoNotifyDequeue(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) override;
-    void DoNotifyRemove(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) override;
+    void DoNotifyDequeue(AcIndex ac, std::span<const Ptr<WifiMpdu>> mpdus) override;
+    void DoNotifyRemove(AcIndex ac, std::span<const Ptr<WifiMpdu>> mpdus) override;
+
+    /**
+     * @param mpdus the given MPDUs
+     * @return the sorted IDs (without duplicates) of the container queues storing the given MPDUs
+     */
+    static std::vector<WifiContainerQueueId> GetSortedQueueIds(
+        std::span<const Ptr<WifiMpdu>> mpdus);
 
     DropPolicy m_dropPolicy; //!< Drop behavior of queue
     NS_LOG_TEMPLATE_DECLARE; //!< redefinition of the log component
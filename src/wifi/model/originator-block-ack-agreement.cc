@@ -97,15 +97,13 @@ OriginatorBlockAckAgreement::AllAckedMpdusInTxWindow(const std::set<uint16_t>& s
         distances.insert(GetDistance(seqN));
     }
 
-    for (std::size_t i = 0; i < m_txWindow.GetWinSize(); ++i)
+    // only visit the positions that are available or contain an unacknowledged MPDU
+    for (auto i = m_txWindow.FindFirstUnset(); i < m_txWindow.GetWinSize();
+         i = m_txWindow.FindFirstUnset(i + 1))
     {
-        if (distances.contains(i))
+        if (!distances.contains(i))
         {
-            continue; // this is one of the positions to ignore
-        }
-        if (!m_txWindow.At(i))
-        {
-            return false; // this position is available or contains an unacknowledged MPDU
+            return false; // this position is not one of the positions to ignore
         }
     }
     NS_LOG_INFO("TX window is blocked");
@@ -115,10 +113,8 @@ OriginatorBlockAckAgreement::AllAckedMpdusInTxWindow(const std::set<uint16_t>& s
 void
 OriginatorBlockAckAgreement::AdvanceTxWindow()
 {
-    while (m_txWindow.At(0))
-    {
-        m_txWindow.Advance(1); // reset the current head -- ensures loop termination
-    }
+    // advance the window up to the first position that has not been acknowledged
+    m_txWindow.Advance(m_txWindow.FindFirstUnset());
 }
 
 void
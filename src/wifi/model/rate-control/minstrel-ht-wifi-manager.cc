@@ -91,25 +91,28 @@ const std::map<WifiModulationClass, MinstrelHtWifiManager::StandardInfo> minstre
     },
 };
 
-/// MinstrelHtWifiRemoteStation structure
-struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
+void
+MinstrelHtRateTable::Resize(std::size_t nRates)
 {
-    uint8_t m_sampleGroup; //!< The group that the sample rate belongs to.
-
-    uint32_t m_sampleWait;     //!< How many transmission attempts to wait until a new sample.
-    uint32_t m_sampleTries;    //!< Number of sample tries after waiting sampleWait.
-    uint32_t m_sampleCount;    //!< Max number of samples per update interval.
-    uint32_t m_numSamplesSlow; //!< Number of times a slow rate was sampled.
-
-    uint32_t m_avgAmpduLen;      //!< Average number of MPDUs in an A-MPDU.
-    uint32_t m_ampduLen;         //!< Number of MPDUs in an A-MPDU.
-    uint32_t m_ampduPacketCount; //!< Number of A-MPDUs transmitted.
-
-    McsGroupData m_groupsTable; //!< Table of groups with stats.
-    bool m_isHt;                //!< If the station is HT capable.
-
-    std::ofstream m_statsFile; //!< File where statistics table is written.
-};
+    perfectTxTime.assign(nRates, Time{});
+    perfectTxTimeSeconds.assign(nRates, 0);
+    supported.assign(nRates, 0);
+    mcsIndex.assign(nRates, 0);
+    retryCount.assign(nRates, 0);
+    adjustedRetryCount.assign(nRates, 0);
+    numRateAttempt.assign(nRates, 0);
+    numRateSuccess.assign(nRates, 0);
+    prob.assign(nRates, 0);
+    retryUpdated.assign(nRates, 0);
+    ewmaProb.assign(nRates, 0);
+    ewmsdProb.assign(nRates, 0);
+    prevNumRateAttempt.assign(nRates, 0);
+    prevNumRateSuccess.assign(nRates, 0);
+    numSamplesSkipped.assign(nRates, 0);
+    successHist.assign(nRates, 0);
+    attemptHist.assign(nRates, 0);
+    throughput.assign(nRates, 0);
+}
 
 NS_OBJECT_ENSURE_REGISTERED(MinstrelHtWifiManager);
 
@@ -161,6 +164,13 @@ MinstrelHtWifiManager::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&MinstrelHtWifiManager::m_printStats),
                           MakeBooleanChecker())
+            .AddAttribute("LazyStatsUpdate",
+                          "If true, transmission reports only update the per-rate counters, "
+                          "while the statistics update and the rate selection are deferred "
+                          "until a TXVECTOR is requested for the station",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&MinstrelHtWifiManager::m_lazyStatsUpdate),
+                          MakeBooleanChecker())
             .AddTraceSource("Rate",
                             "Traced value for rate changes (b/s)",
                             MakeTraceSourceAccessor(&MinstrelHtWifiManager::m_currentRate),
@@ -253,6 +263,8 @@ MinstrelHtWifiManager::InitializeGroups(WifiModulationClass mc)
                         streams)) /// Are streams supported by the transmitter?
                 {
                     m_minstrelGroups[groupId].isSupported = true;
+                    m_minstrelGroups[groupId].ratesTxTimeTable.assign(m_numRates, Time{});
+                    m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable.assign(m_numRates, Time{});
 
                     // Calculate TX time for all rates of the group
                     WifiModeList mcsList = GetDeviceMcsList(mc);
@@ -267,14 +279,14 @@ MinstrelHtWifiManager::InitializeGroups(WifiModulationClass mc)
                         if (IsValidMcs(streams, chWidth, mode))
                         {
                             AddFirstMpduTxTime(groupId,
-                                               mode,
+                                               i,
                                                CalculateMpduTxDuration(streams,
                                                                        guardInterval,
                                                                        chWidth,
                                                                        mode,
                                                                        FIRST_MPDU_IN_AGGREGATE));
                             AddMpduTxTime(groupId,
-                                          mode,
+                                          i,
                                           CalculateMpduTxDuration(streams,
                                                                   guardInterval,
                                                                   chWidth,
@@ -414,35 +426,37 @@ MinstrelHtWifiManager::CalculateMpduTxDuration(uint8_t streams,
 }
 
 Time
-MinstrelHtWifiManager::GetFirstMpduTxTime(std::size_t groupId, WifiMode mode) const
+MinstrelHtWifiManager::GetFirstMpduTxTime(std::size_t groupId, uint8_t rateId) const
 {
-    NS_LOG_FUNCTION(this << groupId << mode);
-    const auto it = m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable.find(mode);
-    NS_ASSERT(it != m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable.cend());
-    return it->second;
+    NS_LOG_FUNCTION(this << groupId << +rateId);
+    NS_ASSERT(rateId < m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable.size());
+    const auto txTime = m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable[rateId];
+    NS_ASSERT(txTime.IsStrictlyPositive());
+    return txTime;
 }
 
 void
-MinstrelHtWifiManager::AddFirstMpduTxTime(std::size_t groupId, WifiMode mode, Time t)
+MinstrelHtWifiManager::AddFirstMpduTxTime(std::size_t groupId, uint8_t rateId, Time t)
 {
-    NS_LOG_FUNCTION(this << groupId << mode << t);
-    m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable.insert(std::make_pair(mode, t));
+    NS_LOG_FUNCTION(this << groupId << +rateId << t);
+    m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable.at(rateId) = t;
 }
 
 Time
-MinstrelHtWifiManager::GetMpduTxTime(std::size_t groupId, WifiMode mode) const
+MinstrelHtWifiManager::GetMpduTxTime(std::size_t groupId, uint8_t rateId) const
 {
-    NS_LOG_FUNCTION(this << groupId << mode);
-    auto it = m_minstrelGroups[groupId].ratesTxTimeTable.find(mode);
-    NS_ASSERT(it != m_minstrelGroups[groupId].ratesTxTimeTable.end());
-    return it->second;
+    NS_LOG_FUNCTION(this << groupId << +rateId);
+    NS_ASSERT(rateId < m_minstrelGroups[groupId].ratesTxTimeTable.size());
+    const auto txTime = m_minstrelGroups[groupId].ratesTxTimeTable[rateId];
+    NS_ASSERT(txTime.IsStrictlyPositive());
+    return txTime;
 }
 
 void
-MinstrelHtWifiManager::AddMpduTxTime(std::size_t groupId, WifiMode mode, Time t)
+MinstrelHtWifiManager::AddMpduTxTime(std::size_t groupId, uint8_t rateId, Time t)
 {
-    NS_LOG_FUNCTION(this << groupId << mode << t);
-    m_minstrelGroups[groupId].ratesTxTimeTable.insert(std::make_pair(mode, t));
+    NS_LOG_FUNCTION(this << groupId << +rateId << t);
+    m_minstrelGroups[groupId].ratesTxTimeTable.at(rateId) = t;
 }
 
 WifiRemoteStation*
@@ -468,6 +482,7 @@ MinstrelHtWifiManager::DoCreateStation() const
     station->m_longRetry = 0;
     station->m_txrate = 0;
     station->m_initialized = false;
+    station->m_rateDecisionPending = false;
 
     // Variables specific to HT station
     station->m_sampleGroup = 0;
@@ -513,6 +528,7 @@ MinstrelHtWifiManager::CheckInit(MinstrelHtWifiRemoteStation* station)
             m_legacyManager->SetAttribute("SampleColumn", UintegerValue(m_nSampleCol));
             m_legacyManager->SetAttribute("PacketLength", UintegerValue(m_frameLength));
             m_legacyManager->SetAttribute("PrintStats", BooleanValue(m_printStats));
+            m_legacyManager->SetAttribute("LazyStatsUpdate", BooleanValue(m_lazyStatsUpdate));
             m_legacyManager->CheckInit(station);
         }
         else
@@ -597,9 +613,8 @@ MinstrelHtWifiManager::DoReportDataFailed(WifiRemoteStation* st)
     {
         const auto rateId = GetRateId(station->m_txrate);
         const auto groupId = GetGroupId(station->m_txrate);
-        station->m_groupsTable[groupId]
-            .m_ratesTable[rateId]
-            .numRateAttempt++; // Increment the attempts counter for the rate used.
+        // Increment the attempts counter for the rate used.
+        station->m_groupsTable[groupId].m_ratesTable.numRateAttempt[rateId]++;
         UpdateRate(station);
     }
 }
@@ -641,12 +656,7 @@ MinstrelHtWifiManager::DoReportDataOk(WifiRemoteStation* st,
                      << " (after update).");
 
         UpdateRetry(station);
-        m_legacyManager->UpdateStats(station);
-
-        if (station->m_nModes >= 1)
-        {
-            station->m_txrate = m_legacyManager->FindRate(station);
-        }
+        m_legacyManager->SelectRate(station);
     }
     else
     {
@@ -656,35 +666,27 @@ MinstrelHtWifiManager::DoReportDataOk(WifiRemoteStation* st,
         NS_LOG_DEBUG(
             "DoReportDataOk m_txrate = "
             << station->m_txrate
-            << ", attempt = " << station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt
-            << ", success = " << station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess
+            << ", attempt = " << station->m_groupsTable[groupId].m_ratesTable.numRateAttempt[rateId]
+            << ", success = " << station->m_groupsTable[groupId].m_ratesTable.numRateSuccess[rateId]
             << " (before update).");
 
-        station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess++;
-        station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt++;
+        station->m_groupsTable[groupId].m_ratesTable.numRateSuccess[rateId]++;
+        station->m_groupsTable[groupId].m_ratesTable.numRateAttempt[rateId]++;
 
         UpdatePacketCounters(station, 1, 0);
 
         NS_LOG_DEBUG(
             "DoReportDataOk m_txrate = "
             << station->m_txrate
-            << ", attempt = " << station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt
-            << ", success = " << station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess
+            << ", attempt = " << station->m_groupsTable[groupId].m_ratesTable.numRateAttempt[rateId]
+            << ", success = " << station->m_groupsTable[groupId].m_ratesTable.numRateSuccess[rateId]
             << " (after update).");
 
         station->m_isSampling = false;
         station->m_sampleDeferred = false;
 
         UpdateRetry(station);
-        if (Simulator::Now() >= station->m_nextStatsUpdate)
-        {
-            UpdateStats(station);
-        }
-
-        if (station->m_nModes >= 1)
-        {
-            station->m_txrate = FindRate(station);
-        }
+        SelectRate(station);
     }
 
     NS_LOG_DEBUG("Next rate to use TxRate = " << station->m_txrate);
@@ -709,12 +711,7 @@ MinstrelHtWifiManager::DoReportFinalDataFailed(WifiRemoteStation* st)
         m_legacyManager->UpdatePacketCounters(station);
 
         UpdateRetry(station);
-
-        m_legacyManager->UpdateStats(station);
-        if (station->m_nModes >= 1)
-        {
-            station->m_txrate = m_legacyManager->FindRate(station);
-        }
+        m_legacyManager->SelectRate(station);
     }
     else
     {
@@ -724,15 +721,7 @@ MinstrelHtWifiManager::DoReportFinalDataFailed(WifiRemoteStation* st)
         station->m_sampleDeferred = false;
 
         UpdateRetry(station);
-        if (Simulator::Now() >= station->m_nextStatsUpdate)
-        {
-            UpdateStats(station);
-        }
-
-        if (station->m_nModes >= 1)
-        {
-            station->m_txrate = FindRate(station);
-        }
+        SelectRate(station);
     }
     NS_LOG_DEBUG("Next rate to use TxRate = " << station->m_txrate);
 }
@@ -769,8 +758,8 @@ MinstrelHtWifiManager::DoReportAmpduTxStatus(WifiRemoteStation* st,
 
     const auto rateId = GetRateId(station->m_txrate);
     const auto groupId = GetGroupId(station->m_txrate);
-    station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess += nSuccessfulMpdus;
-    station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt +=
+    station->m_groupsTable[groupId].m_ratesTable.numRateSuccess[rateId] += nSuccessfulMpdus;
+    station->m_groupsTable[groupId].m_ratesTable.numRateAttempt[rateId] +=
         nSuccessfulMpdus + nFailedMpdus;
 
     if (nSuccessfulMpdus == 0 && station->m_longRetry < CountRetries(station))
@@ -784,15 +773,7 @@ MinstrelHtWifiManager::DoReportAmpduTxStatus(WifiRemoteStation* st,
         station->m_sampleDeferred = false;
 
         UpdateRetry(station);
-        if (Simulator::Now() >= station->m_nextStatsUpdate)
-        {
-            UpdateStats(station);
-        }
-
-        if (station->m_nModes >= 1)
-        {
-            station->m_txrate = FindRate(station);
-        }
+        SelectRate(station);
         NS_LOG_DEBUG("Next rate to use TxRate = " << station->m_txrate);
     }
 }
@@ -845,7 +826,7 @@ MinstrelHtWifiManager::UpdateRate(MinstrelHtWifiRemoteStation* station)
     {
         /// Use best throughput rate.
         if (station->m_longRetry <
-            station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].retryCount)
+            station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTpRateId])
         {
             NS_LOG_DEBUG("Not Sampling; use the same rate again");
             station->m_txrate = station->m_maxTpRate; //!<  There are still a few retries.
@@ -853,8 +834,8 @@ MinstrelHtWifiManager::UpdateRate(MinstrelHtWifiRemoteStation* station)
 
         /// Use second best throughput rate.
         else if (station->m_longRetry <
-                 (station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].retryCount +
-                  station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].retryCount))
+                 (station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTpRateId] +
+                  station->m_groupsTable[maxTp2GroupId].m_ratesTable.retryCount[maxTp2RateId]))
         {
             NS_LOG_DEBUG("Not Sampling; use the Max TP2");
             station->m_txrate = station->m_maxTpRate2;
@@ -862,9 +843,9 @@ MinstrelHtWifiManager::UpdateRate(MinstrelHtWifiRemoteStation* station)
 
         /// Use best probability rate.
         else if (station->m_longRetry <=
-                 (station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].retryCount +
-                  station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].retryCount +
-                  station->m_groupsTable[maxProbGroupId].m_ratesTable[maxProbRateId].retryCount))
+                 (station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTpRateId] +
+                  station->m_groupsTable[maxTp2GroupId].m_ratesTable.retryCount[maxTp2RateId] +
+                  station->m_groupsTable[maxProbGroupId].m_ratesTable.retryCount[maxProbRateId]))
         {
             NS_LOG_DEBUG("Not Sampling; use Max Prob");
             station->m_txrate = station->m_maxProbRate;
@@ -882,7 +863,7 @@ MinstrelHtWifiManager::UpdateRate(MinstrelHtWifiRemoteStation* station)
         /// Sample rate is used only once
         /// Use the best rate.
         if (station->m_longRetry <
-            1 + station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTp2RateId].retryCount)
+            1 + station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTp2RateId])
         {
             NS_LOG_DEBUG("Sampling use the MaxTP rate");
             station->m_txrate = station->m_maxTpRate2;
@@ -890,8 +871,8 @@ MinstrelHtWifiManager::UpdateRate(MinstrelHtWifiRemoteStation* station)
 
         /// Use the best probability rate.
         else if (station->m_longRetry <=
-                 1 + station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTp2RateId].retryCount +
-                     station->m_groupsTable[maxProbGroupId].m_ratesTable[maxProbRateId].retryCount)
+                 1 + station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTp2RateId] +
+                     station->m_groupsTable[maxProbGroupId].m_ratesTable.retryCount[maxProbRateId])
         {
             NS_LOG_DEBUG("Sampling use the MaxProb rate");
             station->m_txrate = station->m_maxProbRate;
@@ -945,20 +926,20 @@ MinstrelHtWifiManager::UpdateRateAfterAllowedWidth(uint16_t txRate, MHz_u allowe
     NS_LOG_FUNCTION(this << txRate << allowedWidth);
 
     auto groupId = GetGroupId(txRate);
-    McsGroup group = m_minstrelGroups[groupId];
+    const McsGroup* group = &m_minstrelGroups[groupId];
 
-    if (group.chWidth <= allowedWidth)
+    if (group->chWidth <= allowedWidth)
     {
         NS_LOG_DEBUG("Channel width is not greater than allowed width, nothing to do");
         return txRate;
     }
 
     NS_ASSERT(GetPhy()->GetDevice()->GetHtConfiguration() != nullptr);
-    NS_ASSERT(static_cast<uint16_t>(group.chWidth) % 20 == 0);
+    NS_ASSERT(static_cast<uint16_t>(group->chWidth) % 20 == 0);
     // try halving the channel width and check if the group with the same number of
     // streams and same GI is supported, until either a supported group is found or
     // the width becomes lower than 20 MHz
-    auto width = group.chWidth / 2;
+    auto width = group->chWidth / 2;
 
     while (width >= MHz_u{20})
     {
@@ -967,9 +948,9 @@ MinstrelHtWifiManager::UpdateRateAfterAllowedWidth(uint16_t txRate, MHz_u allowe
             width /= 2;
             continue;
         }
-        groupId = GetGroupIdForType(group.type, group.streams, group.gi, width);
-        group = m_minstrelGroups[groupId];
-        if (group.isSupported)
+        groupId = GetGroupIdForType(group->type, group->streams, group->gi, width);
+        group = &m_minstrelGroups[groupId];
+        if (group->isSupported)
         {
             break;
         }
@@ -1004,17 +985,22 @@ MinstrelHtWifiManager::DoGetDataTxVector(WifiRemoteStation* st, MHz_u allowedWid
         return vector;
     }
 
+    if (station->m_rateDecisionPending)
+    {
+        DoSelectRate(station);
+    }
+
     station->m_txrate = UpdateRateAfterAllowedWidth(station->m_txrate, allowedWidth);
     NS_LOG_DEBUG("DoGetDataMode m_txrate= " << station->m_txrate);
 
     const auto rateId = GetRateId(station->m_txrate);
     const auto groupId = GetGroupId(station->m_txrate);
-    const auto mcsIndex = station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex;
+    const auto mcsIndex = station->m_groupsTable[groupId].m_ratesTable.mcsIndex[rateId];
 
     NS_LOG_DEBUG("DoGetDataMode rateId= " << rateId << " groupId= " << groupId
                                           << " mode= " << GetMcsSupported(station, mcsIndex));
 
-    McsGroup group = m_minstrelGroups[groupId];
+    const auto& group = m_minstrelGroups[groupId];
 
     // Check consistency of rate selected.
     if (((group.type >= WIFI_MINSTREL_GROUP_HE) && (group.gi < GetGuardInterval(station))) ||
@@ -1068,6 +1054,10 @@ MinstrelHtWifiManager::DoGetRtsTxVector(WifiRemoteStation* st)
     }
     else
     {
+        if (station->m_rateDecisionPending)
+        {
+            DoSelectRate(station);
+        }
         NS_LOG_DEBUG("DoGetRtsMode m_txrate=" << station->m_txrate);
 
         /* RTS is sent in a non-HT frame. RTS with HT is not supported yet in NS3.
@@ -1086,7 +1076,7 @@ MinstrelHtWifiManager::DoGetRtsTxVector(WifiRemoteStation* st)
         // As we are in Minstrel HT, assume the last rate was an HT rate.
         const auto rateId = GetRateId(station->m_txrate);
         const auto groupId = GetGroupId(station->m_txrate);
-        const auto mcsIndex = station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex;
+        const auto mcsIndex = station->m_groupsTable[groupId].m_ratesTable.mcsIndex[rateId];
 
         const auto lastRate = GetMcsSupported(station, mcsIndex);
         const auto lastDataRate = lastRate.GetNonHtReferenceRate();
@@ -1206,14 +1196,14 @@ MinstrelHtWifiManager::CountRetries(MinstrelHtWifiRemoteStation* station)
 
     if (!station->m_isSampling)
     {
-        return station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].retryCount +
-               station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].retryCount +
-               station->m_groupsTable[maxProbGroupId].m_ratesTable[maxProbRateId].retryCount;
+        return station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTpRateId] +
+               station->m_groupsTable[maxTp2GroupId].m_ratesTable.retryCount[maxTp2RateId] +
+               station->m_groupsTable[maxProbGroupId].m_ratesTable.retryCount[maxProbRateId];
     }
     else
     {
-        return 1 + station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTp2RateId].retryCount +
-               station->m_groupsTable[maxProbGroupId].m_ratesTable[maxProbRateId].retryCount;
+        return 1 + station->m_groupsTable[maxTpGroupId].m_ratesTable.retryCount[maxTp2RateId] +
+               station->m_groupsTable[maxProbGroupId].m_ratesTable.retryCount[maxProbRateId];
     }
 }
 
@@ -1235,11 +1225,13 @@ void
 MinstrelHtWifiManager::SetNextSample(MinstrelHtWifiRemoteStation* station)
 {
     NS_LOG_FUNCTION(this << station);
-    do
-    {
-        station->m_sampleGroup++;
-        station->m_sampleGroup %= m_numGroups;
-    } while (!station->m_groupsTable[station->m_sampleGroup].m_supported);
+    // move to the next supported group (wrapping around)
+    auto groupIt = std::upper_bound(station->m_supportedGroups.cbegin(),
+                                    station->m_supportedGroups.cend(),
+                                    station->m_sampleGroup);
+    station->m_sampleGroup = (groupIt != station->m_supportedGroups.cend())
+                                 ? *groupIt
+                                 : station->m_supportedGroups.front();
 
     station->m_groupsTable[station->m_sampleGroup].m_index++;
 
@@ -1288,7 +1280,7 @@ MinstrelHtWifiManager::FindRate(MinstrelHtWifiRemoteStation* station)
 
         // If the rate selected is not supported, then don't sample.
         if (station->m_groupsTable[sampleGroupId].m_supported &&
-            station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId].supported)
+            station->m_groupsTable[sampleGroupId].m_ratesTable.supported[sampleRateId])
         {
             /**
              * Sampling might add some overhead to the frame.
@@ -1297,16 +1289,15 @@ MinstrelHtWifiManager::FindRate(MinstrelHtWifiRemoteStation* station)
              * Also do not sample if the probability is already higher than 95%
              * to avoid wasting airtime.
              */
-            const auto sampleRateInfo =
-                station->m_groupsTable[sampleGroupId].m_ratesTable[sampleRateId];
+            const auto& sampleRates = station->m_groupsTable[sampleGroupId].m_ratesTable;
 
             NS_LOG_DEBUG("Use sample rate? MaxTpRate= "
                          << station->m_maxTpRate << " CurrentRate= " << station->m_txrate
                          << " SampleRate= " << sampleIdx
-                         << " SampleProb= " << sampleRateInfo.ewmaProb);
+                         << " SampleProb= " << sampleRates.ewmaProb[sampleRateId]);
 
             if (sampleIdx != station->m_maxTpRate && sampleIdx != station->m_maxTpRate2 &&
-                sampleIdx != station->m_maxProbRate && sampleRateInfo.ewmaProb <= 95)
+                sampleIdx != station->m_maxProbRate && sampleRates.ewmaProb[sampleRateId] <= 95)
             {
                 /**
                  * Make sure that lower rates get sampled only occasionally,
@@ -1322,12 +1313,11 @@ MinstrelHtWifiManager::FindRate(MinstrelHtWifiRemoteStation* station)
                 const auto maxTpStreams = m_minstrelGroups[maxTpGroupId].streams;
                 const auto sampleStreams = m_minstrelGroups[sampleGroupId].streams;
 
-                const auto sampleDuration = sampleRateInfo.perfectTxTime;
+                const auto sampleDuration = sampleRates.perfectTxTime[sampleRateId];
                 const auto maxTp2Duration =
-                    station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].perfectTxTime;
+                    station->m_groupsTable[maxTp2GroupId].m_ratesTable.perfectTxTime[maxTp2RateId];
                 const auto maxProbDuration = station->m_groupsTable[maxProbGroupId]
-                                                 .m_ratesTable[maxProbRateId]
-                                                 .perfectTxTime;
+                                                 .m_ratesTable.perfectTxTime[maxProbRateId];
 
                 NS_LOG_DEBUG("Use sample rate? SampleDuration= "
                              << sampleDuration << " maxTp2Duration= " << maxTp2Duration
@@ -1349,7 +1339,8 @@ MinstrelHtWifiManager::FindRate(MinstrelHtWifiRemoteStation* station)
                 else
                 {
                     station->m_numSamplesSlow++;
-                    if (sampleRateInfo.numSamplesSkipped >= 20 && station->m_numSamplesSlow <= 2)
+                    if (sampleRates.numSamplesSkipped[sampleRateId] >= 20 &&
+                        station->m_numSamplesSlow <= 2)
                     {
                         /// Set flag that we are currently sampling.
                         station->m_isSampling = true;
@@ -1376,6 +1367,35 @@ MinstrelHtWifiManager::FindRate(MinstrelHtWifiRemoteStation* station)
     return station->m_maxTpRate;
 }
 
+void
+MinstrelHtWifiManager::SelectRate(MinstrelHtWifiRemoteStation* station)
+{
+    NS_LOG_FUNCTION(this << station);
+    if (m_lazyStatsUpdate)
+    {
+        NS_LOG_DEBUG("Rate selection deferred until the next transmission");
+        station->m_rateDecisionPending = true;
+        return;
+    }
+    DoSelectRate(station);
+}
+
+void
+MinstrelHtWifiManager::DoSelectRate(MinstrelHtWifiRemoteStation* station)
+{
+    NS_LOG_FUNCTION(this << station);
+    station->m_rateDecisionPending = false;
+    if (Simulator::Now() >= station->m_nextStatsUpdate)
+    {
+        UpdateStats(station);
+    }
+
+    if (station->m_nModes >= 1)
+    {
+        station->m_txrate = FindRate(station);
+    }
+}
+
 void
 MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
 {
@@ -1386,8 +1406,6 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     station->m_numSamplesSlow = 0;
     station->m_sampleCount = 0;
 
-    double tempProb;
-
     if (station->m_ampduPacketCount > 0)
     {
         uint32_t newLen = station->m_ampduLen / station->m_ampduPacketCount;
@@ -1402,94 +1420,28 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     station->m_maxTpRate2 = GetLowestIndex(station);
     station->m_maxProbRate = GetLowestIndex(station);
 
-    /// Update throughput and EWMA for each rate inside each group.
-    for (std::size_t j = 0; j < m_numGroups; j++)
+    /// Update throughput and EWMA for each rate inside each supported group.
+    for (const auto j : station->m_supportedGroups)
     {
-        if (station->m_groupsTable[j].m_supported)
-        {
-            station->m_sampleCount++;
-
-            /* (re)Initialize group rate indexes */
-            station->m_groupsTable[j].m_maxTpRate = GetLowestIndex(station, j);
-            station->m_groupsTable[j].m_maxTpRate2 = GetLowestIndex(station, j);
-            station->m_groupsTable[j].m_maxProbRate = GetLowestIndex(station, j);
+        station->m_sampleCount++;
 
-            for (uint8_t i = 0; i < m_numRates; i++)
-            {
-                if (station->m_groupsTable[j].m_ratesTable[i].supported)
-                {
-                    station->m_groupsTable[j].m_ratesTable[i].retryUpdated = false;
-
-                    NS_LOG_DEBUG(
-                        +i << " "
-                           << GetMcsSupported(station,
-                                              station->m_groupsTable[j].m_ratesTable[i].mcsIndex)
-                           << "\t attempt="
-                           << station->m_groupsTable[j].m_ratesTable[i].numRateAttempt
-                           << "\t success="
-                           << station->m_groupsTable[j].m_ratesTable[i].numRateSuccess);
-
-                    /// If we've attempted something.
-                    if (station->m_groupsTable[j].m_ratesTable[i].numRateAttempt > 0)
-                    {
-                        station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped = 0;
-                        /**
-                         * Calculate the probability of success.
-                         * Assume probability scales from 0 to 100.
-                         */
-                        tempProb =
-                            (100 * station->m_groupsTable[j].m_ratesTable[i].numRateSuccess) /
-                            station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-
-                        /// Bookkeeping.
-                        station->m_groupsTable[j].m_ratesTable[i].prob = tempProb;
-
-                        if (station->m_groupsTable[j].m_ratesTable[i].successHist == 0)
-                        {
-                            station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
-                        else
-                        {
-                            station->m_groupsTable[j].m_ratesTable[i].ewmsdProb =
-                                CalculateEwmsd(station->m_groupsTable[j].m_ratesTable[i].ewmsdProb,
-                                               tempProb,
-                                               station->m_groupsTable[j].m_ratesTable[i].ewmaProb,
-                                               m_ewmaLevel);
-                            /// EWMA probability
-                            tempProb =
-                                (tempProb * (100 - m_ewmaLevel) +
-                                 station->m_groupsTable[j].m_ratesTable[i].ewmaProb * m_ewmaLevel) /
-                                100;
-                            station->m_groupsTable[j].m_ratesTable[i].ewmaProb = tempProb;
-                        }
+        /* (re)Initialize group rate indexes */
+        station->m_groupsTable[j].m_maxTpRate = GetLowestIndex(station, j);
+        station->m_groupsTable[j].m_maxTpRate2 = GetLowestIndex(station, j);
+        station->m_groupsTable[j].m_maxProbRate = GetLowestIndex(station, j);
 
-                        station->m_groupsTable[j].m_ratesTable[i].throughput =
-                            CalculateThroughput(station, j, i, tempProb);
+        UpdateGroupStats(station, j);
 
-                        station->m_groupsTable[j].m_ratesTable[i].successHist +=
-                            station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                        station->m_groupsTable[j].m_ratesTable[i].attemptHist +=
-                            station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    }
-                    else
-                    {
-                        station->m_groupsTable[j].m_ratesTable[i].numSamplesSkipped++;
-                    }
-
-                    /// Bookkeeping.
-                    station->m_groupsTable[j].m_ratesTable[i].prevNumRateSuccess =
-                        station->m_groupsTable[j].m_ratesTable[i].numRateSuccess;
-                    station->m_groupsTable[j].m_ratesTable[i].prevNumRateAttempt =
-                        station->m_groupsTable[j].m_ratesTable[i].numRateAttempt;
-                    station->m_groupsTable[j].m_ratesTable[i].numRateSuccess = 0;
-                    station->m_groupsTable[j].m_ratesTable[i].numRateAttempt = 0;
-
-                    if (station->m_groupsTable[j].m_ratesTable[i].throughput != 0)
-                    {
-                        SetBestStationThRates(station, GetIndex(j, i));
-                        SetBestProbabilityRate(station, GetIndex(j, i));
-                    }
-                }
+        // The best rates are selected after updating the statistics of all the rates of
+        // the group. This is equivalent to updating and selecting rate by rate, because
+        // the rates compared to the current one always have a lower index.
+        const auto& ratesTable = station->m_groupsTable[j].m_ratesTable;
+        for (uint8_t i = 0; i < m_numRates; i++)
+        {
+            if (ratesTable.supported[i] && ratesTable.throughput[i] != 0)
+            {
+                SetBestStationThRates(station, GetIndex(j, i));
+                SetBestProbabilityRate(station, GetIndex(j, i));
             }
         }
     }
@@ -1510,6 +1462,91 @@ MinstrelHtWifiManager::UpdateStats(MinstrelHtWifiRemoteStation* station)
     }
 }
 
+void
+MinstrelHtWifiManager::UpdateGroupStats(MinstrelHtWifiRemoteStation* station, std::size_t groupId)
+{
+    NS_LOG_FUNCTION(this << station << groupId);
+
+    auto& rates = station->m_groupsTable[groupId].m_ratesTable;
+
+    // Each statistic is stored in a separate array, hence every loop below only visits
+    // contiguous memory. Rates that are not supported are never used for transmission,
+    // hence their counters are always zero and they are skipped by the checks on the
+    // number of attempts.
+    for (uint8_t i = 0; i < m_numRates; i++)
+    {
+        NS_LOG_DEBUG(+i << " supported=" << +rates.supported[i]
+                        << "\t attempt=" << rates.numRateAttempt[i]
+                        << "\t success=" << rates.numRateSuccess[i]);
+        rates.retryUpdated[i] = 0;
+    }
+
+    for (uint8_t i = 0; i < m_numRates; i++)
+    {
+        /// If we've attempted something.
+        if (rates.numRateAttempt[i] > 0)
+        {
+            rates.numSamplesSkipped[i] = 0;
+            /**
+             * Calculate the probability of success.
+             * Assume probability scales from 0 to 100.
+             */
+            double tempProb = (100 * rates.numRateSuccess[i]) / rates.numRateAttempt[i];
+
+            /// Bookkeeping.
+            rates.prob[i] = tempProb;
+
+            if (rates.successHist[i] == 0)
+            {
+                rates.ewmaProb[i] = tempProb;
+            }
+            else
+            {
+                rates.ewmsdProb[i] =
+                    CalculateEwmsd(rates.ewmsdProb[i], tempProb, rates.ewmaProb[i], m_ewmaLevel);
+                /// EWMA probability
+                tempProb = (tempProb * (100 - m_ewmaLevel) + rates.ewmaProb[i] * m_ewmaLevel) / 100;
+                rates.ewmaProb[i] = tempProb;
+            }
+        }
+        else if (rates.supported[i])
+        {
+            rates.numSamplesSkipped[i]++;
+        }
+    }
+
+    /**
+     * Throughput of the rates that have been attempted (see CalculateThroughput). This pass
+     * only reads and writes plain arrays and uses selects instead of branches, so that the
+     * compiler can vectorize it. The throughput of the rates that have not been attempted is
+     * left unchanged.
+     */
+    const auto* attempts = rates.numRateAttempt.data();
+    const auto* ewmaProb = rates.ewmaProb.data();
+    const auto* txTime = rates.perfectTxTimeSeconds.data();
+    auto* throughput = rates.throughput.data();
+    for (uint8_t i = 0; i < m_numRates; i++)
+    {
+        const auto prob = ewmaProb[i] > 90 ? 90 : ewmaProb[i];
+        const auto rateTh = ewmaProb[i] < 10 ? 0 : prob / txTime[i];
+        throughput[i] = attempts[i] > 0 ? rateTh : throughput[i];
+    }
+
+    /// Bookkeeping (branch-free, so that the compiler can vectorize the loops).
+    for (uint8_t i = 0; i < m_numRates; i++)
+    {
+        rates.successHist[i] += rates.numRateSuccess[i];
+        rates.attemptHist[i] += rates.numRateAttempt[i];
+    }
+    for (uint8_t i = 0; i < m_numRates; i++)
+    {
+        rates.prevNumRateSuccess[i] = rates.numRateSuccess[i];
+        rates.prevNumRateAttempt[i] = rates.numRateAttempt[i];
+        rates.numRateSuccess[i] = 0;
+        rates.numRateAttempt[i] = 0;
+    }
+}
+
 double
 MinstrelHtWifiManager::CalculateThroughput(MinstrelHtWifiRemoteStation* station,
                                            std::size_t groupId,
@@ -1531,7 +1568,7 @@ MinstrelHtWifiManager::CalculateThroughput(MinstrelHtWifiRemoteStation* station,
          * For the throughput calculation, limit the probability value to 90% to
          * account for collision related packet error rate fluctuation.
          */
-        const auto txTime = station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime;
+        const auto txTime = station->m_groupsTable[groupId].m_ratesTable.perfectTxTime[rateId];
         if (ewmaProb > 90)
         {
             return 90 / txTime.GetSeconds();
@@ -1547,7 +1584,6 @@ void
 MinstrelHtWifiManager::SetBestProbabilityRate(MinstrelHtWifiRemoteStation* station, uint16_t index)
 {
     GroupInfo* group;
-    MinstrelHtRateInfo rate;
     std::size_t tmpGroupId;
     uint8_t tmpRateId;
     double tmpTh;
@@ -1563,16 +1599,16 @@ MinstrelHtWifiManager::SetBestProbabilityRate(MinstrelHtWifiRemoteStation* stati
     groupId = GetGroupId(index);
     rateId = GetRateId(index);
     group = &station->m_groupsTable[groupId];
-    rate = group->m_ratesTable[rateId];
+    const auto ewmaProb = group->m_ratesTable.ewmaProb[rateId];
 
     tmpGroupId = GetGroupId(station->m_maxProbRate);
     tmpRateId = GetRateId(station->m_maxProbRate);
-    tmpProb = station->m_groupsTable[tmpGroupId].m_ratesTable[tmpRateId].ewmaProb;
-    tmpTh = station->m_groupsTable[tmpGroupId].m_ratesTable[tmpRateId].throughput;
+    tmpProb = station->m_groupsTable[tmpGroupId].m_ratesTable.ewmaProb[tmpRateId];
+    tmpTh = station->m_groupsTable[tmpGroupId].m_ratesTable.throughput[tmpRateId];
 
-    if (rate.ewmaProb > 75)
+    if (ewmaProb > 75)
     {
-        currentTh = station->m_groupsTable[groupId].m_ratesTable[rateId].throughput;
+        currentTh = station->m_groupsTable[groupId].m_ratesTable.throughput[rateId];
         if (currentTh > tmpTh)
         {
             station->m_maxProbRate = index;
@@ -1580,7 +1616,7 @@ MinstrelHtWifiManager::SetBestProbabilityRate(MinstrelHtWifiRemoteStation* stati
 
         maxGPGroupId = GetGroupId(group->m_maxProbRate);
         maxGPRateId = GetRateId(group->m_maxProbRate);
-        maxGPTh = station->m_groupsTable[maxGPGroupId].m_ratesTable[maxGPRateId].throughput;
+        maxGPTh = station->m_groupsTable[maxGPGroupId].m_ratesTable.throughput[maxGPRateId];
 
         if (currentTh > maxGPTh)
         {
@@ -1589,12 +1625,12 @@ MinstrelHtWifiManager::SetBestProbabilityRate(MinstrelHtWifiRemoteStation* stati
     }
     else
     {
-        if (rate.ewmaProb > tmpProb)
+        if (ewmaProb > tmpProb)
         {
             station->m_maxProbRate = index;
         }
         maxGPRateId = GetRateId(group->m_maxProbRate);
-        if (rate.ewmaProb > group->m_ratesTable[maxGPRateId].ewmaProb)
+        if (ewmaProb > group->m_ratesTable.ewmaProb[maxGPRateId])
         {
             group->m_maxProbRate = index;
         }
@@ -1626,18 +1662,18 @@ MinstrelHtWifiManager::SetBestStationThRates(MinstrelHtWifiRemoteStation* statio
 
     groupId = GetGroupId(index);
     rateId = GetRateId(index);
-    prob = station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb;
-    th = station->m_groupsTable[groupId].m_ratesTable[rateId].throughput;
+    prob = station->m_groupsTable[groupId].m_ratesTable.ewmaProb[rateId];
+    th = station->m_groupsTable[groupId].m_ratesTable.throughput[rateId];
 
     maxTpGroupId = GetGroupId(station->m_maxTpRate);
     maxTpRateId = GetRateId(station->m_maxTpRate);
-    maxTpProb = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].ewmaProb;
-    maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].throughput;
+    maxTpProb = station->m_groupsTable[maxTpGroupId].m_ratesTable.ewmaProb[maxTpRateId];
+    maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable.throughput[maxTpRateId];
 
     maxTp2GroupId = GetGroupId(station->m_maxTpRate2);
     maxTp2RateId = GetRateId(station->m_maxTpRate2);
-    maxTp2Prob = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].ewmaProb;
-    maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].throughput;
+    maxTp2Prob = station->m_groupsTable[maxTp2GroupId].m_ratesTable.ewmaProb[maxTp2RateId];
+    maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable.throughput[maxTp2RateId];
 
     if (th > maxTpTh || (th == maxTpTh && prob > maxTpProb))
     {
@@ -1654,13 +1690,13 @@ MinstrelHtWifiManager::SetBestStationThRates(MinstrelHtWifiRemoteStation* statio
     GroupInfo* group = &station->m_groupsTable[groupId];
     maxTpGroupId = GetGroupId(group->m_maxTpRate);
     maxTpRateId = GetRateId(group->m_maxTpRate);
-    maxTpProb = group->m_ratesTable[maxTpRateId].ewmaProb;
-    maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable[maxTpRateId].throughput;
+    maxTpProb = group->m_ratesTable.ewmaProb[maxTpRateId];
+    maxTpTh = station->m_groupsTable[maxTpGroupId].m_ratesTable.throughput[maxTpRateId];
 
     maxTp2GroupId = GetGroupId(group->m_maxTpRate2);
     maxTp2RateId = GetRateId(group->m_maxTpRate2);
-    maxTp2Prob = group->m_ratesTable[maxTp2RateId].ewmaProb;
-    maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable[maxTp2RateId].throughput;
+    maxTp2Prob = group->m_ratesTable.ewmaProb[maxTp2RateId];
+    maxTp2Th = station->m_groupsTable[maxTp2GroupId].m_ratesTable.throughput[maxTp2RateId];
 
     if (th > maxTpTh || (th == maxTpTh && prob > maxTpProb))
     {
@@ -1679,6 +1715,7 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
     NS_LOG_FUNCTION(this << station);
 
     station->m_groupsTable = McsGroupData(m_numGroups);
+    station->m_supportedGroups.clear();
 
     /**
      * Initialize groups supported by the receiver.
@@ -1762,16 +1799,13 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
                                    << " width: " << m_minstrelGroups[groupId].chWidth);
 
             noSupportedGroupFound = false;
+            station->m_supportedGroups.push_back(groupId);
             station->m_groupsTable[groupId].m_supported = true;
             station->m_groupsTable[groupId].m_col = 0;
             station->m_groupsTable[groupId].m_index = 0;
 
-            station->m_groupsTable[groupId].m_ratesTable =
-                MinstrelHtRate(m_numRates); /// Create the rate list for the group.
-            for (uint8_t i = 0; i < m_numRates; i++)
-            {
-                station->m_groupsTable[groupId].m_ratesTable[i].supported = false;
-            }
+            /// Create the rate table for the group (all the rates are marked as not supported).
+            station->m_groupsTable[groupId].m_ratesTable.Resize(m_numRates);
 
             // Initialize all modes supported by the remote station that belong to the current
             // group.
@@ -1790,23 +1824,14 @@ MinstrelHtWifiManager::RateInit(MinstrelHtWifiRemoteStation* station)
                         rateId %= (minstrelHtStandardInfos.at(WIFI_MOD_CLASS_HT).maxMcs + 1);
                     }
 
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].supported = true;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex =
-                        i; /// Mapping between rateId and operationalMcsSet
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].numRateAttempt = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].numRateSuccess = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].prob = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateAttempt = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].prevNumRateSuccess = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].numSamplesSkipped = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].successHist = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].attemptHist = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].throughput = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].perfectTxTime =
-                        GetFirstMpduTxTime(groupId, GetMcsSupported(station, i));
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 0;
-                    station->m_groupsTable[groupId].m_ratesTable[rateId].adjustedRetryCount = 0;
+                    // all the statistics have been zeroed when the table was created
+                    auto& ratesTable = station->m_groupsTable[groupId].m_ratesTable;
+                    ratesTable.supported[rateId] = 1;
+                    /// Mapping between rateId and operationalMcsSet
+                    ratesTable.mcsIndex[rateId] = i;
+                    ratesTable.perfectTxTime[rateId] = GetFirstMpduTxTime(groupId, rateId);
+                    ratesTable.perfectTxTimeSeconds[rateId] =
+                        ratesTable.perfectTxTime[rateId].GetSeconds();
                     CalculateRetransmits(station, groupId, rateId);
                 }
             }
@@ -1829,7 +1854,7 @@ MinstrelHtWifiManager::CalculateRetransmits(MinstrelHtWifiRemoteStation* station
     NS_LOG_FUNCTION(this << station << index);
     const auto groupId = GetGroupId(index);
     const auto rateId = GetRateId(index);
-    if (!station->m_groupsTable[groupId].m_ratesTable[rateId].retryUpdated)
+    if (!station->m_groupsTable[groupId].m_ratesTable.retryUpdated[rateId])
     {
         CalculateRetransmits(station, groupId, rateId);
     }
@@ -1848,23 +1873,23 @@ MinstrelHtWifiManager::CalculateRetransmits(MinstrelHtWifiRemoteStation* station
     Time txTime;
     const auto slotTime = GetPhy()->GetSlot();
 
-    if (station->m_groupsTable[groupId].m_ratesTable[rateId].ewmaProb < 1)
+    if (station->m_groupsTable[groupId].m_ratesTable.ewmaProb[rateId] < 1)
     {
-        station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 1;
+        station->m_groupsTable[groupId].m_ratesTable.retryCount[rateId] = 1;
     }
     else
     {
-        station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount = 2;
-        station->m_groupsTable[groupId].m_ratesTable[rateId].retryUpdated = true;
+        station->m_groupsTable[groupId].m_ratesTable.retryCount[rateId] = 2;
+        station->m_groupsTable[groupId].m_ratesTable.retryUpdated[rateId] = 1;
 
         auto mode =
-            GetMcsSupported(station, station->m_groupsTable[groupId].m_ratesTable[rateId].mcsIndex);
+            GetMcsSupported(station, station->m_groupsTable[groupId].m_ratesTable.mcsIndex[rateId]);
         WifiTxVector txVector;
         txVector.SetMode(mode);
         txVector.SetPreambleType(GetPreambleForTransmission(mode.GetModulationClass()));
 
-        const auto dataTxTime = GetFirstMpduTxTime(groupId, mode) +
-                                GetMpduTxTime(groupId, mode) * (station->m_avgAmpduLen - 1);
+        const auto dataTxTime = GetFirstMpduTxTime(groupId, rateId) +
+                                GetMpduTxTime(groupId, rateId) * (station->m_avgAmpduLen - 1);
         const auto ackTime = GetPhy()->GetSifs() + GetEstimatedAckTxTime(txVector);
 
         /* Contention time for first 2 tries */
@@ -1886,7 +1911,7 @@ MinstrelHtWifiManager::CalculateRetransmits(MinstrelHtWifiRemoteStation* station
             /* Total TX time after this try */
             txTime += cwTime + ackTime + dataTxTime;
         } while ((txTime < MilliSeconds(6)) &&
-                 (++station->m_groupsTable[groupId].m_ratesTable[rateId].retryCount < 7));
+                 (++station->m_groupsTable[groupId].m_ratesTable.retryCount[rateId] < 7));
     }
 }
 
@@ -1956,9 +1981,9 @@ MinstrelHtWifiManager::PrintTable(MinstrelHtWifiRemoteStation* station)
            "________last_______    ______sum-of________\n"
         << " mode guard #  rate  [name   idx airtime  max_tp]  [avg(tp) avg(prob) sd(prob)]  "
            "[prob.|retry|suc|att]  [#success | #attempts]\n";
-    for (std::size_t i = 0; i < m_numGroups; i++)
+    for (const auto groupId : station->m_supportedGroups)
     {
-        StatsDump(station, i, station->m_statsFile);
+        StatsDump(station, groupId, station->m_statsFile);
     }
 
     station->m_statsFile << "\nTotal packet count::    ideal "
@@ -1976,12 +2001,12 @@ MinstrelHtWifiManager::StatsDump(MinstrelHtWifiRemoteStation* station,
                                  std::ofstream& of)
 {
     auto numRates = m_numRates;
-    McsGroup group = m_minstrelGroups[groupId];
+    const auto& group = m_minstrelGroups[groupId];
     Time txTime;
     for (uint8_t i = 0; i < numRates; i++)
     {
         if (station->m_groupsTable[groupId].m_supported &&
-            station->m_groupsTable[groupId].m_ratesTable[i].supported)
+            station->m_groupsTable[groupId].m_ratesTable.supported[i])
         {
             of << group.type << " " << group.chWidth << "   " << group.gi << "  " << +group.streams
                << "   ";
@@ -2031,23 +2056,21 @@ MinstrelHtWifiManager::StatsDump(MinstrelHtWifiRemoteStation* station,
             of << "  " << std::setw(3) << idx << "  ";
 
             /* tx_time[rate(i)] in usec */
-            txTime = GetFirstMpduTxTime(
-                groupId,
-                GetMcsSupported(station, station->m_groupsTable[groupId].m_ratesTable[i].mcsIndex));
+            txTime = GetFirstMpduTxTime(groupId, i);
             of << std::setw(6) << txTime.GetMicroSeconds() << "  ";
 
             of << std::setw(7) << CalculateThroughput(station, groupId, i, 100) / 100 << "   "
-               << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].throughput / 100
-               << "   " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].ewmaProb
-               << "  " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].ewmsdProb
-               << "  " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable[i].prob
-               << "  " << std::setw(2) << station->m_groupsTable[groupId].m_ratesTable[i].retryCount
+               << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable.throughput[i] / 100
+               << "   " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable.ewmaProb[i]
+               << "  " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable.ewmsdProb[i]
+               << "  " << std::setw(7) << station->m_groupsTable[groupId].m_ratesTable.prob[i]
+               << "  " << std::setw(2) << station->m_groupsTable[groupId].m_ratesTable.retryCount[i]
                << "   " << std::setw(3)
-               << station->m_groupsTable[groupId].m_ratesTable[i].prevNumRateSuccess << "  "
-               << std::setw(3) << station->m_groupsTable[groupId].m_ratesTable[i].prevNumRateAttempt
+               << station->m_groupsTable[groupId].m_ratesTable.prevNumRateSuccess[i] << "  "
+               << std::setw(3) << station->m_groupsTable[groupId].m_ratesTable.prevNumRateAttempt[i]
                << "   " << std::setw(9)
-               << station->m_groupsTable[groupId].m_ratesTable[i].successHist << "   "
-               << std::setw(9) << station->m_groupsTable[groupId].m_ratesTable[i].attemptHist
+               << station->m_groupsTable[groupId].m_ratesTable.successHist[i] << "   "
+               << std::setw(9) << station->m_groupsTable[groupId].m_ratesTable.attemptHist[i]
                << "\n";
         }
     }
@@ -2167,18 +2190,15 @@ MinstrelHtWifiManager::GetLowestIndex(MinstrelHtWifiRemoteStation* station)
 {
     NS_LOG_FUNCTION(this << station);
 
-    std::size_t groupId = 0;
+    NS_ASSERT(!station->m_supportedGroups.empty());
+    const auto groupId = station->m_supportedGroups.front();
     uint8_t rateId = 0;
-    while (groupId < m_numGroups && !station->m_groupsTable[groupId].m_supported)
-    {
-        groupId++;
-    }
-    while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable[rateId].supported)
+    while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable.supported[rateId])
     {
         rateId++;
     }
     NS_ASSERT(station->m_groupsTable[groupId].m_supported &&
-              station->m_groupsTable[groupId].m_ratesTable[rateId].supported);
+              station->m_groupsTable[groupId].m_ratesTable.supported[rateId]);
     return GetIndex(groupId, rateId);
 }
 
@@ -2188,12 +2208,12 @@ MinstrelHtWifiManager::GetLowestIndex(MinstrelHtWifiRemoteStation* station, std:
     NS_LOG_FUNCTION(this << station << groupId);
 
     uint8_t rateId = 0;
-    while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable[rateId].supported)
+    while (rateId < m_numRates && !station->m_groupsTable[groupId].m_ratesTable.supported[rateId])
     {
         rateId++;
     }
     NS_ASSERT(station->m_groupsTable[groupId].m_supported &&
-              station->m_groupsTable[groupId].m_ratesTable[rateId].supported);
+              station->m_groupsTable[groupId].m_ratesTable.supported[rateId]);
     return GetIndex(groupId, rateId);
 }
 
@@ -19,14 +19,12 @@
 #include "ns3/wifi-remote-station-manager.h"
 #include "ns3/wifi-types.h"
 
+/// forward declaration of the test class
+class MinstrelHtStatsTest;
+
 namespace ns3
 {
 
-/**
- * Data structure to save transmission time calculations per rate.
- */
-typedef std::map<WifiMode, Time> TxTime;
-
 /**
  * @enum McsGroupType
  * @brief Available MCS group types
@@ -69,7 +67,8 @@ operator<<(std::ostream& os, McsGroupType type)
 
 /**
  * Data structure to contain the information that defines a group.
- * It also contains the transmission times for all the MCS in the group.
+ * It also contains the transmission times for all the MCS in the group, stored
+ * in arrays indexed by the rate ID of the MCS within the group.
  * A group is a collection of MCS defined by the number of spatial streams,
  * if it uses or not Short Guard Interval, and the channel width used.
  */
@@ -82,8 +81,8 @@ struct McsGroup
     bool isSupported;  ///< flag whether group is  supported
     // To accurately account for TX times, we separate the TX time of the first
     // MPDU in an A-MPDU from the rest of the MPDUs.
-    TxTime ratesTxTimeTable;          ///< rates transmit time table
-    TxTime ratesFirstMpduTxTimeTable; ///< rates MPDU transmit time table
+    std::vector<Time> ratesTxTimeTable;          ///< rates transmit time table
+    std::vector<Time> ratesFirstMpduTxTimeTable; ///< rates MPDU transmit time table
 };
 
 /**
@@ -92,49 +91,59 @@ struct McsGroup
  */
 typedef std::vector<McsGroup> MinstrelMcsGroups;
 
-struct MinstrelHtWifiRemoteStation;
-
 /**
- * A struct to contain all statistics information related to a data rate.
+ * A struct to contain all statistics information related to the data rates of a group.
+ *
+ * The statistics are stored as a structure of arrays, i.e., there is an array, indexed
+ * by the rate ID, for each statistic. This way, the periodic update of the statistics
+ * of the rates of a group visits contiguous memory locations and can be vectorized
+ * by the compiler.
  */
-struct MinstrelHtRateInfo
+struct MinstrelHtRateTable
 {
+    /**
+     * Resize all the arrays to the given number of rates and (re)initialize all the elements.
+     *
+     * @param nRates the number of rates
+     */
+    void Resize(std::size_t nRates);
+
     /**
      * Perfect transmission time calculation, or frame calculation.
      * Given a bit rate and a packet length n bytes.
      */
-    Time perfectTxTime;
-    bool supported;      //!< If the rate is supported.
-    uint8_t mcsIndex;    //!< The index in the operationalMcsSet of the WifiRemoteStationManager.
-    uint32_t retryCount; //!< Retry limit.
-    uint32_t adjustedRetryCount; //!< Adjust the retry limit for this rate.
-    uint32_t numRateAttempt;     //!< Number of transmission attempts so far.
-    uint32_t numRateSuccess;     //!< Number of successful frames transmitted so far.
-    double prob; //!< Current probability within last time interval. (# frame success )/(# total
-                 //!< frames)
-    bool retryUpdated; //!< If number of retries was updated already.
+    std::vector<Time> perfectTxTime;
+    std::vector<double> perfectTxTimeSeconds; //!< perfectTxTime in seconds (for the vectorized
+                                              //!< throughput computation).
+    std::vector<uint8_t> supported;           //!< If the rate is supported.
+    std::vector<uint8_t> mcsIndex;    //!< The index in the operationalMcsSet of the
+                                      //!< WifiRemoteStationManager.
+    std::vector<uint32_t> retryCount; //!< Retry limit.
+    std::vector<uint32_t> adjustedRetryCount; //!< Adjust the retry limit for this rate.
+    std::vector<uint32_t> numRateAttempt;     //!< Number of transmission attempts so far.
+    std::vector<uint32_t> numRateSuccess;     //!< Number of successful frames transmitted so far.
+    std::vector<double> prob; //!< Current probability within last time interval. (# frame
+                              //!< success )/(# total frames)
+    std::vector<uint8_t> retryUpdated; //!< If number of retries was updated already.
     /**
      * Exponential weighted moving average of probability.
      * EWMA calculation:
      * ewma_prob =[prob *(100 - ewma_level) + (ewma_prob_old * ewma_level)]/100
      */
-    double ewmaProb;
-    double ewmsdProb;            //!< Exponential weighted moving standard deviation of probability.
-    uint32_t prevNumRateAttempt; //!< Number of transmission attempts with previous rate.
-    uint32_t prevNumRateSuccess; //!< Number of successful frames transmitted with previous rate.
-    uint32_t numSamplesSkipped;  //!< Number of times this rate statistics were not updated because
-                                 //!< no attempts have been made.
-    uint64_t successHist;        //!< Aggregate of all transmission successes.
-    uint64_t attemptHist;        //!< Aggregate of all transmission attempts.
-    double throughput;           //!< Throughput of this rate (in packets per second).
+    std::vector<double> ewmaProb;
+    std::vector<double> ewmsdProb; //!< Exponential weighted moving standard deviation of
+                                   //!< probability.
+    std::vector<uint32_t> prevNumRateAttempt; //!< Number of transmission attempts with previous
+                                              //!< rate.
+    std::vector<uint32_t> prevNumRateSuccess; //!< Number of successful frames transmitted with
+                                              //!< previous rate.
+    std::vector<uint32_t> numSamplesSkipped;  //!< Number of times this rate statistics were not
+                                              //!< updated because no attempts have been made.
+    std::vector<uint64_t> successHist;        //!< Aggregate of all transmission successes.
+    std::vector<uint64_t> attemptHist;        //!< Aggregate of all transmission attempts.
+    std::vector<double> throughput; //!< Throughput of this rate (in packets per second).
 };
 
-/**
- * Data structure for a Minstrel Rate table.
- * A vector of a struct MinstrelHtRateInfo.
- */
-typedef std::vector<MinstrelHtRateInfo> MinstrelHtRate;
-
 /**
  * A struct to contain information of a group.
  */
@@ -149,7 +158,8 @@ struct GroupInfo
     uint16_t m_maxTpRate;        //!< The max throughput rate of this group in bps.
     uint16_t m_maxTpRate2;       //!< The second max throughput rate of this group in bps.
     uint16_t m_maxProbRate;      //!< The highest success probability rate of this group in bps.
-    MinstrelHtRate m_ratesTable; //!< Information about rates of this group.
+    MinstrelHtRateTable m_ratesTable; //!< Information about rates of this group (only
+                                      //!< allocated if the group is supported).
 };
 
 /**
@@ -158,6 +168,28 @@ struct GroupInfo
  */
 typedef std::vector<GroupInfo> McsGroupData;
 
+/// MinstrelHtWifiRemoteStation structure
+struct MinstrelHtWifiRemoteStation : MinstrelWifiRemoteStation
+{
+    std::size_t m_sampleGroup; //!< The group that the sample rate belongs to.
+
+    uint32_t m_sampleWait;     //!< How many transmission attempts to wait until a new sample.
+    uint32_t m_sampleTries;    //!< Number of sample tries after waiting sampleWait.
+    uint32_t m_sampleCount;    //!< Max number of samples per update interval.
+    uint32_t m_numSamplesSlow; //!< Number of times a slow rate was sampled.
+
+    uint32_t m_avgAmpduLen;      //!< Average number of MPDUs in an A-MPDU.
+    uint32_t m_ampduLen;         //!< Number of MPDUs in an A-MPDU.
+    uint32_t m_ampduPacketCount; //!< Number of A-MPDUs transmitted.
+
+    McsGroupData m_groupsTable;                 //!< Table of groups with stats.
+    std::vector<std::size_t> m_supportedGroups; //!< IDs of the groups supported by the station
+                                                //!< (sorted in increasing order).
+    bool m_isHt;                                //!< If the station is HT capable.
+
+    std::ofstream m_statsFile; //!< File where statistics table is written.
+};
+
 /**
  * @brief Implementation of Minstrel-HT Rate Control Algorithm
  * @ingroup wifi
@@ -201,6 +233,11 @@ typedef std::vector<GroupInfo> McsGroupData;
  *
  * When this rate control is configured but non-legacy modes are not supported,
  * Minstrel-HT uses legacy Minstrel (minstrel-wifi-manager) for rate control.
+ *
+ * If the LazyStatsUpdate attribute is set to true, transmission reports only
+ * update the per-rate counters, while the statistics update and the selection
+ * of the next rate are deferred until a TXVECTOR is requested for the station.
+ * The setting also applies to the legacy Minstrel instance.
  */
 class MinstrelHtWifiManager : public WifiRemoteStationManager
 {
@@ -238,6 +275,9 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
     typedef void (*RateChangeTracedCallback)(const uint64_t rate, const Mac48Address remoteAddress);
 
   private:
+    /// allow MinstrelHtStatsTest class access
+    friend class ::MinstrelHtStatsTest;
+
     void DoInitialize() override;
     WifiRemoteStation* DoCreateStation() const override;
     void DoReportRxOk(WifiRemoteStation* station, double rxSnr, WifiMode txMode) override;
@@ -327,37 +367,37 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
      * Obtain the TxTime saved in the group information.
      *
      * @param groupId the group ID
-     * @param mode the wifi mode
+     * @param rateId the rate ID
      * @returns the transmit time
      */
-    Time GetMpduTxTime(std::size_t groupId, WifiMode mode) const;
+    Time GetMpduTxTime(std::size_t groupId, uint8_t rateId) const;
 
     /**
      * Save a TxTime to the vector of groups.
      *
      * @param groupId the group ID
-     * @param mode the wifi mode
+     * @param rateId the rate ID
      * @param t the transmit time
      */
-    void AddMpduTxTime(std::size_t groupId, WifiMode mode, Time t);
+    void AddMpduTxTime(std::size_t groupId, uint8_t rateId, Time t);
 
     /**
      * Obtain the TxTime saved in the group information.
      *
      * @param groupId the group ID
-     * @param mode the wifi mode
+     * @param rateId the rate ID
      * @returns the transmit time
      */
-    Time GetFirstMpduTxTime(std::size_t groupId, WifiMode mode) const;
+    Time GetFirstMpduTxTime(std::size_t groupId, uint8_t rateId) const;
 
     /**
      * Save a TxTime to the vector of groups.
      *
      * @param groupId the group ID
-     * @param mode the wifi mode
+     * @param rateId the rate ID
      * @param t the transmit time
      */
-    void AddFirstMpduTxTime(std::size_t groupId, WifiMode mode, Time t);
+    void AddFirstMpduTxTime(std::size_t groupId, uint8_t rateId, Time t);
 
     /**
      * Update the number of retries and reset accordingly.
@@ -406,6 +446,33 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
      */
     void UpdateStats(MinstrelHtWifiRemoteStation* station);
 
+    /**
+     * Update the Minstrel Table, if the update interval has elapsed, and select the rate to
+     * use for the next transmission. If lazy statistics update is enabled, both operations
+     * are deferred until a TXVECTOR is requested for the given station.
+     *
+     * @param station the Minstrel-HT wifi remote station
+     */
+    void SelectRate(MinstrelHtWifiRemoteStation* station);
+
+    /**
+     * Update the Minstrel Table, if the update interval has elapsed, and select the rate to
+     * use for the next transmission.
+     *
+     * @param station the Minstrel-HT wifi remote station
+     */
+    void DoSelectRate(MinstrelHtWifiRemoteStation* station);
+
+    /**
+     * Update the success probability, its EWMA and EWMSD, and the throughput of all the
+     * supported rates of the given group, based on the attempts and successes counted
+     * since the last update, and reset the counters.
+     *
+     * @param station the Minstrel-HT wifi remote station
+     * @param groupId the group ID
+     */
+    void UpdateGroupStats(MinstrelHtWifiRemoteStation* station, std::size_t groupId);
+
     /**
      * Initialize Minstrel Table.
      *
@@ -414,7 +481,8 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
     void RateInit(MinstrelHtWifiRemoteStation* station);
 
     /**
-     * Return the average throughput of the MCS defined by groupId and rateId.
+     * Return the average throughput of the MCS defined by groupId and rateId. Note that
+     * UpdateGroupStats computes the same value for all the rates of a group in a single pass.
      *
      * @param station the Minstrel-HT wifi remote station
      * @param groupId the group ID
@@ -710,6 +778,7 @@ class MinstrelHtWifiManager : public WifiRemoteStationManager
     bool m_useLatestAmendmentOnly; //!< Flag if only the latest supported amendment by both peers
                                    //!< should be used.
     bool m_printStats;             //!< If statistics table should be printed.
+    bool m_lazyStatsUpdate;        //!< Whether to defer stats update and rate selection until TX.
 
     MinstrelMcsGroups m_minstrelGroups; //!< Global array for groups information.
 
@@ -82,6 +82,13 @@ MinstrelWifiManager::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&MinstrelWifiManager::m_printSamples),
                           MakeBooleanChecker())
+            .AddAttribute("LazyStatsUpdate",
+                          "If true, transmission reports only update the per-rate counters, "
+                          "while the statistics update and the rate selection are deferred "
+                          "until a TXVECTOR is requested for the station",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&MinstrelWifiManager::m_lazyStatsUpdate),
+                          MakeBooleanChecker())
             .AddTraceSource("Rate",
                             "Traced value for rate changes (b/s)",
                             MakeTraceSourceAccessor(&MinstrelWifiManager::m_currentRate),
@@ -188,6 +195,7 @@ MinstrelWifiManager::DoCreateStation() const
     station->m_retry = 0;
     station->m_txrate = 0;
     station->m_initialized = false;
+    station->m_rateDecisionPending = false;
 
     return station;
 }
@@ -385,6 +393,10 @@ MinstrelWifiManager::GetDataTxVector(MinstrelWifiRemoteStation* station)
     {
         CheckInit(station);
     }
+    if (station->m_rateDecisionPending)
+    {
+        DoSelectRate(station);
+    }
     WifiMode mode = GetSupported(station, station->m_txrate);
     uint64_t rate = mode.GetDataRate(channelWidth);
     if (m_currentRate != rate && !station->m_isSampling)
@@ -408,6 +420,10 @@ WifiTxVector
 MinstrelWifiManager::GetRtsTxVector(MinstrelWifiRemoteStation* station)
 {
     NS_LOG_FUNCTION(this << station);
+    if (station->m_rateDecisionPending)
+    {
+        DoSelectRate(station);
+    }
     NS_LOG_DEBUG("DoGetRtsMode m_txrate=" << station->m_txrate);
     auto channelWidth = GetChannelWidth(station);
     if (channelWidth > MHz_u{20} && channelWidth != MHz_u{22})
@@ -567,6 +583,34 @@ MinstrelWifiManager::FindRate(MinstrelWifiRemoteStation* station)
     return idx;
 }
 
+void
+MinstrelWifiManager::SelectRate(MinstrelWifiRemoteStation* station)
+{
+    NS_LOG_FUNCTION(this << station);
+    if (m_lazyStatsUpdate)
+    {
+        NS_LOG_DEBUG("Rate selection deferred until the next transmission");
+        station->m_rateDecisionPending = true;
+        return;
+    }
+    DoSelectRate(station);
+}
+
+void
+MinstrelWifiManager::DoSelectRate(MinstrelWifiRemoteStation* station)
+{
+    NS_LOG_FUNCTION(this << station);
+    station->m_rateDecisionPending = false;
+    ++m_nRateDecisions;
+    UpdateStats(station);
+
+    if (station->m_nModes >= 1)
+    {
+        station->m_txrate = FindRate(station);
+    }
+    NS_LOG_DEBUG("Next rate to use TxRate = " << station->m_txrate);
+}
+
 void
 MinstrelWifiManager::UpdateStats(MinstrelWifiRemoteStation* station)
 {
@@ -839,13 +883,7 @@ MinstrelWifiManager::DoReportDataOk(WifiRemoteStation* st,
                  << " (after update).");
 
     UpdateRetry(station);
-    UpdateStats(station);
-
-    if (station->m_nModes >= 1)
-    {
-        station->m_txrate = FindRate(station);
-    }
-    NS_LOG_DEBUG("Next rate to use TxRate = " << station->m_txrate);
+    SelectRate(station);
 }
 
 void
@@ -869,19 +907,13 @@ MinstrelWifiManager::DoReportFinalDataFailed(WifiRemoteStation* st)
     UpdatePacketCounters(station);
 
     UpdateRetry(station);
-    UpdateStats(station);
+    const auto txrate = station->m_txrate;
+    SelectRate(station);
 
     NS_LOG_DEBUG("DoReportFinalDataFailed m_txrate = "
-                 << station->m_txrate
-                 << ", attempt = " << station->m_minstrelTable[station->m_txrate].numRateAttempt
-                 << ", success = " << station->m_minstrelTable[station->m_txrate].numRateSuccess
-                 << " (after update).");
-
-    if (station->m_nModes >= 1)
-    {
-        station->m_txrate = FindRate(station);
-    }
-    NS_LOG_DEBUG("Next rate to use TxRate = " << station->m_txrate);
+                 << txrate << ", attempt = " << station->m_minstrelTable[txrate].numRateAttempt
+                 << ", success = " << station->m_minstrelTable[txrate].numRateSuccess
+                 << (station->m_rateDecisionPending ? " (update deferred)." : " (after update)."));
 }
 
 void
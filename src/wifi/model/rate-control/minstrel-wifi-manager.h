@@ -16,6 +16,8 @@
 #include <fstream>
 #include <map>
 
+class MinstrelLazyStatsUpdateTest;
+
 namespace ns3
 {
 
@@ -97,6 +99,7 @@ struct MinstrelWifiRemoteStation : public WifiRemoteStation
     uint32_t m_retry;             ///< total retries short + long
     uint16_t m_txrate;            ///< current transmit rate in bps
     bool m_initialized;           ///< for initializing tables
+    bool m_rateDecisionPending;   ///< whether the rate must be selected before the next TX
     MinstrelRate m_minstrelTable; ///< minstrel table
     SampleRate m_sampleTable;     ///< sample table
     std::ofstream m_statsFile;    ///< stats file
@@ -142,6 +145,14 @@ struct MinstrelWifiRemoteStation : public WifiRemoteStation
  * not apply EWMA but instead assigns the entire probability.
  * Since the EWMA probability is initialized to zero, this generates
  * a more accurate EWMA.
+ *
+ * By default, statistics are updated (if the update interval has elapsed) and
+ * the next rate is selected every time a transmission outcome is reported.
+ * If the LazyStatsUpdate attribute is set to true, reports only update the
+ * per-rate attempt and success counters, while the statistics update and the
+ * rate selection are deferred until a TXVECTOR is requested for the station.
+ * Multiple reports received in between two transmissions thus trigger a
+ * single rate selection, and stations that are not transmitted to cost nothing.
  */
 class MinstrelWifiManager : public WifiRemoteStationManager
 {
@@ -180,6 +191,15 @@ class MinstrelWifiManager : public WifiRemoteStationManager
      */
     uint16_t FindRate(MinstrelWifiRemoteStation* station);
 
+    /**
+     * Update the Minstrel Table, if the update interval has elapsed, and select the rate to
+     * use for the next transmission. If lazy statistics update is enabled, both operations
+     * are deferred until a TXVECTOR is requested for the given station.
+     *
+     * @param station the station object
+     */
+    void SelectRate(MinstrelWifiRemoteStation* station);
+
     /**
      * Get data transmit vector.
      *
@@ -233,6 +253,9 @@ class MinstrelWifiManager : public WifiRemoteStationManager
     void InitSampleTable(MinstrelWifiRemoteStation* station);
 
   private:
+    /// allow MinstrelLazyStatsUpdateTest class access
+    friend class ::MinstrelLazyStatsUpdateTest;
+
     void DoInitialize() override;
     WifiRemoteStation* DoCreateStation() const override;
     void DoReportRxOk(WifiRemoteStation* station, double rxSnr, WifiMode txMode) override;
@@ -268,6 +291,14 @@ class MinstrelWifiManager : public WifiRemoteStationManager
      */
     bool DoNeedRetransmission(WifiRemoteStation* st, Ptr<const Packet> packet, bool normally);
 
+    /**
+     * Update the Minstrel Table, if the update interval has elapsed, and select the rate to
+     * use for the next transmission.
+     *
+     * @param station the station object
+     */
+    void DoSelectRate(MinstrelWifiRemoteStation* station);
+
     /**
      * Estimate the TxTime of a packet with a given mode.
      *
@@ -342,14 +373,16 @@ class MinstrelWifiManager : public WifiRemoteStationManager
      */
     typedef std::map<WifiMode, Time> TxTime;
 
-    TxTime m_calcTxTime;      ///< to hold all the calculated TxTime for all modes
-    Time m_updateStats;       ///< how frequent do we calculate the stats
-    uint8_t m_lookAroundRate; ///< the % to try other rates than our current rate
-    uint8_t m_ewmaLevel;      ///< exponential weighted moving average
-    uint8_t m_sampleCol;      ///< number of sample columns
-    uint32_t m_pktLen;        ///< packet length used to calculate mode TxTime
-    bool m_printStats;        ///< whether statistics table should be printed.
-    bool m_printSamples;      ///< whether samples table should be printed.
+    TxTime m_calcTxTime;          ///< to hold all the calculated TxTime for all modes
+    Time m_updateStats;           ///< how frequent do we calculate the stats
+    uint8_t m_lookAroundRate;     ///< the % to try other rates than our current rate
+    uint8_t m_ewmaLevel;          ///< exponential weighted moving average
+    uint8_t m_sampleCol;          ///< number of sample columns
+    uint32_t m_pktLen;            ///< packet length used to calculate mode TxTime
+    bool m_printStats;            ///< whether statistics table should be printed.
+    bool m_printSamples;          ///< whether samples table should be printed.
+    bool m_lazyStatsUpdate;       ///< whether to defer stats update and rate selection until TX
+    uint64_t m_nRateDecisions{0}; ///< number of rate selections performed for all stations
 
     /// Provides uniform random variables.
     Ptr<UniformRandomVariable> m_uniformRandomVariable;
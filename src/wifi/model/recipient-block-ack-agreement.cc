@@ -244,12 +244,10 @@ RecipientBlockAckAgreement::FillBlockAckBitmap(CtrlBAckResponseHeader& blockAckH
         blockAckHeader.SetStartingSequence(ssn, index);
         blockAckHeader.ResetBitmap(index);
 
-        for (std::size_t i = 0; i < m_scoreboard.GetWinSize(); i++)
+        for (auto i = m_scoreboard.FindFirstSet(); i < m_scoreboard.GetWinSize();
+             i = m_scoreboard.FindFirstSet(i + 1))
         {
-            if (m_scoreboard.At(i))
-            {
-                blockAckHeader.SetReceivedPacket((ssn + i) % SEQNO_SPACE_SIZE, index);
-            }
+            blockAckHeader.SetReceivedPacket((ssn + i) % SEQNO_SPACE_SIZE, index);
         }
     }
 }
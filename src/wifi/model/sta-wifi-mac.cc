@@ -10,6 +10,7 @@
 
 #include "sta-wifi-mac.h"
 
+#include "beacon-digest-tag.h"
 #include "channel-access-manager.h"
 #include "frame-exchange-manager.h"
 #include "mgt-action-headers.h"
@@ -145,6 +146,13 @@ StaWifiMac::GetTypeId()
                             "Information about every received Beacon frame",
                             MakeTraceSourceAccessor(&StaWifiMac::m_beaconInfo),
                             "ns3::ApInfo::TracedCallback")
+            .AddTraceSource("BeaconSkipped",
+                            "A Beacon frame sent by an AP operating in abstracted beacon mode was "
+                            "not deserialized, because it is a placeholder or its content did not "
+                            "change since the last Beacon frame processed. Provides the ID of the "
+                            "link and the address of the AP.",
+                            MakeTraceSourceAccessor(&StaWifiMac::m_beaconSkipped),
+                            "ns3::StaWifiMac::BeaconSkippedCallback")
             .AddTraceSource("EmlsrLinkSwitch",
                             "Trace start/end of EMLSR link switch events. Specifically, this trace "
                             "is fired: (i) when a PHY _operating on a link_ starts switching to "
@@ -1273,6 +1281,33 @@ StaWifiMac::ReceiveBeacon(Ptr<const WifiMpdu> mpdu, uint8_t linkId)
     NS_ASSERT(hdr.IsBeacon());
 
     NS_LOG_DEBUG("Beacon received");
+
+    // If the AP operates in abstracted beacon mode, this Beacon frame is not deserialized if
+    // it is a placeholder (which carries no content) or, while we are associated, if its
+    // content is the same as that of the last Beacon frame processed and applied
+    BeaconDigestTag digestTag;
+    const auto hasDigest = mpdu->GetPacket()->PeekPacketTag(digestTag);
+    if (hasDigest)
+    {
+        const auto& beaconDigests = GetLink(linkId).beaconDigests;
+        const auto it = beaconDigests.find(from);
+        const auto known = (it != beaconDigests.cend());
+        if (digestTag.IsPlaceholder() ||
+            (m_state == ASSOCIATED && m_beaconInfo.IsEmpty() && known && it->second.applied &&
+             it->second.digest == digestTag.Get()))
+        {
+            NS_LOG_DEBUG("Placeholder Beacon frame or content unchanged, skip processing");
+            m_beaconSkipped(linkId, from);
+            if (const auto& bssid = GetLink(linkId).bssid;
+                m_state == ASSOCIATED && known && bssid && hdr.GetAddr3() == *bssid)
+            {
+                m_beaconArrival(Simulator::Now());
+                RestartBeaconWatchdog(it->second.beaconInterval * m_maxMissedBeacons);
+            }
+            return;
+        }
+    }
+
     MgtBeaconHeader beacon;
     mpdu->GetPacket()->PeekHeader(beacon);
     const auto& capabilities = beacon.Capabilities();
@@ -1310,6 +1345,15 @@ StaWifiMac::ReceiveBeacon(Ptr<const WifiMpdu> mpdu, uint8_t linkId)
     RecordCapabilities(beacon, from, linkId);
     RecordOperations(beacon, from, linkId);
 
+    if (hasDigest)
+    {
+        GetLink(linkId).beaconDigests[from] = {
+            .digest = digestTag.Get(),
+            .beaconInterval = MicroSeconds(
+                std::get<MgtBeaconHeader>(apInfo.m_frame).GetBeaconIntervalUs()),
+            .applied = (m_state == ASSOCIATED && goodBeacon)};
+    }
+
     if (!goodBeacon)
     {
         NS_LOG_LOGIC("Beacon is not for us");
@@ -2017,6 +2061,18 @@ StaWifiMac::GetCapabilities(uint8_t linkId) const
 void
 StaWifiMac::SetState(MacState value)
 {
+    if (value != ASSOCIATED)
+    {
+        // the operational settings advertised in the Beacon frames received while associated
+        // have to be applied again in the next association
+        for (auto& [id, link] : GetLinks())
+        {
+            for (auto& [apAddr, beaconDigest] : GetStaLink(link).beaconDigests)
+            {
+                beaconDigest.applied = false;
+            }
+        }
+    }
     m_state = value;
 }
 
@@ -374,6 +374,19 @@ class StaWifiMac : public WifiMac
                                                              associated, or the PM mode to switch
                                                              to upon association, otherwise */
         bool emlsrEnabled{false}; //!< whether EMLSR mode is enabled on this link
+
+        /// Information about the last Beacon frame processed that was sent by an AP
+        /// operating in abstracted beacon mode
+        struct BeaconDigest
+        {
+            uint32_t digest;     //!< the digest of the content of the Beacon frame
+            Time beaconInterval; //!< the beacon interval advertised in the Beacon frame
+            bool applied;        //!< whether the operational settings advertised in the Beacon
+                                 //!< frame were applied in the current association
+        };
+
+        /// Information about the last Beacon frame processed, per transmitting AP
+        std::map<Mac48Address, BeaconDigest> beaconDigests;
     };
 
     /**
@@ -679,12 +692,16 @@ class StaWifiMac : public WifiMac
     TracedCallback<Mac48Address> m_deAssocLogger;           ///< disassociation logger
     TracedCallback<Time> m_beaconArrival;                   ///< beacon arrival logger
     TracedCallback<ApInfo> m_beaconInfo;                    ///< beacon info logger
+    TracedCallback<uint8_t, Mac48Address> m_beaconSkipped;  ///< skipped beacon logger
     TracedCallback<uint8_t, Ptr<WifiPhy>, bool>
         m_emlsrLinkSwitchLogger; ///< EMLSR link switch logger
 
     /// TracedCallback signature for link setup completed/canceled events
     using LinkSetupCallback = void (*)(uint8_t /* link ID */, Mac48Address /* AP address */);
 
+    /// TracedCallback signature for skipped Beacon frame events
+    using BeaconSkippedCallback = void (*)(uint8_t /* link ID */, Mac48Address /* AP address */);
+
     /// TracedCallback signature for EMLSR link switch events
     using EmlsrLinkSwitchCallback = void (*)(uint8_t /* link ID */, Ptr<WifiPhy> /* PHY */);
 };
@@ -14,32 +14,45 @@
 #include "ns3/mac48-address.h"
 #include "ns3/simulator.h"
 
-#include <vector>
-
 namespace ns3
 {
 
+WifiMacQueueContainer::QueueInfo::QueueInfo(WifiMacQueueElemPool* pool)
+    : queue(pool)
+{
+}
+
+WifiMacQueueContainer::WifiMacQueueContainer()
+    : m_expiredQueue(&m_pool)
+{
+}
+
 void
 WifiMacQueueContainer::clear()
 {
     m_queues.clear();
     m_expiredQueue.clear();
-    m_nBytesPerQueue.clear();
+}
+
+WifiMacQueueContainer::QueueInfo&
+WifiMacQueueContainer::GetQueueInfo(const WifiContainerQueueId& queueId) const
+{
+    return m_queues.try_emplace(queueId, &m_pool).first->second;
 }
 
 WifiMacQueueContainer::iterator
 WifiMacQueueContainer::insert(const_iterator pos, Ptr<WifiMpdu> item)
 {
     WifiContainerQueueId queueId = GetQueueId(item);
+    auto& queueInfo = GetQueueInfo(queueId);
 
-    NS_ABORT_MSG_UNLESS(pos == m_queues[queueId].cend() || GetQueueId(pos->mpdu) == queueId,
+    NS_ABORT_MSG_UNLESS(pos == queueInfo.queue.cend() || GetQueueId(pos->mpdu) == queueId,
                         "pos iterator does not point to the correct container queue");
     NS_ABORT_MSG_IF(!item->IsOriginal(), "Only the original copy of an MPDU can be inserted");
 
-    auto [it, ret] = m_nBytesPerQueue.insert({queueId, 0});
-    it->second += item->GetSize();
+    queueInfo.nBytes += item->GetSize();
 
-    return m_queues[queueId].emplace(pos, item);
+    return queueInfo.queue.emplace(pos, item);
 }
 
 WifiMacQueueContainer::iterator
@@ -50,13 +63,12 @@ WifiMacQueueContainer::erase(const_iterator pos)
         return m_expiredQueue.erase(pos);
     }
 
-    WifiContainerQueueId queueId = GetQueueId(pos->mpdu);
-    auto it = m_nBytesPerQueue.find(queueId);
-    NS_ASSERT(it != m_nBytesPerQueue.end());
-    NS_ASSERT(it->second >= pos->mpdu->GetSize());
-    it->second -= pos->mpdu->GetSize();
+    auto it = m_queues.find(GetQueueId(pos->mpdu));
+    NS_ASSERT(it != m_queues.end());
+    NS_ASSERT(it->second.nBytes >= pos->mpdu->GetSize());
+    it->second.nBytes -= pos->mpdu->GetSize();
 
-    return m_queues[queueId].erase(pos);
+    return it->second.queue.erase(pos);
 }
 
 Ptr<WifiMpdu>
@@ -106,28 +118,35 @@ WifiMacQueueContainer::GetQueueId(Ptr<const WifiMpdu> mpdu)
 const WifiMacQueueContainer::ContainerQueue&
 WifiMacQueueContainer::GetQueue(const WifiContainerQueueId& queueId) const
 {
-    return m_queues[queueId];
+    return GetQueueInfo(queueId).queue;
 }
 
 uint32_t
 WifiMacQueueContainer::GetNBytes(const WifiContainerQueueId& queueId) const
 {
-    if (auto it = m_queues.find(queueId); it == m_queues.end() || it->second.empty())
+    if (auto it = m_queues.find(queueId); it != m_queues.end() && !it->second.queue.empty())
     {
-        return 0;
+        return it->second.nBytes;
     }
-    return m_nBytesPerQueue.at(queueId);
+    return 0;
+}
+
+const WifiMacQueueElemPool&
+WifiMacQueueContainer::GetPool() const
+{
+    return m_pool;
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
 WifiMacQueueContainer::ExtractExpiredMpdus(const WifiContainerQueueId& queueId) const
 {
-    return DoExtractExpiredMpdus(m_queues[queueId]);
+    return DoExtractExpiredMpdus(GetQueueInfo(queueId));
 }
 
 std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>
-WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
+WifiMacQueueContainer::DoExtractExpiredMpdus(QueueInfo& queueInfo) const
 {
+    auto& queue = queueInfo.queue;
     std::optional<std::pair<WifiMacQueueContainer::iterator, WifiMacQueueContainer::iterator>> ret;
     auto firstExpiredIt = queue.begin();
     auto lastExpiredIt = firstExpiredIt;
@@ -157,11 +176,8 @@ WifiMacQueueContainer::DoExtractExpiredMpdus(ContainerQueue& queue) const
             lastExpiredIt->ac = AC_UNDEF;
             lastExpiredIt->deleter(lastExpiredIt->mpdu);
 
-            WifiContainerQueueId queueId = GetQueueId(lastExpiredIt->mpdu);
-            auto it = m_nBytesPerQueue.find(queueId);
-            NS_ASSERT(it != m_nBytesPerQueue.end());
-            NS_ASSERT(it->second >= lastExpiredIt->mpdu->GetSize());
-            it->second -= lastExpiredIt->mpdu->GetSize();
+            NS_ASSERT(queueInfo.nBytes >= lastExpiredIt->mpdu->GetSize());
+            queueInfo.nBytes -= lastExpiredIt->mpdu->GetSize();
 
             ++lastExpiredIt;
         }
@@ -215,16 +231,22 @@ std::size_t
 std::hash<ns3::WifiContainerQueueId>::operator()(ns3::WifiContainerQueueId queueId) const
 {
     auto [type, addrType, address, tid] = queueId;
-    const std::size_t size = tid.has_value() ? 8 : 7;
 
-    std::vector<uint8_t> buffer(size);
-    buffer[0] = type;
-    address.CopyTo(&buffer[1]);
+    // pack the queue ID into a 64-bit integer (48 bits of address, 8 bits of TID,
+    // 1 bit indicating whether the TID is present, 2 bits of receiver address type
+    // and 2 bits of queue type) to avoid allocating memory at every lookup
+    uint8_t buffer[6];
+    address.CopyTo(buffer);
+    uint64_t key = 0;
+    for (const auto byte : buffer)
+    {
+        key = (key << 8) | byte;
+    }
     if (tid.has_value())
     {
-        buffer[7] = *tid;
+        key |= (static_cast<uint64_t>(*tid) << 48) | (1ULL << 56);
     }
+    key |= (static_cast<uint64_t>(addrType) << 57) | (static_cast<uint64_t>(type) << 59);
 
-    std::string s(buffer.begin(), buffer.end());
-    return std::hash<std::string>{}(s);
+    return std::hash<uint64_t>{}(key);
 }
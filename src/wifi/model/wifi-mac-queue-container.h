@@ -13,7 +13,6 @@
 
 #include "ns3/mac48-address.h"
 
-#include <list>
 #include <optional>
 #include <tuple>
 #include <unordered_map>
@@ -114,17 +113,25 @@ namespace ns3
  *
  * This container holds multiple container queues organized in an hash table
  * whose keys are WifiContainerQueueId tuples identifying the container queues.
+ * Container queues are intrusive lists whose elements are allocated from a pool
+ * owned by the container, so that enqueuing and dequeuing MPDUs do not require
+ * heap allocations in steady state.
  */
 class WifiMacQueueContainer
 {
   public:
     /// Type of a queue held by the container
-    using ContainerQueue = std::list<WifiMacQueueElem>;
+    using ContainerQueue = WifiMacQueueElemList;
     /// iterator over elements in a container queue
     using iterator = ContainerQueue::iterator;
     /// const iterator over elements in a container queue
     using const_iterator = ContainerQueue::const_iterator;
 
+    WifiMacQueueContainer();
+
+    WifiMacQueueContainer(const WifiMacQueueContainer&) = delete;
+    WifiMacQueueContainer& operator=(const WifiMacQueueContainer&) = delete;
+
     /**
      * Erase all elements from the container.
      */
@@ -209,22 +216,52 @@ class WifiMacQueueContainer
      */
     std::pair<iterator, iterator> GetAllExpiredMpdus() const;
 
+    /**
+     * @return a const reference to the pool used to allocate the elements of this container
+     */
+    const WifiMacQueueElemPool& GetPool() const;
+
   private:
+    /**
+     * Information associated with a container queue.
+     */
+    struct QueueInfo
+    {
+        /**
+         * Constructor.
+         *
+         * @param pool the pool used to allocate the elements of the container queue
+         */
+        QueueInfo(WifiMacQueueElemPool* pool);
+
+        ContainerQueue queue; //!< the container queue
+        uint32_t nBytes{0};   //!< size in bytes of the container queue
+    };
+
+    /**
+     * Get a reference to the information associated with the container queue identified
+     * by the given QueueId. The container queue is created if it does not exist.
+     *
+     * @param queueId the given QueueId
+     * @return a reference to the information associated with the given container queue
+     */
+    QueueInfo& GetQueueInfo(const WifiContainerQueueId& queueId) const;
+
     /**
      * Transfer non-inflight MPDUs with expired lifetime in the given container queue to the
      * container queue storing MPDUs with expired lifetime.
      *
-     * @param queue the given container queue
+     * @param queueInfo the information associated with the given container queue
      * @return the range [first, last) of iterators pointing to the MPDUs transferred
      *         to the container queue storing MPDUs with expired lifetime
      */
-    std::pair<iterator, iterator> DoExtractExpiredMpdus(ContainerQueue& queue) const;
+    std::pair<iterator, iterator> DoExtractExpiredMpdus(QueueInfo& queueInfo) const;
 
-    mutable std::unordered_map<WifiContainerQueueId, ContainerQueue>
+    // the pool must be declared first so that it is destroyed after all the queues
+    mutable WifiMacQueueElemPool m_pool; //!< pool of container queue elements
+    mutable std::unordered_map<WifiContainerQueueId, QueueInfo>
         m_queues;                          //!< the container queues
     mutable ContainerQueue m_expiredQueue; //!< queue storing MPDUs with expired lifetime
-    mutable std::unordered_map<WifiContainerQueueId, uint32_t>
-        m_nBytesPerQueue; //!< size in bytes of the container queues
 };
 
 } // namespace ns3
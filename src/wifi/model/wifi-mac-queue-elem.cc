@@ -10,6 +10,10 @@
 
 #include "wifi-mpdu.h"
 
+#include "ns3/assert.h"
+
+#include <new>
+
 namespace ns3
 {
 
@@ -27,4 +31,196 @@ WifiMacQueueElem::~WifiMacQueueElem()
     inflights.clear();
 }
 
+/*
+ * WifiMacQueueElemPool
+ */
+
+WifiMacQueueElemPool::WifiMacQueueElemPool(std::size_t blockSize)
+    : m_blockSize(blockSize)
+{
+    NS_ASSERT(m_blockSize > 0);
+}
+
+WifiMacQueueElemPool::~WifiMacQueueElemPool()
+{
+    NS_ASSERT_MSG(m_nAllocated == 0, "Pool destroyed while elements are still in use");
+}
+
+WifiMacQueueElem*
+WifiMacQueueElemPool::Create(Ptr<WifiMpdu> item)
+{
+    if (!m_free)
+    {
+        // the pool is exhausted, allocate a new block and chain its slots in the free list
+        auto& block = m_blocks.emplace_back(new Slot[m_blockSize]);
+        for (std::size_t i = 0; i < m_blockSize; ++i)
+        {
+            block[i].next = (i + 1 < m_blockSize ? &block[i + 1] : nullptr);
+        }
+        m_free = &block[0];
+    }
+
+    auto slot = m_free;
+    m_free = slot->next;
+    ++m_nAllocated;
+    return new (slot->storage) WifiMacQueueElem(item);
+}
+
+void
+WifiMacQueueElemPool::Destroy(WifiMacQueueElem* elem)
+{
+    NS_ASSERT(m_nAllocated > 0);
+    elem->~WifiMacQueueElem();
+    auto slot = reinterpret_cast<Slot*>(elem);
+    slot->next = m_free;
+    m_free = slot;
+    --m_nAllocated;
+}
+
+std::size_t
+WifiMacQueueElemPool::GetNAllocated() const
+{
+    return m_nAllocated;
+}
+
+std::size_t
+WifiMacQueueElemPool::GetCapacity() const
+{
+    return m_blocks.size() * m_blockSize;
+}
+
+/*
+ * WifiMacQueueElemList
+ */
+
+WifiMacQueueElemList::WifiMacQueueElemList(WifiMacQueueElemPool* pool)
+    : m_pool(pool)
+{
+    NS_ASSERT(m_pool);
+    m_head.prev = m_head.next = &m_head;
+}
+
+WifiMacQueueElemList::~WifiMacQueueElemList()
+{
+    clear();
+}
+
+WifiMacQueueElemList::iterator
+WifiMacQueueElemList::begin()
+{
+    return iterator(m_head.next);
+}
+
+WifiMacQueueElemList::iterator
+WifiMacQueueElemList::end()
+{
+    return iterator(&m_head);
+}
+
+WifiMacQueueElemList::const_iterator
+WifiMacQueueElemList::begin() const
+{
+    return cbegin();
+}
+
+WifiMacQueueElemList::const_iterator
+WifiMacQueueElemList::end() const
+{
+    return cend();
+}
+
+WifiMacQueueElemList::const_iterator
+WifiMacQueueElemList::cbegin() const
+{
+    return const_iterator(m_head.next);
+}
+
+WifiMacQueueElemList::const_iterator
+WifiMacQueueElemList::cend() const
+{
+    return const_iterator(const_cast<WifiMacQueueElemHook*>(&m_head));
+}
+
+std::size_t
+WifiMacQueueElemList::size() const
+{
+    return m_size;
+}
+
+bool
+WifiMacQueueElemList::empty() const
+{
+    return m_size == 0;
+}
+
+WifiMacQueueElemList::iterator
+WifiMacQueueElemList::emplace(const_iterator pos, Ptr<WifiMpdu> item)
+{
+    auto next = pos.GetNode();
+    WifiMacQueueElemHook* elem = m_pool->Create(item);
+    elem->next = next;
+    elem->prev = next->prev;
+    next->prev->next = elem;
+    next->prev = elem;
+    ++m_size;
+    return iterator(elem);
+}
+
+WifiMacQueueElemList::iterator
+WifiMacQueueElemList::erase(const_iterator pos)
+{
+    auto node = pos.GetNode();
+    NS_ASSERT(node != &m_head);
+    auto next = node->next;
+    node->prev->next = next;
+    next->prev = node->prev;
+    --m_size;
+    m_pool->Destroy(static_cast<WifiMacQueueElem*>(node));
+    return iterator(next);
+}
+
+void
+WifiMacQueueElemList::splice(const_iterator pos,
+                             WifiMacQueueElemList& other,
+                             const_iterator first,
+                             const_iterator last)
+{
+    NS_ASSERT(m_pool == other.m_pool);
+
+    if (first == last)
+    {
+        return;
+    }
+
+    if (&other != this)
+    {
+        std::size_t n = std::distance(first, last);
+        other.m_size -= n;
+        m_size += n;
+    }
+
+    auto firstNode = first.GetNode();
+    auto lastNode = last.GetNode()->prev; // last node of the range
+    auto posNode = pos.GetNode();
+
+    // unlink the range from the other list
+    firstNode->prev->next = last.GetNode();
+    last.GetNode()->prev = firstNode->prev;
+
+    // link the range before pos
+    firstNode->prev = posNode->prev;
+    lastNode->next = posNode;
+    posNode->prev->next = firstNode;
+    posNode->prev = lastNode;
+}
+
+void
+WifiMacQueueElemList::clear()
+{
+    while (m_size > 0)
+    {
+        erase(cbegin());
+    }
+}
+
 } // namespace ns3
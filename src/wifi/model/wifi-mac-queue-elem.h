@@ -14,13 +14,30 @@
 #include "ns3/callback.h"
 #include "ns3/nstime.h"
 
+#include <cstddef>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace ns3
 {
 
 class WifiMpdu;
 
+/**
+ * @ingroup wifi
+ * Links used to chain the elements of a WifiMacQueueElemList. Such links are embedded
+ * in the elements themselves (intrusive list), so that no additional node has to be
+ * allocated when an element is inserted into a list or moved between lists.
+ */
+struct WifiMacQueueElemHook
+{
+    WifiMacQueueElemHook* prev{nullptr}; ///< previous element in the list
+    WifiMacQueueElemHook* next{nullptr}; ///< next element in the list
+};
+
 /**
  * @ingroup wifi
  * Type of elements stored in a WifiMacQueue container.
@@ -36,7 +53,7 @@ class WifiMpdu;
  * For consistency, also data frame transmitted by non-MLDs have an alias, which is
  * simply a pointer to the original version of the data frame.
  */
-struct WifiMacQueueElem
+struct WifiMacQueueElem : public WifiMacQueueElemHook
 {
     Ptr<WifiMpdu> mpdu;                         ///< MPDU stored by this element
     Time expiryTime{0};                         ///< expiry time of the MPDU (set by WifiMacQueue)
@@ -55,6 +72,268 @@ struct WifiMacQueueElem
     ~WifiMacQueueElem();
 };
 
+/**
+ * @ingroup wifi
+ * Pool of WifiMacQueueElem objects.
+ *
+ * Memory for queue elements is allocated in blocks of a given number of elements and
+ * released elements are kept in a free list to be reused by subsequent allocations.
+ * Memory blocks are only returned to the system when the pool is destroyed, hence
+ * the pool must outlive all the elements it allocated.
+ */
+class WifiMacQueueElemPool
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param blockSize the number of elements allocated at once when the pool is exhausted
+     */
+    explicit WifiMacQueueElemPool(std::size_t blockSize = 64);
+
+    ~WifiMacQueueElemPool();
+
+    WifiMacQueueElemPool(const WifiMacQueueElemPool&) = delete;
+    WifiMacQueueElemPool& operator=(const WifiMacQueueElemPool&) = delete;
+
+    /**
+     * Construct a queue element storing the given MPDU in memory taken from the pool.
+     *
+     * @param item the MPDU stored by the queue element
+     * @return a pointer to the constructed queue element
+     */
+    WifiMacQueueElem* Create(Ptr<WifiMpdu> item);
+
+    /**
+     * Destroy the given queue element and return its memory to the pool.
+     *
+     * @param elem the queue element to destroy
+     */
+    void Destroy(WifiMacQueueElem* elem);
+
+    /**
+     * @return the number of elements currently allocated from the pool
+     */
+    std::size_t GetNAllocated() const;
+
+    /**
+     * @return the number of elements the pool can hold without allocating more memory
+     */
+    std::size_t GetCapacity() const;
+
+  private:
+    /// Storage for a single queue element, which doubles as a free list node when unused
+    union Slot
+    {
+        Slot* next; ///< next free slot (valid only when the slot is unused)
+        alignas(WifiMacQueueElem) std::byte storage[sizeof(WifiMacQueueElem)]; ///< element
+    };
+
+    std::size_t m_blockSize;                       //!< number of slots per block
+    std::vector<std::unique_ptr<Slot[]>> m_blocks; //!< the allocated blocks of slots
+    Slot* m_free{nullptr};                         //!< head of the free list
+    std::size_t m_nAllocated{0};                   //!< number of elements in use
+};
+
+/**
+ * @ingroup wifi
+ * Bidirectional iterator over the elements of a WifiMacQueueElemList.
+ *
+ * @tparam IsConst whether this is a const iterator
+ */
+template <bool IsConst>
+class WifiMacQueueElemListIterator
+{
+  public:
+    /// iterator category
+    using iterator_category = std::bidirectional_iterator_tag;
+    /// value type
+    using value_type = WifiMacQueueElem;
+    /// difference type
+    using difference_type = std::ptrdiff_t;
+    /// pointer type
+    using pointer = std::conditional_t<IsConst, const WifiMacQueueElem*, WifiMacQueueElem*>;
+    /// reference type
+    using reference = std::conditional_t<IsConst, const WifiMacQueueElem&, WifiMacQueueElem&>;
+
+    WifiMacQueueElemListIterator() = default;
+
+    /**
+     * Constructor.
+     *
+     * @param node the list node pointed to by this iterator
+     */
+    explicit WifiMacQueueElemListIterator(WifiMacQueueElemHook* node)
+        : m_node(node)
+    {
+    }
+
+    /**
+     * Conversion from a non-const iterator to a const iterator.
+     *
+     * @param other the non-const iterator
+     */
+    template <bool C = IsConst, typename = std::enable_if_t<C>>
+    WifiMacQueueElemListIterator(const WifiMacQueueElemListIterator<false>& other)
+        : m_node(other.GetNode())
+    {
+    }
+
+    /// @return a reference to the pointed element
+    reference operator*() const
+    {
+        return *static_cast<pointer>(m_node);
+    }
+
+    /// @return a pointer to the pointed element
+    pointer operator->() const
+    {
+        return static_cast<pointer>(m_node);
+    }
+
+    /// @return this iterator after advancing it to the next element
+    WifiMacQueueElemListIterator& operator++()
+    {
+        m_node = m_node->next;
+        return *this;
+    }
+
+    /// @return a copy of this iterator before advancing it to the next element
+    WifiMacQueueElemListIterator operator++(int)
+    {
+        auto tmp = *this;
+        m_node = m_node->next;
+        return tmp;
+    }
+
+    /// @return this iterator after moving it to the previous element
+    WifiMacQueueElemListIterator& operator--()
+    {
+        m_node = m_node->prev;
+        return *this;
+    }
+
+    /// @return a copy of this iterator before moving it to the previous element
+    WifiMacQueueElemListIterator operator--(int)
+    {
+        auto tmp = *this;
+        m_node = m_node->prev;
+        return tmp;
+    }
+
+    /**
+     * @param other another iterator
+     * @return whether the two iterators point to the same element
+     */
+    template <bool C>
+    bool operator==(const WifiMacQueueElemListIterator<C>& other) const
+    {
+        return m_node == other.GetNode();
+    }
+
+    /// @return the list node pointed to by this iterator
+    WifiMacQueueElemHook* GetNode() const
+    {
+        return m_node;
+    }
+
+  private:
+    WifiMacQueueElemHook* m_node{nullptr}; //!< the list node pointed to by this iterator
+};
+
+/**
+ * @ingroup wifi
+ * Intrusive doubly-linked list of WifiMacQueueElem objects.
+ *
+ * Elements are allocated from a WifiMacQueueElemPool shared by all the lists of a
+ * container, hence inserting an element does not require a heap allocation in steady
+ * state and elements can be moved between lists sharing the same pool by relinking
+ * them. Iterators (and references) to elements are not invalidated by insertions,
+ * by removal of other elements or by splicing. Lists cannot be copied or moved,
+ * because the end iterator points to a sentinel node embedded in the list object.
+ */
+class WifiMacQueueElemList
+{
+  public:
+    /// iterator over the elements in the list
+    using iterator = WifiMacQueueElemListIterator<false>;
+    /// const iterator over the elements in the list
+    using const_iterator = WifiMacQueueElemListIterator<true>;
+
+    /**
+     * Constructor.
+     *
+     * @param pool the pool used to allocate the elements of this list
+     */
+    explicit WifiMacQueueElemList(WifiMacQueueElemPool* pool);
+
+    ~WifiMacQueueElemList();
+
+    WifiMacQueueElemList(const WifiMacQueueElemList&) = delete;
+    WifiMacQueueElemList& operator=(const WifiMacQueueElemList&) = delete;
+
+    /// @return an iterator to the first element in the list
+    iterator begin();
+    /// @return an iterator past the last element in the list
+    iterator end();
+    /// @return a const iterator to the first element in the list
+    const_iterator begin() const;
+    /// @return a const iterator past the last element in the list
+    const_iterator end() const;
+    /// @return a const iterator to the first element in the list
+    const_iterator cbegin() const;
+    /// @return a const iterator past the last element in the list
+    const_iterator cend() const;
+
+    /// @return the number of elements in the list
+    std::size_t size() const;
+    /// @return whether the list is empty
+    bool empty() const;
+
+    /**
+     * Create an element storing the given MPDU and insert it before the given position.
+     *
+     * @param pos iterator before which the element will be inserted
+     * @param item the MPDU stored by the new element
+     * @return iterator pointing to the inserted element
+     */
+    iterator emplace(const_iterator pos, Ptr<WifiMpdu> item);
+
+    /**
+     * Remove the element at the given position and return its memory to the pool.
+     *
+     * @param pos iterator to the element to remove
+     * @return iterator following the removed element
+     */
+    iterator erase(const_iterator pos);
+
+    /**
+     * Move the elements in the range [first, last) of the given list before the given
+     * position of this list. The two lists must share the same pool. Linear in the
+     * number of moved elements when the two lists differ (to update the sizes),
+     * constant otherwise.
+     *
+     * @param pos iterator before which the elements will be inserted
+     * @param other the list the elements are moved from
+     * @param first iterator to the first element to move
+     * @param last iterator past the last element to move
+     */
+    void splice(const_iterator pos,
+                WifiMacQueueElemList& other,
+                const_iterator first,
+                const_iterator last);
+
+    /**
+     * Remove all the elements from the list.
+     */
+    void clear();
+
+  private:
+    WifiMacQueueElemHook m_head;  //!< sentinel node (the end of the list)
+    std::size_t m_size{0};        //!< number of elements in the list
+    WifiMacQueueElemPool* m_pool; //!< pool used to allocate the elements
+};
+
 } // namespace ns3
 
 #endif /* WIFI_MAC_QUEUE_ELEM_H */
@@ -107,9 +107,9 @@ class WifiMacQueueSchedulerImpl : public WifiMacQueueScheduler
     /** @copydoc ns3::WifiMacQueueScheduler::NotifyEnqueue */
     void NotifyEnqueue(AcIndex ac, Ptr<WifiMpdu> mpdu) final;
     /** @copydoc ns3::WifiMacQueueScheduler::NotifyDequeue */
-    void NotifyDequeue(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) final;
+    void NotifyDequeue(AcIndex ac, std::span<const Ptr<WifiMpdu>> mpdus) final;
     /** @copydoc ns3::WifiMacQueueScheduler::NotifyRemove */
-    void NotifyRemove(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) final;
+    void NotifyRemove(AcIndex ac, std::span<const Ptr<WifiMpdu>> mpdus) final;
 
   protected:
     /** @copydoc ns3::Object::DoDispose */
@@ -248,7 +248,7 @@ class WifiMacQueueSchedulerImpl : public WifiMacQueueScheduler
      * @param ac the Access Category of the dequeued MPDUs
      * @param mpdus the list of dequeued MPDUs
      */
-    virtual void DoNotifyDequeue(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) = 0;
+    virtual void DoNotifyDequeue(AcIndex ac, std::span<const Ptr<WifiMpdu>> mpdus) = 0;
     /**
      * Notify the scheduler that the given list of MPDUs have been removed by the
      * given Access Category. The container queues which became empty after removing
@@ -257,7 +257,7 @@ class WifiMacQueueSchedulerImpl : public WifiMacQueueScheduler
      * @param ac the Access Category of the removed MPDUs
      * @param mpdus the list of removed MPDUs
      */
-    virtual void DoNotifyRemove(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) = 0;
+    virtual void DoNotifyRemove(AcIndex ac, std::span<const Ptr<WifiMpdu>> mpdus) = 0;
 
     /**
      * Block or unblock the given set of links for the container queues of the given types and
@@ -833,22 +833,16 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::NotifyEnqueue(AcIndex ac, Ptr<Wifi
 template <class Priority, class Compare>
 void
 WifiMacQueueSchedulerImpl<Priority, Compare>::NotifyDequeue(AcIndex ac,
-                                                            const std::list<Ptr<WifiMpdu>>& mpdus)
+                                                            std::span<const Ptr<WifiMpdu>> mpdus)
 {
     NS_LOG_FUNCTION(this << +ac);
     NS_ASSERT(static_cast<uint8_t>(ac) < AC_UNDEF);
 
     DoNotifyDequeue(ac, mpdus);
 
-    std::list<WifiContainerQueueId> queueIds;
-
     for (const auto& mpdu : mpdus)
     {
-        queueIds.push_back(WifiMacQueueContainer::GetQueueId(mpdu));
-    }
-
-    for (const auto& queueId : queueIds)
-    {
+        const auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
         if (GetWifiMacQueue(ac)->GetNBytes(queueId) == 0)
         {
             // The queue has now become empty and needs to be removed from the sorted
@@ -867,22 +861,16 @@ WifiMacQueueSchedulerImpl<Priority, Compare>::NotifyDequeue(AcIndex ac,
 template <class Priority, class Compare>
 void
 WifiMacQueueSchedulerImpl<Priority, Compare>::NotifyRemove(AcIndex ac,
-                                                           const std::list<Ptr<WifiMpdu>>& mpdus)
+                                                           std::span<const Ptr<WifiMpdu>> mpdus)
 {
     NS_LOG_FUNCTION(this << +ac);
     NS_ASSERT(static_cast<uint8_t>(ac) < AC_UNDEF);
 
     DoNotifyRemove(ac, mpdus);
 
-    std::list<WifiContainerQueueId> queueIds;
-
     for (const auto& mpdu : mpdus)
     {
-        queueIds.push_back(WifiMacQueueContainer::GetQueueId(mpdu));
-    }
-
-    for (const auto& queueId : queueIds)
-    {
+        const auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
         if (GetWifiMacQueue(ac)->GetNBytes(queueId) == 0)
         {
             // The queue has now become empty and needs to be removed from the sorted
@@ -16,6 +16,7 @@
 
 #include <bitset>
 #include <optional>
+#include <span>
 
 namespace ns3
 {
@@ -253,7 +254,7 @@ class WifiMacQueueScheduler : public Object
      * @param ac the Access Category of the dequeued MPDUs
      * @param mpdus the list of dequeued MPDUs
      */
-    virtual void NotifyDequeue(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) = 0;
+    virtual void NotifyDequeue(AcIndex ac, std::span<const Ptr<WifiMpdu>> mpdus) = 0;
     /**
      * Notify the scheduler that the given list of MPDUs have been removed by the
      * given Access Category. The container queues which became empty after removing
@@ -262,7 +263,7 @@ class WifiMacQueueScheduler : public Object
      * @param ac the Access Category of the removed MPDUs
      * @param mpdus the list of removed MPDUs
      */
-    virtual void NotifyRemove(AcIndex ac, const std::list<Ptr<WifiMpdu>>& mpdus) = 0;
+    virtual void NotifyRemove(AcIndex ac, std::span<const Ptr<WifiMpdu>> mpdus) = 0;
 
   protected:
     void DoDispose() override;
@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <optional>
+#include <vector>
 
 namespace ns3
 {
@@ -109,7 +110,7 @@ WifiMacQueue::ExtractExpiredMpdus(const WifiContainerQueueId& queueId) const
 {
     NS_LOG_FUNCTION(this);
 
-    std::list<Ptr<WifiMpdu>> mpdus;
+    std::vector<Ptr<WifiMpdu>> mpdus;
     auto [first, last] = GetContainer().ExtractExpiredMpdus(queueId);
 
     for (auto it = first; it != last; it++)
@@ -134,7 +135,7 @@ WifiMacQueue::ExtractAllExpiredMpdus() const
 {
     NS_LOG_FUNCTION(this);
 
-    std::list<Ptr<WifiMpdu>> mpdus;
+    std::vector<Ptr<WifiMpdu>> mpdus;
     auto [first, last] = GetContainer().ExtractAllExpiredMpdus();
 
     for (auto it = first; it != last; it++)
@@ -274,7 +275,8 @@ WifiMacQueue::DequeueIfQueued(const std::list<Ptr<const WifiMpdu>>& mpdus)
 {
     NS_LOG_FUNCTION(this);
 
-    std::list<ConstIterator> iterators;
+    std::vector<ConstIterator> iterators;
+    iterators.reserve(mpdus.size());
 
     for (const auto& mpdu : mpdus)
     {
@@ -431,7 +433,8 @@ WifiMacQueue::Replace(Ptr<const WifiMpdu> currentItem, Ptr<WifiMpdu> newItem)
 
     Time expiryTime = currentIt->expiryTime;
     auto pos = std::next(currentIt);
-    DoDequeue({currentIt});
+    ConstIterator currentConstIt = currentIt;
+    DoDequeue({&currentConstIt, 1});
     bool ret = Insert(pos, newItem);
     GetIt(newItem)->expiryTime = expiryTime;
     // The size of a WifiMacQueue is measured as number of packets. We dequeued
@@ -501,11 +504,12 @@ WifiMacQueue::DoEnqueue(ConstIterator pos, Ptr<WifiMpdu> item)
 }
 
 void
-WifiMacQueue::DoDequeue(const std::list<ConstIterator>& iterators)
+WifiMacQueue::DoDequeue(std::span<const ConstIterator> iterators)
 {
     NS_LOG_FUNCTION(this);
 
-    std::list<Ptr<WifiMpdu>> items;
+    std::vector<Ptr<WifiMpdu>> items;
+    items.reserve(iterators.size());
 
     // First, dequeue all the items
     for (auto& it : iterators)
@@ -540,7 +544,7 @@ WifiMacQueue::DoRemove(ConstIterator pos)
         {
             SetMaxSize(GetMaxSize() - item);
         }
-        m_scheduler->NotifyRemove(m_ac, {item});
+        m_scheduler->NotifyRemove(m_ac, {&item, 1});
     }
 
     return item;
@@ -20,6 +20,7 @@
 
 #include <functional>
 #include <optional>
+#include <span>
 #include <unordered_map>
 
 namespace ns3
@@ -325,7 +326,7 @@ class WifiMacQueue : public Queue<WifiMpdu, ns3::WifiMacQueueContainer>
      *
      * @param iterators the list of iterators pointing to the items to dequeue
      */
-    void DoDequeue(const std::list<ConstIterator>& iterators);
+    void DoDequeue(std::span<const ConstIterator> iterators);
     /**
      * Wrapper for the DoRemove method provided by the base class that additionally
      * resets the iterator field of the item and notifies the scheduleer, if an
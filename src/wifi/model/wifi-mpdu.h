@@ -147,7 +147,7 @@ class WifiMpdu : public SimpleRefCount<WifiMpdu>
     DeaggregatedMsdusCI end() const;
 
     /// Const iterator typedef
-    typedef std::list<WifiMacQueueElem>::iterator Iterator;
+    typedef WifiMacQueueElemList::iterator Iterator;
 
     /**
      * Set the queue iterator stored by this object.
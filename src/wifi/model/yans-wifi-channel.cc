@@ -22,6 +22,9 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <limits>
+#include <vector>
+
 namespace ns3
 {
 
@@ -81,41 +84,55 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, dBm_u t
     NS_LOG_FUNCTION(this << sender << ppdu << txPower);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+
+    // compute the rx power at all the receivers with a single call to the loss model
+    std::vector<Ptr<YansWifiPhy>> receivers;
+    std::vector<Ptr<MobilityModel>> receiverMobilities;
+    receivers.reserve(m_phyList.size());
+    receiverMobilities.reserve(m_phyList.size());
+    for (const auto& phy : m_phyList)
+    {
+        // For now don't account for inter channel interference nor channel bonding
+        if (sender != phy && phy->GetChannelNumber() == sender->GetChannelNumber())
+        {
+            receivers.push_back(phy);
+            receiverMobilities.push_back(phy->GetMobility()->GetObject<MobilityModel>());
+        }
+    }
+    std::vector<double> rxPowers;
+    m_loss->CalcRxPower(txPower, senderMobility, receiverMobilities, rxPowers);
+
+    for (std::size_t i = 0; i < receivers.size(); ++i)
     {
-        if (sender != (*i))
+        if (rxPowers[i] == -std::numeric_limits<double>::infinity())
+        {
+            // the receiver is unreachable (e.g., culled by MatrixPropagationLossModel)
+            continue;
+        }
+        const auto& receiverMobility = receiverMobilities[i];
+        const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
+        const dBm_u rxPower{rxPowers[i]};
+        NS_LOG_DEBUG("propagation: txPower="
+                     << txPower << "dBm, rxPower=" << rxPower << "dBm, "
+                     << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                     << "m, delay=" << delay);
+        auto dstNetDevice = receivers[i]->GetDevice();
+        uint32_t dstNode;
+        if (!dstNetDevice)
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
-            {
-                continue;
-            }
-
-            auto receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            const auto delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            const dBm_u rxPower{m_loss->CalcRxPower(txPower, senderMobility, receiverMobility)};
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPower << "dBm, rxPower=" << rxPower << "dBm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            auto dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
-            {
-                dstNode = 0xffffffff;
-            }
-            else
-            {
-                dstNode = dstNetDevice->GetNode()->GetId();
-            }
-
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPower);
+            dstNode = 0xffffffff;
         }
+        else
+        {
+            dstNode = dstNetDevice->GetNode()->GetId();
+        }
+
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &YansWifiChannel::Receive,
+                                       receivers[i],
+                                       ppdu,
+                                       rxPower);
     }
 }
 
@@ -8,6 +8,8 @@
 
 #include "ns3/ap-wifi-mac.h"
 #include "ns3/attribute-container.h"
+#include "ns3/block-ack-inflight-queue.h"
+#include "ns3/block-ack-window.h"
 #include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/ctrl-headers.h"
@@ -36,6 +38,7 @@
 #include "ns3/wifi-phy.h"
 #include "ns3/yans-wifi-helper.h"
 
+#include <algorithm>
 #include <list>
 
 using namespace ns3;
@@ -664,6 +667,217 @@ OriginatorBlockAckWindowTest::DoRun()
     }
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the bitmap scans of the block ack window against a vector of bool
+ */
+class BlockAckWindowBitmapTest : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * @param winSize the window size
+     */
+    BlockAckWindowBitmapTest(uint16_t winSize);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that the window matches the given reference window.
+     *
+     * @param window the window
+     * @param reference the reference window
+     * @param step the current step (used in the error messages)
+     */
+    void CheckWindow(const BlockAckWindow& window,
+                     const std::vector<bool>& reference,
+                     std::size_t step);
+
+    uint16_t m_winSize; ///< the window size
+};
+
+BlockAckWindowBitmapTest::BlockAckWindowBitmapTest(uint16_t winSize)
+    : TestCase("Check the bitmap scans of a block ack window of size " + std::to_string(winSize)),
+      m_winSize(winSize)
+{
+}
+
+void
+BlockAckWindowBitmapTest::CheckWindow(const BlockAckWindow& window,
+                                      const std::vector<bool>& reference,
+                                      std::size_t step)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < m_winSize; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(window.At(i),
+                              reference[i],
+                              "Unexpected element at distance " << i << " (step " << step << ")");
+        count += (reference[i] ? 1 : 0);
+
+        auto firstSet = std::find(reference.cbegin() + i, reference.cend(), true);
+        NS_TEST_ASSERT_MSG_EQ(window.FindFirstSet(i),
+                              static_cast<std::size_t>(firstSet - reference.cbegin()),
+                              "Unexpected first set element from " << i << " (step " << step
+                                                                   << ")");
+        auto firstUnset = std::find(reference.cbegin() + i, reference.cend(), false);
+        NS_TEST_ASSERT_MSG_EQ(window.FindFirstUnset(i),
+                              static_cast<std::size_t>(firstUnset - reference.cbegin()),
+                              "Unexpected first unset element from " << i << " (step " << step
+                                                                     << ")");
+    }
+    NS_TEST_ASSERT_MSG_EQ(window.Count(), count, "Unexpected number of set elements");
+    NS_TEST_ASSERT_MSG_EQ(window.FindFirstSet(m_winSize), m_winSize, "Unexpected search result");
+}
+
+void
+BlockAckWindowBitmapTest::DoRun()
+{
+    const uint16_t winStart = 4000;
+    BlockAckWindow window;
+    window.Init(winStart, m_winSize);
+    std::vector<bool> reference(m_winSize, false);
+    uint16_t expectedWinStart = winStart;
+
+    CheckWindow(window, reference, 0);
+
+    // at every step, set some elements (in a pattern depending on the step) and advance
+    // the window by a number of positions that is not a multiple of the word size, so
+    // that the head of the window moves across word boundaries and wraps around
+    for (std::size_t step = 1; step <= 20; step++)
+    {
+        for (std::size_t i = step % 3; i < m_winSize; i += 1 + step % 5)
+        {
+            window.At(i) = true;
+            reference[i] = true;
+        }
+        // copy the value of an element into another element
+        window.At(step % m_winSize) = window.At((step + 1) % m_winSize);
+        reference[step % m_winSize] = reference[(step + 1) % m_winSize];
+        CheckWindow(window, reference, step);
+
+        const std::size_t count = (step * 37) % m_winSize;
+        window.Advance(count);
+        reference.erase(reference.begin(), reference.begin() + count);
+        reference.resize(m_winSize, false);
+        expectedWinStart = (expectedWinStart + count) % SEQNO_SPACE_SIZE;
+
+        NS_TEST_ASSERT_MSG_EQ(window.GetWinStart(), expectedWinStart, "Unexpected winStart");
+        CheckWindow(window, reference, step);
+    }
+
+    // set all the elements and advance the window up to the first unset element
+    for (std::size_t i = 0; i < m_winSize; i++)
+    {
+        window.At(i) = true;
+    }
+    NS_TEST_EXPECT_MSG_EQ(window.Count(), m_winSize, "Expected all elements to be set");
+    NS_TEST_EXPECT_MSG_EQ(window.FindFirstUnset(), m_winSize, "Expected no unset element");
+    window.Advance(window.FindFirstUnset());
+    expectedWinStart = (expectedWinStart + m_winSize) % SEQNO_SPACE_SIZE;
+    NS_TEST_EXPECT_MSG_EQ(window.GetWinStart(), expectedWinStart, "Unexpected winStart");
+    NS_TEST_EXPECT_MSG_EQ(window.Count(), 0, "Expected all elements to be cleared");
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the queue of in flight MPDUs of an originator block ack agreement
+ */
+class BlockAckInflightQueueTest : public TestCase
+{
+  public:
+    BlockAckInflightQueueTest();
+
+  private:
+    void DoRun() override;
+};
+
+BlockAckInflightQueueTest::BlockAckInflightQueueTest()
+    : TestCase("Check the lookup of in flight MPDUs by sequence number")
+{
+}
+
+void
+BlockAckInflightQueueTest::DoRun()
+{
+    BlockAckInflightQueue queue;
+
+    auto createMpdu = [](uint16_t seqNumber, uint8_t fragNumber = 0) {
+        WifiMacHeader hdr;
+        hdr.SetType(WIFI_MAC_QOSDATA);
+        hdr.SetSequenceNumber(seqNumber);
+        hdr.SetFragmentNumber(fragNumber);
+        return Create<WifiMpdu>(Create<Packet>(), hdr);
+    };
+
+    // insert MPDUs with sequence numbers from 4090 to 4095 and from 0 to 9 (MPDU 6
+    // is the second fragment of an MSDU)
+    for (uint16_t seqN = 4090; seqN != 10; seqN = (seqN + 1) % SEQNO_SPACE_SIZE)
+    {
+        queue.insert(queue.end(), createMpdu(seqN, (seqN == 6 ? 1 : 0)));
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue.size(), 16, "Unexpected queue size");
+
+    for (uint16_t seqN = 4090; seqN != 10; seqN = (seqN + 1) % SEQNO_SPACE_SIZE)
+    {
+        auto it = queue.Find(seqN);
+        NS_TEST_ASSERT_MSG_EQ((it != queue.end()), true, "MPDU " << seqN << " not found");
+        NS_TEST_EXPECT_MSG_EQ((*it)->GetHeader().GetSequenceNumber(), seqN, "Wrong MPDU found");
+    }
+    NS_TEST_EXPECT_MSG_EQ((queue.Find(100) == queue.end()), true, "MPDU 100 not expected");
+
+    // insert a second fragment of MPDU 5 and the first fragment of MPDU 6
+    queue.insert(std::next(queue.Find(5)), createMpdu(5, 1));
+    auto it = queue.insert(queue.Find(6), createMpdu(6, 0));
+    NS_TEST_EXPECT_MSG_EQ((queue.Find(6) == it), true, "Lookup must return the first fragment");
+    NS_TEST_EXPECT_MSG_EQ((*queue.Find(5))->GetHeader().GetFragmentNumber(),
+                          0,
+                          "Lookup must return the first fragment");
+
+    // removing the first fragment makes the lookup return the second fragment
+    queue.erase(queue.Find(5));
+    NS_TEST_ASSERT_MSG_EQ((queue.Find(5) != queue.end()), true, "MPDU 5 not found");
+    NS_TEST_EXPECT_MSG_EQ((*queue.Find(5))->GetHeader().GetFragmentNumber(),
+                          1,
+                          "Lookup must return the second fragment");
+    queue.erase(queue.Find(5));
+    NS_TEST_EXPECT_MSG_EQ((queue.Find(5) == queue.end()), true, "MPDU 5 not expected");
+
+    // inserting an MPDU whose sequence number collides with an in flight MPDU grows the table
+    const auto tableSize = queue.GetTableSize();
+    queue.insert(queue.end(), createMpdu(9 + tableSize));
+    NS_TEST_EXPECT_MSG_GT(queue.GetTableSize(), tableSize, "Table size expected to grow");
+    NS_TEST_EXPECT_MSG_EQ((*queue.Find(9 + tableSize))->GetHeader().GetSequenceNumber(),
+                          9 + tableSize,
+                          "Wrong MPDU found");
+    for (uint16_t seqN = 4090; seqN != 10; seqN = (seqN + 1) % SEQNO_SPACE_SIZE)
+    {
+        NS_TEST_EXPECT_MSG_EQ((queue.Find(seqN) != queue.end()),
+                              (seqN != 5),
+                              "Unexpected lookup result for MPDU " << seqN);
+    }
+
+    // remove all the MPDUs in order
+    for (auto mpduIt = queue.begin(); mpduIt != queue.end();)
+    {
+        auto seqN = (*mpduIt)->GetHeader().GetSequenceNumber();
+        mpduIt = queue.erase(mpduIt);
+        if (mpduIt == queue.end() || (*mpduIt)->GetHeader().GetSequenceNumber() != seqN)
+        {
+            NS_TEST_EXPECT_MSG_EQ((queue.Find(seqN) == queue.end()),
+                                  true,
+                                  "MPDU " << seqN << " not expected");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(queue.empty(), true, "Queue expected to be empty");
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -2258,6 +2472,9 @@ BlockAckTestSuite::BlockAckTestSuite()
     AddTestCase(new PacketBufferingCaseA, TestCase::Duration::QUICK);
     AddTestCase(new PacketBufferingCaseB, TestCase::Duration::QUICK);
     AddTestCase(new OriginatorBlockAckWindowTest, TestCase::Duration::QUICK);
+    AddTestCase(new BlockAckWindowBitmapTest(100), TestCase::Duration::QUICK);
+    AddTestCase(new BlockAckWindowBitmapTest(1024), TestCase::Duration::QUICK);
+    AddTestCase(new BlockAckInflightQueueTest, TestCase::Duration::QUICK);
     AddTestCase(new CtrlBAckResponseHeaderTest, TestCase::Duration::QUICK);
     AddTestCase(new BlockAckRecipientBufferTest(0), TestCase::Duration::QUICK);
     AddTestCase(new BlockAckRecipientBufferTest(4090), TestCase::Duration::QUICK);
@@ -12,6 +12,7 @@
 #include "ns3/wifi-mac-queue.h"
 
 #include <algorithm>
+#include <vector>
 
 using namespace ns3;
 
@@ -508,6 +509,129 @@ WifiMacQueueFlushTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the intrusive list of queue elements and the pool they are allocated from.
+ *
+ * This test verifies that elements are correctly linked when they are inserted, erased and
+ * spliced between lists, that iterators to other elements are not invalidated and that the
+ * memory of erased elements is reused by subsequent insertions.
+ */
+class WifiMacQueueElemListTest : public TestCase
+{
+  public:
+    WifiMacQueueElemListTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check that the given list contains MPDUs with the given sequence numbers.
+     *
+     * @param list the given list
+     * @param seqNos the expected sequence numbers
+     * @param name the name of the list
+     */
+    void CheckList(const WifiMacQueueElemList& list,
+                   const std::vector<uint16_t>& seqNos,
+                   const std::string& name);
+};
+
+WifiMacQueueElemListTest::WifiMacQueueElemListTest()
+    : TestCase("Test intrusive list of wifi MAC queue elements")
+{
+}
+
+void
+WifiMacQueueElemListTest::CheckList(const WifiMacQueueElemList& list,
+                                    const std::vector<uint16_t>& seqNos,
+                                    const std::string& name)
+{
+    NS_TEST_EXPECT_MSG_EQ(list.size(), seqNos.size(), "Unexpected size of " << name);
+    NS_TEST_EXPECT_MSG_EQ(list.empty(), seqNos.empty(), "Unexpected emptiness of " << name);
+
+    std::vector<uint16_t> actual;
+    for (const auto& elem : list)
+    {
+        actual.push_back(elem.mpdu->GetHeader().GetSequenceNumber());
+    }
+    NS_TEST_EXPECT_MSG_EQ((actual == seqNos), true, "Unexpected elements in " << name);
+
+    // check backward links as well
+    std::vector<uint16_t> reversed;
+    for (auto it = list.cend(); it != list.cbegin();)
+    {
+        --it;
+        reversed.push_back(it->mpdu->GetHeader().GetSequenceNumber());
+    }
+    std::reverse(reversed.begin(), reversed.end());
+    NS_TEST_EXPECT_MSG_EQ((reversed == seqNos), true, "Unexpected backward links in " << name);
+}
+
+void
+WifiMacQueueElemListTest::DoRun()
+{
+    WifiMacQueueElemPool pool(4);
+    WifiMacQueueElemList list1(&pool);
+    WifiMacQueueElemList list2(&pool);
+
+    auto emplace = [](WifiMacQueueElemList& list,
+                      WifiMacQueueElemList::const_iterator pos,
+                      uint16_t seqNo) {
+        WifiMacHeader header(WIFI_MAC_QOSDATA);
+        header.SetSequenceNumber(seqNo);
+        auto it = list.emplace(pos, Create<WifiMpdu>(Create<Packet>(), header));
+        it->deleter = [](auto mpdu) {};
+        return it;
+    };
+
+    // insert at the end and before a given position
+    for (uint16_t seqNo : {0, 1, 3})
+    {
+        emplace(list1, list1.cend(), seqNo);
+    }
+    auto it3 = std::prev(list1.end());
+    auto it2 = emplace(list1, it3, 2);
+    emplace(list1, list1.cbegin(), 10);
+    CheckList(list1, {10, 0, 1, 2, 3}, "list 1");
+    NS_TEST_EXPECT_MSG_EQ(pool.GetNAllocated(), 5, "Unexpected number of allocated elements");
+    NS_TEST_EXPECT_MSG_EQ(pool.GetCapacity(), 8, "Unexpected pool capacity");
+
+    // erase the first element
+    auto it = list1.erase(list1.cbegin());
+    NS_TEST_EXPECT_MSG_EQ(it->mpdu->GetHeader().GetSequenceNumber(),
+                          0,
+                          "Erase did not return an iterator to the following element");
+    CheckList(list1, {0, 1, 2, 3}, "list 1");
+
+    // the memory of the erased element is reused
+    emplace(list2, list2.cend(), 20);
+    NS_TEST_EXPECT_MSG_EQ(pool.GetNAllocated(), 5, "Unexpected number of allocated elements");
+    NS_TEST_EXPECT_MSG_EQ(pool.GetCapacity(), 8, "Memory of erased element not reused");
+
+    // move elements 1 and 2 to the front of list 2
+    list2.splice(list2.cbegin(), list1, std::next(list1.cbegin()), it3);
+    CheckList(list1, {0, 3}, "list 1");
+    CheckList(list2, {1, 2, 20}, "list 2");
+    NS_TEST_EXPECT_MSG_EQ(it2->mpdu->GetHeader().GetSequenceNumber(),
+                          2,
+                          "Iterator invalidated by splice");
+    NS_TEST_EXPECT_MSG_EQ((std::next(it2) == std::prev(list2.end())),
+                          true,
+                          "Spliced element not linked to the following element");
+
+    // move an element within the same list
+    list2.splice(list2.cend(), list2, list2.cbegin(), std::next(list2.cbegin()));
+    CheckList(list2, {2, 20, 1}, "list 2");
+
+    list1.clear();
+    CheckList(list1, {}, "list 1");
+    list2.clear();
+    NS_TEST_EXPECT_MSG_EQ(pool.GetNAllocated(), 0, "Unexpected number of allocated elements");
+}
+
 /**
  * @ingroup wifi-test
  * @ingroup tests
@@ -526,6 +650,7 @@ WifiMacQueueTestSuite::WifiMacQueueTestSuite()
     AddTestCase(new WifiMacQueueDropOldestTest, TestCase::Duration::QUICK);
     AddTestCase(new WifiExtractExpiredMpdusTest, TestCase::Duration::QUICK);
     AddTestCase(new WifiMacQueueFlushTest, TestCase::Duration::QUICK);
+    AddTestCase(new WifiMacQueueElemListTest, TestCase::Duration::QUICK);
 }
 
 static WifiMacQueueTestSuite g_wifiMacQueueTestSuite; ///< the test suite
@@ -0,0 +1,537 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/adhoc-wifi-mac.h"
+#include "ns3/boolean.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/fcfs-wifi-queue-scheduler.h"
+#include "ns3/frame-exchange-manager.h"
+#include "ns3/interference-helper.h"
+#include "ns3/minstrel-ht-wifi-manager.h"
+#include "ns3/minstrel-wifi-manager.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-default-ack-manager.h"
+#include "ns3/wifi-default-protection-manager.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/wifi-mpdu.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/yans-wifi-phy.h"
+
+#include <set>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Create a device using a MinstrelWifiManager on an 802.11a PHY, with an ad hoc MAC
+ * (so that no association is needed to get the supported rates of the remote station).
+ *
+ * @param lazy the value of the LazyStatsUpdate attribute of the manager
+ * @return the device
+ */
+static Ptr<WifiNetDevice>
+CreateMinstrelDevice(bool lazy)
+{
+    auto dev = CreateObject<WifiNetDevice>();
+    auto node = CreateObject<Node>();
+    node->AddDevice(dev);
+
+    auto phy = CreateObject<YansWifiPhy>();
+    phy->SetInterferenceHelper(CreateObject<InterferenceHelper>());
+    dev->SetPhy(phy);
+    phy->SetChannel(CreateObject<YansWifiChannel>());
+    phy->SetDevice(dev);
+    phy->SetMobility(CreateObject<ConstantPositionMobilityModel>());
+    phy->ConfigureStandard(WIFI_STANDARD_80211a);
+
+    auto manager =
+        CreateObjectWithAttributes<MinstrelWifiManager>("LazyStatsUpdate", BooleanValue(lazy));
+    dev->SetRemoteStationManager(manager);
+
+    auto mac = CreateObjectWithAttributes<AdhocWifiMac>(
+        "Txop",
+        PointerValue(CreateObjectWithAttributes<Txop>("AcIndex", StringValue("AC_BE_NQOS"))));
+    mac->SetDevice(dev);
+    mac->SetAddress(Mac48Address::Allocate());
+    dev->SetMac(mac);
+    mac->SetChannelAccessManagers({CreateObject<ChannelAccessManager>()});
+    mac->SetFrameExchangeManagers({CreateObject<FrameExchangeManager>()});
+    mac->GetFrameExchangeManager(SINGLE_LINK_OP_ID)->SetAddress(mac->GetAddress());
+    mac->SetMacQueueScheduler(CreateObject<FcfsWifiQueueScheduler>());
+    auto fem = mac->GetFrameExchangeManager();
+
+    auto protectionManager = CreateObject<WifiDefaultProtectionManager>();
+    protectionManager->SetWifiMac(mac);
+    fem->SetProtectionManager(protectionManager);
+
+    auto ackManager = CreateObject<WifiDefaultAckManager>();
+    ackManager->SetWifiMac(mac);
+    fem->SetAckManager(ackManager);
+
+    manager->AssignStreams(1);
+    return dev;
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the LazyStatsUpdate attribute of the MinstrelWifiManager.
+ *
+ * A sequence of transmissions to a remote station is simulated by reporting transmission
+ * outcomes (transmissions at a rate above 24 Mbps fail) and requesting the TXVECTOR for the
+ * next transmission. When the LazyStatsUpdate attribute is enabled, the test checks that
+ * reports do not trigger a rate selection and that the deferred rate selection is performed
+ * exactly once when a (data or RTS) TXVECTOR is requested after some reports. The test also
+ * checks that, when a single report precedes every TXVECTOR request, the rates selected with
+ * and without the LazyStatsUpdate attribute are the same for the same seed.
+ */
+class MinstrelLazyStatsUpdateTest : public TestCase
+{
+  public:
+    MinstrelLazyStatsUpdateTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Simulate a sequence of transmissions to a remote station.
+     *
+     * @param lazy the value of the LazyStatsUpdate attribute
+     * @param nReports the number of outcomes reported before each TXVECTOR request
+     * @return the data rates of the TXVECTORs returned for the transmissions
+     */
+    std::vector<uint64_t> RunTransmissions(bool lazy, uint32_t nReports);
+};
+
+MinstrelLazyStatsUpdateTest::MinstrelLazyStatsUpdateTest()
+    : TestCase("Check the deferred rate selection of Minstrel")
+{
+}
+
+std::vector<uint64_t>
+MinstrelLazyStatsUpdateTest::RunTransmissions(bool lazy, uint32_t nReports)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    auto dev = CreateMinstrelDevice(lazy);
+    auto manager = dev->GetRemoteStationManager();
+    auto minstrel = DynamicCast<MinstrelWifiManager>(manager);
+    const auto width = dev->GetPhy()->GetChannelWidth();
+
+    auto remoteAddress = Mac48Address::Allocate();
+    WifiMacHeader header;
+    header.SetAddr1(remoteAddress);
+    header.SetType(WIFI_MAC_DATA);
+    header.SetQosTid(0);
+    auto mpdu = Create<WifiMpdu>(Create<Packet>(1000), header);
+
+    // as done by the ad hoc MAC, assume that the remote station supports all our rates; no
+    // frame is actually queued, so that the outcomes are only reported by this test
+    manager->AddAllSupportedModes(remoteAddress);
+    manager->RecordDisassociated(remoteAddress);
+
+    std::vector<uint64_t> rates;
+    WifiTxVector txVector = manager->GetDataTxVector(header, width);
+
+    const uint32_t nTransmissions = 400;
+    for (uint32_t i = 1; i <= nTransmissions; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(5 * i), [&, i]() {
+            const auto decisions = minstrel->m_nRateDecisions;
+            for (uint32_t r = 0; r < nReports; ++r)
+            {
+                if (txVector.GetMode().GetDataRate(txVector) <= 24000000)
+                {
+                    manager->ReportDataOk(mpdu, 0, WifiMode(), 0, txVector);
+                }
+                else
+                {
+                    manager->ReportDataFailed(mpdu);
+                    manager->ReportFinalDataFailed(mpdu);
+                }
+            }
+            if (lazy)
+            {
+                NS_TEST_EXPECT_MSG_EQ(minstrel->m_nRateDecisions,
+                                      decisions,
+                                      "Reports triggered a rate selection in lazy mode");
+            }
+
+            // alternate between RTS and data TXVECTOR requests to trigger the deferred
+            // selection; in both cases, the next data TXVECTOR uses the selected rate
+            if (i % 4 == 0)
+            {
+                manager->GetRtsTxVector(remoteAddress, width);
+            }
+            txVector = manager->GetDataTxVector(header, width);
+            const auto afterRequest = minstrel->m_nRateDecisions;
+            if (lazy)
+            {
+                NS_TEST_EXPECT_MSG_EQ(afterRequest,
+                                      decisions + 1,
+                                      "Deferred rate selection not performed exactly once");
+            }
+
+            // requesting the TXVECTOR again does not trigger a new rate selection
+            auto again = manager->GetDataTxVector(header, width);
+            NS_TEST_EXPECT_MSG_EQ(again.GetMode(), txVector.GetMode(), "Unexpected rate change");
+            NS_TEST_EXPECT_MSG_EQ(minstrel->m_nRateDecisions,
+                                  afterRequest,
+                                  "Rate selection without any report");
+
+            rates.push_back(txVector.GetMode().GetDataRate(txVector));
+        });
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_EXPECT_MSG_EQ(rates.size(), nTransmissions, "Unexpected number of transmissions");
+    return rates;
+}
+
+void
+MinstrelLazyStatsUpdateTest::DoRun()
+{
+    auto eager = RunTransmissions(false, 1);
+    auto lazy = RunTransmissions(true, 1);
+    NS_TEST_ASSERT_MSG_EQ(lazy.size(), eager.size(), "Unexpected number of transmissions");
+    bool slowRateSelected = false;
+    for (std::size_t i = 0; i < eager.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(lazy[i], eager[i], "Different rate selected for TX " << i);
+        slowRateSelected = slowRateSelected || (eager[i] <= 24000000);
+    }
+    NS_TEST_EXPECT_MSG_EQ(slowRateSelected, true, "Minstrel did not adapt the rate");
+
+    // several reports between two transmissions trigger a single rate selection
+    RunTransmissions(true, 3);
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Test the statistics of the MinstrelHtWifiManager.
+ *
+ * A MinstrelHtWifiManager is installed on an EHT device using 4 spatial streams over a
+ * 160 MHz channel in the 5 GHz band, so that the IDs of some of the supported groups are
+ * greater than 255, and a remote station supporting all the groups supported by the device
+ * is created. The test checks that:
+ *
+ * - all the supported groups (including those whose ID is greater than 255) are sampled;
+ * - the statistics of the rates updated by the manager are the same as those obtained by
+ *   updating the statistics of each rate in turn, as done when the statistics of a rate were
+ *   stored in a single structure (for the same attempts and successes).
+ */
+class MinstrelHtStatsTest : public TestCase
+{
+  public:
+    MinstrelHtStatsTest();
+    ~MinstrelHtStatsTest() override;
+
+  private:
+    void DoRun() override;
+
+    /// Create the remote station, supporting all the groups supported by the device
+    void CreateStation();
+
+    /// Check that all the supported groups are sampled
+    void CheckSampleGroups();
+
+    /// Check that the statistics are updated as when they were stored rate by rate
+    void CheckStatsUpdate();
+
+    /// Statistics of a rate, as they were stored before the introduction of MinstrelHtRateTable
+    struct RateStats
+    {
+        Time perfectTxTime;             //!< perfect transmission time
+        bool supported{false};          //!< whether the rate is supported
+        uint32_t numRateAttempt{0};     //!< number of attempts since the last update
+        uint32_t numRateSuccess{0};     //!< number of successes since the last update
+        double prob{0};                 //!< probability of success in the last interval
+        double ewmaProb{0};             //!< EWMA of the probability of success
+        double ewmsdProb{0};            //!< EWMSD of the probability of success
+        uint32_t prevNumRateAttempt{0}; //!< number of attempts in the last interval
+        uint32_t prevNumRateSuccess{0}; //!< number of successes in the last interval
+        uint32_t numSamplesSkipped{0};  //!< number of updates without attempts
+        uint64_t successHist{0};        //!< aggregate of all the successes
+        uint64_t attemptHist{0};        //!< aggregate of all the attempts
+        double throughput{0};           //!< throughput
+    };
+
+    /**
+     * Update the statistics of a rate as done before the introduction of MinstrelHtRateTable.
+     *
+     * @param rate the statistics of the rate
+     */
+    void UpdateRateStats(RateStats& rate) const;
+
+    Ptr<MinstrelHtWifiManager> m_manager;            //!< the Minstrel-HT manager
+    MinstrelHtWifiRemoteStation* m_station{nullptr}; //!< the remote station
+};
+
+MinstrelHtStatsTest::MinstrelHtStatsTest()
+    : TestCase("Check the sampling and the statistics update of Minstrel-HT")
+{
+}
+
+MinstrelHtStatsTest::~MinstrelHtStatsTest()
+{
+    delete m_station;
+}
+
+void
+MinstrelHtStatsTest::CreateStation()
+{
+    // supported groups and rates are initialized as done by RateInit for a remote station
+    // having the same capabilities as the device
+    m_station = static_cast<MinstrelHtWifiRemoteStation*>(m_manager->DoCreateStation());
+    m_station->m_state = nullptr;
+    m_station->m_groupsTable = McsGroupData(m_manager->m_numGroups);
+    for (std::size_t groupId = 0; groupId < m_manager->m_numGroups; ++groupId)
+    {
+        auto& group = m_station->m_groupsTable[groupId];
+        group.m_supported = m_manager->m_minstrelGroups[groupId].isSupported;
+        if (!group.m_supported)
+        {
+            continue;
+        }
+        m_station->m_supportedGroups.push_back(groupId);
+        group.m_col = 0;
+        group.m_index = 0;
+        group.m_ratesTable.Resize(m_manager->m_numRates);
+        for (uint8_t rateId = 0; rateId < m_manager->m_numRates; ++rateId)
+        {
+            const auto& txTimes = m_manager->m_minstrelGroups[groupId].ratesFirstMpduTxTimeTable;
+            if (txTimes[rateId].IsStrictlyPositive())
+            {
+                group.m_ratesTable.supported[rateId] = 1;
+                group.m_ratesTable.perfectTxTime[rateId] = txTimes[rateId];
+                group.m_ratesTable.perfectTxTimeSeconds[rateId] = txTimes[rateId].GetSeconds();
+            }
+        }
+    }
+    m_station->m_sampleTable =
+        SampleRate(m_manager->m_numRates, std::vector<uint8_t>(m_manager->m_nSampleCol));
+    m_manager->InitSampleTable(m_station);
+}
+
+void
+MinstrelHtStatsTest::CheckSampleGroups()
+{
+    const auto& supportedGroups = m_station->m_supportedGroups;
+    NS_TEST_ASSERT_MSG_GT(supportedGroups.back(), 255, "Expected a group ID greater than 255");
+
+    std::set<std::size_t> sampledGroups;
+    for (std::size_t i = 0; i < supportedGroups.size(); ++i)
+    {
+        m_manager->SetNextSample(m_station);
+        NS_TEST_EXPECT_MSG_EQ(m_station->m_groupsTable[m_station->m_sampleGroup].m_supported,
+                              true,
+                              "Group " << m_station->m_sampleGroup << " is not supported");
+        sampledGroups.insert(m_station->m_sampleGroup);
+    }
+    NS_TEST_EXPECT_MSG_EQ(sampledGroups.size(),
+                          supportedGroups.size(),
+                          "Not all the supported groups have been sampled");
+    NS_TEST_EXPECT_MSG_EQ(*sampledGroups.rbegin(),
+                          supportedGroups.back(),
+                          "The supported group with the highest ID has not been sampled");
+}
+
+void
+MinstrelHtStatsTest::UpdateRateStats(RateStats& rate) const
+{
+    if (!rate.supported)
+    {
+        return;
+    }
+    if (rate.numRateAttempt > 0)
+    {
+        rate.numSamplesSkipped = 0;
+        double tempProb = (100 * rate.numRateSuccess) / rate.numRateAttempt;
+        rate.prob = tempProb;
+        if (rate.successHist == 0)
+        {
+            rate.ewmaProb = tempProb;
+        }
+        else
+        {
+            rate.ewmsdProb = m_manager->CalculateEwmsd(rate.ewmsdProb,
+                                                       tempProb,
+                                                       rate.ewmaProb,
+                                                       m_manager->m_ewmaLevel);
+            tempProb = (tempProb * (100 - m_manager->m_ewmaLevel) +
+                        rate.ewmaProb * m_manager->m_ewmaLevel) /
+                       100;
+            rate.ewmaProb = tempProb;
+        }
+        if (tempProb < 10)
+        {
+            rate.throughput = 0;
+        }
+        else if (tempProb > 90)
+        {
+            rate.throughput = 90 / rate.perfectTxTime.GetSeconds();
+        }
+        else
+        {
+            rate.throughput = tempProb / rate.perfectTxTime.GetSeconds();
+        }
+        rate.successHist += rate.numRateSuccess;
+        rate.attemptHist += rate.numRateAttempt;
+    }
+    else
+    {
+        rate.numSamplesSkipped++;
+    }
+    rate.prevNumRateSuccess = rate.numRateSuccess;
+    rate.prevNumRateAttempt = rate.numRateAttempt;
+    rate.numRateSuccess = 0;
+    rate.numRateAttempt = 0;
+}
+
+void
+MinstrelHtStatsTest::CheckStatsUpdate()
+{
+    auto attempts = CreateObject<UniformRandomVariable>();
+    attempts->SetStream(1);
+    const auto nRates = m_manager->m_numRates;
+
+    for (const auto groupId : m_station->m_supportedGroups)
+    {
+        auto& rates = m_station->m_groupsTable[groupId].m_ratesTable;
+        std::vector<RateStats> expected(nRates);
+        for (uint8_t i = 0; i < nRates; ++i)
+        {
+            expected[i].supported = rates.supported[i];
+            expected[i].perfectTxTime = rates.perfectTxTime[i];
+        }
+
+        for (uint32_t update = 0; update < 10; ++update)
+        {
+            for (uint8_t i = 0; i < nRates; ++i)
+            {
+                if (!rates.supported[i])
+                {
+                    continue;
+                }
+                // no attempt at all in some intervals
+                const auto nAttempts = attempts->GetInteger(0, 3) * attempts->GetInteger(0, 20);
+                const auto nSuccesses = attempts->GetInteger(0, nAttempts);
+                rates.numRateAttempt[i] = expected[i].numRateAttempt = nAttempts;
+                rates.numRateSuccess[i] = expected[i].numRateSuccess = nSuccesses;
+                UpdateRateStats(expected[i]);
+            }
+            m_manager->UpdateGroupStats(m_station, groupId);
+
+            for (uint8_t i = 0; i < nRates; ++i)
+            {
+                NS_TEST_EXPECT_MSG_EQ(rates.prob[i], expected[i].prob, "Unexpected probability");
+                NS_TEST_EXPECT_MSG_EQ(rates.ewmaProb[i], expected[i].ewmaProb, "Unexpected EWMA");
+                NS_TEST_EXPECT_MSG_EQ(rates.ewmsdProb[i],
+                                      expected[i].ewmsdProb,
+                                      "Unexpected EWMSD");
+                NS_TEST_EXPECT_MSG_EQ(rates.throughput[i],
+                                      expected[i].throughput,
+                                      "Unexpected throughput for rate " << +i << " of group "
+                                                                        << groupId);
+                NS_TEST_EXPECT_MSG_EQ(rates.successHist[i],
+                                      expected[i].successHist,
+                                      "Unexpected success history");
+                NS_TEST_EXPECT_MSG_EQ(rates.attemptHist[i],
+                                      expected[i].attemptHist,
+                                      "Unexpected attempt history");
+                NS_TEST_EXPECT_MSG_EQ(rates.prevNumRateSuccess[i],
+                                      expected[i].prevNumRateSuccess,
+                                      "Unexpected number of successes in the last interval");
+                NS_TEST_EXPECT_MSG_EQ(rates.prevNumRateAttempt[i],
+                                      expected[i].prevNumRateAttempt,
+                                      "Unexpected number of attempts in the last interval");
+                NS_TEST_EXPECT_MSG_EQ(rates.numSamplesSkipped[i],
+                                      expected[i].numSamplesSkipped,
+                                      "Unexpected number of skipped samples");
+                NS_TEST_EXPECT_MSG_EQ(rates.numRateAttempt[i], 0, "Attempts not reset");
+                NS_TEST_EXPECT_MSG_EQ(rates.numRateSuccess[i], 0, "Successes not reset");
+            }
+        }
+    }
+}
+
+void
+MinstrelHtStatsTest::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer nodes(1);
+
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+    phy.Set("ChannelSettings", StringValue("{0, 160, BAND_5GHZ, 0}"));
+    phy.Set("Antennas", UintegerValue(4));
+    phy.Set("MaxSupportedTxSpatialStreams", UintegerValue(4));
+    phy.Set("MaxSupportedRxSpatialStreams", UintegerValue(4));
+
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211be);
+    wifi.SetRemoteStationManager("ns3::MinstrelHtWifiManager");
+    // enable all the HE/EHT guard intervals
+    wifi.ConfigHeOptions("GuardInterval", TimeValue(NanoSeconds(800)));
+    auto devices = wifi.Install(phy, mac, nodes);
+
+    // the MCS groups are initialized when the manager is initialized
+    Simulator::Stop(MilliSeconds(1));
+    Simulator::Run();
+
+    auto dev = DynamicCast<WifiNetDevice>(devices.Get(0));
+    m_manager = DynamicCast<MinstrelHtWifiManager>(dev->GetRemoteStationManager());
+    NS_TEST_ASSERT_MSG_NE(m_manager, nullptr, "Expected a Minstrel-HT manager");
+
+    CreateStation();
+    CheckSampleGroups();
+    CheckStatsUpdate();
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup wifi-test
+ * @ingroup tests
+ *
+ * @brief Minstrel Test Suite
+ */
+class MinstrelTestSuite : public TestSuite
+{
+  public:
+    MinstrelTestSuite();
+};
+
+MinstrelTestSuite::MinstrelTestSuite()
+    : TestSuite("wifi-minstrel", Type::UNIT)
+{
+    AddTestCase(new MinstrelLazyStatsUpdateTest, TestCase::Duration::QUICK);
+    AddTestCase(new MinstrelHtStatsTest, TestCase::Duration::QUICK);
+}
+
+static MinstrelTestSuite g_minstrelTestSuite; ///< the test suite
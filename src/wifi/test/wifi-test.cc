@@ -11,6 +11,7 @@
 
 #include "ns3/adhoc-wifi-mac.h"
 #include "ns3/ap-wifi-mac.h"
+#include "ns3/beacon-digest-tag.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/constant-rate-wifi-manager.h"
@@ -49,6 +50,7 @@
 #include "ns3/yans-wifi-phy.h"
 
 #include <optional>
+#include <set>
 
 using namespace ns3;
 
@@ -2152,6 +2154,187 @@ StaWifiMacScanningTestCase::DoRun()
     }
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * Make sure that the abstracted beacon mode of the AP (AbstractBeacons attribute set to true)
+ * does not change the size of the transmitted Beacon frames, that placeholder Beacon frames
+ * are transmitted and skipped by the STA, that an associated STA skipping the processing of
+ * Beacon frames keeps restarting its beacon watchdog (the STA is configured to disassociate
+ * after missing two Beacon frames) and that a change of the EDCA parameters advertised by the
+ * AP (which changes the digest of the Beacon frames) is applied by the STA.
+ */
+class AbstractBeaconsTestCase : public TestCase
+{
+  public:
+    AbstractBeaconsTestCase();
+    void DoRun() override;
+
+  private:
+    /// Information collected in a simulation run
+    struct RunResult
+    {
+        std::vector<uint32_t> beaconSizes; //!< the size of the transmitted Beacon frames
+        std::set<uint32_t> digests;        //!< the digests carried by Beacon frames
+        std::size_t nTaggedBeacons{0};     //!< the number of Beacon frames carrying a digest
+        std::size_t nPlaceholders{0};      //!< the number of placeholder Beacon frames
+        std::size_t nBeaconArrivals{0};    //!< the number of Beacon frames received by the STA
+        std::size_t nSkippedBeacons{0};    //!< the number of Beacon frames skipped by the STA
+        std::size_t nDeAssoc{0};           //!< the number of disassociations of the STA
+        bool associated{false};            //!< whether the STA is associated at the end
+        uint32_t staCwMin{0};              //!< the CWmin used by the STA for AC BE at the end
+    };
+
+    static constexpr uint32_t m_newCwMin{31}; //!< the CWmin for AC BE advertised after 0.6 s
+
+    /**
+     * Run a simulation with one AP and one STA.
+     *
+     * @param abstractBeacons the value of the AbstractBeacons attribute of the AP
+     * @return the information collected in the simulation run
+     */
+    RunResult Run(bool abstractBeacons);
+};
+
+AbstractBeaconsTestCase::AbstractBeaconsTestCase()
+    : TestCase("Test case for the abstracted beacon mode")
+{
+}
+
+AbstractBeaconsTestCase::RunResult
+AbstractBeaconsTestCase::Run(bool abstractBeacons)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    int64_t streamNumber = 1;
+
+    Ptr<Node> apNode = CreateObject<Node>();
+    Ptr<Node> staNode = CreateObject<Node>();
+
+    YansWifiPhyHelper phy;
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    phy.SetChannel(channel.Create());
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211ax);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager");
+
+    WifiMacHelper mac;
+    mac.SetType("ns3::ApWifiMac",
+                "AbstractBeacons",
+                BooleanValue(abstractBeacons),
+                "FullBeaconPeriod",
+                UintegerValue(4));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, apNode);
+    mac.SetType("ns3::StaWifiMac", "MaxMissedBeacons", UintegerValue(2));
+    NetDeviceContainer staDevice = wifi.Install(phy, mac, staNode);
+
+    WifiHelper::AssignStreams(apDevice, streamNumber);
+    WifiHelper::AssignStreams(staDevice, streamNumber + 1);
+
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 0.0));
+    positionAlloc->Add(Vector(5.0, 0.0, 0.0));
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+    mobility.Install(staNode);
+
+    RunResult result;
+
+    auto apDev = DynamicCast<WifiNetDevice>(apDevice.Get(0));
+    apDev->GetPhy()->TraceConnectWithoutContext(
+        "PhyTxPsduBegin",
+        Callback<void, WifiConstPsduMap, WifiTxVector, double>(
+            [&result](WifiConstPsduMap psduMap, WifiTxVector, double) {
+                auto psdu = psduMap.cbegin()->second;
+                if (!psdu->GetHeader(0).IsBeacon())
+                {
+                    return;
+                }
+                result.beaconSizes.push_back(psdu->GetSize());
+                if (BeaconDigestTag tag; psdu->GetPayload(0)->PeekPacketTag(tag))
+                {
+                    result.nTaggedBeacons++;
+                    result.digests.insert(tag.Get());
+                    result.nPlaceholders += (tag.IsPlaceholder() ? 1 : 0);
+                }
+            }));
+
+    auto staMac = DynamicCast<StaWifiMac>(DynamicCast<WifiNetDevice>(staDevice.Get(0))->GetMac());
+    staMac->TraceConnectWithoutContext("BeaconArrival",
+                                       Callback<void, Time>([&result](Time) {
+                                           result.nBeaconArrivals++;
+                                       }));
+    staMac->TraceConnectWithoutContext("DeAssoc",
+                                       Callback<void, Mac48Address>([&result](Mac48Address) {
+                                           result.nDeAssoc++;
+                                       }));
+    staMac->TraceConnectWithoutContext(
+        "BeaconSkipped",
+        Callback<void, uint8_t, Mac48Address>(
+            [&result](uint8_t, Mac48Address) { result.nSkippedBeacons++; }));
+
+    // change the EDCA parameters advertised by the AP, which does not change the state of the
+    // AP checked before every Beacon frame
+    Simulator::Schedule(Seconds(0.6), [=]() {
+        apDev->GetMac()->SetAttribute("CwMinsForSta",
+                                      ApWifiMac::UintAccessParamsMapValue(
+                                          ApWifiMac::UintAccessParamsMap{
+                                              {AC_BE, std::vector<uint64_t>{m_newCwMin}}}));
+    });
+
+    Simulator::Stop(Seconds(1.5));
+    Simulator::Run();
+    result.associated = staMac->IsAssociated();
+    result.staCwMin = staMac->GetQosTxop(AC_BE)->GetMinCw(SINGLE_LINK_OP_ID);
+    Simulator::Destroy();
+
+    return result;
+}
+
+void
+AbstractBeaconsTestCase::DoRun()
+{
+    const auto normal = Run(false);
+    const auto abstracted = Run(true);
+
+    NS_TEST_EXPECT_MSG_EQ(normal.nTaggedBeacons, 0, "Unexpected digest in normal mode");
+    NS_TEST_EXPECT_MSG_EQ(normal.nSkippedBeacons, 0, "Unexpected skipped Beacon in normal mode");
+    NS_TEST_EXPECT_MSG_EQ(abstracted.nTaggedBeacons,
+                          abstracted.beaconSizes.size(),
+                          "All Beacon frames should carry a digest in abstracted beacon mode");
+    NS_TEST_EXPECT_MSG_GT(abstracted.beaconSizes.size(), 10, "Too few Beacon frames transmitted");
+    NS_TEST_EXPECT_MSG_EQ((abstracted.beaconSizes == normal.beaconSizes),
+                          true,
+                          "The abstracted beacon mode must not change the size of Beacon frames");
+    NS_TEST_EXPECT_MSG_GT(abstracted.nPlaceholders, 0, "No placeholder Beacon frame sent");
+    NS_TEST_EXPECT_MSG_LT(abstracted.nPlaceholders,
+                          abstracted.beaconSizes.size(),
+                          "Some Beacon frames must be sent in full");
+    // all the placeholder Beacon frames (and possibly some Beacon frames sent in full) are
+    // skipped by the STA
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(abstracted.nSkippedBeacons,
+                                abstracted.nPlaceholders,
+                                "The STA did not skip all the placeholder Beacon frames");
+    // the content of the Beacon frames may change when the STA associates and changes when
+    // the EDCA parameters are changed
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(abstracted.digests.size(), 2, "Unexpected number of digests");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(abstracted.digests.size(), 3, "Unexpected number of digests");
+
+    for (const auto& result : {normal, abstracted})
+    {
+        NS_TEST_EXPECT_MSG_EQ(result.associated, true, "STA should be associated");
+        NS_TEST_EXPECT_MSG_EQ(result.nDeAssoc, 0, "STA should not disassociate");
+        NS_TEST_EXPECT_MSG_EQ(result.staCwMin,
+                              m_newCwMin,
+                              "The new EDCA parameters have not been applied by the STA");
+    }
+    NS_TEST_EXPECT_MSG_EQ(abstracted.nBeaconArrivals,
+                          normal.nBeaconArrivals,
+                          "The STA should be notified of the same number of Beacon frames");
+}
+
 //-----------------------------------------------------------------------------
 /**
  * Make sure that the ADDBA handshake process is protected.
@@ -4002,6 +4185,7 @@ WifiTestSuite::WifiTestSuite()
     AddTestCase(new Bug2843TestCase, TestCase::Duration::QUICK);            // Bug 2843
     AddTestCase(new Bug2831TestCase, TestCase::Duration::QUICK);            // Bug 2831
     AddTestCase(new StaWifiMacScanningTestCase, TestCase::Duration::QUICK); // Bug 2399
+    AddTestCase(new AbstractBeaconsTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Bug2470TestCase, TestCase::Duration::QUICK);            // Bug 2470
     AddTestCase(new Issue40TestCase, TestCase::Duration::QUICK);            // Issue #40
     AddTestCase(new Issue169TestCase, TestCase::Duration::QUICK);           // Issue #169
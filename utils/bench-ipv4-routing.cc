@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the route lookup of the IPv4 static and global routing
+// protocols, by adding 'routes' routes to networks of random length and looking up the route to
+// 'n' random destinations. Each lookup is performed both by searching the prefix trie and by
+// scanning the routing table (which is forced by adding a route whose mask is not a prefix).
+// Sample usage:  ./ns3 run 'bench-ipv4-routing --routes=20000 --n=100000'
+
+#include "ns3/command-line.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/// The networks the routes are added for, along with their mask
+static std::vector<std::pair<Ipv4Address, Ipv4Mask>> g_networks;
+/// The destinations the routes are looked up for
+static std::vector<Ipv4Address> g_destinations;
+
+/**
+ * Create the networks and the destinations used by the benchmarks. Networks are subnets of
+ * 10.0.0.0/8 whose length is between 16 and 30 bits.
+ *
+ * @param nRoutes the number of networks
+ * @param n the number of destinations
+ */
+static void
+CreateAddresses(uint32_t nRoutes, uint32_t n)
+{
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<uint32_t> host(0, 0xffffff);
+    std::uniform_int_distribution<uint32_t> length(16, 30);
+
+    g_networks.clear();
+    for (uint32_t i = 0; i < nRoutes; i++)
+    {
+        Ipv4Mask mask(("/" + std::to_string(length(gen))).c_str());
+        g_networks.emplace_back(Ipv4Address(0x0a000000 | host(gen)).CombineMask(mask), mask);
+    }
+    g_destinations.clear();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // half of the destinations belong to one of the networks
+        auto address = Ipv4Address(0x0a000000 | host(gen));
+        if (i % 2 == 0)
+        {
+            const auto& [network, mask] = g_networks[i % nRoutes];
+            address = Ipv4Address(network.Get() | (address.Get() & mask.GetInverse()));
+        }
+        g_destinations.push_back(address);
+    }
+}
+
+/**
+ * Look up the route to all the destinations.
+ *
+ * @param routing the routing protocol
+ * @return the number of destinations for which a route has been found
+ */
+static uint32_t
+Lookup(Ptr<Ipv4RoutingProtocol> routing)
+{
+    uint32_t found = 0;
+    Ipv4Header header;
+    auto packet = Create<Packet>();
+    Socket::SocketErrno sockerr;
+    for (const auto& destination : g_destinations)
+    {
+        header.SetDestination(destination);
+        if (routing->RouteOutput(packet, header, nullptr, sockerr))
+        {
+            ++found;
+        }
+    }
+    return found;
+}
+
+/**
+ * Fill the given routing protocol, then look up the routes to all the destinations with the
+ * prefix trie and by scanning the routing table, and print the results.
+ *
+ * @tparam T the type of the routing protocol
+ * @param ipv4 the IPv4 stack the routing protocol is attached to
+ * @param addRoute a function adding a route to the given network to the routing protocol
+ * @param name the name of the routing protocol
+ */
+template <typename T>
+static void
+RunBench(Ptr<Ipv4> ipv4,
+         std::function<void(Ptr<T>, Ipv4Address, Ipv4Mask)> addRoute,
+         const char* name)
+{
+    auto routing = CreateObject<T>();
+    routing->SetIpv4(ipv4);
+
+    SystemWallClockMs time;
+    time.Start();
+    for (const auto& [network, mask] : g_networks)
+    {
+        addRoute(routing, network, mask);
+    }
+    auto addDelay = time.End();
+    std::cout << name << ": " << routing->GetNRoutes() << " routes added in " << addDelay << " ms"
+              << std::endl;
+
+    for (auto trie : {true, false})
+    {
+        if (!trie)
+        {
+            // a route that matches none of the destinations
+            addRoute(routing, Ipv4Address("192.0.1.0"), Ipv4Mask("255.0.255.0"));
+        }
+        time.Start();
+        auto found = Lookup(routing);
+        auto delay = time.End();
+        double ps = g_destinations.size();
+        ps *= 1000;
+        ps /= std::max<uint64_t>(delay, 1);
+        std::cout << ps << " lookups/s (" << delay << " ms elapsed, " << found
+                  << " routes found)\t" << name << (trie ? " prefix trie" : " table scan")
+                  << std::endl;
+    }
+    routing->Dispose();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t nRoutes = 10000;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the route lookup of the IPv4 static and global routing protocols");
+    cmd.AddValue("n", "number of lookups", n);
+    cmd.AddValue("routes", "number of routes", nRoutes);
+    cmd.Parse(argc, argv);
+
+    if (n == 0 || nRoutes == 0)
+    {
+        std::cerr << "Error-- number of lookups must be specified "
+                  << "by command-line argument --n=(number of lookups)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-ipv4-routing with n=" << n << " and " << nRoutes << " routes"
+              << std::endl;
+
+    auto node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    SimpleNetDeviceHelper devHelper;
+    auto devices = devHelper.Install(node);
+    Ipv4AddressHelper addresses("192.168.0.0", "255.255.255.0");
+    addresses.Assign(devices);
+    auto ipv4 = node->GetObject<Ipv4>();
+
+    CreateAddresses(nRoutes, n);
+
+    RunBench<Ipv4StaticRouting>(
+        ipv4,
+        [](Ptr<Ipv4StaticRouting> routing, Ipv4Address network, Ipv4Mask mask) {
+            routing->AddNetworkRouteTo(network, mask, Ipv4Address("192.168.0.2"), 1);
+        },
+        "Ipv4StaticRouting");
+    RunBench<Ipv4GlobalRouting>(
+        ipv4,
+        [](Ptr<Ipv4GlobalRouting> routing, Ipv4Address network, Ipv4Mask mask) {
+            routing->AddNetworkRouteTo(network, mask, Ipv4Address("192.168.0.2"), 1);
+        },
+        "Ipv4GlobalRouting");
+
+    Simulator::Destroy();
+    return 0;
+}
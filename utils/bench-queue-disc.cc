@@ -0,0 +1,277 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the flow queuing disciplines, by enqueuing and
+// dequeuing 'n' packets belonging to a given number of flows. The time per packet spent
+// enqueuing, dequeuing and enqueuing/dequeuing at a steady queue depth is reported.
+// Sample usage:  ./ns3 run 'bench-queue-disc --n=100000 --flows=1024 --type=fq-codel'
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/fq-cobalt-queue-disc.h"
+#include "ns3/fq-codel-queue-disc.h"
+#include "ns3/fq-pie-queue-disc.h"
+#include "ns3/packet.h"
+#include "ns3/queue-item.h"
+#include "ns3/queue-size.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Queue disc item whose flow hash is set at construction time.
+ */
+class BenchQueueDiscItem : public QueueDiscItem
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * @param p the packet
+     * @param hash the flow hash
+     */
+    BenchQueueDiscItem(Ptr<Packet> p, uint32_t hash)
+        : QueueDiscItem(p, Address(), 0),
+          m_hash(hash)
+    {
+    }
+
+    void AddHeader() override
+    {
+    }
+
+    bool Mark() override
+    {
+        return false;
+    }
+
+    uint32_t Hash(uint32_t perturbation) const override
+    {
+        return m_hash;
+    }
+
+  private:
+    uint32_t m_hash; //!< the flow hash
+};
+
+/// The items enqueued by the benchmarks
+static std::vector<Ptr<QueueDiscItem>> g_items;
+
+/**
+ * Create the items used by the benchmarks. Items belong to the given number of flows in a
+ * round robin fashion.
+ *
+ * @param n the number of items
+ * @param nFlows the number of flows
+ */
+static void
+CreateItems(uint32_t n, uint32_t nFlows)
+{
+    g_items.clear();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        g_items.push_back(Create<BenchQueueDiscItem>(Create<Packet>(1000), i % nFlows));
+    }
+}
+
+/**
+ * Create and initialize a flow queuing discipline.
+ *
+ * @param type the type of queue disc (fq-codel, fq-cobalt or fq-pie)
+ * @param nFlows the number of flow queues
+ * @param setAssociativeHash whether to enable the set associative hash
+ * @return the queue disc, or a null pointer if the type is unknown
+ */
+static Ptr<QueueDisc>
+CreateQueueDisc(const std::string& type, uint32_t nFlows, bool setAssociativeHash)
+{
+    Ptr<QueueDisc> qd;
+    if (type == "fq-codel")
+    {
+        auto fq = CreateObject<FqCoDelQueueDisc>();
+        fq->SetQuantum(1500);
+        qd = fq;
+    }
+    else if (type == "fq-cobalt")
+    {
+        auto fq = CreateObject<FqCobaltQueueDisc>();
+        fq->SetQuantum(1500);
+        qd = fq;
+    }
+    else if (type == "fq-pie")
+    {
+        auto fq = CreateObject<FqPieQueueDisc>();
+        fq->SetQuantum(1500);
+        qd = fq;
+    }
+    else
+    {
+        return nullptr;
+    }
+    // all the packets must fit the queue disc
+    qd->SetAttribute("MaxSize", QueueSizeValue(QueueSize(QueueSizeUnit::PACKETS, g_items.size())));
+    qd->SetAttribute("Flows", UintegerValue(nFlows));
+    qd->SetAttribute("EnableSetAssociativeHash", BooleanValue(setAssociativeHash));
+    qd->Initialize();
+    return qd;
+}
+
+/**
+ * Enqueue all the items.
+ *
+ * @param qd the queue disc
+ * @return the time spent enqueuing, in milliseconds
+ */
+static int64_t
+BenchEnqueue(Ptr<QueueDisc> qd)
+{
+    SystemWallClockMs time;
+    time.Start();
+    for (const auto& item : g_items)
+    {
+        qd->Enqueue(item);
+    }
+    auto elapsed = time.End();
+
+    while (qd->Dequeue())
+    {
+    }
+    return elapsed;
+}
+
+/**
+ * Enqueue all the items and time dequeuing them.
+ *
+ * @param qd the queue disc
+ * @return the time spent dequeuing, in milliseconds
+ */
+static int64_t
+BenchDequeue(Ptr<QueueDisc> qd)
+{
+    for (const auto& item : g_items)
+    {
+        qd->Enqueue(item);
+    }
+
+    SystemWallClockMs time;
+    time.Start();
+    while (qd->Dequeue())
+    {
+    }
+    return time.End();
+}
+
+/**
+ * Keep the queue disc at a steady depth by dequeuing an item for every item enqueued.
+ *
+ * @param qd the queue disc
+ * @return the time spent enqueuing and dequeuing, in milliseconds
+ */
+static int64_t
+BenchSteadyState(Ptr<QueueDisc> qd)
+{
+    const std::size_t depth = g_items.size() / 4;
+
+    SystemWallClockMs time;
+    time.Start();
+    for (std::size_t i = 0; i < g_items.size(); i++)
+    {
+        qd->Enqueue(g_items[i]);
+        if (i >= depth)
+        {
+            qd->Dequeue();
+        }
+    }
+    auto elapsed = time.End();
+
+    while (qd->Dequeue())
+    {
+    }
+    return elapsed;
+}
+
+/**
+ * Run the given benchmark a number of times and print the best result.
+ *
+ * @param bench the benchmark
+ * @param type the type of queue disc
+ * @param nFlows the number of flow queues
+ * @param setAssociativeHash whether to enable the set associative hash
+ * @param minIterations the number of times the benchmark is run
+ * @param name the name of the benchmark
+ */
+static void
+RunBench(int64_t (*bench)(Ptr<QueueDisc>),
+         const std::string& type,
+         uint32_t nFlows,
+         bool setAssociativeHash,
+         uint32_t minIterations,
+         const char* name)
+{
+    int64_t minTime = std::numeric_limits<int64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        auto qd = CreateQueueDisc(type, nFlows, setAssociativeHash);
+        minTime = std::min(minTime, (*bench)(qd));
+        qd->Dispose();
+    }
+    double minTimeNs = minTime * 1e6 / g_items.size();
+    std::cout << minTimeNs << " ns/packet (" << minTime << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t nFlows = 1024;
+    std::string type = "fq-codel";
+    bool setAssociativeHash = false;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the flow queuing disciplines");
+    cmd.AddValue("n", "number of packets", n);
+    cmd.AddValue("flows", "number of flows the packets belong to", nFlows);
+    cmd.AddValue("type", "type of queue disc (fq-codel, fq-cobalt or fq-pie)", type);
+    cmd.AddValue("set-associative", "enable the set associative hash", setAssociativeHash);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0 || nFlows == 0)
+    {
+        std::cerr << "Error-- number of packets must be specified "
+                  << "by command-line argument --n=(number of packets)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-queue-disc with n=" << n << ", " << nFlows << " flows and type "
+              << type << std::endl;
+
+    CreateItems(n, nFlows);
+    if (!CreateQueueDisc(type, nFlows, setAssociativeHash))
+    {
+        std::cerr << "Error-- unknown queue disc type " << type << std::endl;
+        exit(1);
+    }
+
+    RunBench(&BenchEnqueue, type, nFlows, setAssociativeHash, minIterations, "Enqueue");
+    RunBench(&BenchDequeue, type, nFlows, setAssociativeHash, minIterations, "Dequeue");
+    RunBench(&BenchSteadyState,
+             type,
+             nFlows,
+             setAssociativeHash,
+             minIterations,
+             "Enqueue and dequeue at steady queue depth");
+
+    g_items.clear();
+    return 0;
+}
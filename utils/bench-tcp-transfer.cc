@@ -0,0 +1,171 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the TCP transmission and reception buffers, by running a
+// bulk transfer of 'bytes' bytes between two nodes connected by a link dropping a fraction 'loss'
+// of the packets, so that the SACK scoreboard is exercised. The number of simulated events per
+// second of wall-clock time is reported. The sender emulates TCP segmentation offload if 'tso' is
+// larger than the segment size.
+// Sample usage:  ./ns3 run 'bench-tcp-transfer --bytes=200000000 --loss=0.00001'
+
+#include "ns3/command-line.h"
+#include "ns3/error-model.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/pointer.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/tcp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <iostream>
+
+using namespace ns3;
+
+static uint64_t g_toSend = 0;   //!< Bytes still to be passed to the sending socket
+static uint64_t g_received = 0; //!< Bytes read from the receiving socket
+
+/**
+ * Fill the transmission buffer of the sending socket.
+ *
+ * @param socket the sending socket
+ * @param available the free space in the transmission buffer
+ */
+static void
+Fill(Ptr<Socket> socket, uint32_t available)
+{
+    while (g_toSend > 0 && socket->GetTxAvailable() > 0)
+    {
+        uint32_t size = std::min<uint64_t>({g_toSend, socket->GetTxAvailable(), 1448});
+        int sent = socket->Send(Create<Packet>(size));
+        if (sent <= 0)
+        {
+            break;
+        }
+        g_toSend -= sent;
+    }
+    if (g_toSend == 0)
+    {
+        socket->SetSendCallback(MakeNullCallback<void, Ptr<Socket>, uint32_t>());
+        socket->Close();
+    }
+}
+
+/**
+ * Read all the data available in the receiving socket.
+ *
+ * @param socket the receiving socket
+ */
+static void
+Drain(Ptr<Socket> socket)
+{
+    while (auto packet = socket->Recv())
+    {
+        if (packet->GetSize() == 0)
+        {
+            break;
+        }
+        g_received += packet->GetSize();
+    }
+}
+
+/**
+ * Start reading the data received by an accepted socket.
+ *
+ * @param socket the accepted socket
+ * @param from the address of the peer
+ */
+static void
+Accept(Ptr<Socket> socket, const Address& from)
+{
+    socket->SetRecvCallback(MakeCallback(&Drain));
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t bytes = 0;
+    double loss = 1e-5;
+    std::string dataRate = "1Gbps";
+    std::string delay = "10ms";
+    uint32_t bufferSize = 4 << 20;
+    uint32_t tsoMaxSize = 0;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark a TCP bulk transfer over a lossy link");
+    cmd.AddValue("bytes", "number of bytes to transfer", bytes);
+    cmd.AddValue("loss", "packet error rate of the link", loss);
+    cmd.AddValue("rate", "data rate of the link", dataRate);
+    cmd.AddValue("delay", "propagation delay of the link", delay);
+    cmd.AddValue("buffer", "size of the socket buffers", bufferSize);
+    cmd.AddValue("tso", "maximum payload size of the TSO super-segments", tsoMaxSize);
+    cmd.Parse(argc, argv);
+
+    if (bytes == 0)
+    {
+        std::cerr << "Error-- number of bytes must be specified "
+                  << "by command-line argument --bytes=(number of bytes)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-tcp-transfer with bytes=" << bytes << " and loss=" << loss
+              << std::endl;
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetDeviceAttribute("DataRate", StringValue(dataRate));
+    devHelper.SetChannelAttribute("Delay", StringValue(delay));
+    devHelper.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("10000p"));
+    auto devices = devHelper.Install(nodes);
+    if (loss > 0)
+    {
+        auto errorModel = CreateObject<RateErrorModel>();
+        errorModel->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+        errorModel->SetRate(loss);
+        devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(errorModel));
+    }
+    Ipv4AddressHelper addresses("10.0.0.0", "255.255.255.0");
+    auto interfaces = addresses.Assign(devices);
+
+    auto sink = Socket::CreateSocket(nodes.Get(1), TcpSocketFactory::GetTypeId());
+    sink->SetAttribute("RcvBufSize", UintegerValue(bufferSize));
+    sink->Bind(InetSocketAddress(Ipv4Address::GetAny(), 5000));
+    sink->Listen();
+    sink->SetAcceptCallback(MakeNullCallback<bool, Ptr<Socket>, const Address&>(),
+                            MakeCallback(&Accept));
+
+    auto source = Socket::CreateSocket(nodes.Get(0), TcpSocketFactory::GetTypeId());
+    source->SetAttribute("SndBufSize", UintegerValue(bufferSize));
+    source->SetAttribute("TsoMaxSize", UintegerValue(tsoMaxSize));
+    source->SetSendCallback(MakeCallback(&Fill));
+    source->Connect(InetSocketAddress(interfaces.GetAddress(1), 5000));
+    g_toSend = bytes;
+
+    SystemWallClockMs time;
+    time.Start();
+    Simulator::Run();
+    auto elapsed = time.End();
+
+    double eventsPerSec = Simulator::GetEventCount();
+    eventsPerSec *= 1000;
+    eventsPerSec /= std::max<uint64_t>(elapsed, 1);
+    auto simulated = Simulator::Now().GetSeconds();
+    std::cout << Simulator::GetEventCount() << " events in " << elapsed << " ms ("
+              << eventsPerSec << " events/s)" << std::endl;
+    std::cout << g_received << " bytes received in " << simulated << " s of simulated time ("
+              << g_received * 8 / std::max(simulated, 1e-9) / 1e6 << " Mbps)" << std::endl;
+
+    Simulator::Destroy();
+    return 0;
+}
@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the container used by the wifi MAC queue,
+// by enqueuing and dequeuing 'n' MPDUs destined to a given number of stations
+// Sample usage:  ./ns3 run 'bench-wifi-mac-queue --n=100000 --stations=50'
+
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-mac-queue-container.h"
+#include "ns3/wifi-mpdu.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace ns3;
+
+/// The MPDUs enqueued by the benchmarks
+static std::vector<Ptr<WifiMpdu>> g_mpdus;
+/// The IDs of the container queues the MPDUs are enqueued into
+static std::vector<WifiContainerQueueId> g_queueIds;
+
+/**
+ * Create the MPDUs used by the benchmarks. MPDUs are destined to the given number of
+ * stations in a round robin fashion and use all the TIDs of AC_BE.
+ *
+ * @param n the number of MPDUs
+ * @param nStations the number of stations
+ */
+static void
+CreateMpdus(uint32_t n, uint32_t nStations)
+{
+    std::vector<Mac48Address> addresses;
+    for (uint32_t i = 0; i < nStations; i++)
+    {
+        addresses.push_back(Mac48Address::Allocate());
+    }
+    const auto txAddr = Mac48Address::Allocate();
+
+    g_mpdus.clear();
+    g_queueIds.clear();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        WifiMacHeader header(WIFI_MAC_QOSDATA);
+        header.SetAddr1(addresses[i % nStations]);
+        header.SetAddr2(txAddr);
+        header.SetQosTid((i / nStations) % 2 == 0 ? 0 : 3);
+        header.SetSequenceNumber(i % 4096);
+        g_mpdus.push_back(Create<WifiMpdu>(Create<Packet>(1000), header));
+        if (i < 2 * nStations)
+        {
+            g_queueIds.push_back(WifiMacQueueContainer::GetQueueId(g_mpdus.back()));
+        }
+    }
+}
+
+/**
+ * Enqueue all the MPDUs and then dequeue them from the head of each container queue.
+ *
+ * @param container the container
+ */
+static void
+BenchEnqueueDequeue(WifiMacQueueContainer& container)
+{
+    for (const auto& mpdu : g_mpdus)
+    {
+        auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+        auto it = container.insert(container.GetQueue(queueId).cend(), mpdu);
+        it->deleter = [](auto) {};
+    }
+
+    bool empty = false;
+    while (!empty)
+    {
+        empty = true;
+        for (const auto& queueId : g_queueIds)
+        {
+            if (const auto& queue = container.GetQueue(queueId); !queue.empty())
+            {
+                container.erase(queue.cbegin());
+                empty = false;
+            }
+        }
+    }
+}
+
+/**
+ * Keep each container queue at a steady depth by enqueuing an MPDU for every MPDU dequeued.
+ *
+ * @param container the container
+ */
+static void
+BenchSteadyState(WifiMacQueueContainer& container)
+{
+    const std::size_t depth = g_mpdus.size() / 4;
+
+    for (std::size_t i = 0; i < g_mpdus.size(); i++)
+    {
+        const auto& mpdu = g_mpdus[i];
+        auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+        auto it = container.insert(container.GetQueue(queueId).cend(), mpdu);
+        it->deleter = [](auto) {};
+
+        if (i >= depth)
+        {
+            const auto& queue =
+                container.GetQueue(WifiMacQueueContainer::GetQueueId(g_mpdus[i - depth]));
+            container.erase(queue.cbegin());
+        }
+    }
+    container.clear();
+}
+
+/**
+ * Enqueue all the MPDUs and then extract them all as MPDUs with expired lifetime.
+ *
+ * @param container the container
+ */
+static void
+BenchExpired(WifiMacQueueContainer& container)
+{
+    for (const auto& mpdu : g_mpdus)
+    {
+        auto queueId = WifiMacQueueContainer::GetQueueId(mpdu);
+        auto it = container.insert(container.GetQueue(queueId).cend(), mpdu);
+        it->deleter = [](auto) {};
+    }
+
+    container.ExtractAllExpiredMpdus();
+    auto [first, last] = container.GetAllExpiredMpdus();
+    while (first != last)
+    {
+        first = container.erase(first);
+    }
+}
+
+/**
+ * Run the given benchmark a number of times and print the best result.
+ *
+ * @param bench the benchmark
+ * @param minIterations the number of times the benchmark is run
+ * @param name the name of the benchmark
+ */
+static void
+RunBench(void (*bench)(WifiMacQueueContainer&), uint32_t minIterations, const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    std::size_t poolCapacity = 0;
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        WifiMacQueueContainer container;
+        SystemWallClockMs time;
+        time.Start();
+        (*bench)(container);
+        minDelay = std::min<uint64_t>(minDelay, time.End());
+        poolCapacity = container.GetPool().GetCapacity();
+    }
+    double ps = g_mpdus.size();
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " MPDUs/s"
+              << " (" << minDelay << " ms elapsed, pool capacity " << poolCapacity
+              << " elements)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t nStations = 10;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the wifi MAC queue container");
+    cmd.AddValue("n", "number of MPDUs", n);
+    cmd.AddValue("stations", "number of stations the MPDUs are destined to", nStations);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0 || nStations == 0)
+    {
+        std::cerr << "Error-- number of MPDUs must be specified "
+                  << "by command-line argument --n=(number of MPDUs)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-wifi-mac-queue with n=" << n << " and " << nStations
+              << " stations" << std::endl;
+
+    CreateMpdus(n, nStations);
+
+    RunBench(&BenchEnqueueDequeue, minIterations, "Enqueue all, dequeue round robin");
+    RunBench(&BenchSteadyState, minIterations, "Enqueue/dequeue at steady queue depth");
+    RunBench(&BenchExpired, minIterations, "Extract and wipe expired MPDUs");
+
+    g_mpdus.clear();
+    return 0;
+}